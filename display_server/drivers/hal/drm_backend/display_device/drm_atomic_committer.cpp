@@ -29,26 +29,50 @@ DrmAtomicCommitter::~DrmAtomicCommitter() noexcept
     drmModeAtomicFree(req_);
 }
 
-void DrmAtomicCommitter::AddAtomicProperty(uint32_t objId, uint32_t propId, uint64_t value)
+void DrmAtomicCommitter::AddAtomicProperty(uint32_t objId, uint32_t propId, uint64_t value, bool cacheable)
 {
     if (OE_UNLIKELY(req_ == nullptr)) {
         LOG_ERROR("DrmAtomicCommitter::AddAtomicProperty: req_ is nullptr!");
         return;
     }
 
+    if (cacheable && propertyCache_ != nullptr) {
+        if (propertyCache_->IsCommitted(objId, propId, value)) {
+            return;
+        }
+        pendingProperties_.push_back({objId, propId, value});
+    }
+
     int ret = drmModeAtomicAddProperty(req_, objId, propId, value);
     if (ret < 0) {
         LOG_WARN("drmModeAtomicAddProperty failed, err: %{public}s", ErrnoToString(errno).c_str());
     }
 }
 
-void DrmAtomicCommitter::Commit()
+bool DrmAtomicCommitter::Commit()
 {
     LOG_DEBUG("DrmAtomicCommitter::Commit: drmFd: %{public}i, flags: %{public}i, userData: %{public}p", drmFd_, flags_, userData_);
     int ret = drmModeAtomicCommit(drmFd_, req_, flags_, userData_);
     if (ret < 0) {
-        LOG_ERROR("DrmAtomicCommitter::Commit: failed, err: %{public}d, %{public}s", ret, ErrnoToString(errno).c_str());
+        if (flags_ & DRM_MODE_ATOMIC_TEST_ONLY) {
+            LOG_DEBUG("DrmAtomicCommitter::Commit: test only commit rejected, err: %{public}d, %{public}s",
+                ret, ErrnoToString(errno).c_str());
+        } else {
+            LOG_ERROR("DrmAtomicCommitter::Commit: failed, err: %{public}d, %{public}s", ret, ErrnoToString(errno).c_str());
+        }
+        if (propertyCache_ != nullptr) {
+            // we don't know what the kernel state is now, the next commit should carry everything.
+            propertyCache_->Clear();
+        }
+        return false;
+    }
+
+    if (propertyCache_ != nullptr && (flags_ & DRM_MODE_ATOMIC_TEST_ONLY) == 0) {
+        for (const auto &prop : pendingProperties_) {
+            propertyCache_->Update(prop.objId, prop.propId, prop.value);
+        }
     }
+    return true;
 }
 } // namespace drm
 } // namespace FT
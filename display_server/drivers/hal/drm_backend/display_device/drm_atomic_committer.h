@@ -15,10 +15,43 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "drm_common.h"
 
 namespace FT {
 namespace drm {
+// Remembers the property values which are already committed to the kernel,
+// so that steady-state commits only need to carry the properties which changed.
+class DrmAtomicPropertyCache : NonCopyable {
+public:
+    DrmAtomicPropertyCache() = default;
+    ~DrmAtomicPropertyCache() noexcept = default;
+
+    bool IsCommitted(uint32_t objId, uint32_t propId, uint64_t value) const
+    {
+        auto iter = values_.find(MakeKey(objId, propId));
+        return iter != values_.end() && iter->second == value;
+    }
+    void Update(uint32_t objId, uint32_t propId, uint64_t value)
+    {
+        values_[MakeKey(objId, propId)] = value;
+    }
+    void Clear()
+    {
+        values_.clear();
+    }
+
+private:
+    static uint64_t MakeKey(uint32_t objId, uint32_t propId)
+    {
+        return (static_cast<uint64_t>(objId) << 32) | propId;
+    }
+
+    std::unordered_map<uint64_t, uint64_t> values_;
+};
+
 // RAII object for drm auto atomic committing.
 class DrmAtomicCommitter : NonCopyable {
 public:
@@ -28,14 +61,30 @@ public:
         void *userData = nullptr);
     ~DrmAtomicCommitter() noexcept;
 
-    void AddAtomicProperty(uint32_t objId, uint32_t propId, uint64_t value);
-    void Commit();
+    // With a property cache, the properties already committed with the same value are skipped,
+    // and the cache is updated after a successful commit(cleared if failed).
+    void SetPropertyCache(DrmAtomicPropertyCache *cache)
+    {
+        propertyCache_ = cache;
+    }
+    // set cacheable to false for the properties which must be carried by every commit, e.g. OUT_FENCE_PTR.
+    void AddAtomicProperty(uint32_t objId, uint32_t propId, uint64_t value, bool cacheable = true);
+    // return true if the commit(or the TEST_ONLY check) succeeded.
+    bool Commit();
 
 private:
     int drmFd_ = INVALID_FD;
     drmModeAtomicReqPtr req_;
     int flags_;
     void *userData_ = nullptr;
+
+    struct PendingProperty {
+        uint32_t objId;
+        uint32_t propId;
+        uint64_t value;
+    };
+    DrmAtomicPropertyCache *propertyCache_ = nullptr;
+    std::vector<PendingProperty> pendingProperties_;
 };
 } // namespace drm
 } // namespace FT
\ No newline at end of file
@@ -227,9 +227,15 @@ std::shared_ptr<HdiDisplay> DrmDevice::BuildHdiDisplayFromConnector(
     }
 
     for (const auto &[planeId, plane] : planes_) {
-        UNUSED(planeId);
-        if (plane->GetPossibleCrtcs() & (1 << crtc->Pipe()) && plane->GetPlaneType() == DRM_PLANE_TYPE_PRIMARY) {
+        if ((plane->GetPossibleCrtcs() & (1 << crtc->Pipe())) == 0) {
+            continue;
+        }
+        if (plane->GetPlaneType() == DRM_PLANE_TYPE_PRIMARY) {
             display->SetPrimaryPlane(plane);
+        } else if (plane->GetPlaneType() == DRM_PLANE_TYPE_OVERLAY && claimedOverlayPlanes_.count(planeId) == 0) {
+            // an overlay plane may be usable by several crtcs, but only one display can own it.
+            claimedOverlayPlanes_.insert(planeId);
+            display->AddOverlayPlane(plane);
         }
     }
 
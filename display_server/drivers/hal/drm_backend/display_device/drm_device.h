@@ -17,6 +17,7 @@
 
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #ifdef DRM_BACKEND_USE_GBM
 #include <gbm.h>
@@ -148,6 +149,7 @@ private:
     IdMapPtr<DrmConnector> connectors_;
     IdMapPtr<DrmEncoder> encoders_;
     IdMapPtr<DrmPlane> planes_;
+    std::unordered_set<uint32_t> claimedOverlayPlanes_;
 
     mutable std::mutex mutex_;
     IdMapPtr<HdiDisplay> displays_; // guarded by mutex_;
@@ -15,8 +15,11 @@
 
 #include "drm_display.h"
 
+#include <algorithm>
+#include <chrono>
+#include <drm_fourcc.h>
+
 #include "sync_fence.h"
-#include "drm_atomic_committer.h"
 #include "log.h"
 
 #include "hdi_session.h"
@@ -28,11 +31,24 @@ DrmDisplay::DrmDisplay(
     HdiDisplayId id,
     std::shared_ptr<DrmConnector> connector,
     std::shared_ptr<DrmCrtc> crtc)
-    : drmFd_(drmFd), id_(id), connector_(std::move(connector)), crtc_(std::move(crtc))
+    : drmFd_(drmFd),
+      id_(id),
+      connector_(std::move(connector)),
+      crtc_(std::move(crtc)),
+      fbCache_(std::make_shared<DrmFrameBufferCache>(drmFd))
 {}
 
 DrmDisplay::~DrmDisplay() noexcept {}
 
+void DrmDisplay::AddOverlayPlane(const std::shared_ptr<DrmPlane> &overlayPlane)
+{
+    overlayPlanes_.push_back(overlayPlane);
+    std::stable_sort(overlayPlanes_.begin(), overlayPlanes_.end(),
+        [](const std::shared_ptr<DrmPlane> &lhs, const std::shared_ptr<DrmPlane> &rhs) {
+            return lhs->GetZpos() < rhs->GetZpos();
+        });
+}
+
 bool DrmDisplay::Init()
 {
     LOG_DEBUG("DrmDisplay::Init");
@@ -85,6 +101,7 @@ int32_t DrmDisplay::SetDisplayMode(uint32_t modeId)
     if (!connector_->SetActiveModeId(modeId)) {
         return DISPLAY_PARAM_ERR;
     }
+    modeSetCommitted_ = false;
 
     return DISPLAY_SUCCESS;
 }
@@ -117,6 +134,7 @@ int32_t DrmDisplay::SetDisplayPowerStatus(DispPowerStatus status)
     if (!connector_->SetDpms(dpms)) {
         return DISPLAY_FAILURE;
     }
+    modeSetCommitted_ = false;
 
     return DISPLAY_SUCCESS;
 }
@@ -156,7 +174,12 @@ uint64_t DrmDisplay::ToDpms(DispPowerStatus status)
 std::unique_ptr<HdiLayer> DrmDisplay::CreateHdiLayer(HDI::DISPLAY::LayerId id, LayerType type)
 {
     LOG_DEBUG("DrmDisplay::CreateHdiLayer");
-    return std::make_unique<DrmLayer>(id, type);
+    return std::make_unique<DrmLayer>(id, type, fbCache_);
+}
+
+void DrmDisplay::OnBufferFreed(const BufferHandle &handle)
+{
+    fbCache_->Evict(handle);
 }
 
 int32_t DrmDisplay::GetDisplayBacklight(uint32_t *value)
@@ -265,7 +288,10 @@ void DrmDisplay::OnVSync(uint32_t sequence, uint64_t timeStamp)
         std::lock_guard<std::mutex> lock(mutex_);
         cb = vSyncCallBack_;
         data = vsyncUserData_;
+        // the page flip of the last commit is done.
+        flipPending_ = false;
     }
+    flipCond_.notify_all();
  #ifdef ENABLE_HARDWARE_VSYNC
     if (enableVsync_) {
         if (cb != nullptr) {
@@ -284,6 +310,19 @@ void DrmDisplay::OnVSync(uint32_t sequence, uint64_t timeStamp)
 #endif
 }
 
+void DrmDisplay::WaitForPendingFlip()
+{
+    // A NONBLOCK commit would be rejected with EBUSY while the last page flip is not done yet.
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!flipPending_) {
+        return;
+    }
+    if (!flipCond_.wait_for(lock, std::chrono::milliseconds(FLIP_TIMEOUT_MS), [this]() { return !flipPending_; })) {
+        LOG_WARN("DrmDisplay::WaitForPendingFlip: wait for page flip event timeout.");
+        flipPending_ = false;
+    }
+}
+
 int32_t DrmDisplay::SetDisplayVsyncEnabled(bool enabled)
 {
 #ifdef ENABLE_HARDWARE_VSYNC
@@ -388,9 +427,15 @@ int32_t DrmDisplay::PrepareDisplayLayers(bool *needFlushFb)
                   , layer->GetId(), layer->GetZOrder());
     }
 
+    AssignPlanes(layers);
+
     for (auto &layer : layers) {
-        if (layer->GetCompositionType() != COMPOSITION_CURSOR && layer->GetCompositionType() != COMPOSITION_VIDEO &&
-            layer->GetCompositionType() != COMPOSITION_TUNNEL) {
+        if (layer->GetId() == primaryPlaneLayerId_ ||
+            std::any_of(overlayAssignments_.begin(), overlayAssignments_.end(),
+                [&layer](const PlaneAssignment &assignment) { return assignment.layerId == layer->GetId(); })) {
+            layer->SetDeviceSelect(COMPOSITION_DEVICE);
+        } else if (layer->GetCompositionType() != COMPOSITION_CURSOR &&
+            layer->GetCompositionType() != COMPOSITION_VIDEO && layer->GetCompositionType() != COMPOSITION_TUNNEL) {
             layer->SetDeviceSelect(COMPOSITION_CLIENT);
         } else {
             layer->SetDeviceSelect(layer->GetCompositionType());
@@ -405,10 +450,149 @@ int32_t DrmDisplay::PrepareDisplayLayers(bool *needFlushFb)
         }
     }
 
-    *needFlushFb = true;
+    *needFlushFb = clientCompositionNeeded_;
     return DISPLAY_SUCCESS;
 }
 
+DrmLayer *DrmDisplay::GetDrmLayer(HDI::DISPLAY::LayerId layerId)
+{
+    return DownCast<DrmLayer *>(GetHdiLayer(layerId));
+}
+
+bool DrmDisplay::CanScanoutDirectly(HdiLayer &layer, const DrmPlane &plane) const
+{
+    if (layer.GetCompositionType() != COMPOSITION_DEVICE) {
+        return false;
+    }
+
+    auto buffer = layer.GetCurrentBuffer();
+    if (buffer == nullptr) {
+        return false;
+    }
+
+    // Only DMA buffers can be imported as framebuffers.
+    const auto &handle = buffer->GetBufferHandle();
+    if ((handle.usage & HBM_USE_MEM_DMA) == 0) {
+        return false;
+    }
+
+    // Framebuffers are always created as XRGB8888(see DrmFrameBuffer), so we can only scanout opaque 32bit buffers.
+    if (handle.format != PIXEL_FMT_RGBX_8888 && handle.format != PIXEL_FMT_RGBA_8888 &&
+        handle.format != PIXEL_FMT_BGRX_8888 && handle.format != PIXEL_FMT_BGRA_8888) {
+        return false;
+    }
+    if (!plane.SupportFormat(DRM_FORMAT_XRGB8888)) {
+        return false;
+    }
+    if (layer.GetLayerBlenType() != BLEND_NONE && layer.GetLayerBlenType() != BLEND_SRC) {
+        return false;
+    }
+    const auto &alpha = layer.GetAlpha();
+    if (alpha.enGlobalAlpha && alpha.gAlpha != 0xff) {
+        return false;
+    }
+    if (layer.GetTransFormType() != ROTATE_NONE && layer.GetTransFormType() != ROTATE_BUTT) {
+        return false;
+    }
+
+    // Scaling support differs between planes, the TEST_ONLY commit will tell us whether the driver accepts it.
+    const auto &crop = layer.GetLayerCrop();
+    const auto &rect = layer.GetLayerDisplayRect();
+    if (crop.w <= 0 || crop.h <= 0 || rect.w <= 0 || rect.h <= 0) {
+        return false;
+    }
+    if (crop.x < 0 || crop.y < 0 || crop.x + crop.w > handle.width || crop.y + crop.h > handle.height) {
+        return false;
+    }
+
+    drmModeModeInfo mode{};
+    connector_->GetMode(connector_->GetActiveModeId(), &mode);
+    if (rect.x < 0 || rect.y < 0 || rect.x + rect.w > mode.hdisplay || rect.y + rect.h > mode.vdisplay) {
+        return false;
+    }
+
+    return true;
+}
+
+void DrmDisplay::ResetPlaneAssignment()
+{
+    clientCompositionNeeded_ = true;
+    primaryPlaneLayerId_ = HDI::DISPLAY::INVALID_LAYER_ID;
+    overlayAssignments_.clear();
+}
+
+// layers must be sorted by zorder.
+void DrmDisplay::AssignPlanes(const std::vector<HdiLayer *> &layers)
+{
+    ResetPlaneAssignment();
+
+    const auto &displayDevice = FT::HDI::DISPLAY::HdiSession::GetInstance().GetDisplayDevice();
+    if (!displayDevice->SupportAtomicModeSet() || primaryPlane_ == nullptr || layers.empty()) {
+        return;
+    }
+
+    // The client composition result is always on the primary plane, which is below all overlay planes,
+    // so we can only assign overlays to the topmost layers, from top to bottom.
+    size_t remainLayers = layers.size();
+    auto planeIter = overlayPlanes_.rbegin();
+    std::vector<PlaneAssignment> assignments;
+    while (remainLayers > 0 && planeIter != overlayPlanes_.rend()) {
+        const auto &layer = layers[remainLayers - 1];
+        if (!CanScanoutDirectly(*layer, **planeIter)) {
+            break;
+        }
+        assignments.push_back({*planeIter, layer->GetId()});
+        ++planeIter;
+        --remainLayers;
+    }
+
+    // The primary plane can not be left empty, let the bottom layer go there directly if it is the only one left,
+    // otherwise give the bottom overlay layer back.
+    if (remainLayers == 0) {
+        assignments.pop_back();
+        remainLayers = 1;
+    }
+    if (remainLayers == 1 && CanScanoutDirectly(*layers[0], *primaryPlane_)) {
+        primaryPlaneLayerId_ = layers[0]->GetId();
+        clientCompositionNeeded_ = false;
+    }
+    overlayAssignments_ = std::move(assignments);
+
+    if (primaryPlaneLayerId_ == HDI::DISPLAY::INVALID_LAYER_ID && overlayAssignments_.empty()) {
+        return;
+    }
+
+    if (!TestPlaneAssignment()) {
+        LOG_DEBUG("DrmDisplay::AssignPlanes: plane assignment rejected by driver, fallback to client composition.");
+        ResetPlaneAssignment();
+    }
+}
+
+bool DrmDisplay::TestPlaneAssignment()
+{
+    HdiLayer *primaryLayer = nullptr;
+    const DrmFrameBuffer *fb = nullptr;
+    if (clientCompositionNeeded_) {
+        // the client buffer of this frame is not ready yet, the one of last frame has the same layout.
+        fb = DownCast<DrmLayer *>(clientLayer_.get())->GetCurrentFrameBuffer();
+        if (fb == nullptr) {
+            fb = reservedFb_.get();
+        }
+    } else {
+        auto layer = GetDrmLayer(primaryPlaneLayerId_);
+        fb = layer->GetFrameBuffer();
+        primaryLayer = layer;
+    }
+    if (fb == nullptr) {
+        return false;
+    }
+
+    DrmAtomicCommitter testCommitter(drmFd_, DRM_MODE_ATOMIC_TEST_ONLY | DRM_MODE_ATOMIC_ALLOW_MODESET);
+    AddModeSetProperties(testCommitter);
+    AddAllPlanesProperties(testCommitter, *fb, primaryLayer);
+    return testCommitter.Commit();
+}
+
 int32_t DrmDisplay::GetDisplayCompChange(uint32_t *num, uint32_t *layers, int32_t *type)
 {
     *num = changeLayers_.size();
@@ -424,12 +608,78 @@ int32_t DrmDisplay::GetDisplayCompChange(uint32_t *num, uint32_t *layers, int32_
     return DISPLAY_SUCCESS;
 }
 
-void DrmDisplay::CommitAtomic(int32_t *fence, const DrmFrameBuffer *fb, int commitFlag)
+void DrmDisplay::AddModeSetProperties(DrmAtomicCommitter &committer)
+{
+    /* set id of the CRTC id that the connector is using */
+    committer.AddAtomicProperty(connector_->Id(), connector_->CrtcPropId(), crtc_->Id());
+
+    /* set the mode id of the CRTC; this property receives the id of a blob
+	 * property that holds the struct that actually contains the mode info */
+    committer.AddAtomicProperty(crtc_->Id(), crtc_->ModeIdPropId(), connector_->BlobId());
+
+    /* set the CRTC object as active */
+    committer.AddAtomicProperty(crtc_->Id(), crtc_->ActivePropId(), 1);
+}
+
+void DrmDisplay::AddPlaneProperties(DrmAtomicCommitter &committer, const DrmPlane &plane, const DrmFrameBuffer &fb,
+    const IRect &src, const IRect &dst)
+{
+    /* set properties of the plane related to the CRTC and the framebuffer */
+    committer.AddAtomicProperty(plane.Id(), plane.FBPropId(), fb.GetFbId());
+    committer.AddAtomicProperty(plane.Id(), plane.CrtcPropId(), crtc_->Id());
+    // SRC_* are in 16.16 fixed point.
+    committer.AddAtomicProperty(plane.Id(), plane.SrcXPropId(), static_cast<uint64_t>(src.x) << 16);
+    committer.AddAtomicProperty(plane.Id(), plane.SrcYPropId(), static_cast<uint64_t>(src.y) << 16);
+    committer.AddAtomicProperty(plane.Id(), plane.SrcWPropId(), static_cast<uint64_t>(src.w) << 16);
+    committer.AddAtomicProperty(plane.Id(), plane.SrcHPropId(), static_cast<uint64_t>(src.h) << 16);
+    committer.AddAtomicProperty(plane.Id(), plane.CrtcXPropId(), dst.x);
+    committer.AddAtomicProperty(plane.Id(), plane.CrtcYPropId(), dst.y);
+    committer.AddAtomicProperty(plane.Id(), plane.CrtcWPropId(), dst.w);
+    committer.AddAtomicProperty(plane.Id(), plane.CrtcHPropId(), dst.h);
+}
+
+bool DrmDisplay::AddAllPlanesProperties(DrmAtomicCommitter &committer, const DrmFrameBuffer &fb, HdiLayer *primaryLayer)
+{
+    // primary plane
+    if (primaryLayer != nullptr) {
+        AddPlaneProperties(committer, *primaryPlane_, fb, primaryLayer->GetLayerCrop(),
+            primaryLayer->GetLayerDisplayRect());
+    } else {
+        auto width = static_cast<int32_t>(fb.GetFbWidth());
+        auto height = static_cast<int32_t>(fb.GetFbHeight());
+        IRect fullRect = {0, 0, width, height};
+        AddPlaneProperties(committer, *primaryPlane_, fb, fullRect, fullRect);
+    }
+
+    // overlay planes
+    for (const auto &assignment : overlayAssignments_) {
+        auto layer = GetDrmLayer(assignment.layerId);
+        const DrmFrameBuffer *layerFb = (layer == nullptr ? nullptr : layer->GetFrameBuffer());
+        if (layerFb == nullptr) {
+            LOG_ERROR("DrmDisplay::AddAllPlanesProperties: no framebuffer for layer %{public}" PRIu32 ".",
+                assignment.layerId);
+            return false;
+        }
+        AddPlaneProperties(committer, *assignment.plane, *layerFb, layer->GetLayerCrop(),
+            layer->GetLayerDisplayRect());
+    }
+
+    // disable the overlay planes which are not used any more.
+    for (const auto &plane : activeOverlayPlanes_) {
+        bool stillInUse = std::any_of(overlayAssignments_.begin(), overlayAssignments_.end(),
+            [&plane](const PlaneAssignment &assignment) { return assignment.plane == plane; });
+        if (!stillInUse) {
+            committer.AddAtomicProperty(plane->Id(), plane->FBPropId(), 0);
+            committer.AddAtomicProperty(plane->Id(), plane->CrtcPropId(), 0);
+        }
+    }
+
+    return true;
+}
+
+void DrmDisplay::CommitAtomic(int32_t *fence, const DrmFrameBuffer *fb, int commitFlag, HdiLayer *primaryLayer)
 {
     ASSERT(fb != nullptr);
-    auto width = fb->GetFbWidth();
-    auto height = fb->GetFbHeight();
-    auto fbId = fb->GetFbId();
 
     LOG_DEBUG("DrmDisplay::CommitAtomic. \n"
         "Connector Id: %{public}u, "
@@ -439,41 +689,70 @@ void DrmDisplay::CommitAtomic(int32_t *fence, const DrmFrameBuffer *fb, int comm
         "CRTC OutFence: %{public}lu, "
         "Plain Id: %{public}u, "
         "Plain FB Id: %{public}u, "
-        "Plain SRC W: %{public}u, "
-        "Plain SRC H: %{public}u, "
-        "Plain CRTC W: %{public}u, "
-        "Plain CRTC H: %{public}u, "
+        "Overlay planes: %{public}zu, "
         "Commit flag: %{public}d.",
         connector_->Id(), crtc_->Id(), connector_->BlobId(), (uint64_t)fence,
-        primaryPlane_->Id(), fbId, width << 16, height << 16, width, height, commitFlag);
-
-    DrmAtomicCommitter atomicAutoCommitter(drmFd_, commitFlag, this);
-
-    /* set id of the CRTC id that the connector is using */
-    atomicAutoCommitter.AddAtomicProperty(connector_->Id(), connector_->CrtcPropId(), crtc_->Id());
-
-    /* set the mode id of the CRTC; this property receives the id of a blob
-	 * property that holds the struct that actually contains the mode info */
-    atomicAutoCommitter.AddAtomicProperty(crtc_->Id(), crtc_->ModeIdPropId(), connector_->BlobId());
-
-    /* set the CRTC object as active */
-    atomicAutoCommitter.AddAtomicProperty(crtc_->Id(), crtc_->ActivePropId(), 1);
+        primaryPlane_->Id(), fb->GetFbId(), overlayAssignments_.size(), commitFlag);
+
+    // drop the overlay layers which lost their buffer after prepare.
+    overlayAssignments_.erase(std::remove_if(overlayAssignments_.begin(), overlayAssignments_.end(),
+        [this](const PlaneAssignment &assignment) {
+            auto layer = GetDrmLayer(assignment.layerId);
+            return layer == nullptr || layer->GetFrameBuffer() == nullptr;
+        }), overlayAssignments_.end());
+
+    // device layers are scanned out as they are, wait until their content is ready.
+    for (const auto &assignment : overlayAssignments_) {
+        GetHdiLayer(assignment.layerId)->WaitAcquireFence();
+    }
+    if (primaryLayer != nullptr) {
+        primaryLayer->WaitAcquireFence();
+    }
 
-    atomicAutoCommitter.AddAtomicProperty(crtc_->Id(), crtc_->OutFencePropId(), (uint64_t)fence);
+    bool testOnly = (commitFlag & DRM_MODE_ATOMIC_TEST_ONLY) != 0;
+    bool needModeSet = testOnly || !modeSetCommitted_ || committedModeBlobId_ != connector_->BlobId();
+    if (needModeSet) {
+        commitFlag |= DRM_MODE_ATOMIC_ALLOW_MODESET;
+    } else {
+        commitFlag &= ~DRM_MODE_ATOMIC_ALLOW_MODESET;
+    }
 
-    /* set properties of the plane related to the CRTC and the framebuffer */
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->FBPropId(), fbId);
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->CrtcPropId(), crtc_->Id());
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->SrcXPropId(), 0);
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->SrcYPropId(), 0);
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->SrcWPropId(), width << 16);
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->SrcHPropId(), height << 16);
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->CrtcXPropId(), 0);
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->CrtcYPropId(), 0);
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->CrtcWPropId(), width);
-    atomicAutoCommitter.AddAtomicProperty(primaryPlane_->Id(), primaryPlane_->CrtcHPropId(), height);
-    atomicAutoCommitter.Commit();
+    DrmAtomicCommitter atomicAutoCommitter(drmFd_, commitFlag, this);
+    if (!testOnly) {
+        if (needModeSet) {
+            // commit the full state, and remember it for the following page flips.
+            propertyCache_.Clear();
+        }
+        atomicAutoCommitter.SetPropertyCache(&propertyCache_);
+    }
+    if (needModeSet) {
+        AddModeSetProperties(atomicAutoCommitter);
+    }
+    atomicAutoCommitter.AddAtomicProperty(crtc_->Id(), crtc_->OutFencePropId(), (uint64_t)fence, false);
+    (void)AddAllPlanesProperties(atomicAutoCommitter, *fb, primaryLayer);
+    bool committed = atomicAutoCommitter.Commit();
+
+    if (!testOnly) {
+        // a failed commit may leave the mode state unknown, do a full modeset next time.
+        modeSetCommitted_ = committed;
+        committedModeBlobId_ = committed ? connector_->BlobId() : DRM_INVALID_OBJECT_ID;
+        if (committed && (commitFlag & DRM_MODE_PAGE_FLIP_EVENT)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            flipPending_ = true;
+        }
+    }
 
+    activeOverlayPlanes_.clear();
+    for (const auto &assignment : overlayAssignments_) {
+        activeOverlayPlanes_.push_back(assignment.plane);
+        auto layer = GetHdiLayer(assignment.layerId);
+        if (layer != nullptr) {
+            layer->SetReleaseFence(*fence);
+        }
+    }
+    if (primaryLayer != nullptr) {
+        primaryLayer->SetReleaseFence(*fence);
+    }
     clientLayer_->SetReleaseFence(*fence);
     LOG_DEBUG("DrmDisplay::CommitAtomic: done.");
 }
@@ -503,20 +782,33 @@ void DrmDisplay::CommitLegacy(int32_t *fence, const DrmFrameBuffer *fb)
 
 int32_t DrmDisplay::Commit(int32_t *fence)
 {
-    DrmLayer *layer = DownCast<DrmLayer *>(clientLayer_.get());
+    bool supportAtomic = FT::HDI::DISPLAY::HdiSession::GetInstance().GetDisplayDevice()->SupportAtomicModeSet();
+    if (supportAtomic) {
+        // wait before the layers switch their framebuffers, the old ones are still on screen until the flip is done.
+        WaitForPendingFlip();
+    }
+
+    // the primary plane shows either the client composition result or a device layer directly.
+    DrmLayer *primaryLayer = nullptr;
+    if (supportAtomic && !clientCompositionNeeded_) {
+        primaryLayer = GetDrmLayer(primaryPlaneLayerId_);
+    }
+
+    DrmLayer *layer = (primaryLayer != nullptr ? primaryLayer : DownCast<DrmLayer *>(clientLayer_.get()));
     if (layer == nullptr) {
         LOG_ERROR("DrmDisplay::Commit: client layer nullptr.");
         return DISPLAY_NULL_PTR;
     }
 
-    const DrmFrameBuffer *fb = layer->GetFrameBuffer(drmFd_);
+    const DrmFrameBuffer *fb = layer->GetFrameBuffer();
     if (fb == nullptr) {
         LOG_ERROR("DrmDisplay::Commit: failed to get framebuffer, use reservedFb_ instead.");
         fb = reservedFb_.get();
+        primaryLayer = nullptr;
     }
 
-    if (FT::HDI::DISPLAY::HdiSession::GetInstance().GetDisplayDevice()->SupportAtomicModeSet()) {
-        CommitAtomic(fence, fb, commitFlag_);
+    if (supportAtomic) {
+        CommitAtomic(fence, fb, commitFlag_, primaryLayer);
     } else {
         // legacy
         CommitLegacy(fence, fb);
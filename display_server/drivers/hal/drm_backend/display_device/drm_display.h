@@ -16,8 +16,11 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <mutex>
+#include <vector>
 
+#include "drm_atomic_committer.h"
 #include "drm_connector.h"
 #include "drm_layer.h"
 #include "drm_mode.h"
@@ -36,6 +39,7 @@ public:
     {
         primaryPlane_ = primaryPlane;
     }
+    void AddOverlayPlane(const std::shared_ptr<DrmPlane> &overlayPlane);
 
     HdiDisplayId Id() const override
     {
@@ -68,6 +72,8 @@ public:
     int32_t GetDisplayCompChange(uint32_t *num, uint32_t *layers, int32_t *type) override;
     int32_t Commit(int32_t *fence) override;
 
+    void OnBufferFreed(const BufferHandle &handle) override;
+
 private:
     // convert drm DPMS(display power manager status) to hdi DispPowerStatus.
     static DispPowerStatus ToDispPowerStatus(uint64_t dpms);
@@ -76,8 +82,24 @@ private:
 
     std::unique_ptr<HdiLayer> CreateHdiLayer(HDI::DISPLAY::LayerId id, LayerType type) override;
 
-    void CommitAtomic(int32_t *fence, const DrmFrameBuffer *fb, int commitFlag);
+    // primaryLayer is the layer scanned out by the primary plane directly, nullptr means fb is a full screen buffer.
+    void CommitAtomic(int32_t *fence, const DrmFrameBuffer *fb, int commitFlag, HdiLayer *primaryLayer = nullptr);
     void CommitLegacy(int32_t *fence, const DrmFrameBuffer *fb);
+    void AddModeSetProperties(DrmAtomicCommitter &committer);
+    void AddPlaneProperties(DrmAtomicCommitter &committer, const DrmPlane &plane, const DrmFrameBuffer &fb,
+        const IRect &src, const IRect &dst);
+    bool AddAllPlanesProperties(DrmAtomicCommitter &committer, const DrmFrameBuffer &fb, HdiLayer *primaryLayer);
+
+    // plane allocation
+    struct PlaneAssignment {
+        std::shared_ptr<DrmPlane> plane;
+        HDI::DISPLAY::LayerId layerId = HDI::DISPLAY::INVALID_LAYER_ID;
+    };
+    bool CanScanoutDirectly(HdiLayer &layer, const DrmPlane &plane) const;
+    void AssignPlanes(const std::vector<HdiLayer *> &layers);
+    bool TestPlaneAssignment();
+    void ResetPlaneAssignment();
+    DrmLayer *GetDrmLayer(HDI::DISPLAY::LayerId layerId);
 
     int drmFd_ = INVALID_FD;
 
@@ -85,11 +107,22 @@ private:
     std::shared_ptr<DrmConnector> connector_;
     std::shared_ptr<DrmCrtc> crtc_;
     std::shared_ptr<DrmPlane> primaryPlane_;
+    std::vector<std::shared_ptr<DrmPlane>> overlayPlanes_; // sorted by zpos, from bottom to top.
+    std::shared_ptr<DrmFrameBufferCache> fbCache_;
+
+    // the result of PrepareDisplayLayers, the layers assigned to hardware planes are composed by the device.
+    bool clientCompositionNeeded_ = true;
+    HDI::DISPLAY::LayerId primaryPlaneLayerId_ = HDI::DISPLAY::INVALID_LAYER_ID;
+    std::vector<PlaneAssignment> overlayAssignments_;
+    // overlay planes enabled by the last commit, we should disable them if they are not used any more.
+    std::vector<std::shared_ptr<DrmPlane>> activeOverlayPlanes_;
 
     mutable std::mutex mutex_;
     VBlankCallback vSyncCallBack_ = nullptr; // guarded by mutex_;
     void *vsyncUserData_ = nullptr;          // guarded by mutex_;
     bool vSyncCbEverReged_ = false;          // guarded by mutex_;
+    bool flipPending_ = false;               // guarded by mutex_;
+    std::condition_variable flipCond_;
 #ifdef ENABLE_HARDWARE_VSYNC
     int sampleVsync = 6; // same with MIN_SAMPLES_FOR_UPDATE in vsync_sampler.h
     bool enableVsync_ = false;
@@ -97,11 +130,20 @@ private:
 
     void InitReservedFb();
     std::unique_ptr<DrmFrameBuffer> reservedFb_; // to do first commit to enable vsync.
+    // ALLOW_MODESET is added by CommitAtomic only when the mode state has to be (re)committed.
 #ifdef ENABLE_HARDWARE_VSYNC
-    int commitFlag_ = DRM_MODE_ATOMIC_ALLOW_MODESET | DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_ATOMIC_NONBLOCK;
+    int commitFlag_ = DRM_MODE_PAGE_FLIP_EVENT | DRM_MODE_ATOMIC_NONBLOCK;
 #else
-    int commitFlag_ = DRM_MODE_ATOMIC_ALLOW_MODESET | DRM_MODE_ATOMIC_NONBLOCK;
+    int commitFlag_ = DRM_MODE_ATOMIC_NONBLOCK;
 #endif // ENABLE_HARDWARE_VSYNC
+
+    // the modeset state(connector CRTC_ID, crtc MODE_ID and ACTIVE) is committed once,
+    // steady-state commits are page flips which only carry the changed plane properties.
+    void WaitForPendingFlip();
+    static constexpr int64_t FLIP_TIMEOUT_MS = 50;
+    bool modeSetCommitted_ = false;
+    uint64_t committedModeBlobId_ = DRM_INVALID_OBJECT_ID;
+    DrmAtomicPropertyCache propertyCache_;
 };
 } // namespace drm
 } // namespace FT
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drm_frame_buffer_cache.h"
+
+#include "log.h"
+
+namespace FT {
+namespace drm {
+std::shared_ptr<DrmFrameBuffer> DrmFrameBufferCache::GetOrCreate(const BufferHandle &handle)
+{
+    auto gemHandle = static_cast<uint32_t>(handle.key);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++useCount_;
+    auto iter = entries_.find(gemHandle);
+    if (iter != entries_.end()) {
+        if (IsSameBuffer(iter->second, handle)) {
+            iter->second.lastUsed = useCount_;
+            return iter->second.fb;
+        }
+        // The gem handle was reused by another buffer which we were not told about, drop the stale one.
+        LOG_WARN("DrmFrameBufferCache::GetOrCreate: stale framebuffer(fbId: %{public}u) for gem handle %{public}u.",
+            iter->second.fb->GetFbId(), gemHandle);
+        entries_.erase(iter);
+    }
+
+    std::shared_ptr<DrmFrameBuffer> fb = DrmFrameBuffer::CreateFromBufferHandle(drmFd_, handle);
+    if (fb == nullptr) {
+        LOG_ERROR("DrmFrameBufferCache::GetOrCreate: create framebuffer from BufferHandle failed.");
+        return nullptr;
+    }
+
+    if (entries_.size() >= MAX_CACHE_SIZE) {
+        EvictLeastRecentlyUsed();
+    }
+
+    CacheEntry entry;
+    entry.fb = fb;
+    entry.width = handle.width;
+    entry.height = handle.height;
+    entry.stride = handle.stride;
+    entry.format = handle.format;
+    entry.lastUsed = useCount_;
+    entries_[gemHandle] = std::move(entry);
+    LOG_DEBUG("DrmFrameBufferCache::GetOrCreate: cache fbId %{public}u for gem handle %{public}u, size: %{public}zu.",
+        fb->GetFbId(), gemHandle, entries_.size());
+    return fb;
+}
+
+void DrmFrameBufferCache::Evict(const BufferHandle &handle)
+{
+    // The framebuffer may still be on screen, the layers hold their own reference to it,
+    // so RmFB is deferred until the layer moves on to another buffer.
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(static_cast<uint32_t>(handle.key));
+}
+
+void DrmFrameBufferCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+void DrmFrameBufferCache::EvictLeastRecentlyUsed()
+{
+    auto victim = entries_.end();
+    for (auto iter = entries_.begin(); iter != entries_.end(); ++iter) {
+        if (victim == entries_.end() || iter->second.lastUsed < victim->second.lastUsed) {
+            victim = iter;
+        }
+    }
+    if (victim != entries_.end()) {
+        entries_.erase(victim);
+    }
+}
+} // namespace drm
+} // namespace FT
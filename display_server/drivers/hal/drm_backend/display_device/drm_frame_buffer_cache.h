@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "drm_frame_buffer.h"
+
+namespace FT {
+namespace drm {
+// Per-display cache of KMS framebuffers created from BufferHandles.
+// The client layer cycles through the same few BufferQueue buffers, so we keep the fb of each buffer alive
+// instead of doing AddFB/RmFB on every commit. Entries are keyed by the GEM handle stored in BufferHandle.key,
+// which stays unique for the lifetime of the buffer, and are evicted when gralloc frees the buffer.
+class DrmFrameBufferCache : NonCopyable {
+public:
+    explicit DrmFrameBufferCache(int drmFd) : drmFd_(drmFd) {}
+    ~DrmFrameBufferCache() noexcept = default;
+
+    // return the cached framebuffer of this buffer, create and cache a new one if not found.
+    std::shared_ptr<DrmFrameBuffer> GetOrCreate(const BufferHandle &handle);
+    // drop the framebuffer created from this buffer, called when the buffer is going to be freed.
+    void Evict(const BufferHandle &handle);
+    void Clear();
+
+    size_t Size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+private:
+    struct CacheEntry {
+        std::shared_ptr<DrmFrameBuffer> fb;
+        int32_t width = 0;
+        int32_t height = 0;
+        int32_t stride = 0;
+        int32_t format = 0;
+        uint64_t lastUsed = 0;
+    };
+
+    static bool IsSameBuffer(const CacheEntry &entry, const BufferHandle &handle)
+    {
+        return entry.width == handle.width && entry.height == handle.height &&
+            entry.stride == handle.stride && entry.format == handle.format;
+    }
+    void EvictLeastRecentlyUsed(); // guarded by mutex_;
+
+    // a BufferQueue holds at most 3~4 buffers, keep some headroom for queue resizing.
+    static constexpr size_t MAX_CACHE_SIZE = 8;
+
+    int drmFd_ = INVALID_FD;
+    mutable std::mutex mutex_;
+    uint64_t useCount_ = 0;                            // guarded by mutex_;
+    std::unordered_map<uint32_t, CacheEntry> entries_; // guarded by mutex_;
+};
+} // namespace drm
+} // namespace FT
@@ -19,10 +19,10 @@
 
 namespace FT {
 namespace drm {
-DrmFrameBuffer *DrmLayer::GetFrameBuffer(int drmFd)
+DrmFrameBuffer *DrmLayer::GetFrameBuffer()
 {
-    if (IsInvalidFd(drmFd)) {
-        LOG_ERROR("DrmLayer::GetFrameBuffer: invalid drm fd");
+    if (fbCache_ == nullptr) {
+        LOG_ERROR("DrmLayer::GetFrameBuffer: framebuffer cache is nullptr");
         return nullptr;
     }
 
@@ -32,15 +32,20 @@ DrmFrameBuffer *DrmLayer::GetFrameBuffer(int drmFd)
         return nullptr;
     }
 
-    lastFrameBuffer_ = std::move(currentFrameBuffer_);
-
     const auto &bufferHandle = layerBuffer->GetBufferHandle();
-    currentFrameBuffer_ = DrmFrameBuffer::CreateFromBufferHandle(drmFd, bufferHandle);
-    if (currentFrameBuffer_ == nullptr) {
+    auto fb = fbCache_->GetOrCreate(bufferHandle);
+    if (fb == nullptr) {
         LOG_ERROR("DrmLayer::GetFrameBuffer: create framebuffer from BufferHandle failed.");
         return nullptr;
     }
 
+    // The same buffer may be asked for several times in one frame (e.g. by the TEST_ONLY commit),
+    // only rotate when the layer really switches to another buffer.
+    if (fb != currentFrameBuffer_) {
+        lastFrameBuffer_ = std::move(currentFrameBuffer_);
+        currentFrameBuffer_ = std::move(fb);
+    }
+
     return currentFrameBuffer_.get();
 }
 } // namespace drm
@@ -17,21 +17,30 @@
 
 #include <deque>
 
-#include "drm_frame_buffer.h"
+#include "drm_frame_buffer_cache.h"
 #include "hdi_layer.h"
 
 namespace FT {
 namespace drm {
 class DrmLayer : public HdiLayer {
 public:
-    DrmLayer(HdiLayerId id, LayerType type) : HdiLayer(id, type) {}
+    DrmLayer(HdiLayerId id, LayerType type, std::shared_ptr<DrmFrameBufferCache> fbCache)
+        : HdiLayer(id, type), fbCache_(std::move(fbCache))
+    {}
     ~DrmLayer() noexcept override = default;
 
-    DrmFrameBuffer *GetFrameBuffer(int drmFd);
+    DrmFrameBuffer *GetFrameBuffer();
+    // the framebuffer of the last GetFrameBuffer() call, it may be nullptr.
+    const DrmFrameBuffer *GetCurrentFrameBuffer() const
+    {
+        return currentFrameBuffer_.get();
+    }
 
 private:
-    std::unique_ptr<DrmFrameBuffer> lastFrameBuffer_;
-    std::unique_ptr<DrmFrameBuffer> currentFrameBuffer_;
+    std::shared_ptr<DrmFrameBufferCache> fbCache_;
+    // keep the framebuffers being scanned out alive even if they are evicted from the cache.
+    std::shared_ptr<DrmFrameBuffer> lastFrameBuffer_;
+    std::shared_ptr<DrmFrameBuffer> currentFrameBuffer_;
 };
 } // namespace drm
 } // namespace FT
@@ -15,6 +15,8 @@
 
 #include "drm_plane.h"
 
+#include <algorithm>
+
 #include "drm_mode.h"
 #include "log.h"
 
@@ -48,7 +50,15 @@ void DrmPlane::ParseFrom(drmModePlanePtr const &plane)
     srcWPropId_ = planePropFetcher.GetPropId(PROP_SRC_W_ID);
     srcHPropId_ = planePropFetcher.GetPropId(PROP_SRC_H_ID);
     type_ = planePropFetcher.GetPropValue(PROP_TYPE);
+    auto zpos = planePropFetcher.GetPropValue(PROP_ZPOS_ID);
+    zpos_ = (zpos == DRM_INVLIAD_VALUE) ? 0 : zpos;
     possibleCrtcs_ = plane->possible_crtcs;
+    formats_.assign(plane->formats, plane->formats + plane->count_formats);
+}
+
+bool DrmPlane::SupportFormat(uint32_t drmFormat) const
+{
+    return std::find(formats_.begin(), formats_.end(), drmFormat) != formats_.end();
 }
 } // namespace drm
 } // namespace FT
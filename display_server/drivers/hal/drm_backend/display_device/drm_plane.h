@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "noncopyable_hal.h"
 #include "drm_common.h"
 #include "drm_property.h"
@@ -33,6 +35,7 @@ constexpr char PROP_SRC_X_ID[] = "SRC_X";
 constexpr char PROP_SRC_Y_ID[] = "SRC_Y";
 constexpr char PROP_SRC_W_ID[] = "SRC_W";
 constexpr char PROP_SRC_H_ID[] = "SRC_H";
+constexpr char PROP_ZPOS_ID[] = "zpos";
 // typedef struct _drmModePlane {
 // 	uint32_t count_formats;
 // 	uint32_t *formats;
@@ -103,10 +106,16 @@ public:
     {
         return srcHPropId_;
     }
+    // planes with bigger zpos are stacked on top, it is 0 if the driver does not expose zpos.
+    uint64_t GetZpos() const
+    {
+        return zpos_;
+    }
     uint32_t GetPossibleCrtcs() const
     {
         return possibleCrtcs_;
     }
+    bool SupportFormat(uint32_t drmFormat) const;
 
 private:
     void ParseFrom(const drmModePlanePtr &plane);
@@ -125,7 +134,9 @@ private:
     uint32_t srcWPropId_ = DRM_INVALID_PROP_ID;
     uint32_t srcHPropId_ = DRM_INVALID_PROP_ID;
     uint64_t type_ = DRM_INVLIAD_VALUE;
+    uint64_t zpos_ = 0;
     uint32_t possibleCrtcs_ = 0;
+    std::vector<uint32_t> formats_;
 };
 } // namespace drm
 } // namespace FT
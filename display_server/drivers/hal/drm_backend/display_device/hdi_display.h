@@ -80,6 +80,9 @@ public:
     virtual int32_t GetDisplayCompChange(uint32_t *num, uint32_t *layers, int32_t *type) = 0;
     virtual int32_t Commit(int32_t *fence) = 0;
 
+    // called before the buffer is freed, so that the display can drop the resources created from it.
+    virtual void OnBufferFreed(const BufferHandle &handle) {}
+
     HdiLayer *GetHdiLayer(LayerId id);
 
 protected:
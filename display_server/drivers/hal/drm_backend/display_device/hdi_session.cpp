@@ -135,6 +135,19 @@ int32_t HdiSession::RegHotPlugCallback(HotPlugCallback callback, void *data)
     return DISPLAY_SUCCESS;
 }
 
+void HdiSession::OnBufferFreed(const BufferHandle &handle)
+{
+    if (displayDevice_ == nullptr) {
+        return;
+    }
+
+    const auto &displays = displayDevice_->GetDisplays();
+    for (const auto &[id, display] : displays) {
+        UNUSED(id);
+        display->OnBufferFreed(handle);
+    }
+}
+
 void HdiSession::DoHotPlugCallback(uint32_t devId, bool connect)
 {
     if (hotPlugCallback_ == nullptr) {
@@ -86,6 +86,8 @@ public:
     }
 
     int32_t RegHotPlugCallback(HotPlugCallback callback, void *data);
+    // notify all displays that the buffer is going to be freed by gralloc.
+    void OnBufferFreed(const BufferHandle &handle);
 
 private:
     HdiSession();
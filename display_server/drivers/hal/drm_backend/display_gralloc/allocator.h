@@ -17,7 +17,9 @@
 
 #include "display_type.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace FT {
 namespace HDI {
@@ -76,6 +78,33 @@ public:
      * @return Returns DISPLAY_SUCCESS(0) if the operation is successful; returns an error code defined otherwise.
      */
     virtual int32_t InvalidateCache(BufferHandle &buffer) = 0;
+    /**
+     * @brief Marks a buffer as passed to another process, the allocator must not recycle it when it is freed.
+     *
+     * @param buffer Indicates the buffer that left the process.
+     */
+    virtual void MarkExported(BufferHandle &buffer)
+    {
+        (void)buffer;
+    }
+    /**
+     * @brief Releases the recycled buffers kept by the allocator until it holds at most `targetBytes`.
+     *
+     * @param targetBytes Indicates the bytes the allocator can keep, 0 to release all of them.
+     */
+    virtual void TrimPool(size_t targetBytes)
+    {
+        (void)targetBytes;
+    }
+    /**
+     * @brief Dumps the statistics of the recycled buffers kept by the allocator.
+     *
+     * @param result Indicates the string the statistics appended to.
+     */
+    virtual void DumpPool(std::string &result) const
+    {
+        (void)result;
+    }
 };
 
 } // namespace DISPLAY
@@ -43,6 +43,9 @@ int32_t AllocatorController::Init()
 int32_t AllocatorController::Uninit()
 {
     LOG_DEBUG("[Gralloc::AllocatorController::Uninit] Uninit.");
+    std::string dump;
+    DumpBufferPools(dump);
+    LOG_DEBUG("[Gralloc::AllocatorController::Uninit] %{public}s", dump.c_str());
 
     gbmAllocator_.reset();
     dumbAllocator_.reset();
@@ -85,6 +88,24 @@ std::shared_ptr<Allocator> AllocatorController::GetAllocator(uint64_t usage)
     return nullptr;
 }
 
+void AllocatorController::TrimBufferPools(size_t targetBytes)
+{
+    for (const auto &allocator : {gbmAllocator_, dumbAllocator_, shmAllocator_}) {
+        if (allocator != nullptr) {
+            allocator->TrimPool(targetBytes);
+        }
+    }
+}
+
+void AllocatorController::DumpBufferPools(std::string &result) const
+{
+    for (const auto &allocator : {gbmAllocator_, dumbAllocator_, shmAllocator_}) {
+        if (allocator != nullptr) {
+            allocator->DumpPool(result);
+        }
+    }
+}
+
 } // namespace DISPLAY
 } // namespace HDI
 } // namespace FT
\ No newline at end of file
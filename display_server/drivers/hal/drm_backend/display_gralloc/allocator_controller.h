@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 
 namespace FT {
 namespace HDI {
@@ -57,6 +58,16 @@ public:
      * @return std::shared_ptr<Allocator> return Allocator. If failed, return nullptr.
      */
     std::shared_ptr<Allocator> GetAllocator(uint64_t usage);
+    /**
+     * @brief Release the recycled buffers of all allocators, e.g. on memory pressure.
+     *
+     * @param targetBytes bytes each allocator can keep, 0 to release all of them.
+     */
+    void TrimBufferPools(size_t targetBytes);
+    /**
+     * @brief Dump the hit/miss statistics of the allocator buffer pools.
+     */
+    void DumpBufferPools(std::string &result) const;
 
 private:
     AllocatorController() {}
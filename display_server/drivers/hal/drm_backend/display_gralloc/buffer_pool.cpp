@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "buffer_pool.h"
+
+#include "log.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace FT {
+namespace HDI {
+namespace DISPLAY {
+
+BufferPool::BufferPool(const std::string &name, size_t budgetBytes, ReleaseFunc releaseFunc)
+    : name_(name), releaseFunc_(std::move(releaseFunc)), budgetBytes_(budgetBytes)
+{
+    stats_.budgetBytes = budgetBytes;
+}
+
+BufferPool::~BufferPool() noexcept
+{
+    std::string dump;
+    Dump(dump);
+    LOG_DEBUG("[Gralloc::BufferPool::~BufferPool] %{public}s", dump.c_str());
+    Trim(0);
+}
+
+BufferHandle *BufferPool::Acquire(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = buckets_.find(key);
+    if (iter == buckets_.end() || iter->second.empty()) {
+        ++stats_.misses;
+        return nullptr;
+    }
+
+    EntryIter entry = iter->second.back();
+    iter->second.pop_back();
+    if (iter->second.empty()) {
+        buckets_.erase(iter);
+    }
+
+    BufferHandle *buffer = entry->buffer;
+    lru_.erase(entry);
+    ++stats_.hits;
+    --stats_.cachedCount;
+    stats_.cachedBytes -= static_cast<size_t>(buffer->size);
+    ownedBuffers_.insert(buffer);
+    return buffer;
+}
+
+bool BufferPool::Recycle(uint64_t key, BufferHandle *buffer)
+{
+    if (buffer == nullptr || buffer->size <= 0) {
+        return false;
+    }
+
+    std::vector<BufferHandle *> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ownedBuffers_.erase(buffer) == 0) {
+            // not allocated by the owner allocator, e.g. imported from another process.
+            return false;
+        }
+        size_t bytes = static_cast<size_t>(buffer->size);
+        if (bytes > budgetBytes_) {
+            return false;
+        }
+
+        lru_.push_front({key, buffer});
+        buckets_[key].push_back(lru_.begin());
+        ++stats_.recycled;
+        ++stats_.cachedCount;
+        stats_.cachedBytes += bytes;
+        EvictLocked(budgetBytes_, victims);
+    }
+    Release(victims);
+    return true;
+}
+
+void BufferPool::Trim(size_t targetBytes)
+{
+    std::vector<BufferHandle *> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        EvictLocked(targetBytes, victims);
+    }
+    Release(victims);
+}
+
+void BufferPool::SetBudget(size_t budgetBytes)
+{
+    std::vector<BufferHandle *> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        budgetBytes_ = budgetBytes;
+        stats_.budgetBytes = budgetBytes;
+        EvictLocked(budgetBytes_, victims);
+    }
+    Release(victims);
+}
+
+void BufferPool::MarkOwned(const BufferHandle *buffer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ownedBuffers_.insert(buffer);
+}
+
+bool BufferPool::UnmarkOwned(const BufferHandle *buffer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ownedBuffers_.erase(buffer) != 0;
+}
+
+BufferPool::Stats BufferPool::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void BufferPool::Dump(std::string &result) const
+{
+    Stats stats = GetStats();
+    uint64_t total = stats.hits + stats.misses;
+    uint64_t hitRate = (total == 0) ? 0 : (stats.hits * 100 / total);
+    result += "BufferPool[" + name_ + "]: hits: " + std::to_string(stats.hits) +
+        ", misses: " + std::to_string(stats.misses) + " (hit rate " + std::to_string(hitRate) + "%)" +
+        ", recycled: " + std::to_string(stats.recycled) + ", released: " + std::to_string(stats.released) +
+        ", cached: " + std::to_string(stats.cachedCount) + " buffers/" + std::to_string(stats.cachedBytes) +
+        " bytes, budget: " + std::to_string(stats.budgetBytes) + " bytes.\n";
+}
+
+void BufferPool::EvictLocked(size_t targetBytes, std::vector<BufferHandle *> &victims)
+{
+    while (stats_.cachedBytes > targetBytes && !lru_.empty()) {
+        EntryIter victim = std::prev(lru_.end());
+        auto &bucket = buckets_[victim->key];
+        bucket.erase(std::remove(bucket.begin(), bucket.end(), victim), bucket.end());
+        if (bucket.empty()) {
+            buckets_.erase(victim->key);
+        }
+
+        --stats_.cachedCount;
+        stats_.cachedBytes -= static_cast<size_t>(victim->buffer->size);
+        ++stats_.released;
+        victims.push_back(victim->buffer);
+        lru_.erase(victim);
+    }
+}
+
+void BufferPool::Release(const std::vector<BufferHandle *> &victims)
+{
+    // release outside of the lock, it may munmap/close/ioctl.
+    for (auto buffer : victims) {
+        releaseFunc_(buffer);
+    }
+}
+
+} // namespace DISPLAY
+} // namespace HDI
+} // namespace FT
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "buffer_handle.h"
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace FT {
+namespace HDI {
+namespace DISPLAY {
+
+/**
+ * Recycling pool of released buffers, keyed by a bucket key chosen by the allocator.
+ *
+ * A buffer put back to the pool keeps its fd (and its mapping if it was mapped), so that the next allocation of
+ * the same bucket costs nothing. Only buffers that never left the process are recycled, a buffer whose fd may be
+ * held by another process must be unmarked before it is freed. The owner allocator clears a recycled buffer before
+ * handing it out again. The pool only keeps at most `budgetBytes` of buffers, the least recently recycled ones are
+ * released first.
+ */
+class BufferPool {
+public:
+    using ReleaseFunc = std::function<void(BufferHandle *)>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t recycled = 0;
+        uint64_t released = 0; // released because of budget or trim.
+        size_t cachedCount = 0;
+        size_t cachedBytes = 0;
+        size_t budgetBytes = 0;
+    };
+
+    BufferPool(const std::string &name, size_t budgetBytes, ReleaseFunc releaseFunc);
+    ~BufferPool() noexcept;
+
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    /**
+     * @brief Take a buffer of this bucket out of the pool.
+     *
+     * @return BufferHandle* the recycled buffer, or nullptr if the bucket is empty.
+     */
+    BufferHandle *Acquire(uint64_t key);
+    /**
+     * @brief Put a released buffer back to the pool.
+     *
+     * @return bool false if the buffer is not accepted, the caller should release it by itself.
+     */
+    bool Recycle(uint64_t key, BufferHandle *buffer);
+    /**
+     * @brief Release the least recently recycled buffers until the pool holds at most `targetBytes`.
+     */
+    void Trim(size_t targetBytes);
+    void SetBudget(size_t budgetBytes);
+
+    // Buffers handed out by the owner allocator, only these can be recycled.
+    void MarkOwned(const BufferHandle *buffer);
+    // e.g. the buffer is exported to another process, it will be released for real when freed.
+    bool UnmarkOwned(const BufferHandle *buffer);
+
+    Stats GetStats() const;
+    void Dump(std::string &result) const;
+
+private:
+    struct Entry {
+        uint64_t key = 0;
+        BufferHandle *buffer = nullptr;
+    };
+    using EntryIter = std::list<Entry>::iterator;
+
+    // collect the entries to release until cachedBytes_ <= targetBytes, guarded by mutex_.
+    void EvictLocked(size_t targetBytes, std::vector<BufferHandle *> &victims);
+    void Release(const std::vector<BufferHandle *> &victims);
+
+    std::string name_;
+    ReleaseFunc releaseFunc_;
+
+    mutable std::mutex mutex_;
+    size_t budgetBytes_ = 0;                                    // guarded by mutex_;
+    std::list<Entry> lru_;                                      // guarded by mutex_; front is the most recent one.
+    std::unordered_map<uint64_t, std::vector<EntryIter>> buckets_; // guarded by mutex_;
+    std::unordered_set<const BufferHandle *> ownedBuffers_;     // guarded by mutex_;
+    Stats stats_;                                               // guarded by mutex_;
+};
+
+} // namespace DISPLAY
+} // namespace HDI
+} // namespace FT
@@ -28,6 +28,7 @@
 #include "display_gralloc.h"
 
 #include "allocator_controller.h"
+#include "display_gralloc_utils.h"
 #include "display_type.h"
 #include "log.h"
 
@@ -71,9 +72,29 @@ void FreeMem(BufferHandle *handle)
         return;
     }
 
+    // Only DMA buffers can be scanned out, drop the framebuffers created from it before the GEM handle is gone.
+    if (handle->usage & HBM_USE_MEM_DMA) {
+        GrallocUtils::NotifyBufferFreedToSession(handle);
+    }
+
     allocator->FreeMem(handle);
 }
 
+void MarkExported(BufferHandle *handle)
+{
+    if (handle == nullptr) {
+        LOG_ERROR("[Gralloc::MarkExported] Get nullptr param: `handle`");
+        return;
+    }
+
+    auto allocator = AllocatorController::GetInstance().GetAllocator(handle->usage);
+    if (allocator == nullptr) {
+        return;
+    }
+
+    allocator->MarkExported(*handle);
+}
+
 void *Mmap(BufferHandle *handle)
 {
     if (handle == nullptr) {
@@ -166,6 +187,7 @@ int32_t GrallocInitialize(GrallocFuncs **funcs)
     grallocFuncs->Unmap = Unmap;
     grallocFuncs->InvalidateCache = InvalidateCache;
     grallocFuncs->FlushCache = FlushCache;
+    grallocFuncs->MarkExported = MarkExported;
     *funcs = grallocFuncs;
 
     return DISPLAY_SUCCESS;
@@ -18,6 +18,8 @@
 #include "log.h"
 #include "hdi_session.h"
 
+// std
+#include <cstdlib>
 // driver
 #include <linux/dma-buf.h>
 
@@ -34,6 +36,28 @@ int GetDrmFdFromSession()
     return device->Fd();
 }
 
+void NotifyBufferFreedToSession(const BufferHandle *handle)
+{
+    auto &session = FT::HDI::DISPLAY::HdiSession::GetInstance();
+    session.OnBufferFreed(*handle);
+}
+
+size_t GetBufferPoolBudget(size_t defaultBytes)
+{
+    const char *budgetMb = ::getenv("OEWM_GRALLOC_POOL_BUDGET_MB");
+    if (budgetMb == nullptr) {
+        return defaultBytes;
+    }
+
+    char *end = nullptr;
+    unsigned long mb = ::strtoul(budgetMb, &end, 10);
+    if (end == budgetMb || *end != '\0') {
+        LOG_WARN("[Gralloc] Invalid OEWM_GRALLOC_POOL_BUDGET_MB: %{public}s, use default.", budgetMb);
+        return defaultBytes;
+    }
+    return static_cast<size_t>(mb) * 1024 * 1024;
+}
+
 int32_t DmaBufferSync(const BufferHandle *handle, bool isStart)
 {
     // LOG_DEBUG << "[Gralloc] Sync DMA-BUF mmap cache : " << (isStart ? "invalidate" : "flush");
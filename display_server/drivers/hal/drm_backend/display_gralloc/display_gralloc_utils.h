@@ -18,6 +18,7 @@
 #include "buffer_handle.h"
 
 #include <optional>
+#include <cstddef>
 #include <cstdint>
 
 namespace GrallocUtils {
@@ -29,6 +30,24 @@ namespace GrallocUtils {
  */
 int GetDrmFdFromSession();
 
+/**
+ * @brief Internal func: Notify HdiSession that the buffer is going to be freed.
+ *
+ * Displays may cache resources created from the buffer (e.g. KMS framebuffers), they should be dropped
+ * before the buffer is released.
+ * @param handle buffer handle
+ */
+void NotifyBufferFreedToSession(const BufferHandle *handle);
+
+/**
+ * @brief Internal func: Get the byte budget of the allocator buffer pools.
+ *
+ * It can be overridden by env `OEWM_GRALLOC_POOL_BUDGET_MB`, set it to 0 to disable buffer recycling.
+ * @param defaultBytes budget used if the env is not set.
+ * @return size_t budget in bytes
+ */
+size_t GetBufferPoolBudget(size_t defaultBytes);
+
 /**
  * @brief Internal func: sync DMA-buffer for CPU access.
  *
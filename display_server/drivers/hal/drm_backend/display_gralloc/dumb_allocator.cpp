@@ -17,6 +17,7 @@
 
 // std
 #include <sys/mman.h> // mmap
+#include <cstring>
 #include <mutex>
 // drm
 #include <drm.h>
@@ -36,6 +37,11 @@ namespace FT {
 namespace HDI {
 namespace DISPLAY {
 
+namespace {
+// about 4 buffers of 1920x1080 XRGB, dumb buffers are mostly used as (cursor) framebuffers.
+constexpr size_t DEFAULT_POOL_BUDGET = 32 * 1024 * 1024;
+} // namespace
+
 int32_t DumbAllocator::Init()
 {
     LOG_DEBUG("[Gralloc::DumbAllocator::Init] Initing...");
@@ -48,6 +54,9 @@ int32_t DumbAllocator::Init()
     }
     drmFd_ = drmFd;
 
+    size_t budget = GrallocUtils::GetBufferPoolBudget(DEFAULT_POOL_BUDGET);
+    pool_ = std::make_unique<BufferPool>("dumb", budget, [this](BufferHandle *buffer) { ReleaseBuffer(buffer); });
+
     LOG_DEBUG("[Gralloc::DumbAllocator::Init] Init done.");
 
     return DISPLAY_SUCCESS;
@@ -68,6 +77,21 @@ int32_t DumbAllocator::AllocMem(const AllocInfo &info, BufferHandle **bufferPtr)
     }
     const DrmFormat::DrmFormatInfo *fmtInfo = DrmFormat::GetDrmFormatInfo(drmFmt);
 
+    uint64_t poolKey = GetPoolKey(info.width, info.height, fmtInfo->bpp);
+    BufferHandle *recycled = (pool_ != nullptr) ? pool_->Acquire(poolKey) : nullptr;
+    if (recycled != nullptr) {
+        // keep the GEM handle, prime fd and the mapping of the recycled one, it never left the process.
+        recycled->format = info.format;
+        recycled->usage = info.usage;
+        if (ClearRecycled(*recycled)) {
+            *bufferPtr = recycled;
+            return DISPLAY_SUCCESS;
+        }
+        LOG_WARN("[Gralloc::DumbAllocator::AllocMem] Failed to clear recycled buffer, allocate a new one.");
+        pool_->UnmarkOwned(recycled);
+        ReleaseBuffer(recycled);
+    }
+
     {
         std::lock_guard<std::mutex> lock(mutex_);
 
@@ -78,7 +102,14 @@ int32_t DumbAllocator::AllocMem(const AllocInfo &info, BufferHandle **bufferPtr)
         create.width = info.width;
         create.bpp = fmtInfo->bpp; // bits per pixel
 
-        if (drmIoctl(drmFd_, DRM_IOCTL_MODE_CREATE_DUMB, &create) != 0) {
+        int ret = drmIoctl(drmFd_, DRM_IOCTL_MODE_CREATE_DUMB, &create);
+        if (ret != 0 && pool_ != nullptr) {
+            // out of (video) memory, give the pooled buffers back and try again.
+            LOG_WARN("[Gralloc::DumbAllocator::AllocMem] Failed to create dumb buffer, trim the pool and retry.");
+            pool_->Trim(0);
+            ret = drmIoctl(drmFd_, DRM_IOCTL_MODE_CREATE_DUMB, &create);
+        }
+        if (ret != 0) {
             LOG_ERROR("[Gralloc::DumbAllocator::AllocMem] Failed to create DRM dumb buffer: %{public}s"
                 , ErrnoToString(errno).c_str());
             return DISPLAY_NOMEM;
@@ -118,6 +149,9 @@ int32_t DumbAllocator::AllocMem(const AllocInfo &info, BufferHandle **bufferPtr)
         *bufferPtr = &priBuffer->hdl;
     }
 
+    if (pool_ != nullptr) {
+        pool_->MarkOwned(*bufferPtr);
+    }
     return DISPLAY_SUCCESS;
 }
 
@@ -128,6 +162,21 @@ int32_t DumbAllocator::FreeMem(BufferHandle *buffer)
         return DISPLAY_PARAM_ERR;
     }
 
+    /* Keep the buffer (and its mapping) for the next allocation of the same geometry */
+    if (pool_ != nullptr) {
+        uint32_t drmFmt = DrmFormat::ConvertPixelFormatToDrmFormat(static_cast<PixelFormat>(buffer->format));
+        const DrmFormat::DrmFormatInfo *fmtInfo = DrmFormat::GetDrmFormatInfo(drmFmt);
+        if (fmtInfo != nullptr && pool_->Recycle(GetPoolKey(buffer->width, buffer->height, fmtInfo->bpp), buffer)) {
+            return DISPLAY_SUCCESS;
+        }
+    }
+
+    ReleaseBuffer(buffer);
+    return DISPLAY_SUCCESS;
+}
+
+void DumbAllocator::ReleaseBuffer(BufferHandle *buffer)
+{
     /* Perform memory unmapping if mmap is not clear */
     if ((buffer->virAddr != nullptr) && Unmap(*buffer) != DISPLAY_SUCCESS) {
         LOG_ERROR("[Gralloc::DumbAllocator::FreeMem] Failed to unmap buffer");
@@ -152,15 +201,49 @@ int32_t DumbAllocator::FreeMem(BufferHandle *buffer)
 
     /* Free BufferHandle */
     delete buffer;
+}
 
-    return DISPLAY_SUCCESS;
+bool DumbAllocator::ClearRecycled(BufferHandle &buffer)
+{
+    if (buffer.virAddr == nullptr && Mmap(buffer) == nullptr) {
+        return false;
+    }
+    (void)memset(buffer.virAddr, 0, static_cast<size_t>(buffer.size));
+    return true;
+}
+
+void DumbAllocator::MarkExported(BufferHandle &buffer)
+{
+    if (pool_ != nullptr) {
+        pool_->UnmarkOwned(&buffer);
+    }
+}
+
+void DumbAllocator::TrimPool(size_t targetBytes)
+{
+    if (pool_ != nullptr) {
+        pool_->Trim(targetBytes);
+    }
+}
+
+void DumbAllocator::DumpPool(std::string &result) const
+{
+    if (pool_ != nullptr) {
+        pool_->Dump(result);
+    }
+}
+
+uint64_t DumbAllocator::GetPoolKey(uint32_t width, uint32_t height, uint32_t bpp)
+{
+    return (static_cast<uint64_t>(width) << 40) | (static_cast<uint64_t>(height & 0xFFFFFF) << 16) | (bpp & 0xFFFF);
 }
 
 void *DumbAllocator::Mmap(BufferHandle &buffer)
 {
     if (buffer.virAddr != nullptr) {
-        LOG_ERROR("Get err param: buffer.virAddr is not null");
-        return nullptr;
+        // a recycled buffer keeps its mapping.
+        LOG_DEBUG("[Gralloc::DumbAllocator::Mmap] buffer.virAddr is not empty");
+        return buffer.virAddr;
     }
 
     /**
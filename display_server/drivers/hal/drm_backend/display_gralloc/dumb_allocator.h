@@ -16,8 +16,11 @@
 #pragma once
 
 #include "allocator.h"
+#include "buffer_pool.h"
 
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace FT {
 namespace HDI {
@@ -37,13 +40,24 @@ public:
     virtual int32_t FlushCache(BufferHandle &buffer) override;
     virtual int32_t InvalidateCache(BufferHandle &buffer) override;
 
+    virtual void MarkExported(BufferHandle &buffer) override;
+    virtual void TrimPool(size_t targetBytes) override;
+    virtual void DumpPool(std::string &result) const override;
+
 private:
     int32_t DestroyGemDumbHandle(unsigned int handle);
     bool GetSupportGbmModifyFromSession();
+    // unmap, close fds and destroy the GEM handle for real.
+    void ReleaseBuffer(BufferHandle *buffer);
+    // zero a recycled buffer before it is handed out again, map it if it is not mapped yet.
+    bool ClearRecycled(BufferHandle &buffer);
+    // the pitch of a dumb buffer is decided by the driver, only buffers of the same geometry can be reused.
+    static uint64_t GetPoolKey(uint32_t width, uint32_t height, uint32_t bpp);
 
 private:
     std::mutex mutex_;
     int drmFd_ = -1;
+    std::unique_ptr<BufferPool> pool_;
 };
 
 } // namespace DISPLAY
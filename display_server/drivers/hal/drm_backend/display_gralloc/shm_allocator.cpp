@@ -21,8 +21,12 @@
 #include "types.h"
 #include "hi_drm_format.h" // TMP
 
+#include <algorithm>
 #include <cinttypes>
-#include <sys/mman.h> // for shm_xxx
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h> // for shm_xxx, memfd_create
 
 namespace FT {
 namespace HDI {
@@ -30,6 +34,102 @@ namespace DISPLAY {
 
 #define RANDNAME_PATTERN "/ft-shm-XXXXXX"
 
+namespace {
+constexpr size_t SHM_PAGE_SIZE = 4096;
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+constexpr uint32_t MAX_STRIDE_ALIGNMENT = 4096;
+// size classes are 1/8 of the power of 2 range, so a pooled buffer wastes at most 12.5%.
+constexpr size_t SIZE_CLASS_SUB_BITS = 3;
+// about 8 buffers of 1920x1080 RGBA.
+constexpr size_t DEFAULT_POOL_BUDGET = 64 * 1024 * 1024;
+} // namespace
+
+inline size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+ShmAllocator::ShmAllocator(const Options &options) : options_(options)
+{
+    uint32_t alignment = options_.strideAlignment;
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > MAX_STRIDE_ALIGNMENT) {
+        LOG_WARN("[Gralloc::ShmAllocator] Invalid stride alignment %{public}u, use 4 bytes.", alignment);
+        options_.strideAlignment = 4;
+    }
+#ifndef MFD_CLOEXEC
+    options_.useMemfd = false;
+#endif // MFD_CLOEXEC
+}
+
+ShmAllocator::Options ShmAllocator::GetOptionsFromEnv()
+{
+    Options options;
+    if (::getenv("OEWM_GRALLOC_SHM_DISABLE_MEMFD") != nullptr) {
+        options.useMemfd = false;
+    }
+    if (::getenv("OEWM_GRALLOC_SHM_HUGEPAGE") != nullptr) {
+        options.hugePage = true;
+    }
+    return options;
+}
+
+int32_t ShmAllocator::Init()
+{
+    size_t budget = GrallocUtils::GetBufferPoolBudget(DEFAULT_POOL_BUDGET);
+    pool_ = std::make_unique<BufferPool>("shm", budget, [this](BufferHandle *buffer) { ReleaseBuffer(buffer); });
+    return DISPLAY_SUCCESS;
+}
+
+size_t ShmAllocator::GetSizeClass(size_t size)
+{
+    size = AlignUp(size, SHM_PAGE_SIZE);
+    size_t highBit = 1;
+    while ((highBit << 1) <= size) {
+        highBit <<= 1;
+    }
+    size_t step = highBit >> SIZE_CLASS_SUB_BITS;
+    if (step < SHM_PAGE_SIZE) {
+        return size;
+    }
+    return AlignUp(size, step);
+}
+
+uint32_t ShmAllocator::GetStrideAlignment(const AllocInfo &info) const
+{
+    uint32_t alignment = info.strideAlignment;
+    if (alignment == 0) {
+        return options_.strideAlignment;
+    }
+    if ((alignment & (alignment - 1)) != 0 || alignment > MAX_STRIDE_ALIGNMENT) {
+        LOG_WARN("[Gralloc::ShmAllocator] Invalid stride alignment %{public}u, use %{public}u bytes.",
+            alignment, options_.strideAlignment);
+        return options_.strideAlignment;
+    }
+    // the requested alignment only raises the one of the allocator
+    return std::max(alignment, options_.strideAlignment);
+}
+
+bool ShmAllocator::UseHugeTlb(size_t size) const
+{
+    return options_.useMemfd && options_.hugePage && size >= HUGE_PAGE_SIZE;
+}
+
+size_t ShmAllocator::GetCapacity(size_t size) const
+{
+    // hugetlb files must be sized in whole huge pages.
+    return UseHugeTlb(size) ? AlignUp(size, HUGE_PAGE_SIZE) : GetSizeClass(size);
+}
+
+bool ShmAllocator::ClearRecycled(BufferHandle &buffer)
+{
+    if (buffer.virAddr == nullptr && Mmap(buffer) == nullptr) {
+        return false;
+    }
+    // the whole file is mapped, so nothing of the former content is left for the next owner.
+    (void)memset(buffer.virAddr, 0, GetCapacity(static_cast<size_t>(buffer.size)));
+    return true;
+}
+
 int32_t ShmAllocator::AllocMem(const AllocInfo &info, BufferHandle **bufferPtr)
 {
     if (bufferPtr == nullptr) {
@@ -37,8 +137,6 @@ int32_t ShmAllocator::AllocMem(const AllocInfo &info, BufferHandle **bufferPtr)
         return DISPLAY_PARAM_ERR;
     }
 
-    PriBufferHandle *priBuffer = new PriBufferHandle();
-
     /* Get format info */
     // TODO: only get bpp from PixelFormat
     LOG_DEBUG("[Gralloc::ShmAllocator::AllocMem] Get format info for bpp.");
@@ -46,21 +144,49 @@ int32_t ShmAllocator::AllocMem(const AllocInfo &info, BufferHandle **bufferPtr)
     const DrmFormat::DrmFormatInfo *fmtInfo = DrmFormat::GetDrmFormatInfo(drmFmt);
 
     uint32_t bytesPerPixel = fmtInfo->bpp / 8;
-    int32_t stride = static_cast<int32_t>(info.width * bytesPerPixel); // TODO: align?
+    int32_t stride = static_cast<int32_t>(AlignUp(info.width * bytesPerPixel, GetStrideAlignment(info)));
     int32_t size = stride * static_cast<int32_t>(info.height);
 
-    if (size != static_cast<int32_t>(info.expectedSize)) {
+    if (info.expectedSize != 0 && size != static_cast<int32_t>(info.expectedSize)) {
         LOG_WARN("[Gralloc::ShmAllocator::AllocMem] size(%{public}d) is not equal to user expected size(%{public}u)!",
             size, info.expectedSize);
     }
 
+    bool hugeTlb = UseHugeTlb(static_cast<size_t>(size));
+    size_t capacity = GetCapacity(static_cast<size_t>(size));
+    BufferHandle *recycled = (pool_ != nullptr) ? pool_->Acquire(capacity) : nullptr;
+    if (recycled != nullptr) {
+        // keep the fd and the mapping of the recycled one, they cover the same capacity.
+        recycled->size = size;
+        recycled->stride = stride;
+        recycled->width = info.width;
+        recycled->height = info.height;
+        recycled->usage = info.usage;
+        recycled->format = info.format;
+        if (ClearRecycled(*recycled)) {
+            *bufferPtr = recycled;
+            return DISPLAY_SUCCESS;
+        }
+        LOG_WARN("[Gralloc::ShmAllocator::AllocMem] Failed to clear recycled buffer, allocate a new one.");
+        pool_->UnmarkOwned(recycled);
+        ReleaseBuffer(recycled);
+    }
+
+    PriBufferHandle *priBuffer = new PriBufferHandle();
     {
         std::lock_guard<std::mutex> lock(mutex_);
 
         /* Create shm anonymous file */
-        int32_t shmFd = static_cast<int32_t>(AllocateShmFile(static_cast<size_t>(size)));
+        int32_t shmFd = static_cast<int32_t>(AllocateShmFile(capacity, hugeTlb));
+        if (shmFd < 0 && pool_ != nullptr) {
+            // out of fds or memory, give the pooled buffers back and try again.
+            LOG_WARN("[Gralloc::ShmAllocator::AllocMem] Failed to create shm file, trim the pool and retry.");
+            pool_->Trim(0);
+            shmFd = static_cast<int32_t>(AllocateShmFile(capacity, hugeTlb));
+        }
         if (shmFd < 0) {
-            LOG_ERROR("[Gralloc::ShmAllocator::AllocMem] Failed to create shm file for %{public}" PRId32 " Bytes", size);
+            LOG_ERROR("[Gralloc::ShmAllocator::AllocMem] Failed to create shm file for %{public}zu Bytes", capacity);
+            delete priBuffer;
             return DISPLAY_FD_ERR;
         }
 
@@ -79,6 +205,9 @@ int32_t ShmAllocator::AllocMem(const AllocInfo &info, BufferHandle **bufferPtr)
         *bufferPtr = &priBuffer->hdl;
     }
 
+    if (pool_ != nullptr) {
+        pool_->MarkOwned(*bufferPtr);
+    }
     return DISPLAY_SUCCESS;
 }
 
@@ -89,6 +218,18 @@ int32_t ShmAllocator::FreeMem(BufferHandle *buffer)
         return DISPLAY_PARAM_ERR;
     }
 
+    /* keep the buffer (and its mapping) for the next allocation of the same size class */
+    if (pool_ != nullptr && buffer->size > 0 &&
+        pool_->Recycle(GetCapacity(static_cast<size_t>(buffer->size)), buffer)) {
+        return DISPLAY_SUCCESS;
+    }
+
+    ReleaseBuffer(buffer);
+    return DISPLAY_SUCCESS;
+}
+
+void ShmAllocator::ReleaseBuffer(BufferHandle *buffer)
+{
     /* perform memory unmapping if mmap is not clear */
     if ((buffer->virAddr != nullptr) && Unmap(*buffer) != DISPLAY_SUCCESS) {
         LOG_ERROR("[Gralloc::ShmAllocator::FreeMem] Failed to free shm buffer mmap!");
@@ -97,9 +238,32 @@ int32_t ShmAllocator::FreeMem(BufferHandle *buffer)
     /* close shm fd */
     if (buffer->fd >= 0) {
         ::close(buffer->fd);
+        buffer->fd = -1;
     }
 
-    return DISPLAY_SUCCESS;
+    /* Free BufferHandle */
+    delete buffer;
+}
+
+void ShmAllocator::MarkExported(BufferHandle &buffer)
+{
+    if (pool_ != nullptr) {
+        pool_->UnmarkOwned(&buffer);
+    }
+}
+
+void ShmAllocator::TrimPool(size_t targetBytes)
+{
+    if (pool_ != nullptr) {
+        pool_->Trim(targetBytes);
+    }
+}
+
+void ShmAllocator::DumpPool(std::string &result) const
+{
+    if (pool_ != nullptr) {
+        pool_->Dump(result);
+    }
 }
 
 void *ShmAllocator::Mmap(BufferHandle &buffer)
@@ -113,15 +277,23 @@ void *ShmAllocator::Mmap(BufferHandle &buffer)
         return nullptr;
     }
     if (buffer.virAddr != nullptr) {
-        LOG_WARN("[Gralloc::ShmAllocator::Mmap] buffer.virAddr is not empty");
+        // a recycled buffer keeps its mapping.
+        LOG_DEBUG("[Gralloc::ShmAllocator::Mmap] buffer.virAddr is not empty");
         return buffer.virAddr;
     }
 
-    void *data = mmap(nullptr, buffer.size, PROT_READ | PROT_WRITE, MAP_SHARED, buffer.fd, 0);
+    size_t mapSize = GetCapacity(static_cast<size_t>(buffer.size));
+    void *data = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, buffer.fd, 0);
     if (data == MAP_FAILED) {
         LOG_ERROR("[Gralloc::ShmAllocator::Mmap] Failed to mmap for shm fd: %{public}i", buffer.fd);
         return nullptr;
     }
+#ifdef MADV_HUGEPAGE
+    // no-op for hugetlb files, and only takes effect if shmem THP is set to "advise".
+    if (options_.hugePage && mapSize >= HUGE_PAGE_SIZE) {
+        (void)madvise(data, mapSize, MADV_HUGEPAGE);
+    }
+#endif // MADV_HUGEPAGE
 
     buffer.virAddr = data;
 
@@ -140,10 +312,11 @@ int32_t ShmAllocator::Unmap(BufferHandle &buffer)
         return DISPLAY_PARAM_ERR;
     }
 
-    if (munmap(buffer.virAddr, static_cast<size_t>(buffer.size)) != 0) {
+    if (munmap(buffer.virAddr, GetCapacity(static_cast<size_t>(buffer.size))) != 0) {
         LOG_ERROR("[Gralloc::ShmAllocator::Unmap] Failed to unmap shm buffer (%{public}p)", buffer.virAddr);
         return DISPLAY_FAILURE;
     }
+    buffer.virAddr = nullptr;
 
     return DISPLAY_SUCCESS;
 }
@@ -190,8 +363,59 @@ int ShmAllocator::ExclShmOpen(char *name)
     return -1;
 }
 
-int ShmAllocator::AllocateShmFile(size_t size)
+int ShmAllocator::CreateMemfd(size_t size, bool hugeTlb)
+{
+#ifdef MFD_CLOEXEC
+    unsigned int flags = MFD_CLOEXEC | MFD_ALLOW_SEALING;
+#ifdef MFD_HUGETLB
+    if (hugeTlb) {
+        flags |= MFD_HUGETLB;
+    }
+#else
+    UNUSED(hugeTlb);
+#endif // MFD_HUGETLB
+    int fd = memfd_create("ft-shm", flags);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int ret;
+    do {
+        ret = ftruncate(fd, size);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        close(fd);
+        return -1;
+    }
+#ifdef F_ADD_SEALS
+    // the size is fixed from now on, so no one can make the mappings of others SIGBUS by shrinking it.
+    (void)fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+#endif // F_ADD_SEALS
+    return fd;
+#else
+    UNUSED(size);
+    UNUSED(hugeTlb);
+    return -1;
+#endif // MFD_CLOEXEC
+}
+
+int ShmAllocator::AllocateShmFile(size_t size, bool hugeTlb)
 {
+    if (options_.useMemfd) {
+        int fd = CreateMemfd(size, hugeTlb);
+        if (fd < 0 && hugeTlb) {
+            // the hugetlb pool may be empty, fall back to normal pages.
+            LOG_DEBUG("[Gralloc::ShmAllocator::AllocateShmFile] Failed to create hugetlb memfd: %{public}s",
+                ErrnoToString(errno).c_str());
+            fd = CreateMemfd(size, false);
+        }
+        if (fd >= 0) {
+            return fd;
+        }
+        LOG_WARN("[Gralloc::ShmAllocator::AllocateShmFile] Failed to create memfd: %{public}s, try shm_open.",
+            ErrnoToString(errno).c_str());
+    }
+
     char name[] = RANDNAME_PATTERN;
     int fd = ExclShmOpen(name);
     if (fd < 0) {
@@ -16,8 +16,11 @@
 #pragma once
 
 #include "allocator.h"
+#include "buffer_pool.h"
 
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace FT {
 namespace HDI {
@@ -25,9 +28,24 @@ namespace DISPLAY {
 
 class ShmAllocator : public Allocator {
 public:
-    ShmAllocator() = default;
+    struct Options {
+        // stride alignment(power of 2) of the requests without one, so that each row starts at a SIMD friendly address.
+        uint32_t strideAlignment = 64;
+        // create buffers with memfd_create instead of shm_open.
+        bool useMemfd = true;
+        // back large buffers with huge pages(MFD_HUGETLB, or THP hint if hugetlb is not available).
+        bool hugePage = false;
+    };
+
+    // options are read from env: OEWM_GRALLOC_SHM_DISABLE_MEMFD, OEWM_GRALLOC_SHM_HUGEPAGE.
+    ShmAllocator() : ShmAllocator(GetOptionsFromEnv()) {}
+    explicit ShmAllocator(const Options &options);
     ~ShmAllocator() noexcept override = default;
 
+    static Options GetOptionsFromEnv();
+
+    virtual int32_t Init() override;
+
     virtual int32_t AllocMem(const AllocInfo &info, BufferHandle **bufferPtr) override;
     virtual int32_t FreeMem(BufferHandle *buffer) override;
     virtual void *Mmap(BufferHandle &buffer) override;
@@ -35,13 +53,31 @@ public:
     virtual int32_t FlushCache(BufferHandle &buffer) override;
     virtual int32_t InvalidateCache(BufferHandle &buffer) override;
 
+    virtual void MarkExported(BufferHandle &buffer) override;
+    virtual void TrimPool(size_t targetBytes) override;
+    virtual void DumpPool(std::string &result) const override;
+
 private:
     void Randname(char *buf);
     int ExclShmOpen(char *name);
-    int AllocateShmFile(size_t size);
+    int AllocateShmFile(size_t size, bool hugeTlb);
+    int CreateMemfd(size_t size, bool hugeTlb);
+    // close the fd and free the handle for real.
+    void ReleaseBuffer(BufferHandle *buffer);
+    // round the size up to its size class, so that buffers of slightly different sizes can share a pool bucket.
+    static size_t GetSizeClass(size_t size);
+    // the alignment the requester asked for, or the default one.
+    uint32_t GetStrideAlignment(const AllocInfo &info) const;
+    bool UseHugeTlb(size_t size) const;
+    // size of the shm file of a buffer, it is also the length of its mapping and the key of its pool bucket.
+    size_t GetCapacity(size_t size) const;
+    // zero a recycled buffer before it is handed out again, map it if it is not mapped yet.
+    bool ClearRecycled(BufferHandle &buffer);
 
 private:
+    Options options_;
     std::mutex mutex_;
+    std::unique_ptr<BufferPool> pool_;
 };
 
 } // namespace DISPLAY
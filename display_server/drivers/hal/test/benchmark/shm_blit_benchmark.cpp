@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Raster blit throughput of shm buffers with different ShmAllocator options.
+// usage: shm_blit_benchmark [width] [height] [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "shm_allocator.h"
+
+using FT::HDI::DISPLAY::ShmAllocator;
+
+namespace {
+constexpr uint32_t DEFAULT_WIDTH = 3839; // odd width, so that a packed stride is not aligned.
+constexpr uint32_t DEFAULT_HEIGHT = 2160;
+constexpr uint32_t DEFAULT_ITERATIONS = 100;
+constexpr uint32_t BYTES_PER_PIXEL = 4;
+
+struct BenchCase {
+    const char *name;
+    ShmAllocator::Options options;
+};
+
+bool AllocAndMap(ShmAllocator &allocator, const AllocInfo &info, BufferHandle **handle)
+{
+    if (allocator.AllocMem(info, handle) != DISPLAY_SUCCESS || *handle == nullptr) {
+        printf("AllocMem failed.\n");
+        return false;
+    }
+    if (allocator.Mmap(**handle) == nullptr) {
+        printf("Mmap failed.\n");
+        allocator.FreeMem(*handle);
+        *handle = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// blend the source over the destination row by row, the same access pattern as a raster composition.
+void BlitRows(const BufferHandle &src, BufferHandle &dst, uint32_t width, uint32_t height)
+{
+    const auto *srcBase = static_cast<const uint8_t *>(src.virAddr);
+    auto *dstBase = static_cast<uint8_t *>(dst.virAddr);
+    for (uint32_t y = 0; y < height; ++y) {
+        const auto *srcRow = reinterpret_cast<const uint32_t *>(srcBase + static_cast<size_t>(y) * src.stride);
+        auto *dstRow = reinterpret_cast<uint32_t *>(dstBase + static_cast<size_t>(y) * dst.stride);
+        for (uint32_t x = 0; x < width; ++x) {
+            uint32_t s = srcRow[x];
+            uint32_t d = dstRow[x];
+            uint32_t invAlpha = 255 - (s >> 24);
+            uint32_t rb = (((d & 0x00FF00FF) * invAlpha) >> 8) & 0x00FF00FF;
+            uint32_t ag = (((d >> 8) & 0x00FF00FF) * invAlpha) & 0xFF00FF00;
+            dstRow[x] = s + rb + ag;
+        }
+    }
+}
+
+void CopyRows(const BufferHandle &src, BufferHandle &dst, uint32_t width, uint32_t height)
+{
+    const auto *srcBase = static_cast<const uint8_t *>(src.virAddr);
+    auto *dstBase = static_cast<uint8_t *>(dst.virAddr);
+    size_t rowBytes = static_cast<size_t>(width) * BYTES_PER_PIXEL;
+    for (uint32_t y = 0; y < height; ++y) {
+        memcpy(dstBase + static_cast<size_t>(y) * dst.stride, srcBase + static_cast<size_t>(y) * src.stride, rowBytes);
+    }
+}
+
+template<typename Func>
+double MeasureMBps(Func &&func, uint32_t iterations, size_t bytesPerIteration)
+{
+    func(); // warm up, fault the pages in.
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(bytesPerIteration) * iterations / elapsed.count() / (1024.0 * 1024.0);
+}
+
+void RunCase(const BenchCase &bench, uint32_t width, uint32_t height, uint32_t iterations)
+{
+    ShmAllocator allocator(bench.options);
+    allocator.Init();
+
+    AllocInfo info = {};
+    info.width = width;
+    info.height = height;
+    info.usage = HBM_USE_CPU_READ | HBM_USE_CPU_WRITE;
+    info.format = PIXEL_FMT_RGBA_8888;
+
+    BufferHandle *src = nullptr;
+    BufferHandle *dst = nullptr;
+    if (!AllocAndMap(allocator, info, &src)) {
+        return;
+    }
+    if (!AllocAndMap(allocator, info, &dst)) {
+        allocator.FreeMem(src);
+        return;
+    }
+    for (int32_t i = 0; i < src->size; i += BYTES_PER_PIXEL) {
+        static_cast<uint32_t *>(src->virAddr)[i / BYTES_PER_PIXEL] = 0x80402010u + static_cast<uint32_t>(i);
+    }
+    memset(dst->virAddr, 0xFF, static_cast<size_t>(dst->size));
+
+    size_t bytes = static_cast<size_t>(width) * height * BYTES_PER_PIXEL;
+    double copyMBps = MeasureMBps([&]() { CopyRows(*src, *dst, width, height); }, iterations, bytes);
+    double blendMBps = MeasureMBps([&]() { BlitRows(*src, *dst, width, height); }, iterations, bytes);
+    printf("%-28s stride: %6d  copy: %9.1f MB/s  blend: %9.1f MB/s\n", bench.name, src->stride, copyMBps, blendMBps);
+
+    allocator.FreeMem(src);
+    allocator.FreeMem(dst);
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    uint32_t width = (argc > 1) ? static_cast<uint32_t>(atoi(argv[1])) : DEFAULT_WIDTH;
+    uint32_t height = (argc > 2) ? static_cast<uint32_t>(atoi(argv[2])) : DEFAULT_HEIGHT;
+    uint32_t iterations = (argc > 3) ? static_cast<uint32_t>(atoi(argv[3])) : DEFAULT_ITERATIONS;
+    if (width == 0 || height == 0 || iterations == 0) {
+        printf("usage: %s [width] [height] [iterations]\n", argv[0]);
+        return -1;
+    }
+    printf("shm blit benchmark: %ux%u RGBA, %u iterations.\n", width, height, iterations);
+
+    BenchCase cases[] = {
+        {"packed stride, shm_open", {4, false, false}},
+        {"64B stride, memfd", {64, true, false}},
+        {"256B stride, memfd", {256, true, false}},
+        {"256B stride, memfd+hugepage", {256, true, true}},
+    };
+    for (const auto &bench : cases) {
+        RunCase(bench, width, height, iterations);
+    }
+    return 0;
+}
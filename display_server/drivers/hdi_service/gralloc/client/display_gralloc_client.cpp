@@ -77,12 +77,17 @@ void DisplayGrallocClient::FreeMem(const BufferHandle &handle) const
     mapperAdapter_->FreeBuffer(handle);
 }
 
+void DisplayGrallocClient::MarkExported(const BufferHandle &handle) const
+{
+    mapperAdapter_->MarkExported(handle);
+}
+
 void* DisplayGrallocClient::Mmap(const BufferHandle &handle) const
 {
     void* data = nullptr;
     int32_t ret = mapperAdapter_->MapBuffer(handle, data);
     if (ret != DISPLAY_SUCCESS) {
-        FreeMem(handle);
+        // the caller still owns the handle, do not free it here.
         LOG_ERROR("%{public}s: DisplayGrallocClient::Mmap, mapBuffer failed", __func__);
         return nullptr;
     }
@@ -31,6 +31,7 @@ public:
     virtual ~DisplayGrallocClient() {}
     int32_t AllocMem(const AllocInfo& info, BufferHandle*& handle) const override;
     void FreeMem(const BufferHandle& handle) const override;
+    void MarkExported(const BufferHandle& handle) const override;
     void *Mmap(const BufferHandle& handle) const override;
     void *MmapCache(const BufferHandle &handle) const override;
     int32_t Unmap(const BufferHandle& handle) const override;
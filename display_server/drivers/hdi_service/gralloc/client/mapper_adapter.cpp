@@ -76,6 +76,13 @@ void MapperAdapter::FreeBuffer(const BufferHandle& handle) const
 {
     mapperFuncs_->FreeMem(const_cast<BufferHandle *>(&handle));
 }
+
+void MapperAdapter::MarkExported(const BufferHandle& handle) const
+{
+    if (mapperFuncs_->MarkExported != nullptr) {
+        mapperFuncs_->MarkExported(const_cast<BufferHandle *>(&handle));
+    }
+}
 } // namespace V1_0
 } // namespace Display
 } // namespace HDI
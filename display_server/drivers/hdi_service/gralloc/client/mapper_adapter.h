@@ -33,6 +33,7 @@ public:
     int32_t InvalidateCache(const BufferHandle& handle) const;
     int32_t FlushCache(const BufferHandle& handle) const;
     void FreeBuffer(const BufferHandle& handle) const;
+    void MarkExported(const BufferHandle& handle) const;
 
 private:
     GrallocFuncs *mapperFuncs_ = nullptr;
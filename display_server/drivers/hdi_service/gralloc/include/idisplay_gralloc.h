@@ -63,6 +63,16 @@ public:
      */
     virtual void FreeMem(const BufferHandle &handle) const = 0;
 
+    /**
+     * @brief Marks memory as shared with other processes, so that it is never recycled for another allocation.
+     *
+     * @param handle Indicates the reference to the buffer of the memory passed to another process.
+     *
+     * @since 1.0
+     * @version 1.0
+     */
+    virtual void MarkExported(const BufferHandle &handle) const = 0;
+
     /**
      * @brief Maps memory to memory without cache in the process's address space.
      *
@@ -37,6 +37,7 @@ public:
         pAllocInfo->usage  = data.ReadUint64();
         pAllocInfo->format = static_cast<PixelFormat>(data.ReadUint32());
         pAllocInfo->expectedSize = data.ReadUint32();
+        pAllocInfo->strideAlignment = data.ReadUint32();
         return DISPLAY_SUCCESS;
     }
 
@@ -65,6 +66,10 @@ public:
             HDF_LOGE("%{public}s: write AllocInfo type failed", __func__);
             return DISPLAY_PARAM_ERR;
         }
+        if (!data.WriteUint32(pAllocInfo->strideAlignment)) {
+            HDF_LOGE("%{public}s: write AllocInfo strideAlignment failed", __func__);
+            return DISPLAY_PARAM_ERR;
+        }
         return DISPLAY_SUCCESS;
     }
 };
@@ -165,6 +165,16 @@ typedef struct {
      * @version 1.0
      */
     void *(*MmapYUV)(BufferHandle *handle, YUVDescInfo *info);
+
+    /**
+     * @brief Marks memory as shared with other processes, so that it is never recycled for another allocation.
+     *
+     * @param handle Indicates the pointer to the buffer of the memory passed to another process.
+     *
+     * @since 3.2
+     * @version 1.0
+     */
+    void (*MarkExported)(BufferHandle *handle);
 } GrallocFuncs;
 
 /**
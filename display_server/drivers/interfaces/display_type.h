@@ -475,6 +475,7 @@ typedef struct {
     uint64_t usage;               /**< Usage of the requested memory */
     PixelFormat format;           /**< Format of the requested memory */
     uint32_t expectedSize;        /**< Size assigned by memory requester */
+    uint32_t strideAlignment;     /**< Stride alignment in bytes, 0 for the default of the allocator */
 } AllocInfo;
 /**
  * @brief Enumerates power status.
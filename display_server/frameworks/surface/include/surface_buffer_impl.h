@@ -94,6 +94,8 @@ private:
     void FreeBufferHandleLocked();
 
     BufferHandle *handle_ = nullptr;
+    bool handleAllocated_ = false; // handle_ is allocated by Alloc(), it should be given back to gralloc.
+    bool handleExported_ = false; // handle_ was written to a parcel, gralloc must not recycle it for others.
     uint32_t sequenceNumber_ = UINT32_MAX;
     sptr<BufferExtraData> bedata_ = nullptr;
     sptr<EglData> eglData_ = nullptr;
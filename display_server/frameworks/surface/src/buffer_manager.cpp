@@ -97,6 +97,7 @@ GSError BufferManager::Alloc(const BufferRequestConfig &config, sptr<SurfaceBuff
     int32_t allocWidth = config.width;
     int32_t allocHeight = config.height;
     AllocInfo info = {allocWidth, allocHeight, config.usage, (PixelFormat)config.format};
+    info.strideAlignment = static_cast<uint32_t>(config.strideAlignment);
     auto dret = displayGralloc_->AllocMem(info, handle);
     if (dret == DISPLAY_SUCCESS) {
         buffer->SetBufferHandle(handle);
@@ -171,6 +171,7 @@ GSError SurfaceBufferImpl::Alloc(const BufferRequestConfig &config)
     BufferHandle *handle = nullptr;
     uint64_t usage = BufferUsageToGrallocUsage(config.usage);
     AllocInfo info = {config.width, config.height, usage, (PixelFormat)config.format};
+    info.strideAlignment = static_cast<uint32_t>(config.strideAlignment);
     auto dret = displayGralloc_->AllocMem(info, handle);
     if (dret == DISPLAY_SUCCESS) {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -179,6 +180,7 @@ GSError SurfaceBufferImpl::Alloc(const BufferRequestConfig &config)
         surfaceBufferWidth_ = config.width;
         surfaceBufferHeight_ = config.height;
         handle_ = handle;
+        handleAllocated_ = true;
         BLOGD("buffer handle %{public}p w: %{public}d h: %{public}d t: %{public}d", handle_,
             handle_->width, handle_->height, config.transform);
         return GSERROR_OK;
@@ -296,13 +298,20 @@ GSError SurfaceBufferImpl::InvalidateCache()
 void SurfaceBufferImpl::FreeBufferHandleLocked()
 {
     if (handle_) {
-        if (handle_->virAddr != nullptr && displayGralloc_ != nullptr) {
-            displayGralloc_->Unmap(*handle_);
-            handle_->virAddr = nullptr;
+        if (handleAllocated_ && displayGralloc_ != nullptr) {
+            // gralloc may recycle the buffer together with its mapping for the next Alloc().
+            displayGralloc_->FreeMem(*handle_);
+        } else {
+            if (handle_->virAddr != nullptr && displayGralloc_ != nullptr) {
+                displayGralloc_->Unmap(*handle_);
+                handle_->virAddr = nullptr;
+            }
+            FreeBufferHandle(handle_);
         }
-        FreeBufferHandle(handle_);
     }
     handle_ = nullptr;
+    handleAllocated_ = false;
+    handleExported_ = false;
 }
 
 BufferHandle *SurfaceBufferImpl::GetBufferHandle() const
@@ -475,6 +484,7 @@ void SurfaceBufferImpl::SetBufferHandle(BufferHandle *handle)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     handle_ = handle;
+    handleAllocated_ = false;
 }
 
 GSError SurfaceBufferImpl::WriteToMessageParcel(MessageParcel &parcel)
@@ -487,6 +497,11 @@ GSError SurfaceBufferImpl::WriteToMessageParcel(MessageParcel &parcel)
             return GSERROR_NOT_INIT;
         }
         handle = handle_;
+        // the fds may be mapped by the peer until it exits, whatever it does with the buffer later.
+        if (handleAllocated_ && !handleExported_ && displayGralloc_ != nullptr) {
+            displayGralloc_->MarkExported(*handle_);
+            handleExported_ = true;
+        }
     }
 
     bool ret = WriteBufferHandle(parcel, *handle);
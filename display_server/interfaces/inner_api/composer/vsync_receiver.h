@@ -22,10 +22,12 @@
 #include "file_descriptor_listener.h"
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 
 namespace OHOS {
 namespace Rosen {
@@ -49,6 +51,7 @@ public:
         vsyncCallbacks_ = cb.callback_;
         userData_ = cb.userData_;
     }
+    void OnVSync(int64_t now);
 
 private:
     void OnReadable(int32_t fileDescriptor) override;
@@ -58,6 +61,7 @@ private:
 };
 
 #ifndef ROSEN_CROSS_PLATFORM
+class VSyncTimeline;
 class VSyncReceiver : public RefBase {
 public:
     // check
@@ -76,6 +80,9 @@ public:
     virtual VsyncError SetVSyncRate(FrameCallback callback, int32_t rate);
 
 private:
+    void InitTimeline();
+    void TimelineThreadMain();
+
     sptr<IVSyncConnection> connection_;
     std::shared_ptr<OHOS::AppExecFwk::EventHandler> looper_;
     std::shared_ptr<VSyncCallBackListener> listener_;
@@ -84,6 +91,18 @@ private:
     bool init_;
     int32_t fd_;
     std::string name_;
+
+    // the shared vsync timeline, used instead of fd_ if the distributor has enabled it.
+    std::unique_ptr<VSyncTimeline> timeline_;
+    int32_t timelineSlot_ = -1;
+    int64_t lastSlotVSyncCount_ = 0;
+    std::thread timelineThread_;
+    std::mutex timelineMutex_;
+    std::condition_variable timelineCon_;
+    bool timelineRunning_ = false;    // guarded by timelineMutex_
+    bool timelineRequested_ = false;  // guarded by timelineMutex_, set by RequestNextVSync
+    uint64_t timelineRequestCount_ = 0; // guarded by timelineMutex_
+    bool timelineContinuous_ = false; // guarded by timelineMutex_, set by SetVSyncRate
 };
 #else
 class VSyncReceiver {
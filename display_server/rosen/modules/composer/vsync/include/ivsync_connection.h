@@ -32,6 +32,10 @@ public:
     // if rate > 0, we will continue to send Vsync signals at a frequency of FREQ / rate
     virtual VsyncError SetVSyncRate(int32_t rate) = 0;
 
+    // Get the shared vsync timeline and the slot of this connection, see VSyncTimeline.
+    // Returns an error if the timeline is not enabled, then the vsync is sent through the receive fd.
+    virtual VsyncError GetVSyncTimeline(int32_t &fd, int32_t &slot) = 0;
+
     DECLARE_INTERFACE_DESCRIPTOR(u"IVSyncConnection");
 
 protected:
@@ -39,6 +43,7 @@ protected:
         IVSYNC_CONNECTION_REQUEST_NEXT_VSYNC,
         IVSYNC_CONNECTION_GET_RECEIVE_FD,
         IVSYNC_CONNECTION_SET_RATE,
+        IVSYNC_CONNECTION_GET_TIMELINE,
     };
 };
 } // namespace Vsync
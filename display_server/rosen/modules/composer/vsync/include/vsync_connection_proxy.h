@@ -31,6 +31,7 @@ public:
     virtual VsyncError RequestNextVSync() override;
     virtual VsyncError GetReceiveFd(int32_t &fd) override;
     virtual VsyncError SetVSyncRate(int32_t rate) override;
+    virtual VsyncError GetVSyncTimeline(int32_t &fd, int32_t &slot) override;
 
 private:
     static inline BrokerDelegator<VSyncConnectionProxy> delegator_;
@@ -42,6 +42,7 @@ public:
     VsyncError SetEnable(bool enable = false);
     VsyncError SetCallback(Callback* cb);
     VsyncError SetPhaseOffset(int64_t offset);
+    int64_t GetPhaseOffset();
 
 private:
 
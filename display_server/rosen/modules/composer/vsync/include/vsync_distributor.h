@@ -19,6 +19,7 @@
 
 #include <refbase.h>
 
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <thread>
@@ -27,6 +28,7 @@
 #include "local_socketpair.h"
 #include "vsync_controller.h"
 #include "vsync_connection_stub.h"
+#include "vsync_timeline.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -34,7 +36,9 @@ class VSyncDistributor;
 struct ConnectionInfo {
     std::string name_;
     uint64_t postVSyncCount_;
-    ConnectionInfo(std::string name): postVSyncCount_(0)
+    int64_t frameDuration_; // estimated render duration of the connection, 0 if it has never reported one
+    int64_t phaseOffset_; // phase offset of the distributor the connection belongs to
+    ConnectionInfo(std::string name): postVSyncCount_(0), frameDuration_(0), phaseOffset_(0)
     {
         this->name_ = name;
     }
@@ -43,12 +47,13 @@ struct ConnectionInfo {
 class VSyncConnection : public VSyncConnectionStub {
 public:
 
-    VSyncConnection(const sptr<VSyncDistributor>& distributor, std::string name);
+    VSyncConnection(const sptr<VSyncDistributor>& distributor, std::string name, uint32_t pid = 0);
     ~VSyncConnection();
 
     virtual VsyncError RequestNextVSync() override;
     virtual VsyncError GetReceiveFd(int32_t &fd) override;
     virtual VsyncError SetVSyncRate(int32_t rate) override;
+    virtual VsyncError GetVSyncTimeline(int32_t &fd, int32_t &slot) override;
 
     int32_t PostEvent(int64_t now);
 
@@ -56,6 +61,9 @@ public:
     int32_t highPriorityRate_ = -1;
     bool highPriorityState_ = false;
     ConnectionInfo info_;
+    int32_t timelineSlot_ = VSyncTimeline::INVALID_SLOT; // delivered through the timeline if it's valid
+    uint32_t pid_;
+    int64_t frameVSyncCount_ = 0; // vsyncCount of the distributor when the frame duration is reported
 private:
     // Circular reference， need check
     wptr<VSyncDistributor> distributor_;
@@ -79,6 +87,16 @@ public:
     VsyncError GetVSyncConnectionInfos(std::vector<ConnectionInfo>& infos);
     VsyncError GetQosVSyncRateInfos(std::vector<std::pair<uint32_t, int32_t>>& vsyncRateInfos);
     VsyncError SetQosVSyncRate(uint32_t pid, int32_t rate);
+    // publish the vsync to the connections which have attached the shared timeline, instead of the socket pairs.
+    VsyncError EnableTimeline();
+    VsyncError AttachTimeline(const sptr<VSyncConnection>& connection, int32_t &fd, int32_t &slot);
+    // record the duration from the vsync to the end of the frame for the connections of pid.
+    VsyncError ReportFrameDuration(uint32_t pid, int64_t duration);
+    // the longest estimated frame duration of the connections which reported recently, 0 if none.
+    int64_t GetFrameDuration();
+    // the measured vsync period, 0 if the distributor has not delivered two consecutive vsyncs yet.
+    int64_t GetPeriod();
+    VsyncError SetPhaseOffset(int64_t offset);
 
 private:
 
@@ -94,6 +112,7 @@ private:
     void CollectConnections(bool &waitForVSync, int64_t timestamp,
                             std::vector<sptr<VSyncConnection>> &conns, int64_t vsyncCount);
     VsyncError QosGetPidByName(const std::string& name, uint32_t& pid);
+    void PickTimelineConnections(std::vector<sptr<VSyncConnection>> &conns, std::vector<int32_t> &slots);
 
     std::thread threadLoop_;
     sptr<VSyncController> controller_;
@@ -101,6 +120,10 @@ private:
     std::condition_variable con_;
     std::vector<sptr<VSyncConnection> > connections_;
     VSyncEvent event_;
+    std::unique_ptr<VSyncTimeline> timeline_;
+    int64_t lastTimestamp_ = 0;
+    int64_t lastVSyncCount_ = 0;
+    int64_t period_ = 0;
     bool vsyncEnabled_;
     std::string name_;
     bool vsyncThreadRunning_;
@@ -20,7 +20,9 @@
 #include <refbase.h>
 #include "graphic_common.h"
 
+#include <array>
 #include <mutex>
+#include <string>
 #include <vector>
 #include <thread>
 #include <condition_variable>
@@ -39,6 +41,7 @@ public:
     virtual VsyncError AddListener(int64_t phase, const sptr<Callback>& cb) = 0;
     virtual VsyncError RemoveListener(const sptr<Callback>& cb) = 0;
     virtual VsyncError ChangePhaseOffset(const sptr<Callback>& cb, int64_t offset) = 0;
+    virtual void Dump(std::string &result) = 0;
 };
 
 sptr<VSyncGenerator> CreateVSyncGenerator();
@@ -57,6 +60,7 @@ public:
     VsyncError AddListener(int64_t phase, const sptr<OHOS::Rosen::VSyncGenerator::Callback>& cb) override;
     VsyncError RemoveListener(const sptr<OHOS::Rosen::VSyncGenerator::Callback>& cb) override;
     VsyncError ChangePhaseOffset(const sptr<OHOS::Rosen::VSyncGenerator::Callback>& cb, int64_t offset) override;
+    void Dump(std::string &result) override;
 
 private:
     friend class OHOS::Rosen::VSyncGenerator;
@@ -74,18 +78,32 @@ private:
     std::vector<Listener> GetListenerTimeouted(int64_t now);
     int64_t ComputeListenerNextVSyncTimeStamp(const Listener &listen, int64_t now);
     void ThreadLoop();
+    // sleep until the absolute CLOCK_MONOTONIC time, return false if it is woken up earlier by WakeupThread.
+    bool WaitUntil(int64_t deadline);
+    void WakeupThread();
+    void RecordWakeupJitter(int64_t jitter);
+
+    // upper bounds of the jitter histogram buckets, the last bucket counts the rest.
+    static constexpr std::array<int64_t, 5> JITTER_BUCKET_BOUNDS = { 50000, 100000, 250000, 500000, 1000000 };
+    struct JitterStats {
+        std::array<uint64_t, JITTER_BUCKET_BOUNDS.size() + 1> buckets {};
+        uint64_t count = 0;
+        int64_t sum = 0;
+        int64_t max = 0;
+    };
 
     int64_t period_;
     int64_t phase_;
     int64_t refrenceTime_;
     int64_t wakeupDelay_;
+    JitterStats jitterStats_;
 
     std::vector<Listener> listeners_;
 
     std::mutex mutex_;
     std::condition_variable con_;
-    std::mutex waitForTimeoutMtx_;
-    std::condition_variable waitForTimeoutCon_;
+    int32_t timerFd_ = -1;  // timerfd armed with the absolute deadline of the next vsync
+    int32_t wakeupFd_ = -1; // eventfd to interrupt the wait of the timerfd
     std::thread thread_;
     bool vsyncThreadRunning_;
     static std::once_flag createFlag_;
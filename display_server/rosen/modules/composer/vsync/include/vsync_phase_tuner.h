@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VSYNC_VSYNC_PHASE_TUNER_H
+#define VSYNC_VSYNC_PHASE_TUNER_H
+
+#include <cstdint>
+#include <refbase.h>
+
+#include "vsync_distributor.h"
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Moves the phase offsets of the "rs" and "app" distributors after the measured frame durations, so that the app
+ * frame is flushed just before the render service wakes up, and the render service commits just before the next
+ * hardware vsync, instead of both waiting for a fixed phase.
+ */
+class VSyncPhaseTuner {
+public:
+    struct Offsets {
+        int64_t rsOffset;
+        int64_t appOffset;
+    };
+
+    VSyncPhaseTuner(const sptr<VSyncDistributor> &rsDistributor, const sptr<VSyncDistributor> &appDistributor,
+                    int64_t baseOffset);
+    ~VSyncPhaseTuner() = default;
+
+    // nocopyable
+    VSyncPhaseTuner(const VSyncPhaseTuner &) = delete;
+    VSyncPhaseTuner &operator=(const VSyncPhaseTuner &) = delete;
+
+    // called by the render service after each of its frames, the offsets are retuned once in a while.
+    void OnFrameCommitted();
+    Offsets GetOffsets() const
+    {
+        return offsets_;
+    }
+
+    // the base offset for both if the two frames don't fit in one period.
+    static Offsets ComputeOffsets(int64_t period, int64_t baseOffset, int64_t rsDuration, int64_t appDuration);
+
+private:
+    sptr<VSyncDistributor> rsDistributor_;
+    sptr<VSyncDistributor> appDistributor_;
+    int64_t baseOffset_;
+    Offsets offsets_;
+    uint32_t frameCount_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // VSYNC_VSYNC_PHASE_TUNER_H
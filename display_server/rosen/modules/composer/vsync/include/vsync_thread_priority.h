@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VSYNC_VSYNC_THREAD_PRIORITY_H
+#define VSYNC_VSYNC_THREAD_PRIORITY_H
+
+namespace OHOS {
+namespace Rosen {
+// Move the calling thread to SCHED_FIFO, used by the vsync generator and distributor threads.
+// Returns false if the scheduler policy can not be changed, e.g. without CAP_SYS_NICE.
+bool SetVSyncThreadPriority();
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // VSYNC_VSYNC_THREAD_PRIORITY_H
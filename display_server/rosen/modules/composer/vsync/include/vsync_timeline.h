@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VSYNC_VSYNC_TIMELINE_H
+#define VSYNC_VSYNC_TIMELINE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * A shared memory page with the latest vsync, written by VSyncDistributor and mapped read-only by the VSyncReceivers.
+ *
+ * The page is guarded by a seqlock, whose sequence is also the futex word the receivers wait on, so that a single
+ * FUTEX_WAKE wakes up all of them whatever the count of connections is. Each connection owns a slot, the distributor
+ * stores the vsyncCount into the slots of the connections the vsync is delivered to, so the rate and qos policies
+ * stay in the distributor as with the socket pairs.
+ */
+class VSyncTimeline {
+public:
+    static constexpr int32_t INVALID_SLOT = -1;
+
+    struct Snapshot {
+        int64_t timestamp = 0;
+        int64_t vsyncCount = 0;
+        int64_t period = 0;
+        int64_t slotVSyncCount = 0; // vsyncCount of the last vsync delivered to the slot.
+    };
+
+    // the distributor side, create a new page.
+    static std::unique_ptr<VSyncTimeline> Create(const std::string &name);
+    // the receiver side, map the page of fd read-only, the fd is not kept.
+    static std::unique_ptr<VSyncTimeline> Map(int32_t fd);
+    ~VSyncTimeline() noexcept;
+
+    // nocopyable
+    VSyncTimeline(const VSyncTimeline &) = delete;
+    VSyncTimeline &operator=(const VSyncTimeline &) = delete;
+
+    int32_t GetFd() const
+    {
+        return fd_;
+    }
+
+    int32_t AllocSlot();
+    void FreeSlot(int32_t slot);
+    // publish the vsync to the slots, then wake up all the waiting receivers.
+    void Publish(int64_t timestamp, int64_t vsyncCount, int64_t period, const std::vector<int32_t> &slots);
+
+    // return the sequence of the consistent snapshot, to be passed to Wait.
+    uint32_t Read(int32_t slot, Snapshot &snapshot) const;
+    // block until the page is published after `sequence`, or timeout.
+    void Wait(uint32_t sequence, int64_t timeoutNs) const;
+    void WakeAll() const;
+
+private:
+    struct Page;
+    VSyncTimeline(int32_t fd, Page *page);
+
+    int32_t fd_;
+    Page *page_;
+    std::mutex slotMutex_;
+    std::vector<bool> usedSlots_; // guarded by slotMutex_, only used by the distributor side.
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // VSYNC_VSYNC_TIMELINE_H
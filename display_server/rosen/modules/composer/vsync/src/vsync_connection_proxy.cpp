@@ -69,5 +69,21 @@ VsyncError VSyncConnectionProxy::SetVSyncRate(int32_t rate)
     }
     return VSYNC_ERROR_OK;
 }
+
+VsyncError VSyncConnectionProxy::GetVSyncTimeline(int32_t &fd, int32_t &slot)
+{
+    MessageOption opt;
+    MessageParcel arg;
+    MessageParcel ret;
+
+    arg.WriteInterfaceToken(GetDescriptor());
+    int res = Remote()->SendRequest(IVSYNC_CONNECTION_GET_TIMELINE, arg, ret, opt);
+    if (res != NO_ERROR) {
+        return VSYNC_ERROR_BINDER_ERROR;
+    }
+    slot = ret.ReadInt32();
+    fd = ret.ReadFileDescriptor();
+    return VSYNC_ERROR_OK;
+}
 } // namespace Vsync
 } // namespace OHOS
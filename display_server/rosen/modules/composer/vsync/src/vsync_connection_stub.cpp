@@ -51,6 +51,19 @@ int32_t VSyncConnectionStub::OnRemoteRequest(uint32_t code, MessageParcel &data,
             }
             break;
         }
+        case IVSYNC_CONNECTION_GET_TIMELINE: {
+            int32_t fd = -1;
+            int32_t slot = -1;
+            int32_t ret = GetVSyncTimeline(fd, slot);
+            if (ret != VSYNC_ERROR_OK) {
+                return ret;
+            }
+            reply.WriteInt32(slot);
+            reply.WriteFileDescriptor(fd);
+            // the parcel holds its own dup of the fd.
+            close(fd);
+            break;
+        }
         default: {
             // check add log
             return VSYNC_ERROR_INVALID_OPERATING;
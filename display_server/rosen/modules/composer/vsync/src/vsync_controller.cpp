@@ -71,6 +71,12 @@ VsyncError VSyncController::SetPhaseOffset(int64_t offset)
     return generator->ChangePhaseOffset(this, phaseOffset_);
 }
 
+int64_t VSyncController::GetPhaseOffset()
+{
+    std::lock_guard<std::mutex> locker(offsetMutex_);
+    return phaseOffset_;
+}
+
 void VSyncController::OnVSyncEvent(int64_t now)
 {
     Callback *cb = nullptr;
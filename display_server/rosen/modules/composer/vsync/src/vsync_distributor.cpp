@@ -17,10 +17,10 @@
 #include <chrono>
 #include <condition_variable>
 #include <algorithm>
-#include <sched.h>
-#include <sys/resource.h>
+#include <unistd.h>
 #include <scoped_bytrace.h>
 #include "vsync_log.h"
+#include "vsync_thread_priority.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -28,14 +28,13 @@ namespace {
 constexpr int32_t SOFT_VSYNC_PERIOD = 16;
 constexpr int32_t ERRNO_EAGAIN = -1;
 constexpr int32_t ERRNO_OTHER = -2;
-#ifndef FT_BUILD
-constexpr int32_t THREAD_PRIORTY = -6;
-constexpr int32_t SCHED_PRIORITY = 2;
-#endif
 constexpr uint32_t SOCKET_CHANNEL_SIZE = 1024;
+constexpr int64_t MAX_FRAME_DURATION = 100000000; // 100ms, longer ones are stalls, not frames
+constexpr int64_t FRAME_DURATION_DECAY_SHIFT = 4;
+constexpr int64_t FRAME_DURATION_ACTIVE_VSYNC_COUNT = 120;
 }
-VSyncConnection::VSyncConnection(const sptr<VSyncDistributor>& distributor, std::string name)
-    : rate_(-1), info_(name), distributor_(distributor)
+VSyncConnection::VSyncConnection(const sptr<VSyncDistributor>& distributor, std::string name, uint32_t pid)
+    : rate_(-1), info_(name), pid_(pid), distributor_(distributor)
 {
     socketPair_ = new LocalSocketPair();
     int32_t err = socketPair_->CreateChannel(SOCKET_CHANNEL_SIZE, SOCKET_CHANNEL_SIZE);
@@ -92,6 +91,18 @@ VsyncError VSyncConnection::SetVSyncRate(int32_t rate)
     return distributor->SetVSyncRate(rate, this);
 }
 
+VsyncError VSyncConnection::GetVSyncTimeline(int32_t &fd, int32_t &slot)
+{
+    if (distributor_ == nullptr) {
+        return VSYNC_ERROR_NULLPTR;
+    }
+    const sptr<VSyncDistributor> distributor = distributor_.promote();
+    if (distributor == nullptr) {
+        return VSYNC_ERROR_NULLPTR;
+    }
+    return distributor->AttachTimeline(this, fd, slot);
+}
+
 VSyncDistributor::VSyncDistributor(sptr<VSyncController> controller, std::string name)
     : controller_(controller), mutex_(), con_(), connections_(),
     vsyncEnabled_(false), name_(name)
@@ -140,35 +151,25 @@ VsyncError VSyncDistributor::RemoveConnection(const sptr<VSyncConnection>& conne
         return VSYNC_ERROR_INVALID_ARGUMENTS;
     }
     ScopedBytrace func("Remove VSyncConnection: " + connection->info_.name_);
+    if (timeline_ != nullptr && connection->timelineSlot_ != VSyncTimeline::INVALID_SLOT) {
+        timeline_->FreeSlot(connection->timelineSlot_);
+        connection->timelineSlot_ = VSyncTimeline::INVALID_SLOT;
+    }
     connections_.erase(it);
     return VSYNC_ERROR_OK;
 }
 
 void VSyncDistributor::ThreadMain()
 {
-    // set thread priorty
-#ifdef FT_BUILD
-    pthread_attr_t thread_attr;
-    struct sched_param thread_param;
-    pthread_attr_init(&thread_attr);
-    if (pthread_attr_setschedpolicy(&thread_attr, SCHED_FIFO) == 0) {
-        thread_param.sched_priority = sched_get_priority_max(SCHED_FIFO);
-        if (pthread_attr_setschedparam(&thread_attr, &thread_param) == 0) {
-            VLOGI("set thread priorty: SCHED_FIFO/%{public}d", thread_param.sched_priority);
-        }
-    }
-#else
-    setpriority(PRIO_PROCESS, 0, THREAD_PRIORTY);
-    struct sched_param param = {0};
-    param.sched_priority = SCHED_PRIORITY;
-    sched_setscheduler(0, SCHED_FIFO, &param);
-#endif
-
+    SetVSyncThreadPriority();
 
     int64_t timestamp;
     int64_t vsyncCount;
     while (vsyncThreadRunning_ == true) {
         std::vector<sptr<VSyncConnection>> conns;
+        std::vector<int32_t> timelineSlots;
+        VSyncTimeline *timeline = nullptr;
+        int64_t period = 0;
         {
             bool waitForVSync = false;
             std::unique_lock<std::mutex> locker(mutex_);
@@ -201,6 +202,22 @@ void VSyncDistributor::ThreadMain()
                 DisableVSync();
                 continue;
             }
+            if (timeline_ != nullptr) {
+                timeline = timeline_.get();
+                PickTimelineConnections(conns, timelineSlots);
+            }
+            period = (vsyncCount == lastVSyncCount_ + 1) ? timestamp - lastTimestamp_ : 0;
+            if (period > 0) {
+                period_ = period;
+            }
+            lastTimestamp_ = timestamp;
+            lastVSyncCount_ = vsyncCount;
+        }
+
+        if (!timelineSlots.empty()) {
+            // one futex wake for all the timeline connections, whatever the count of them.
+            ScopedBytrace publish(name_ + "_PublishVSyncTimeline");
+            timeline->Publish(timestamp, vsyncCount, period, timelineSlots);
         }
 
         ScopedBytrace func(name_ + "_SendVsync");
@@ -222,9 +239,6 @@ void VSyncDistributor::ThreadMain()
             }
         }
     }
-#ifdef FT_BUILD
-    pthread_attr_destroy(&thread_attr);
-#endif
 }
 
 void VSyncDistributor::EnableVSync()
@@ -347,12 +361,126 @@ VsyncError VSyncDistributor::SetHighPriorityVSyncRate(int32_t highPriorityRate,
 VsyncError VSyncDistributor::GetVSyncConnectionInfos(std::vector<ConnectionInfo>& infos)
 {
     infos.clear();
+    int64_t phaseOffset = (controller_ != nullptr) ? controller_->GetPhaseOffset() : 0;
+    std::lock_guard<std::mutex> locker(mutex_);
     for (auto &connection : connections_) {
         infos.push_back(connection->info_);
+        infos.back().phaseOffset_ = phaseOffset;
+    }
+    return VSYNC_ERROR_OK;
+}
+
+VsyncError VSyncDistributor::ReportFrameDuration(uint32_t pid, int64_t duration)
+{
+    if (duration <= 0 || duration > MAX_FRAME_DURATION) {
+        return VSYNC_ERROR_INVALID_ARGUMENTS;
+    }
+    std::lock_guard<std::mutex> locker(mutex_);
+    for (auto &connection : connections_) {
+        if (connection->pid_ != pid) {
+            continue;
+        }
+        // follow a longer frame at once and a shorter one slowly, so the phase is not tuned on the lucky frames.
+        int64_t &estimate = connection->info_.frameDuration_;
+        if (duration >= estimate) {
+            estimate = duration;
+        } else {
+            estimate -= (estimate - duration) >> FRAME_DURATION_DECAY_SHIFT;
+        }
+        connection->frameVSyncCount_ = event_.vsyncCount;
+    }
+    return VSYNC_ERROR_OK;
+}
+
+int64_t VSyncDistributor::GetFrameDuration()
+{
+    std::lock_guard<std::mutex> locker(mutex_);
+    int64_t frameDuration = 0;
+    for (auto &connection : connections_) {
+        // the connections which stop drawing do not hold the phase.
+        if (connection->info_.frameDuration_ > 0 &&
+            event_.vsyncCount - connection->frameVSyncCount_ <= FRAME_DURATION_ACTIVE_VSYNC_COUNT) {
+            frameDuration = std::max(frameDuration, connection->info_.frameDuration_);
+        }
+    }
+    return frameDuration;
+}
+
+int64_t VSyncDistributor::GetPeriod()
+{
+    std::lock_guard<std::mutex> locker(mutex_);
+    return period_;
+}
+
+VsyncError VSyncDistributor::SetPhaseOffset(int64_t offset)
+{
+    if (controller_ == nullptr) {
+        return VSYNC_ERROR_NULLPTR;
+    }
+    VsyncError ret = controller_->SetPhaseOffset(offset);
+    // the offset is kept by the controller and applied when the vsync is enabled.
+    return (ret == VSYNC_ERROR_INVALID_OPERATING) ? VSYNC_ERROR_OK : ret;
+}
+
+VsyncError VSyncDistributor::EnableTimeline()
+{
+    std::lock_guard<std::mutex> locker(mutex_);
+    if (timeline_ != nullptr) {
+        return VSYNC_ERROR_OK;
+    }
+    timeline_ = VSyncTimeline::Create(name_);
+    if (timeline_ == nullptr) {
+        VLOGE("create vsync timeline of %{public}s failed", name_.c_str());
+        return VSYNC_ERROR_API_FAILED;
     }
     return VSYNC_ERROR_OK;
 }
 
+VsyncError VSyncDistributor::AttachTimeline(const sptr<VSyncConnection>& connection, int32_t &fd, int32_t &slot)
+{
+    if (connection == nullptr) {
+        return VSYNC_ERROR_NULLPTR;
+    }
+    std::lock_guard<std::mutex> locker(mutex_);
+    if (timeline_ == nullptr) {
+        return VSYNC_ERROR_INVALID_OPERATING;
+    }
+    auto it = find(connections_.begin(), connections_.end(), connection);
+    if (it == connections_.end()) {
+        return VSYNC_ERROR_INVALID_ARGUMENTS;
+    }
+    if (connection->timelineSlot_ == VSyncTimeline::INVALID_SLOT) {
+        connection->timelineSlot_ = timeline_->AllocSlot();
+        if (connection->timelineSlot_ == VSyncTimeline::INVALID_SLOT) {
+            // out of slots, keep using the socket pair.
+            VLOGW("no free timeline slot for %{public}s", connection->info_.name_.c_str());
+            return VSYNC_ERROR_INVALID_OPERATING;
+        }
+    }
+    fd = dup(timeline_->GetFd());
+    if (fd < 0) {
+        timeline_->FreeSlot(connection->timelineSlot_);
+        connection->timelineSlot_ = VSyncTimeline::INVALID_SLOT;
+        return VSYNC_ERROR_API_FAILED;
+    }
+    slot = connection->timelineSlot_;
+    return VSYNC_ERROR_OK;
+}
+
+void VSyncDistributor::PickTimelineConnections(std::vector<sptr<VSyncConnection>> &conns,
+                                               std::vector<int32_t> &slots)
+{
+    auto it = std::remove_if(conns.begin(), conns.end(), [&slots](const sptr<VSyncConnection>& conn) {
+        if (conn->timelineSlot_ == VSyncTimeline::INVALID_SLOT) {
+            return false;
+        }
+        slots.push_back(conn->timelineSlot_);
+        conn->info_.postVSyncCount_++;
+        return true;
+    });
+    conns.erase(it, conns.end());
+}
+
 VsyncError VSyncDistributor::QosGetPidByName(const std::string& name, uint32_t& pid)
 {
     if (name.find("WM") == std::string::npos) {
@@ -15,27 +15,42 @@
 
 #include "vsync_generator.h"
 #include "vsync_log.h"
+#include "vsync_thread_priority.h"
 #include <scoped_bytrace.h>
-#include <sched.h>
-#include <sys/resource.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
 #include <string>
 
 namespace OHOS {
 namespace Rosen {
 namespace impl {
 namespace {
-static int64_t GetSysTimeNs()
-{
-    auto now = std::chrono::steady_clock::now().time_since_epoch();
-    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
-}
+constexpr int64_t NS_PER_SECOND = 1000000000;
+constexpr int64_t NS_PER_US = 1000;
 // 1.5ms
 constexpr int64_t maxWaleupDelay = 1500000;
-#ifndef FT_BUILD
-constexpr int32_t THREAD_PRIORTY = -6;
-constexpr int32_t SCHED_PRIORITY = 2;
-#endif
 constexpr int64_t errorThreshold = 500000;
+
+// same clock as std::chrono::steady_clock, the timer deadlines are absolute CLOCK_MONOTONIC times.
+static int64_t GetSysTimeNs()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * NS_PER_SECOND + ts.tv_nsec;
+}
+
+static struct timespec NsToTimespec(int64_t ns)
+{
+    struct timespec ts = {};
+    ts.tv_sec = static_cast<time_t>(ns / NS_PER_SECOND);
+    ts.tv_nsec = static_cast<long>(ns % NS_PER_SECOND);
+    return ts;
+}
 }
 
 std::once_flag VSyncGenerator::createFlag_;
@@ -59,6 +74,19 @@ void VSyncGenerator::DeleteInstance() noexcept
 VSyncGenerator::VSyncGenerator()
     : period_(0), phase_(0), refrenceTime_(0), wakeupDelay_(0)
 {
+    timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    wakeupFd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (timerFd_ < 0 || wakeupFd_ < 0) {
+        VLOGW("create timerfd failed: %{public}s, fallback to clock_nanosleep", strerror(errno));
+        if (timerFd_ >= 0) {
+            close(timerFd_);
+            timerFd_ = -1;
+        }
+        if (wakeupFd_ >= 0) {
+            close(wakeupFd_);
+            wakeupFd_ = -1;
+        }
+    }
     vsyncThreadRunning_ = true;
     thread_ = std::thread(std::bind(&VSyncGenerator::ThreadLoop, this));
 }
@@ -71,29 +99,74 @@ VSyncGenerator::~VSyncGenerator()
     }
     if (thread_.joinable()) {
         con_.notify_all();
+        WakeupThread();
         thread_.join();
     }
+    if (timerFd_ >= 0) {
+        close(timerFd_);
+    }
+    if (wakeupFd_ >= 0) {
+        close(wakeupFd_);
+    }
 }
 
-void VSyncGenerator::ThreadLoop()
+bool VSyncGenerator::WaitUntil(int64_t deadline)
 {
-    // set thread priorty
-#ifdef FT_BUILD
-    pthread_attr_t thread_attr;
-    struct sched_param thread_param;
-    pthread_attr_init(&thread_attr);
-    if (pthread_attr_setschedpolicy(&thread_attr, SCHED_FIFO) == 0) {
-        thread_param.sched_priority = sched_get_priority_max(SCHED_FIFO);
-        if (pthread_attr_setschedparam(&thread_attr, &thread_param) == 0) {
-            VLOGI("set thread priorty: SCHED_FIFO/%{public}d", thread_param.sched_priority);
+    struct itimerspec spec = {};
+    spec.it_value = NsToTimespec(deadline);
+    if (timerFd_ < 0 || timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+        // can not be woken up, the deadline is at most one period away.
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &spec.it_value, nullptr) == EINTR) {
+        }
+        return true;
+    }
+
+    struct pollfd fds[] = {
+        { timerFd_, POLLIN, 0 },
+        { wakeupFd_, POLLIN, 0 },
+    };
+    while (poll(fds, sizeof(fds) / sizeof(fds[0]), -1) < 0) {
+        if (errno != EINTR) {
+            VLOGE("poll failed: %{public}s", strerror(errno));
+            return false;
         }
     }
-#else
-    setpriority(PRIO_PROCESS, 0, THREAD_PRIORTY);
-    struct sched_param param = {0};
-    param.sched_priority = SCHED_PRIORITY;
-    sched_setscheduler(0, SCHED_FIFO, &param);
-#endif
+    uint64_t value = 0;
+    if (fds[1].revents & POLLIN) {
+        (void)read(wakeupFd_, &value, sizeof(value));
+    }
+    if (fds[0].revents & POLLIN) {
+        (void)read(timerFd_, &value, sizeof(value));
+        return true;
+    }
+    return false;
+}
+
+void VSyncGenerator::WakeupThread()
+{
+    if (wakeupFd_ < 0) {
+        return;
+    }
+    uint64_t value = 1;
+    (void)write(wakeupFd_, &value, sizeof(value));
+}
+
+void VSyncGenerator::RecordWakeupJitter(int64_t jitter)
+{
+    jitter = jitter < 0 ? 0 : jitter;
+    size_t index = 0;
+    while (index < JITTER_BUCKET_BOUNDS.size() && jitter >= JITTER_BUCKET_BOUNDS[index]) {
+        index++;
+    }
+    jitterStats_.buckets[index]++;
+    jitterStats_.count++;
+    jitterStats_.sum += jitter;
+    jitterStats_.max = jitter > jitterStats_.max ? jitter : jitterStats_.max;
+}
+
+void VSyncGenerator::ThreadLoop()
+{
+    SetVSyncThreadPriority();
 
     int64_t occurTimestamp = 0;
     int64_t nextTimeStamp = 0;
@@ -119,9 +192,7 @@ void VSyncGenerator::ThreadLoop()
 
         bool isWakeup = false;
         if (occurTimestamp < nextTimeStamp) {
-            std::unique_lock<std::mutex> lck(waitForTimeoutMtx_);
-            auto err = waitForTimeoutCon_.wait_for(lck, std::chrono::nanoseconds(nextTimeStamp - occurTimestamp));
-            if (err == std::cv_status::timeout) {
+            if (WaitUntil(nextTimeStamp)) {
                 isWakeup = true;
             } else {
                 ScopedBytrace func("VSyncGenerator::ThreadLoop::Continue");
@@ -132,6 +203,7 @@ void VSyncGenerator::ThreadLoop()
             std::unique_lock<std::mutex> locker(mutex_);
             occurTimestamp = GetSysTimeNs();
             if (isWakeup) {
+                RecordWakeupJitter(occurTimestamp - nextTimeStamp);
                 // 63, 1 / 64
                 wakeupDelay_ = ((wakeupDelay_ * 63) + (occurTimestamp - nextTimeStamp)) / 64;
                 wakeupDelay_ = wakeupDelay_ > maxWaleupDelay ? maxWaleupDelay : wakeupDelay_;
@@ -143,9 +215,6 @@ void VSyncGenerator::ThreadLoop()
             listeners[i].callback_->OnVSyncEvent(listeners[i].lastTime_);
         }
     }
-#ifdef FT_BUILD
-    pthread_attr_destroy(&thread_attr);
-#endif
 }
 
 int64_t VSyncGenerator::ComputeNextVSyncTimeStamp(int64_t now)
@@ -212,6 +281,7 @@ VsyncError VSyncGenerator::UpdateMode(int64_t period, int64_t phase, int64_t ref
     phase_ = phase;
     refrenceTime_ = refrenceTime;
     con_.notify_all();
+    WakeupThread();
     return VSYNC_ERROR_OK;
 }
 
@@ -229,6 +299,7 @@ VsyncError VSyncGenerator::AddListener(int64_t phase, const sptr<OHOS::Rosen::VS
 
     listeners_.push_back(listener);
     con_.notify_all();
+    WakeupThread();
     return VSYNC_ERROR_OK;
 }
 
@@ -251,6 +322,7 @@ VsyncError VSyncGenerator::RemoveListener(const sptr<OHOS::Rosen::VSyncGenerator
         return VSYNC_ERROR_INVALID_ARGUMENTS;
     }
     con_.notify_all();
+    WakeupThread();
     return VSYNC_ERROR_OK;
 }
 
@@ -268,11 +340,30 @@ VsyncError VSyncGenerator::ChangePhaseOffset(const sptr<OHOS::Rosen::VSyncGenera
     }
     if (it != listeners_.end()) {
         it->phase_ = offset;
+        WakeupThread();
     } else {
         return VSYNC_ERROR_INVALID_OPERATING;
     }
     return VSYNC_ERROR_OK;
 }
+
+void VSyncGenerator::Dump(std::string &result)
+{
+    std::lock_guard<std::mutex> locker(mutex_);
+    result += "VSyncGenerator: period: " + std::to_string(period_) + "ns, phase: " + std::to_string(phase_) +
+        "ns, listeners: " + std::to_string(listeners_.size()) + ", timer: " +
+        (timerFd_ >= 0 ? "timerfd" : "clock_nanosleep") + ", wakeupDelay: " + std::to_string(wakeupDelay_) + "ns\n";
+    int64_t avg = jitterStats_.count == 0 ? 0 : jitterStats_.sum / static_cast<int64_t>(jitterStats_.count);
+    result += "  wakeup jitter: samples: " + std::to_string(jitterStats_.count) +
+        ", avg: " + std::to_string(avg / NS_PER_US) + "us, max: " + std::to_string(jitterStats_.max / NS_PER_US) +
+        "us\n";
+    for (size_t i = 0; i < jitterStats_.buckets.size(); i++) {
+        std::string range = i < JITTER_BUCKET_BOUNDS.size() ?
+            "< " + std::to_string(JITTER_BUCKET_BOUNDS[i] / NS_PER_US) + "us" :
+            ">= " + std::to_string(JITTER_BUCKET_BOUNDS.back() / NS_PER_US) + "us";
+        result += "    " + range + ": " + std::to_string(jitterStats_.buckets[i]) + "\n";
+    }
+}
 } // namespace impl
 sptr<VSyncGenerator> CreateVSyncGenerator()
 {
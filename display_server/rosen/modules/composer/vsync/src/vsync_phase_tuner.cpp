@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vsync_phase_tuner.h"
+
+#include <cinttypes>
+#include <cstdlib>
+#include <scoped_bytrace.h>
+
+#include "vsync_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr int64_t FRAME_MARGIN = 2000000; // 2ms, for the wakeup latency and the ipc of the flush
+constexpr int64_t TUNE_THRESHOLD = 500000; // 0.5ms, smaller changes are jitter
+constexpr uint32_t TUNE_INTERVAL = 30; // frames
+}
+
+VSyncPhaseTuner::VSyncPhaseTuner(const sptr<VSyncDistributor> &rsDistributor,
+                                 const sptr<VSyncDistributor> &appDistributor, int64_t baseOffset)
+    : rsDistributor_(rsDistributor), appDistributor_(appDistributor), baseOffset_(baseOffset),
+    offsets_({baseOffset, baseOffset})
+{
+}
+
+VSyncPhaseTuner::Offsets VSyncPhaseTuner::ComputeOffsets(int64_t period, int64_t baseOffset,
+                                                         int64_t rsDuration, int64_t appDuration)
+{
+    if (period <= 0 || rsDuration <= 0 || appDuration <= 0) {
+        return {baseOffset, baseOffset};
+    }
+    int64_t rsLead = rsDuration + FRAME_MARGIN;
+    int64_t appLead = appDuration + FRAME_MARGIN;
+    if (rsLead + appLead >= period) {
+        // a frame waits for the next period whatever the offsets are.
+        return {baseOffset, baseOffset};
+    }
+    // the render service commits just before the next hardware vsync, the app flushes just before it wakes up.
+    int64_t rsOffset = period - rsLead;
+    return {rsOffset, rsOffset - appLead};
+}
+
+void VSyncPhaseTuner::OnFrameCommitted()
+{
+    if (rsDistributor_ == nullptr || appDistributor_ == nullptr || ++frameCount_ < TUNE_INTERVAL) {
+        return;
+    }
+    frameCount_ = 0;
+    Offsets offsets = ComputeOffsets(rsDistributor_->GetPeriod(), baseOffset_,
+        rsDistributor_->GetFrameDuration(), appDistributor_->GetFrameDuration());
+    if (std::abs(offsets.rsOffset - offsets_.rsOffset) < TUNE_THRESHOLD &&
+        std::abs(offsets.appOffset - offsets_.appOffset) < TUNE_THRESHOLD) {
+        return;
+    }
+    ScopedBytrace func("VSyncPhaseTuner rs:" + std::to_string(offsets.rsOffset) +
+        ", app:" + std::to_string(offsets.appOffset));
+    VLOGI("tune phase offset, rs: %{public}" PRId64 ", app: %{public}" PRId64, offsets.rsOffset, offsets.appOffset);
+    rsDistributor_->SetPhaseOffset(offsets.rsOffset);
+    appDistributor_->SetPhaseOffset(offsets.appOffset);
+    offsets_ = offsets;
+}
+} // namespace Rosen
+} // namespace OHOS
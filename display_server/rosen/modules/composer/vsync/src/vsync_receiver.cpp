@@ -21,12 +21,15 @@
 #include "event_handler.h"
 #include "graphic_common.h"
 #include "vsync_log.h"
+#include "vsync_timeline.h"
 #include "sandbox_utils.h"
 
 namespace OHOS {
 namespace Rosen {
 namespace {
 constexpr int32_t INVALID_FD = -1;
+// the waiting on the timeline is also woken up by VSyncReceiver::~VSyncReceiver, this is only a safety net.
+constexpr int64_t TIMELINE_WAIT_TIMEOUT = 100000000;
 }
 void VSyncCallBackListener::OnReadable(int32_t fileDescriptor)
 {
@@ -65,6 +68,19 @@ void VSyncCallBackListener::OnReadable(int32_t fileDescriptor)
     }
 }
 
+void VSyncCallBackListener::OnVSync(int64_t now)
+{
+    VSyncCallback cb = nullptr;
+    {
+        std::lock_guard<std::mutex> locker(mtx_);
+        cb = vsyncCallbacks_;
+    }
+    ScopedBytrace func("ReceiveVsync from timeline, now:" + std::to_string(now));
+    if (cb != nullptr) {
+        cb(now, userData_);
+    }
+}
+
 VSyncReceiver::VSyncReceiver(const sptr<IVSyncConnection>& conn,
     const std::shared_ptr<OHOS::AppExecFwk::EventHandler>& looper,
     const std::string& name)
@@ -103,12 +119,85 @@ VsyncError VSyncReceiver::Init()
     }
 
     looper_->AddFileDescriptorListener(fd_, OHOS::AppExecFwk::FILE_DESCRIPTOR_INPUT_EVENT, listener_);
+    InitTimeline();
     init_ = true;
     return VSYNC_ERROR_OK;
 }
 
+void VSyncReceiver::InitTimeline()
+{
+    int32_t timelineFd = INVALID_FD;
+    int32_t slot = VSyncTimeline::INVALID_SLOT;
+    if (connection_->GetVSyncTimeline(timelineFd, slot) != VSYNC_ERROR_OK || timelineFd < 0) {
+        // the timeline is not enabled, the vsync comes from fd_.
+        return;
+    }
+    timeline_ = VSyncTimeline::Map(timelineFd);
+    close(timelineFd);
+    if (timeline_ == nullptr) {
+        VLOGW("map vsync timeline failed, name:%{public}s", name_.c_str());
+        return;
+    }
+    timelineSlot_ = slot;
+    VSyncTimeline::Snapshot snapshot;
+    timeline_->Read(timelineSlot_, snapshot);
+    lastSlotVSyncCount_ = snapshot.slotVSyncCount;
+    timelineRunning_ = true;
+    timelineThread_ = std::thread(std::bind(&VSyncReceiver::TimelineThreadMain, this));
+}
+
+void VSyncReceiver::TimelineThreadMain()
+{
+    while (true) {
+        uint64_t requestCount = 0;
+        {
+            std::unique_lock<std::mutex> locker(timelineMutex_);
+            timelineCon_.wait(locker, [this]() {
+                return !timelineRunning_ || timelineRequested_ || timelineContinuous_;
+            });
+            if (!timelineRunning_) {
+                break;
+            }
+            requestCount = timelineRequestCount_;
+        }
+
+        VSyncTimeline::Snapshot snapshot;
+        uint32_t sequence = timeline_->Read(timelineSlot_, snapshot);
+        if (snapshot.slotVSyncCount == lastSlotVSyncCount_) {
+            // returns at once if the timeline is published after the Read.
+            timeline_->Wait(sequence, TIMELINE_WAIT_TIMEOUT);
+            continue;
+        }
+        lastSlotVSyncCount_ = snapshot.slotVSyncCount;
+        {
+            // keep the request made after the Read, it's served by the next vsync.
+            std::lock_guard<std::mutex> locker(timelineMutex_);
+            if (requestCount == timelineRequestCount_) {
+                timelineRequested_ = false;
+            }
+        }
+        int64_t now = snapshot.timestamp;
+        std::weak_ptr<VSyncCallBackListener> weakListener = listener_;
+        looper_->PostTask([weakListener, now]() {
+            auto listener = weakListener.lock();
+            if (listener != nullptr) {
+                listener->OnVSync(now);
+            }
+        }, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+    }
+}
+
 VSyncReceiver::~VSyncReceiver()
 {
+    if (timelineThread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> locker(timelineMutex_);
+            timelineRunning_ = false;
+        }
+        timelineCon_.notify_all();
+        timeline_->WakeAll();
+        timelineThread_.join();
+    }
     if (fd_ != INVALID_FD) {
         looper_->RemoveFileDescriptorListener(fd_);
         close(fd_);
@@ -123,6 +212,12 @@ VsyncError VSyncReceiver::RequestNextVSync(FrameCallback callback)
         return VSYNC_ERROR_API_FAILED;
     }
     listener_->SetCallback(callback);
+    if (timeline_ != nullptr) {
+        std::lock_guard<std::mutex> timelineLocker(timelineMutex_);
+        timelineRequested_ = true;
+        timelineRequestCount_++;
+        timelineCon_.notify_all();
+    }
     ScopedBytrace func("VSyncReceiver::RequestNextVSync_pid:" + std::to_string(GetRealPid()) + "_name:" + name_);
     return connection_->RequestNextVSync();
 }
@@ -134,6 +229,12 @@ VsyncError VSyncReceiver::SetVSyncRate(FrameCallback callback, int32_t rate)
         return VSYNC_ERROR_API_FAILED;
     }
     listener_->SetCallback(callback);
+    if (timeline_ != nullptr) {
+        // a rate <= 0 turns the continuous vsync off, the timeline thread then only serves RequestNextVSync.
+        std::lock_guard<std::mutex> timelineLocker(timelineMutex_);
+        timelineContinuous_ = rate > 0;
+        timelineCon_.notify_all();
+    }
     return connection_->SetVSyncRate(rate);
 }
 } // namespace Rosen
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vsync_thread_priority.h"
+
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+
+#include "vsync_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+#ifndef FT_BUILD
+constexpr int32_t THREAD_PRIORTY = -6;
+constexpr int32_t SCHED_PRIORITY = 2;
+#endif
+}
+
+bool SetVSyncThreadPriority()
+{
+#ifdef FT_BUILD
+    // pthread_attr_t only takes effect on pthread_create, the running thread has to be changed directly.
+    struct sched_param param = {0};
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (ret != 0) {
+        VLOGW("set thread priorty SCHED_FIFO/%{public}d failed: %{public}s", param.sched_priority, strerror(ret));
+        return false;
+    }
+    VLOGI("set thread priorty: SCHED_FIFO/%{public}d", param.sched_priority);
+    return true;
+#else
+    setpriority(PRIO_PROCESS, 0, THREAD_PRIORTY);
+    struct sched_param param = {0};
+    param.sched_priority = SCHED_PRIORITY;
+    return sched_setscheduler(0, SCHED_FIFO, &param) == 0;
+#endif
+}
+} // namespace Rosen
+} // namespace OHOS
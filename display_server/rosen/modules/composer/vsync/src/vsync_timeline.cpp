@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vsync_timeline.h"
+
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <ashmem.h>
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "vsync_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr size_t TIMELINE_SIZE = 4096;
+constexpr int64_t NS_PER_SECOND = 1000000000;
+constexpr size_t TIMELINE_HEADER_SIZE = 32;
+constexpr size_t MAX_SLOTS = (TIMELINE_SIZE - TIMELINE_HEADER_SIZE) / sizeof(int64_t);
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free,
+    "the timeline is shared between processes, the atomics must be lock free");
+
+long Futex(const std::atomic<uint32_t> *addr, int op, uint32_t val, const struct timespec *timeout)
+{
+    // not FUTEX_PRIVATE_FLAG, the waiters are in other processes.
+    return syscall(SYS_futex, reinterpret_cast<const uint32_t *>(addr), op, val, timeout, nullptr, 0);
+}
+}
+
+struct VSyncTimeline::Page {
+    std::atomic<uint32_t> sequence; // odd while the distributor is writing.
+    uint32_t reserved;
+    std::atomic<int64_t> timestamp;
+    std::atomic<int64_t> vsyncCount;
+    std::atomic<int64_t> period;
+    std::atomic<int64_t> slots[MAX_SLOTS];
+};
+
+std::unique_ptr<VSyncTimeline> VSyncTimeline::Create(const std::string &name)
+{
+    static_assert(sizeof(Page) <= TIMELINE_SIZE, "the timeline must fit in one page");
+    int32_t fd = AshmemCreate(("vsync_timeline_" + name).c_str(), TIMELINE_SIZE);
+    if (fd < 0) {
+        VLOGE("AshmemCreate failed: %{public}s", strerror(errno));
+        return nullptr;
+    }
+    void *addr = mmap(nullptr, TIMELINE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        VLOGE("mmap failed: %{public}s", strerror(errno));
+        close(fd);
+        return nullptr;
+    }
+    // the receivers can only map it read-only, the existing mapping of the distributor is not affected.
+    if (AshmemSetProt(fd, PROT_READ) != 0) {
+        VLOGW("AshmemSetProt failed: %{public}s", strerror(errno));
+    }
+    // the page of ashmem is zero filled, which is a valid empty timeline.
+    auto timeline = std::unique_ptr<VSyncTimeline>(new VSyncTimeline(fd, static_cast<Page *>(addr)));
+    timeline->usedSlots_.resize(MAX_SLOTS, false);
+    return timeline;
+}
+
+std::unique_ptr<VSyncTimeline> VSyncTimeline::Map(int32_t fd)
+{
+    if (fd < 0) {
+        return nullptr;
+    }
+    void *addr = mmap(nullptr, TIMELINE_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        VLOGE("mmap failed: %{public}s", strerror(errno));
+        return nullptr;
+    }
+    return std::unique_ptr<VSyncTimeline>(new VSyncTimeline(-1, static_cast<Page *>(addr)));
+}
+
+VSyncTimeline::VSyncTimeline(int32_t fd, Page *page) : fd_(fd), page_(page)
+{
+}
+
+VSyncTimeline::~VSyncTimeline() noexcept
+{
+    munmap(page_, TIMELINE_SIZE);
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+int32_t VSyncTimeline::AllocSlot()
+{
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    for (size_t i = 0; i < usedSlots_.size(); i++) {
+        if (!usedSlots_[i]) {
+            usedSlots_[i] = true;
+            return static_cast<int32_t>(i);
+        }
+    }
+    return INVALID_SLOT;
+}
+
+void VSyncTimeline::FreeSlot(int32_t slot)
+{
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    if (slot >= 0 && static_cast<size_t>(slot) < usedSlots_.size()) {
+        usedSlots_[slot] = false;
+    }
+}
+
+void VSyncTimeline::Publish(int64_t timestamp, int64_t vsyncCount, int64_t period, const std::vector<int32_t> &slots)
+{
+    uint32_t sequence = page_->sequence.load(std::memory_order_relaxed);
+    page_->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    page_->timestamp.store(timestamp, std::memory_order_relaxed);
+    page_->vsyncCount.store(vsyncCount, std::memory_order_relaxed);
+    page_->period.store(period, std::memory_order_relaxed);
+    for (auto slot : slots) {
+        if (slot >= 0 && static_cast<size_t>(slot) < MAX_SLOTS) {
+            page_->slots[slot].store(vsyncCount, std::memory_order_relaxed);
+        }
+    }
+
+    page_->sequence.store(sequence + 2, std::memory_order_release);
+    WakeAll();
+}
+
+uint32_t VSyncTimeline::Read(int32_t slot, Snapshot &snapshot) const
+{
+    while (true) {
+        uint32_t begin = page_->sequence.load(std::memory_order_acquire);
+        if (begin & 1) {
+            // the distributor is in the middle of Publish, which only takes a few stores.
+            sched_yield();
+            continue;
+        }
+        snapshot.timestamp = page_->timestamp.load(std::memory_order_relaxed);
+        snapshot.vsyncCount = page_->vsyncCount.load(std::memory_order_relaxed);
+        snapshot.period = page_->period.load(std::memory_order_relaxed);
+        snapshot.slotVSyncCount = (slot >= 0 && static_cast<size_t>(slot) < MAX_SLOTS) ?
+            page_->slots[slot].load(std::memory_order_relaxed) : 0;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (page_->sequence.load(std::memory_order_relaxed) == begin) {
+            return begin;
+        }
+    }
+}
+
+void VSyncTimeline::Wait(uint32_t sequence, int64_t timeoutNs) const
+{
+    struct timespec timeout = {};
+    timeout.tv_sec = static_cast<time_t>(timeoutNs / NS_PER_SECOND);
+    timeout.tv_nsec = static_cast<long>(timeoutNs % NS_PER_SECOND);
+    // returns at once with EAGAIN if the sequence has already changed.
+    if (Futex(&page_->sequence, FUTEX_WAIT, sequence, &timeout) != 0 &&
+        errno != EAGAIN && errno != ETIMEDOUT && errno != EINTR) {
+        VLOGE("futex wait failed: %{public}s", strerror(errno));
+    }
+}
+
+void VSyncTimeline::WakeAll() const
+{
+    Futex(&page_->sequence, FUTEX_WAKE, INT_MAX, nullptr);
+}
+} // namespace Rosen
+} // namespace OHOS
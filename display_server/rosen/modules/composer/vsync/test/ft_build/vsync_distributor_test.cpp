@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include "vsync_distributor.h"
 #include "vsync_controller.h"
 
@@ -249,6 +250,71 @@ TEST_F(VSyncDistributorTest, GetVSyncConnectionInfos001)
     VSyncDistributorTest::vsyncDistributor->AddConnection(conn);
     ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->GetVSyncConnectionInfos(infos), VSYNC_ERROR_OK);
 }
+
+/*
+* Function: AttachTimeline001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call AttachTimeline before EnableTimeline and check ret
+*                  2. call EnableTimeline, then AttachTimeline returns the timeline fd and a slot
+ */
+TEST_F(VSyncDistributorTest, AttachTimeline001)
+{
+    sptr<VSyncConnection> conn = new VSyncConnection(vsyncDistributor, "VSyncDistributorTest");
+    VSyncDistributorTest::vsyncDistributor->AddConnection(conn);
+    int32_t fd = -1;
+    int32_t slot = -1;
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->AttachTimeline(conn, fd, slot), VSYNC_ERROR_INVALID_OPERATING);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->EnableTimeline(), VSYNC_ERROR_OK);
+    ASSERT_EQ(conn->GetVSyncTimeline(fd, slot), VSYNC_ERROR_OK);
+    ASSERT_GE(fd, 0);
+    ASSERT_NE(slot, VSyncTimeline::INVALID_SLOT);
+    ASSERT_EQ(conn->timelineSlot_, slot);
+    close(fd);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->RemoveConnection(conn), VSYNC_ERROR_OK);
+    ASSERT_EQ(conn->timelineSlot_, VSyncTimeline::INVALID_SLOT);
+}
+
+/*
+* Function: ReportFrameDuration001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call ReportFrameDuration with invalid durations and check ret
+*                  2. a longer duration is taken at once, a shorter one decays slowly
+*                  3. the estimate and the phase offset show up in GetVSyncConnectionInfos
+ */
+TEST_F(VSyncDistributorTest, ReportFrameDuration001)
+{
+    const uint32_t pid = 100;
+    sptr<VSyncConnection> conn = new VSyncConnection(vsyncDistributor, "VSyncDistributorTest", pid);
+    VSyncDistributorTest::vsyncDistributor->AddConnection(conn);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->ReportFrameDuration(pid, 0), VSYNC_ERROR_INVALID_ARGUMENTS);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->ReportFrameDuration(pid, 1000000000),
+        VSYNC_ERROR_INVALID_ARGUMENTS);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->ReportFrameDuration(pid, 8000000), VSYNC_ERROR_OK);
+    ASSERT_EQ(conn->info_.frameDuration_, 8000000);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->GetFrameDuration(), 8000000);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->ReportFrameDuration(pid, 4000000), VSYNC_ERROR_OK);
+    ASSERT_GT(conn->info_.frameDuration_, 4000000);
+    ASSERT_LT(conn->info_.frameDuration_, 8000000);
+
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->SetPhaseOffset(3000000), VSYNC_ERROR_OK);
+    std::vector<ConnectionInfo> infos;
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->GetVSyncConnectionInfos(infos), VSYNC_ERROR_OK);
+    bool found = false;
+    for (const auto &info : infos) {
+        if (info.frameDuration_ == conn->info_.frameDuration_) {
+            ASSERT_EQ(info.phaseOffset_, 3000000);
+            found = true;
+        }
+    }
+    ASSERT_TRUE(found);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->SetPhaseOffset(0), VSYNC_ERROR_OK);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->RemoveConnection(conn), VSYNC_ERROR_OK);
+    ASSERT_EQ(VSyncDistributorTest::vsyncDistributor->GetFrameDuration(), 0);
+}
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "vsync_generator.h"
 
+#include <chrono>
+#include <thread>
 #include <gtest/gtest.h>
 
 namespace OHOS {
@@ -178,6 +180,43 @@ TEST_F(VSyncGeneratorTest, ChangePhaseOffset003)
     sptr<VSyncGeneratorTestCallback> callback7 = new VSyncGeneratorTestCallback;
     ASSERT_EQ(VSyncGeneratorTest::vsyncGenerator_->ChangePhaseOffset(callback7, 1), VSYNC_ERROR_INVALID_OPERATING);
 }
+
+/*
+* Function: Dump001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call Dump
+ */
+TEST_F(VSyncGeneratorTest, Dump001)
+{
+    std::string result;
+    VSyncGeneratorTest::vsyncGenerator_->Dump(result);
+    ASSERT_NE(result.find("VSyncGenerator"), std::string::npos);
+    ASSERT_NE(result.find("wakeup jitter"), std::string::npos);
+}
+
+/*
+* Function: Dump002
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. generate software vsync for a while
+*                  2. call Dump, the wakeups are counted in the jitter histogram
+ */
+TEST_F(VSyncGeneratorTest, Dump002)
+{
+    constexpr int64_t period = 16666666;
+    sptr<VSyncGeneratorTestCallback> callback8 = new VSyncGeneratorTestCallback;
+    ASSERT_EQ(VSyncGeneratorTest::vsyncGenerator_->UpdateMode(period, 0, 0), VSYNC_ERROR_OK);
+    ASSERT_EQ(VSyncGeneratorTest::vsyncGenerator_->AddListener(0, callback8), VSYNC_ERROR_OK);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    ASSERT_EQ(VSyncGeneratorTest::vsyncGenerator_->RemoveListener(callback8), VSYNC_ERROR_OK);
+
+    std::string result;
+    VSyncGeneratorTest::vsyncGenerator_->Dump(result);
+    ASSERT_EQ(result.find("samples: 0,"), std::string::npos);
+}
 } // namespace
 } // namespace Rosen
 } // namespace OHOS
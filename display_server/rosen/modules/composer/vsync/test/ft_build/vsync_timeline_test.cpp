@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "vsync_timeline.h"
+
+namespace OHOS {
+namespace Rosen {
+class VSyncTimelineTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+
+    static inline std::unique_ptr<VSyncTimeline> timeline_ = nullptr;
+};
+
+void VSyncTimelineTest::SetUpTestCase()
+{
+    timeline_ = VSyncTimeline::Create("VSyncTimelineTest");
+}
+
+void VSyncTimelineTest::TearDownTestCase()
+{
+    timeline_ = nullptr;
+}
+
+namespace {
+/*
+* Function: Create001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call Create
+ */
+TEST_F(VSyncTimelineTest, Create001)
+{
+    ASSERT_NE(VSyncTimelineTest::timeline_, nullptr);
+    ASSERT_GE(VSyncTimelineTest::timeline_->GetFd(), 0);
+}
+
+/*
+* Function: AllocSlot001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call AllocSlot twice, the slots are different
+*                  2. call FreeSlot, the slot is reused by the next AllocSlot
+ */
+TEST_F(VSyncTimelineTest, AllocSlot001)
+{
+    int32_t slot1 = VSyncTimelineTest::timeline_->AllocSlot();
+    int32_t slot2 = VSyncTimelineTest::timeline_->AllocSlot();
+    ASSERT_NE(slot1, VSyncTimeline::INVALID_SLOT);
+    ASSERT_NE(slot2, VSyncTimeline::INVALID_SLOT);
+    ASSERT_NE(slot1, slot2);
+    VSyncTimelineTest::timeline_->FreeSlot(slot1);
+    ASSERT_EQ(VSyncTimelineTest::timeline_->AllocSlot(), slot1);
+    VSyncTimelineTest::timeline_->FreeSlot(slot1);
+    VSyncTimelineTest::timeline_->FreeSlot(slot2);
+}
+
+/*
+* Function: Publish001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call Publish to one slot
+*                  2. call Read from a read-only mapping, only the published slot gets the vsyncCount
+ */
+TEST_F(VSyncTimelineTest, Publish001)
+{
+    int32_t slot1 = VSyncTimelineTest::timeline_->AllocSlot();
+    int32_t slot2 = VSyncTimelineTest::timeline_->AllocSlot();
+    int32_t fd = dup(VSyncTimelineTest::timeline_->GetFd());
+    auto mapped = VSyncTimeline::Map(fd);
+    close(fd);
+    ASSERT_NE(mapped, nullptr);
+
+    VSyncTimeline::Snapshot snapshot;
+    uint32_t sequence = mapped->Read(slot1, snapshot);
+    VSyncTimelineTest::timeline_->Publish(1000, 7, 16, { slot1 });
+    uint32_t newSequence = mapped->Read(slot1, snapshot);
+    ASSERT_NE(newSequence, sequence);
+    ASSERT_EQ(newSequence % 2, 0u);
+    ASSERT_EQ(snapshot.timestamp, 1000);
+    ASSERT_EQ(snapshot.vsyncCount, 7);
+    ASSERT_EQ(snapshot.period, 16);
+    ASSERT_EQ(snapshot.slotVSyncCount, 7);
+    mapped->Read(slot2, snapshot);
+    ASSERT_EQ(snapshot.slotVSyncCount, 0);
+
+    VSyncTimelineTest::timeline_->FreeSlot(slot1);
+    VSyncTimelineTest::timeline_->FreeSlot(slot2);
+}
+
+/*
+* Function: Wait001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call Wait with an outdated sequence, it returns at once
+*                  2. call Wait with the current sequence, it returns after the timeout
+ */
+TEST_F(VSyncTimelineTest, Wait001)
+{
+    constexpr int64_t timeout = 20000000; // 20ms
+    VSyncTimeline::Snapshot snapshot;
+    uint32_t sequence = VSyncTimelineTest::timeline_->Read(VSyncTimeline::INVALID_SLOT, snapshot);
+    VSyncTimelineTest::timeline_->Publish(2000, 8, 16, {});
+
+    auto start = std::chrono::steady_clock::now();
+    VSyncTimelineTest::timeline_->Wait(sequence, timeout);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::nanoseconds(timeout));
+
+    sequence = VSyncTimelineTest::timeline_->Read(VSyncTimeline::INVALID_SLOT, snapshot);
+    start = std::chrono::steady_clock::now();
+    VSyncTimelineTest::timeline_->Wait(sequence, timeout);
+    ASSERT_GE(std::chrono::steady_clock::now() - start, std::chrono::nanoseconds(timeout));
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "vsync_controller.h"
+#include "vsync_distributor.h"
+#include "vsync_phase_tuner.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr int64_t PERIOD = 16666667;
+constexpr int64_t BASE_OFFSET = 10000000;
+}
+
+class VSyncPhaseTunerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+
+    static inline sptr<VSyncGenerator> vsyncGenerator = nullptr;
+    static inline sptr<VSyncDistributor> rsDistributor = nullptr;
+    static inline sptr<VSyncDistributor> appDistributor = nullptr;
+};
+
+void VSyncPhaseTunerTest::SetUpTestCase()
+{
+    vsyncGenerator = CreateVSyncGenerator();
+    rsDistributor = new VSyncDistributor(new VSyncController(vsyncGenerator, BASE_OFFSET), "rs");
+    appDistributor = new VSyncDistributor(new VSyncController(vsyncGenerator, BASE_OFFSET), "app");
+}
+
+void VSyncPhaseTunerTest::TearDownTestCase()
+{
+    rsDistributor = nullptr;
+    appDistributor = nullptr;
+    vsyncGenerator = nullptr;
+    DestroyVSyncGenerator();
+}
+
+namespace {
+/*
+* Function: ComputeOffsets001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call ComputeOffsets with short frames, the app flushes before the render service wakes up
+*                     and the render service commits before the next hardware vsync
+ */
+HWTEST_F(VSyncPhaseTunerTest, ComputeOffsets001, Function | MediumTest| Level3)
+{
+    const int64_t rsDuration = 4000000;
+    const int64_t appDuration = 5000000;
+    auto offsets = VSyncPhaseTuner::ComputeOffsets(PERIOD, BASE_OFFSET, rsDuration, appDuration);
+    ASSERT_GT(offsets.appOffset, 0);
+    ASSERT_GE(offsets.rsOffset - offsets.appOffset, appDuration);
+    ASSERT_LE(offsets.rsOffset + rsDuration, PERIOD);
+}
+
+/*
+* Function: ComputeOffsets002
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call ComputeOffsets without the durations or the period, the base offset is kept
+*                  2. call ComputeOffsets with frames which don't fit in one period, the base offset is kept
+ */
+HWTEST_F(VSyncPhaseTunerTest, ComputeOffsets002, Function | MediumTest| Level3)
+{
+    auto offsets = VSyncPhaseTuner::ComputeOffsets(0, BASE_OFFSET, 4000000, 5000000);
+    ASSERT_EQ(offsets.rsOffset, BASE_OFFSET);
+    ASSERT_EQ(offsets.appOffset, BASE_OFFSET);
+    offsets = VSyncPhaseTuner::ComputeOffsets(PERIOD, BASE_OFFSET, 0, 5000000);
+    ASSERT_EQ(offsets.rsOffset, BASE_OFFSET);
+    ASSERT_EQ(offsets.appOffset, BASE_OFFSET);
+    offsets = VSyncPhaseTuner::ComputeOffsets(PERIOD, BASE_OFFSET, 8000000, 8000000);
+    ASSERT_EQ(offsets.rsOffset, BASE_OFFSET);
+    ASSERT_EQ(offsets.appOffset, BASE_OFFSET);
+}
+
+/*
+* Function: OnFrameCommitted001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: 1. call OnFrameCommitted before any vsync is delivered, the base offset is kept
+ */
+HWTEST_F(VSyncPhaseTunerTest, OnFrameCommitted001, Function | MediumTest| Level3)
+{
+    VSyncPhaseTuner tuner(rsDistributor, appDistributor, BASE_OFFSET);
+    for (int i = 0; i < 100; i++) {
+        tuner.OnFrameCommitted();
+    }
+    ASSERT_EQ(tuner.GetOffsets().rsOffset, BASE_OFFSET);
+    ASSERT_EQ(tuner.GetOffsets().appOffset, BASE_OFFSET);
+}
+} // namespace
+} // namespace Rosen
+} // namespace OHOS
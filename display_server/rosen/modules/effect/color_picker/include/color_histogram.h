@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COLOR_HISTOGRAM_H
+#define COLOR_HISTOGRAM_H
+
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace Rosen {
+struct ColorSwatch {
+    uint32_t color = 0;             // ARGB
+    uint32_t population = 0;        // count of the sampled pixels of the color
+    float whiteContrast = 1.0f;     // contrast ratio against white, from 1 to 21
+    float blackContrast = 1.0f;     // contrast ratio against black, from 1 to 21
+};
+
+/*
+ * One pass over 32 bit pixels which sums the channels and counts the colors quantized to 5 bits per channel, with
+ * NEON or SSE2 where available. The palette is then cut from the histogram by median cut, so its cost doesn't
+ * depend on the size of the image. The buffers are allocated once, a ColorHistogram is not thread safe.
+ */
+class ColorHistogram {
+public:
+    static constexpr uint32_t MAX_PALETTE_SIZE = 16;
+
+    ColorHistogram();
+    ~ColorHistogram() = default;
+
+    // isBgra: the bytes of a pixel are B, G, R, A instead of R, G, B, A.
+    // only every stride-th pixel of every stride-th row is sampled.
+    void Build(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t rowBytes, bool isBgra,
+        uint32_t stride);
+    // the average of the sampled pixels, ARGB.
+    uint32_t GetAverageColor() const;
+    // at most maxCount colors of the pixels which are not transparent, the most populated first.
+    void GetPalette(uint32_t maxCount, std::vector<ColorSwatch>& swatches);
+
+private:
+    struct Box {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t population;
+        uint8_t min[3];
+        uint8_t max[3];
+    };
+
+    void AccumulateRow(const uint8_t* row, uint32_t width);
+    void FitBox(Box& box) const;
+    uint32_t SplitBox(Box& box);
+    ColorSwatch GetSwatch(const Box& box) const;
+
+    std::vector<uint32_t> bins_;
+    std::vector<uint16_t> colors_; // the non-empty opaque bins, reordered by the median cut.
+    uint64_t sums_[4] = { 0 };     // in the byte order of the pixels.
+    uint64_t count_ = 0;
+    bool isBgra_ = false;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // COLOR_HISTOGRAM_H
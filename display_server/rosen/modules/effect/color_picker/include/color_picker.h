@@ -17,6 +17,9 @@
 #define COLOR_PICKER_H
 
 #include <iostream>
+#include <mutex>
+#include <vector>
+#include "color_histogram.h"
 #include "effect_type.h"
 
 #ifdef __cplusplus
@@ -38,12 +41,21 @@ public:
                                                                        uint32_t &errorCode);
     NATIVEEXPORT std::shared_ptr<Media::PixelMap> GetScaledPixelMap();
     NATIVEEXPORT uint32_t GetMainColor(ColorManager::Color &color);
+    // the dominant colors, the most populated first, at most ColorHistogram::MAX_PALETTE_SIZE.
+    NATIVEEXPORT uint32_t GetPalette(uint32_t maxCount, std::vector<ColorSwatch> &swatches);
+    // only sample every stride-th pixel of every stride-th row, for large images.
+    NATIVEEXPORT void SetSampleStride(uint32_t stride);
 
 private:
     ColorPicker(std::shared_ptr<Media::PixelMap> pixmap);
+    // false if the pixel format is not 32 bit RGBA or BGRA.
+    bool BuildHistogram();
 
     // variables
     std::shared_ptr<Media::PixelMap> pixelmap_;
+    std::mutex histogramMutex_;
+    ColorHistogram histogram_; // guarded by histogramMutex_
+    uint32_t sampleStride_ = 1;
 };
 } // namespace Rosen
 } // namespace OHOS
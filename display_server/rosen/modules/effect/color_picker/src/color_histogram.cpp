@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "color_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define COLOR_HISTOGRAM_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define COLOR_HISTOGRAM_SSE2
+#endif
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr uint32_t BYTES_PER_PIXEL = 4;
+constexpr uint32_t CHANNELS = 4;
+constexpr uint32_t QUANTIZE_SHIFT = 3; // 8 bits to 5 bits
+constexpr uint32_t QUANTIZE_BITS = 5;
+constexpr uint32_t QUANTIZE_MASK = (1 << QUANTIZE_BITS) - 1;
+constexpr uint32_t OPAQUE_BINS = 1 << (QUANTIZE_BITS * 3);
+// the pixels with an alpha under MIN_ALPHA are counted here, out of the palette.
+constexpr uint32_t TRANSPARENT_BIN = OPAQUE_BINS;
+constexpr uint8_t MIN_ALPHA = 0x80;
+constexpr uint32_t ALPHA_INDEX = 3;
+
+inline uint32_t QuantizedIndex(const uint8_t* pixel)
+{
+    if (pixel[ALPHA_INDEX] < MIN_ALPHA) {
+        return TRANSPARENT_BIN;
+    }
+    return (static_cast<uint32_t>(pixel[0] >> QUANTIZE_SHIFT) << (QUANTIZE_BITS * 2)) |
+        (static_cast<uint32_t>(pixel[1] >> QUANTIZE_SHIFT) << QUANTIZE_BITS) |
+        static_cast<uint32_t>(pixel[2] >> QUANTIZE_SHIFT);
+}
+
+inline uint8_t Component(uint16_t index, uint32_t channel)
+{
+    return (index >> (QUANTIZE_BITS * (2 - channel))) & QUANTIZE_MASK;
+}
+
+// back to 8 bits, 31 is 255.
+inline uint32_t Expand(uint32_t quantized)
+{
+    return (quantized << QUANTIZE_SHIFT) | (quantized >> (QUANTIZE_BITS - QUANTIZE_SHIFT));
+}
+
+float Linearize(uint32_t channel)
+{
+    float c = channel / 255.0f;
+    return c <= 0.03928f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+// WCAG relative luminance of an ARGB color.
+float Luminance(uint32_t color)
+{
+    constexpr uint32_t RED_SHIFT = 16;
+    constexpr uint32_t GREEN_SHIFT = 8;
+    constexpr uint32_t BYTE_MASK = 0xFF;
+    return 0.2126f * Linearize((color >> RED_SHIFT) & BYTE_MASK) +
+        0.7152f * Linearize((color >> GREEN_SHIFT) & BYTE_MASK) + 0.0722f * Linearize(color & BYTE_MASK);
+}
+} // namespace
+
+ColorHistogram::ColorHistogram() : bins_(OPAQUE_BINS + 1, 0)
+{
+    colors_.reserve(OPAQUE_BINS);
+}
+
+void ColorHistogram::Build(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t rowBytes, bool isBgra,
+    uint32_t stride)
+{
+    std::fill(bins_.begin(), bins_.end(), 0);
+    std::fill(std::begin(sums_), std::end(sums_), 0);
+    count_ = 0;
+    isBgra_ = isBgra;
+    if (pixels == nullptr || rowBytes < width * BYTES_PER_PIXEL) {
+        return;
+    }
+    stride = std::max(stride, 1u);
+    for (uint32_t y = 0; y < height; y += stride) {
+        const uint8_t* row = pixels + static_cast<size_t>(y) * rowBytes;
+        if (stride == 1) {
+            AccumulateRow(row, width);
+            continue;
+        }
+        for (uint32_t x = 0; x < width; x += stride) {
+            const uint8_t* pixel = row + static_cast<size_t>(x) * BYTES_PER_PIXEL;
+            for (uint32_t c = 0; c < CHANNELS; c++) {
+                sums_[c] += pixel[c];
+            }
+            bins_[QuantizedIndex(pixel)]++;
+            count_++;
+        }
+    }
+}
+
+void ColorHistogram::AccumulateRow(const uint8_t* row, uint32_t width)
+{
+    uint32_t x = 0;
+#if defined(COLOR_HISTOGRAM_NEON)
+    constexpr uint32_t LANES = 16;
+    uint32x4_t acc[CHANNELS] = { vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0), vdupq_n_u32(0) };
+    uint16_t indices[LANES];
+    for (; x + LANES <= width; x += LANES) {
+        uint8x16x4_t px = vld4q_u8(row + x * BYTES_PER_PIXEL); // deinterleaved, one register per channel
+        for (uint32_t c = 0; c < CHANNELS; c++) {
+            acc[c] = vpadalq_u16(acc[c], vpaddlq_u8(px.val[c]));
+        }
+        uint8x16_t q0 = vshrq_n_u8(px.val[0], QUANTIZE_SHIFT);
+        uint8x16_t q1 = vshrq_n_u8(px.val[1], QUANTIZE_SHIFT);
+        uint8x16_t q2 = vshrq_n_u8(px.val[2], QUANTIZE_SHIFT);
+        uint8x16_t opaque = vcgeq_u8(px.val[ALPHA_INDEX], vdupq_n_u8(MIN_ALPHA));
+        uint16x8_t transparent = vdupq_n_u16(TRANSPARENT_BIN);
+        uint16x8_t lo = vorrq_u16(vorrq_u16(vshlq_n_u16(vmovl_u8(vget_low_u8(q0)), QUANTIZE_BITS * 2),
+            vshlq_n_u16(vmovl_u8(vget_low_u8(q1)), QUANTIZE_BITS)), vmovl_u8(vget_low_u8(q2)));
+        uint16x8_t hi = vorrq_u16(vorrq_u16(vshlq_n_u16(vmovl_u8(vget_high_u8(q0)), QUANTIZE_BITS * 2),
+            vshlq_n_u16(vmovl_u8(vget_high_u8(q1)), QUANTIZE_BITS)), vmovl_u8(vget_high_u8(q2)));
+        // sign extension widens the 0xff of the mask to 0xffff.
+        lo = vbslq_u16(vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vget_low_u8(opaque)))), lo, transparent);
+        hi = vbslq_u16(vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(vget_high_u8(opaque)))), hi, transparent);
+        vst1q_u16(indices, lo);
+        vst1q_u16(indices + LANES / 2, hi);
+        for (uint32_t i = 0; i < LANES; i++) {
+            bins_[indices[i]]++;
+        }
+    }
+    for (uint32_t c = 0; c < CHANNELS; c++) {
+        // no vaddvq_u32 on armv7.
+        sums_[c] += static_cast<uint64_t>(vgetq_lane_u32(acc[c], 0)) + vgetq_lane_u32(acc[c], 1) +
+            vgetq_lane_u32(acc[c], 2) + vgetq_lane_u32(acc[c], 3);
+    }
+    count_ += x;
+#elif defined(COLOR_HISTOGRAM_SSE2)
+    constexpr uint32_t LANES = 4;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i mask0 = _mm_set1_epi32(QUANTIZE_MASK << (QUANTIZE_BITS * 2));
+    const __m128i mask1 = _mm_set1_epi32(QUANTIZE_MASK << QUANTIZE_BITS);
+    const __m128i mask2 = _mm_set1_epi32(QUANTIZE_MASK);
+    const __m128i transparent = _mm_set1_epi32(TRANSPARENT_BIN);
+    __m128i acc = _mm_setzero_si128(); // one 32 bit lane per channel
+    alignas(16) uint32_t indices[LANES];
+    for (; x + LANES <= width; x += LANES) {
+        __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * BYTES_PER_PIXEL));
+        __m128i lo = _mm_unpacklo_epi8(px, zero);
+        __m128i hi = _mm_unpackhi_epi8(px, zero);
+        __m128i pair = _mm_add_epi16(lo, hi);
+        acc = _mm_add_epi32(acc, _mm_add_epi32(_mm_unpacklo_epi16(pair, zero), _mm_unpackhi_epi16(pair, zero)));
+        // the top 5 bits of byte 0 to bits 10-14, of byte 1 to bits 5-9, of byte 2 to bits 0-4.
+        __m128i index = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_slli_epi32(px, 7), mask0),
+            _mm_and_si128(_mm_srli_epi32(px, 6), mask1)), _mm_and_si128(_mm_srli_epi32(px, 19), mask2));
+        // the top bit of the alpha, spread over the lane.
+        __m128i opaque = _mm_srai_epi32(px, 31);
+        index = _mm_or_si128(_mm_and_si128(opaque, index), _mm_andnot_si128(opaque, transparent));
+        _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+        for (uint32_t i = 0; i < LANES; i++) {
+            bins_[indices[i]]++;
+        }
+    }
+    alignas(16) uint32_t sums[CHANNELS];
+    _mm_store_si128(reinterpret_cast<__m128i*>(sums), acc);
+    for (uint32_t c = 0; c < CHANNELS; c++) {
+        sums_[c] += sums[c];
+    }
+    count_ += x;
+#endif
+    for (; x < width; x++) {
+        const uint8_t* pixel = row + static_cast<size_t>(x) * BYTES_PER_PIXEL;
+        for (uint32_t c = 0; c < CHANNELS; c++) {
+            sums_[c] += pixel[c];
+        }
+        bins_[QuantizedIndex(pixel)]++;
+        count_++;
+    }
+}
+
+uint32_t ColorHistogram::GetAverageColor() const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    uint32_t average[CHANNELS];
+    for (uint32_t c = 0; c < CHANNELS; c++) {
+        average[c] = static_cast<uint32_t>((sums_[c] + count_ / 2) / count_);
+    }
+    uint32_t r = isBgra_ ? average[2] : average[0];
+    uint32_t b = isBgra_ ? average[0] : average[2];
+    return (average[ALPHA_INDEX] << 24) | (r << 16) | (average[1] << 8) | b;
+}
+
+void ColorHistogram::FitBox(Box& box) const
+{
+    box.population = 0;
+    for (uint32_t c = 0; c < 3; c++) {
+        box.min[c] = QUANTIZE_MASK;
+        box.max[c] = 0;
+    }
+    for (uint32_t i = box.begin; i < box.end; i++) {
+        uint16_t index = colors_[i];
+        box.population += bins_[index];
+        for (uint32_t c = 0; c < 3; c++) {
+            box.min[c] = std::min(box.min[c], Component(index, c));
+            box.max[c] = std::max(box.max[c], Component(index, c));
+        }
+    }
+}
+
+uint32_t ColorHistogram::SplitBox(Box& box)
+{
+    // along the longest side, at the median of the population.
+    uint32_t channel = 0;
+    for (uint32_t c = 1; c < 3; c++) {
+        if (box.max[c] - box.min[c] > box.max[channel] - box.min[channel]) {
+            channel = c;
+        }
+    }
+    std::sort(colors_.begin() + box.begin, colors_.begin() + box.end,
+        [channel](uint16_t lhs, uint16_t rhs) { return Component(lhs, channel) < Component(rhs, channel); });
+    uint32_t half = box.population / 2;
+    uint32_t population = 0;
+    uint32_t mid = box.begin + 1;
+    for (uint32_t i = box.begin; i < box.end - 1; i++) {
+        population += bins_[colors_[i]];
+        if (population >= half) {
+            mid = i + 1;
+            break;
+        }
+    }
+    return mid;
+}
+
+ColorSwatch ColorHistogram::GetSwatch(const Box& box) const
+{
+    uint64_t sums[3] = { 0 };
+    for (uint32_t i = box.begin; i < box.end; i++) {
+        uint16_t index = colors_[i];
+        for (uint32_t c = 0; c < 3; c++) {
+            sums[c] += static_cast<uint64_t>(bins_[index]) * Expand(Component(index, c));
+        }
+    }
+    uint32_t channels[3];
+    for (uint32_t c = 0; c < 3; c++) {
+        channels[c] = static_cast<uint32_t>((sums[c] + box.population / 2) / box.population);
+    }
+    uint32_t r = isBgra_ ? channels[2] : channels[0];
+    uint32_t b = isBgra_ ? channels[0] : channels[2];
+
+    ColorSwatch swatch;
+    swatch.color = 0xFF000000 | (r << 16) | (channels[1] << 8) | b;
+    swatch.population = box.population;
+    float luminance = Luminance(swatch.color);
+    swatch.whiteContrast = 1.05f / (luminance + 0.05f);
+    swatch.blackContrast = (luminance + 0.05f) / 0.05f;
+    return swatch;
+}
+
+void ColorHistogram::GetPalette(uint32_t maxCount, std::vector<ColorSwatch>& swatches)
+{
+    swatches.clear();
+    maxCount = std::min(maxCount, MAX_PALETTE_SIZE);
+    colors_.clear();
+    for (uint32_t index = 0; index < OPAQUE_BINS; index++) {
+        if (bins_[index] != 0) {
+            colors_.push_back(static_cast<uint16_t>(index));
+        }
+    }
+    if (maxCount == 0 || colors_.empty()) {
+        return;
+    }
+
+    Box boxes[MAX_PALETTE_SIZE];
+    uint32_t boxCount = 1;
+    boxes[0].begin = 0;
+    boxes[0].end = static_cast<uint32_t>(colors_.size());
+    FitBox(boxes[0]);
+    while (boxCount < maxCount) {
+        // split the largest box in the color space which has more than one color.
+        Box* largest = nullptr;
+        uint32_t largestVolume = 0;
+        for (uint32_t i = 0; i < boxCount; i++) {
+            if (boxes[i].end - boxes[i].begin < 2) {
+                continue;
+            }
+            uint32_t volume = 1;
+            for (uint32_t c = 0; c < 3; c++) {
+                volume *= static_cast<uint32_t>(boxes[i].max[c] - boxes[i].min[c] + 1);
+            }
+            if (volume > largestVolume) {
+                largest = &boxes[i];
+                largestVolume = volume;
+            }
+        }
+        if (largest == nullptr) {
+            break;
+        }
+        Box& next = boxes[boxCount++];
+        next.begin = SplitBox(*largest);
+        next.end = largest->end;
+        largest->end = next.begin;
+        FitBox(*largest);
+        FitBox(next);
+    }
+
+    for (uint32_t i = 0; i < boxCount; i++) {
+        swatches.push_back(GetSwatch(boxes[i]));
+    }
+    std::sort(swatches.begin(), swatches.end(),
+        [](const ColorSwatch& lhs, const ColorSwatch& rhs) { return lhs.population > rhs.population; });
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -14,6 +14,7 @@
  */
 
 #include "color_picker.h"
+#include <algorithm>
 #include "hilog/log.h"
 #include "effect_errors.h"
 #include "effect_utils.h"
@@ -73,11 +74,32 @@ std::shared_ptr<Media::PixelMap> ColorPicker::GetScaledPixelMap()
     return std::move(newPixelMap);
 }
 
+bool ColorPicker::BuildHistogram()
+{
+    auto format = pixelmap_->GetPixelFormat();
+    if ((format != Media::PixelFormat::RGBA_8888 && format != Media::PixelFormat::BGRA_8888) ||
+        pixelmap_->GetPixels() == nullptr || pixelmap_->GetWidth() <= 0 || pixelmap_->GetHeight() <= 0) {
+        return false;
+    }
+    histogram_.Build(pixelmap_->GetPixels(), static_cast<uint32_t>(pixelmap_->GetWidth()),
+        static_cast<uint32_t>(pixelmap_->GetHeight()), static_cast<uint32_t>(pixelmap_->GetRowBytes()),
+        format == Media::PixelFormat::BGRA_8888, sampleStride_);
+    return true;
+}
+
 uint32_t ColorPicker::GetMainColor(ColorManager::Color &color)
 {
     if (pixelmap_ == nullptr) {
         return ERR_EFFECT_INVALID_VALUE;
     }
+    {
+        // average the pixels in place, instead of resampling them into a new pixelmap.
+        std::lock_guard<std::mutex> lock(histogramMutex_);
+        if (BuildHistogram()) {
+            color = ColorManager::Color(histogram_.GetAverageColor());
+            return SUCCESS;
+        }
+    }
     std::shared_ptr<Media::PixelMap> pixelMap = GetScaledPixelMap();
 
     // get color
@@ -90,6 +112,26 @@ uint32_t ColorPicker::GetMainColor(ColorManager::Color &color)
     return SUCCESS;
 }
 
+uint32_t ColorPicker::GetPalette(uint32_t maxCount, std::vector<ColorSwatch> &swatches)
+{
+    if (pixelmap_ == nullptr) {
+        return ERR_EFFECT_INVALID_VALUE;
+    }
+    std::lock_guard<std::mutex> lock(histogramMutex_);
+    if (!BuildHistogram()) {
+        HiLog::Info(LABEL, "[ColorPicker]unsupported pixel format %{public}d.",
+            static_cast<int>(pixelmap_->GetPixelFormat()));
+        return ERR_EFFECT_INVALID_VALUE;
+    }
+    histogram_.GetPalette(maxCount, swatches);
+    return SUCCESS;
+}
+
+void ColorPicker::SetSampleStride(uint32_t stride)
+{
+    std::lock_guard<std::mutex> lock(histogramMutex_);
+    sampleStride_ = std::max(stride, 1u);
+}
 
 ColorPicker::ColorPicker(std::shared_ptr<Media::PixelMap> pixmap)
 {
@@ -35,11 +35,17 @@ protected:
     virtual std::string GetFragmentShader() = 0;
     virtual void LoadFilterParams() = 0;
     virtual void DoProcess(ProcessData& data) override;
+    // the filter on the pixels in memory, the result is written to dstPixels.
+    virtual void DoProcessCpu(ProcessData& data);
     virtual void Prepare(ProcessData& data);
     virtual void Draw(ProcessData& data);
     virtual void CreateProgram(const std::string& vertexString, const std::string& fragmentString);
     std::shared_ptr<Program> program_ = nullptr;
     std::shared_ptr<Mesh> mesh_ = nullptr;
+
+private:
+    std::string vertexString_;
+    std::string fragmentString_;
 };
 } // namespace Rosen
 } // namespace OHOS
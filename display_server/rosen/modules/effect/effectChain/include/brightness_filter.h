@@ -32,6 +32,7 @@ public:
 
 private:
     void LoadFilterParams() override;
+    void DoProcessCpu(ProcessData& data) override;
     float brightness_ = DEFAULT_BRIGHTNESS;
     GLint brightnessID_ = 0;
 };
@@ -33,6 +33,7 @@ namespace OHOS {
 namespace Rosen {
 class Builder {
 public:
+    // the chain renders on the CPU when no EGL context is current on the calling thread.
     ImageChain* CreateFromConfig(std::string path);
 
 private:
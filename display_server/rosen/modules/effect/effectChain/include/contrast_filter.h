@@ -32,6 +32,7 @@ public:
 
 private:
     void LoadFilterParams() override;
+    void DoProcessCpu(ProcessData& data) override;
     float contrast_ = DEFAULT_CONTRAST;
     GLint contrastID_ = 0;
 };
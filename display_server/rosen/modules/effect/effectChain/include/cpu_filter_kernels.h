@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CPU_FILTER_KERNELS_H
+#define CPU_FILTER_KERNELS_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * The raster kernels the filters run when no EGL context is current. The images are tightly packed RGBA8888, the
+ * layout the GL path uploads and reads back. A pixel is processed as one vector of four floats with NEON or SSE2
+ * where available, and the rows are split into stripes which run on the WorkerPool of the process.
+ */
+class CpuFilterKernels {
+public:
+    static constexpr int COLOR_CHANNEL = 4;
+    static constexpr int COLOR_MATRIX_SIZE = 12;
+    static constexpr int MAX_BLUR_RADIUS = 64;
+    static constexpr int STRIPE_HEIGHT = 32;
+
+    // three rows for the red, green and blue outputs, each of the weights of r, g, b and an offset in 0~255.
+    // the alpha is kept.
+    static void ColorMatrix(const uint8_t* src, uint8_t* dst, int width, int height,
+        const float (&matrix)[COLOR_MATRIX_SIZE]);
+    // the shaders sample between two texels at each offset, which is expanded here into 2 * radius + 1 weights
+    // of whole texels.
+    static std::vector<float> ExpandBlurTaps(const float* weight, const float* offset, int count);
+    // the blurs clamp to the edges and write an opaque alpha, like the shaders.
+    static void HorizontalBlur(const uint8_t* src, uint8_t* dst, int width, int height,
+        const std::vector<float>& taps);
+    static void VerticalBlur(const uint8_t* src, uint8_t* dst, int width, int height,
+        const std::vector<float>& taps);
+    // both passes stripe by stripe, the horizontally blurred rows of a stripe stay in the cache for the vertical one.
+    static void SeparableBlur(const uint8_t* src, uint8_t* dst, int width, int height,
+        const std::vector<float>& horizontalTaps, const std::vector<float>& verticalTaps);
+    // bilinear at the texel centers, like the sampler of the GL path.
+    static void Resize(const uint8_t* src, int srcWidth, int srcHeight, uint8_t* dst, int dstWidth, int dstHeight);
+    // calls task(begin, end) for the stripes of the rows, on the caller and the threads of the WorkerPool.
+    static void ParallelStripes(int height, int stripeHeight, const std::function<void(int, int)>& task);
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // CPU_FILTER_KERNELS_H
@@ -36,6 +36,14 @@ struct ProcessData {
     GLuint frameBufferID;
     int textureWidth;
     int textureHeight;
+    // set when the chain renders without an EGL context, the images are RGBA8888 in memory instead of textures.
+    std::vector<uint8_t>* srcPixels = nullptr;
+    std::vector<uint8_t>* dstPixels = nullptr;
+
+    bool IsCpu() const
+    {
+        return srcPixels != nullptr && dstPixels != nullptr;
+    }
 };
 
 class Filter {
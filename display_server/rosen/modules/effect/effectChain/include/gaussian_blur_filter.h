@@ -35,11 +35,14 @@ public:
     std::string GetFragmentShader() override;
 private:
     void DoProcess(ProcessData& data) override;
+    void DoProcessCpu(ProcessData& data) override;
     void LoadFilterParams() override {};
     ScaleFilter* upSampleFilter_ = nullptr;
     ScaleFilter* downSampleFilter_ = nullptr;
     HorizontalBlurFilter* horizontalBlurFilter_ = nullptr;
     VerticalBlurFilter* verticalBlurFilter_ = nullptr;
+    std::vector<uint8_t> downSampledPixels_;
+    std::vector<uint8_t> blurredPixels_;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -35,9 +35,12 @@ public:
     void SetValue(const std::string& key, std::shared_ptr<void> value, int size) override;
     std::string GetFragmentShader() override;
     std::string GetVertexShader() override;
+    // the weights of whole texels the CPU path convolves with.
+    std::vector<float> GetTaps() const;
 
 private:
     void LoadFilterParams() override;
+    void DoProcessCpu(ProcessData& data) override;
     GLint weightID_ = 0;
     GLint offsetID_ = 0;
     float weight_[RADIUS] = {DEFAULT_WEIGHT_ONE, DEFAULT_WEIGHT_TWO, DEFAULT_WEIGHT_THREE};
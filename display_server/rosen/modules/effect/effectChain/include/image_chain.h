@@ -24,7 +24,8 @@ namespace OHOS {
 namespace Rosen {
 class ImageChain {
 public:
-    ImageChain(std::vector<std::shared_ptr<Input>> inputs);
+    // useCpu: the filters run on the pixels in memory, for when there is no EGL context.
+    ImageChain(std::vector<std::shared_ptr<Input>> inputs, bool useCpu = false);
     virtual ~ImageChain() {};
     bool Render();
 
@@ -33,10 +34,13 @@ private:
     bool SeriesRendering(ProcessData& data);
     bool ParallelRendering();
     bool flagSeries_ = false;
-    unsigned int frameBufferID_;
-    unsigned int srcTextureID_;
-    unsigned int dstTextureID_;
+    bool useCpu_ = false;
+    unsigned int frameBufferID_ = 0;
+    unsigned int srcTextureID_ = 0;
+    unsigned int dstTextureID_ = 0;
     std::vector<std::shared_ptr<Input>> inputs_;
+    std::vector<uint8_t> srcPixels_;
+    std::vector<uint8_t> dstPixels_;
 };
 } // namespace Rosen
 } // namespace OHOS
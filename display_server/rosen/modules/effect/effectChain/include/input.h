@@ -28,6 +28,7 @@ namespace OHOS {
 namespace Rosen {
 class Input : public Filter {
 public:
+    static constexpr int COLOR_CHANNEL = 4;
     Input() {};
     virtual ~Input() {};
     void SetValue(const std::string& key, std::shared_ptr<void> value, int size) override;
@@ -38,6 +39,8 @@ protected:
     void DecodeFromFile(ProcessData& data);
     void DecodeFromPixelMap(ProcessData& data);
     void DecodeFromBuffer(ProcessData& data);
+    // the CPU path takes the pixels as they are, RGBA8888 like the GL path uploads them.
+    void CopyToPixels(ProcessData& data, const uint8_t* pixels, int rowBytes);
     std::string format_;
     std::string srcImagePath_;
     std::shared_ptr<OHOS::Media::PixelMap> pixelMap_ = nullptr;
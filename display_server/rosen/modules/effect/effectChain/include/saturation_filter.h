@@ -33,6 +33,7 @@ public:
 
 private:
     void LoadFilterParams() override;
+    void DoProcessCpu(ProcessData& data) override;
     float saturation_ = DEFAULT_SATURATION;
     GLint saturationID_ = 0;
 };
@@ -19,12 +19,11 @@ namespace OHOS {
 namespace Rosen {
 AlgoFilter::AlgoFilter()
 {
-    mesh_ = std::make_shared<Mesh>();
-    mesh_->Use();
 }
 
 void AlgoFilter::Prepare(ProcessData& data)
 {
+#ifdef EFFECT_ENABLE_GPU
     glBindTexture(GL_TEXTURE_2D, data.dstTextureID);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.textureWidth, data.textureHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
     glBindFramebuffer(GL_FRAMEBUFFER, data.frameBufferID);
@@ -32,30 +31,44 @@ void AlgoFilter::Prepare(ProcessData& data)
     glViewport(0, 0, data.textureWidth, data.textureHeight);
     glClearColor(1.0f, 0.0f, 0.0f, 0.0f);
     glClear(GL_COLOR_BUFFER_BIT);
+#endif
 }
 
 void AlgoFilter::Draw(ProcessData& data)
 {
+#ifdef EFFECT_ENABLE_GPU
     Use();
     glBindVertexArray(mesh_->VAO_);
     glBindTexture(GL_TEXTURE_2D, data.srcTextureID);
     glDrawElements(GL_TRIANGLES, DRAW_ELEMENTS_NUMBER, GL_UNSIGNED_INT, 0);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+#endif
 }
 
 void AlgoFilter::CreateProgram(const std::string& vertexString, const std::string& fragmentString)
 {
-    program_ = std::make_shared<Program>();
-    program_->Compile(vertexString, fragmentString);
+    // compiled on the first use, there is no GL context when the chain renders on the CPU.
+    vertexString_ = vertexString;
+    fragmentString_ = fragmentString;
 }
 
 void AlgoFilter::Use()
 {
+#ifdef EFFECT_ENABLE_GPU
+    if (program_ == nullptr && !vertexString_.empty()) {
+        program_ = std::make_shared<Program>();
+        program_->Compile(vertexString_, fragmentString_);
+    }
+    if (mesh_ == nullptr) {
+        mesh_ = std::make_shared<Mesh>();
+        mesh_->Use();
+    }
     if (program_ == nullptr) {
         LOGD("The AlgoFilter Use Program Faild!");
         return;
     }
     program_->UseProgram();
+#endif
 }
 
 FILTER_TYPE AlgoFilter::GetFilterType()
@@ -65,9 +78,20 @@ FILTER_TYPE AlgoFilter::GetFilterType()
 
 void AlgoFilter::DoProcess(ProcessData& data)
 {
+    if (data.IsCpu()) {
+        data.dstPixels->resize(data.srcPixels->size());
+        DoProcessCpu(data);
+        return;
+    }
     Prepare(data);
     LoadFilterParams();
     Draw(data);
 }
+
+void AlgoFilter::DoProcessCpu(ProcessData& data)
+{
+    LOGW("The filter has no CPU implementation, the image is passed through.");
+    *data.dstPixels = *data.srcPixels;
+}
 } // namespcae Rosen
 } // namespace OHOS
\ No newline at end of file
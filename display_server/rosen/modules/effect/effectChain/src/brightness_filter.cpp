@@ -14,6 +14,7 @@
  */
 
 #include "brightness_filter.h"
+#include "cpu_filter_kernels.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -33,9 +34,23 @@ void BrightnessFilter::SetValue(const std::string& key, std::shared_ptr<void> va
 
 void BrightnessFilter::LoadFilterParams()
 {
+#ifdef EFFECT_ENABLE_GPU
     Use();
     brightnessID_ = glGetUniformLocation(program_->programID_, "brightness");
     glUniform1f(brightnessID_, brightness_);
+#endif
+}
+
+void BrightnessFilter::DoProcessCpu(ProcessData& data)
+{
+    float offset = brightness_ * 255.0f;
+    const float matrix[CpuFilterKernels::COLOR_MATRIX_SIZE] = {
+        1.0f, 0.0f, 0.0f, offset,
+        0.0f, 1.0f, 0.0f, offset,
+        0.0f, 0.0f, 1.0f, offset,
+    };
+    CpuFilterKernels::ColorMatrix(data.srcPixels->data(), data.dstPixels->data(), data.textureWidth,
+        data.textureHeight, matrix);
 }
 
 std::string BrightnessFilter::GetVertexShader()
@@ -13,6 +13,9 @@
  * limitations under the License.
  */
 
+#ifdef EFFECT_ENABLE_GPU
+#include <EGL/egl.h>
+#endif
 #include "filter_factory.h"
 #include "ec_log.h"
 #include "builder.h"
@@ -47,7 +50,15 @@ ImageChain* Builder::CreateFromConfig(std::string path)
         return nullptr;
     }
     if (inputs_.size() != 0) {
-        return new ImageChain(inputs_);
+#ifdef EFFECT_ENABLE_GPU
+        bool useCpu = eglGetCurrentContext() == EGL_NO_CONTEXT;
+#else
+        bool useCpu = true;
+#endif
+        if (useCpu) {
+            LOGI("No EGL context, the image chain renders on the CPU.");
+        }
+        return new ImageChain(inputs_, useCpu);
     } else {
         LOGE("No input.");
         return nullptr;
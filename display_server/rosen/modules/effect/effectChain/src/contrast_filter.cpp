@@ -14,6 +14,7 @@
  */
 
 #include "contrast_filter.h"
+#include "cpu_filter_kernels.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -33,9 +34,24 @@ void ContrastFilter::SetValue(const std::string& key, std::shared_ptr<void> valu
 
 void ContrastFilter::LoadFilterParams()
 {
+#ifdef EFFECT_ENABLE_GPU
     Use();
     contrastID_ = glGetUniformLocation(program_->programID_, "contrast");
     glUniform1f(contrastID_, contrast_);
+#endif
+}
+
+void ContrastFilter::DoProcessCpu(ProcessData& data)
+{
+    // (color - 0.5) * contrast + 0.5, in 0~255.
+    float offset = 127.5f * (1.0f - contrast_);
+    const float matrix[CpuFilterKernels::COLOR_MATRIX_SIZE] = {
+        contrast_, 0.0f, 0.0f, offset,
+        0.0f, contrast_, 0.0f, offset,
+        0.0f, 0.0f, contrast_, offset,
+    };
+    CpuFilterKernels::ColorMatrix(data.srcPixels->data(), data.dstPixels->data(), data.textureWidth,
+        data.textureHeight, matrix);
 }
 
 std::string ContrastFilter::GetVertexShader()
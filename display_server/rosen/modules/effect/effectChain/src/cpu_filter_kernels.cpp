@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_filter_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define CPU_FILTER_KERNELS_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define CPU_FILTER_KERNELS_SSE2
+#endif
+
+#include "worker_pool.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr int CHANNEL = CpuFilterKernels::COLOR_CHANNEL;
+constexpr int RED = 0;
+constexpr int GREEN = 1;
+constexpr int BLUE = 2;
+constexpr int ALPHA = 3;
+constexpr uint8_t OPAQUE = 255;
+constexpr float MAX_COLOR = 255.0f;
+constexpr float HALF = 0.5f;
+
+// one pixel, r, g, b and a in 0~255.
+#if defined(CPU_FILTER_KERNELS_NEON)
+using Float4 = float32x4_t;
+
+inline Float4 Splat(float value)
+{
+    return vdupq_n_f32(value);
+}
+
+inline Float4 LoadPixel(const uint8_t* pixel)
+{
+    uint32_t value;
+    memcpy(&value, pixel, sizeof(value));
+    uint16x8_t wide = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(value)));
+    return vcvtq_f32_u32(vmovl_u16(vget_low_u16(wide)));
+}
+
+inline void StorePixel(uint8_t* pixel, Float4 color)
+{
+    color = vminq_f32(vmaxq_f32(vaddq_f32(color, vdupq_n_f32(HALF)), vdupq_n_f32(0.0f)), vdupq_n_f32(MAX_COLOR));
+    uint16x4_t narrow = vmovn_u32(vcvtq_u32_f32(color));
+    uint32_t value = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(narrow, narrow))), 0);
+    memcpy(pixel, &value, sizeof(value));
+}
+
+inline Float4 LoadFloat(const float* data)
+{
+    return vld1q_f32(data);
+}
+
+inline void StoreFloat(float* data, Float4 color)
+{
+    vst1q_f32(data, color);
+}
+
+inline Float4 MulAdd(Float4 acc, Float4 a, float b)
+{
+    return vmlaq_n_f32(acc, a, b);
+}
+
+inline Float4 MulAdd(Float4 acc, Float4 a, Float4 b)
+{
+    return vmlaq_f32(acc, a, b);
+}
+
+template<int lane>
+inline Float4 Broadcast(Float4 color)
+{
+    return vdupq_n_f32(vgetq_lane_f32(color, lane));
+}
+#elif defined(CPU_FILTER_KERNELS_SSE2)
+using Float4 = __m128;
+
+inline Float4 Splat(float value)
+{
+    return _mm_set1_ps(value);
+}
+
+inline Float4 LoadPixel(const uint8_t* pixel)
+{
+    int32_t value;
+    memcpy(&value, pixel, sizeof(value));
+    __m128i zero = _mm_setzero_si128();
+    __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero);
+    return _mm_cvtepi32_ps(wide);
+}
+
+inline void StorePixel(uint8_t* pixel, Float4 color)
+{
+    color = _mm_min_ps(_mm_max_ps(_mm_add_ps(color, _mm_set1_ps(HALF)), _mm_setzero_ps()), _mm_set1_ps(MAX_COLOR));
+    __m128i narrow = _mm_packs_epi32(_mm_cvttps_epi32(color), _mm_setzero_si128());
+    int32_t value = _mm_cvtsi128_si32(_mm_packus_epi16(narrow, narrow));
+    memcpy(pixel, &value, sizeof(value));
+}
+
+inline Float4 LoadFloat(const float* data)
+{
+    return _mm_loadu_ps(data);
+}
+
+inline void StoreFloat(float* data, Float4 color)
+{
+    _mm_storeu_ps(data, color);
+}
+
+inline Float4 MulAdd(Float4 acc, Float4 a, float b)
+{
+    return _mm_add_ps(acc, _mm_mul_ps(a, _mm_set1_ps(b)));
+}
+
+inline Float4 MulAdd(Float4 acc, Float4 a, Float4 b)
+{
+    return _mm_add_ps(acc, _mm_mul_ps(a, b));
+}
+
+template<int lane>
+inline Float4 Broadcast(Float4 color)
+{
+    return _mm_shuffle_ps(color, color, _MM_SHUFFLE(lane, lane, lane, lane));
+}
+#else
+struct Float4 {
+    float v[CHANNEL];
+};
+
+inline Float4 Splat(float value)
+{
+    return { { value, value, value, value } };
+}
+
+inline Float4 LoadPixel(const uint8_t* pixel)
+{
+    return { { static_cast<float>(pixel[RED]), static_cast<float>(pixel[GREEN]), static_cast<float>(pixel[BLUE]),
+        static_cast<float>(pixel[ALPHA]) } };
+}
+
+inline void StorePixel(uint8_t* pixel, Float4 color)
+{
+    for (int i = 0; i < CHANNEL; i++) {
+        pixel[i] = static_cast<uint8_t>(std::clamp(color.v[i] + HALF, 0.0f, MAX_COLOR));
+    }
+}
+
+inline Float4 LoadFloat(const float* data)
+{
+    return { { data[RED], data[GREEN], data[BLUE], data[ALPHA] } };
+}
+
+inline void StoreFloat(float* data, Float4 color)
+{
+    memcpy(data, color.v, sizeof(color.v));
+}
+
+inline Float4 MulAdd(Float4 acc, Float4 a, float b)
+{
+    for (int i = 0; i < CHANNEL; i++) {
+        acc.v[i] += a.v[i] * b;
+    }
+    return acc;
+}
+
+inline Float4 MulAdd(Float4 acc, Float4 a, Float4 b)
+{
+    for (int i = 0; i < CHANNEL; i++) {
+        acc.v[i] += a.v[i] * b.v[i];
+    }
+    return acc;
+}
+
+template<int lane>
+inline Float4 Broadcast(Float4 color)
+{
+    return Splat(color.v[lane]);
+}
+#endif
+
+// the scratch rows of the thread, the stripes run on the persistent workers of the WorkerPool so they are allocated
+// once per thread rather than per call.
+std::vector<float>& GetScratch(int index, size_t size)
+{
+    static constexpr int SCRATCH_COUNT = 2;
+    thread_local std::vector<float> scratch[SCRATCH_COUNT];
+    if (scratch[index].size() < size) {
+        scratch[index].resize(size);
+    }
+    return scratch[index];
+}
+
+inline int ClampIndex(int index, int size)
+{
+    return std::clamp(index, 0, size - 1);
+}
+
+inline int GetRadius(const std::vector<float>& taps)
+{
+    return static_cast<int>(taps.size() / 2);
+}
+
+void BlurRowHorizontal(const uint8_t* src, float* dst, int width, const std::vector<float>& taps)
+{
+    int radius = GetRadius(taps);
+    int tapCount = static_cast<int>(taps.size());
+    for (int x = 0; x < width; x++) {
+        Float4 acc = Splat(0.0f);
+        if (x >= radius && x + radius < width) {
+            const uint8_t* pixel = src + (x - radius) * CHANNEL;
+            for (int t = 0; t < tapCount; t++) {
+                acc = MulAdd(acc, LoadPixel(pixel + t * CHANNEL), taps[t]);
+            }
+        } else {
+            for (int t = 0; t < tapCount; t++) {
+                acc = MulAdd(acc, LoadPixel(src + ClampIndex(x + t - radius, width) * CHANNEL), taps[t]);
+            }
+        }
+        StoreFloat(dst + x * CHANNEL, acc);
+    }
+}
+
+void AccumulateRow(float* acc, const uint8_t* row, int width, float tap)
+{
+    for (int x = 0; x < width; x++) {
+        StoreFloat(acc + x * CHANNEL, MulAdd(LoadFloat(acc + x * CHANNEL), LoadPixel(row + x * CHANNEL), tap));
+    }
+}
+
+void AccumulateRow(float* acc, const float* row, int width, float tap)
+{
+    for (int x = 0; x < width; x++) {
+        StoreFloat(acc + x * CHANNEL, MulAdd(LoadFloat(acc + x * CHANNEL), LoadFloat(row + x * CHANNEL), tap));
+    }
+}
+
+void StoreOpaqueRow(const float* row, uint8_t* dst, int width)
+{
+    for (int x = 0; x < width; x++) {
+        StorePixel(dst + x * CHANNEL, LoadFloat(row + x * CHANNEL));
+        dst[x * CHANNEL + ALPHA] = OPAQUE;
+    }
+}
+} // namespace
+
+void CpuFilterKernels::ColorMatrix(const uint8_t* src, uint8_t* dst, int width, int height,
+    const float (&matrix)[COLOR_MATRIX_SIZE])
+{
+    // the columns of the matrix, so that a pixel is the sum of the columns scaled by its channels.
+    constexpr int ROW = 4;
+    float columns[CHANNEL + 1][CHANNEL] = {};
+    for (int i = 0; i <= BLUE; i++) {
+        columns[RED][i] = matrix[i * ROW + RED];
+        columns[GREEN][i] = matrix[i * ROW + GREEN];
+        columns[BLUE][i] = matrix[i * ROW + BLUE];
+        columns[CHANNEL][i] = matrix[i * ROW + ALPHA];
+    }
+    columns[ALPHA][ALPHA] = 1.0f;
+    Float4 red = LoadFloat(columns[RED]);
+    Float4 green = LoadFloat(columns[GREEN]);
+    Float4 blue = LoadFloat(columns[BLUE]);
+    Float4 alpha = LoadFloat(columns[ALPHA]);
+    Float4 offset = LoadFloat(columns[CHANNEL]);
+    ParallelStripes(height, STRIPE_HEIGHT, [&](int begin, int end) {
+        for (size_t i = static_cast<size_t>(begin) * width; i < static_cast<size_t>(end) * width; i++) {
+            Float4 color = LoadPixel(src + i * CHANNEL);
+            Float4 result = MulAdd(offset, red, Broadcast<RED>(color));
+            result = MulAdd(result, green, Broadcast<GREEN>(color));
+            result = MulAdd(result, blue, Broadcast<BLUE>(color));
+            result = MulAdd(result, alpha, Broadcast<ALPHA>(color));
+            StorePixel(dst + i * CHANNEL, result);
+        }
+    });
+}
+
+std::vector<float> CpuFilterKernels::ExpandBlurTaps(const float* weight, const float* offset, int count)
+{
+    int radius = 0;
+    for (int i = 1; i < count; i++) {
+        float distance = std::min(std::fabs(offset[i]), static_cast<float>(MAX_BLUR_RADIUS));
+        radius = std::max(radius, static_cast<int>(std::ceil(distance)));
+    }
+    std::vector<float> taps(2 * radius + 1, 0.0f);
+    if (count <= 0) {
+        return taps;
+    }
+    // like the shaders, the first weight is of the center and its offset isn't used.
+    taps[radius] += weight[0];
+    for (int i = 1; i < count; i++) {
+        float distance = std::min(std::fabs(offset[i]), static_cast<float>(MAX_BLUR_RADIUS));
+        int near = static_cast<int>(std::floor(distance));
+        float fraction = distance - near;
+        taps[radius + near] += weight[i] * (1.0f - fraction);
+        taps[radius - near] += weight[i] * (1.0f - fraction);
+        if (fraction > 0.0f) {
+            taps[radius + near + 1] += weight[i] * fraction;
+            taps[radius - near - 1] += weight[i] * fraction;
+        }
+    }
+    return taps;
+}
+
+void CpuFilterKernels::HorizontalBlur(const uint8_t* src, uint8_t* dst, int width, int height,
+    const std::vector<float>& taps)
+{
+    size_t stride = static_cast<size_t>(width) * CHANNEL;
+    ParallelStripes(height, STRIPE_HEIGHT, [&](int begin, int end) {
+        float* row = GetScratch(0, stride).data();
+        for (int y = begin; y < end; y++) {
+            BlurRowHorizontal(src + y * stride, row, width, taps);
+            StoreOpaqueRow(row, dst + y * stride, width);
+        }
+    });
+}
+
+void CpuFilterKernels::VerticalBlur(const uint8_t* src, uint8_t* dst, int width, int height,
+    const std::vector<float>& taps)
+{
+    size_t stride = static_cast<size_t>(width) * CHANNEL;
+    int radius = GetRadius(taps);
+    ParallelStripes(height, STRIPE_HEIGHT, [&](int begin, int end) {
+        float* acc = GetScratch(0, stride).data();
+        for (int y = begin; y < end; y++) {
+            std::fill(acc, acc + stride, 0.0f);
+            for (size_t t = 0; t < taps.size(); t++) {
+                AccumulateRow(acc, src + ClampIndex(y + static_cast<int>(t) - radius, height) * stride, width,
+                    taps[t]);
+            }
+            StoreOpaqueRow(acc, dst + y * stride, width);
+        }
+    });
+}
+
+void CpuFilterKernels::SeparableBlur(const uint8_t* src, uint8_t* dst, int width, int height,
+    const std::vector<float>& horizontalTaps, const std::vector<float>& verticalTaps)
+{
+    size_t stride = static_cast<size_t>(width) * CHANNEL;
+    int radius = GetRadius(verticalTaps);
+    ParallelStripes(height, STRIPE_HEIGHT, [&](int begin, int end) {
+        // the rows from begin - radius to end + radius, clamped to the image.
+        int rowCount = end - begin + 2 * radius;
+        float* rows = GetScratch(0, rowCount * stride).data();
+        float* acc = GetScratch(1, stride).data();
+        for (int i = 0; i < rowCount; i++) {
+            BlurRowHorizontal(src + ClampIndex(begin - radius + i, height) * stride, rows + i * stride, width,
+                horizontalTaps);
+        }
+        for (int y = begin; y < end; y++) {
+            std::fill(acc, acc + stride, 0.0f);
+            for (size_t t = 0; t < verticalTaps.size(); t++) {
+                AccumulateRow(acc, rows + (y - begin + t) * stride, width, verticalTaps[t]);
+            }
+            StoreOpaqueRow(acc, dst + y * stride, width);
+        }
+    });
+}
+
+void CpuFilterKernels::Resize(const uint8_t* src, int srcWidth, int srcHeight, uint8_t* dst, int dstWidth,
+    int dstHeight)
+{
+    if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0) {
+        return;
+    }
+    std::vector<int> columns(dstWidth);
+    std::vector<float> fractions(dstWidth);
+    float scaleX = static_cast<float>(srcWidth) / dstWidth;
+    for (int x = 0; x < dstWidth; x++) {
+        float srcX = std::max((x + HALF) * scaleX - HALF, 0.0f);
+        columns[x] = std::min(static_cast<int>(srcX), srcWidth - 1);
+        fractions[x] = srcX - columns[x];
+    }
+    float scaleY = static_cast<float>(srcHeight) / dstHeight;
+    size_t srcStride = static_cast<size_t>(srcWidth) * CHANNEL;
+    size_t dstStride = static_cast<size_t>(dstWidth) * CHANNEL;
+    ParallelStripes(dstHeight, STRIPE_HEIGHT, [&](int begin, int end) {
+        for (int y = begin; y < end; y++) {
+            float srcY = std::max((y + HALF) * scaleY - HALF, 0.0f);
+            int top = std::min(static_cast<int>(srcY), srcHeight - 1);
+            float fractionY = srcY - top;
+            const uint8_t* topRow = src + top * srcStride;
+            const uint8_t* bottomRow = src + std::min(top + 1, srcHeight - 1) * srcStride;
+            for (int x = 0; x < dstWidth; x++) {
+                int left = columns[x] * CHANNEL;
+                int right = std::min(columns[x] + 1, srcWidth - 1) * CHANNEL;
+                float fractionX = fractions[x];
+                Float4 upper = MulAdd(Splat(0.0f), LoadPixel(topRow + left), 1.0f - fractionX);
+                upper = MulAdd(upper, LoadPixel(topRow + right), fractionX);
+                Float4 lower = MulAdd(Splat(0.0f), LoadPixel(bottomRow + left), 1.0f - fractionX);
+                lower = MulAdd(lower, LoadPixel(bottomRow + right), fractionX);
+                Float4 result = MulAdd(MulAdd(Splat(0.0f), upper, 1.0f - fractionY), lower, fractionY);
+                StorePixel(dst + y * dstStride + x * CHANNEL, result);
+            }
+        }
+    });
+}
+
+void CpuFilterKernels::ParallelStripes(int height, int stripeHeight, const std::function<void(int, int)>& task)
+{
+    if (height <= 0) {
+        return;
+    }
+    stripeHeight = std::max(stripeHeight, 1);
+    int stripeCount = (height + stripeHeight - 1) / stripeHeight;
+    WorkerPool::Instance().ParallelFor(stripeCount, [height, stripeHeight, &task](int32_t stripe) {
+        int begin = stripe * stripeHeight;
+        task(begin, std::min(begin + stripeHeight, height));
+    });
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -25,6 +25,7 @@ bool Filter::Process(ProcessData& data)
     ROSEN_TRACE_END(HITRACE_TAG_GRAPHIC_AGP);
     if (this->GetFilterType() == FILTER_TYPE::ALGOFILTER) {
         std::swap(data.srcTextureID, data.dstTextureID);
+        std::swap(data.srcPixels, data.dstPixels);
     }
     if (data.textureWidth == 0 || data.textureHeight == 0) {
         return false;
@@ -14,6 +14,7 @@
  */
 
 #include "gaussian_blur_filter.h"
+#include "cpu_filter_kernels.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -37,12 +38,42 @@ GaussianBlurFilter::~GaussianBlurFilter()
 
 void GaussianBlurFilter::DoProcess(ProcessData& data)
 {
+    if (data.IsCpu()) {
+        DoProcessCpu(data);
+        return;
+    }
     downSampleFilter_->Process(data);
     horizontalBlurFilter_->Process(data);
     verticalBlurFilter_->Process(data);
     upSampleFilter_->Process(data);
 }
 
+void GaussianBlurFilter::DoProcessCpu(ProcessData& data)
+{
+    // the same sizes as the GL path, both passes run on the downsampled pixels in one tiled pass.
+    int width = data.textureWidth;
+    int height = data.textureHeight;
+    int downSampledWidth = std::floor(DOWNSAMPLE_FACTOR * width);
+    int downSampledHeight = std::floor(DOWNSAMPLE_FACTOR * height);
+    data.textureWidth = std::floor(INVERSE_DOWNSAMPLE_FACTOR * downSampledWidth);
+    data.textureHeight = std::floor(INVERSE_DOWNSAMPLE_FACTOR * downSampledHeight);
+    if (downSampledWidth <= 0 || downSampledHeight <= 0) {
+        return;
+    }
+    size_t downSampledSize = static_cast<size_t>(downSampledWidth) * downSampledHeight *
+        CpuFilterKernels::COLOR_CHANNEL;
+    downSampledPixels_.resize(downSampledSize);
+    blurredPixels_.resize(downSampledSize);
+    CpuFilterKernels::Resize(data.srcPixels->data(), width, height, downSampledPixels_.data(), downSampledWidth,
+        downSampledHeight);
+    CpuFilterKernels::SeparableBlur(downSampledPixels_.data(), blurredPixels_.data(), downSampledWidth,
+        downSampledHeight, horizontalBlurFilter_->GetTaps(), verticalBlurFilter_->GetTaps());
+    data.dstPixels->resize(static_cast<size_t>(data.textureWidth) * data.textureHeight *
+        CpuFilterKernels::COLOR_CHANNEL);
+    CpuFilterKernels::Resize(blurredPixels_.data(), downSampledWidth, downSampledHeight, data.dstPixels->data(),
+        data.textureWidth, data.textureHeight);
+}
+
 void GaussianBlurFilter::SetValue(const std::string& key, std::shared_ptr<void> value, int size)
 {
     horizontalBlurFilter_->SetValue(key, value, size);
@@ -14,6 +14,7 @@
  */
 
 #include "horizontal_blur_filter.h"
+#include "cpu_filter_kernels.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -42,11 +43,24 @@ void HorizontalBlurFilter::SetValue(const std::string& key, std::shared_ptr<void
 
 void HorizontalBlurFilter::LoadFilterParams()
 {
+#ifdef EFFECT_ENABLE_GPU
     Use();
     weightID_ = glGetUniformLocation(program_->programID_, "weight");
     offsetID_ = glGetUniformLocation(program_->programID_, "offset");
     glUniform1fv(weightID_, RADIUS, weight_);
     glUniform1fv(offsetID_, RADIUS, offset_);
+#endif
+}
+
+std::vector<float> HorizontalBlurFilter::GetTaps() const
+{
+    return CpuFilterKernels::ExpandBlurTaps(weight_, offset_, RADIUS);
+}
+
+void HorizontalBlurFilter::DoProcessCpu(ProcessData& data)
+{
+    CpuFilterKernels::HorizontalBlur(data.srcPixels->data(), data.dstPixels->data(), data.textureWidth, data.textureHeight,
+        GetTaps());
 }
 
 std::string HorizontalBlurFilter::GetVertexShader()
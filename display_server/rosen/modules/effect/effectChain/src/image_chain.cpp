@@ -17,12 +17,18 @@
 
 namespace OHOS {
 namespace Rosen {
-ImageChain::ImageChain(std::vector<std::shared_ptr<Input>> inputs) : inputs_(inputs)
+ImageChain::ImageChain(std::vector<std::shared_ptr<Input>> inputs, bool useCpu)
+    : useCpu_(useCpu), inputs_(inputs)
 {
-    CreatTexture(srcTextureID_);
-    CreatTexture(dstTextureID_);
-
-    glGenFramebuffers(1, &frameBufferID_);
+#ifdef EFFECT_ENABLE_GPU
+    if (!useCpu_) {
+        CreatTexture(srcTextureID_);
+        CreatTexture(dstTextureID_);
+        glGenFramebuffers(1, &frameBufferID_);
+    }
+#else
+    useCpu_ = true;
+#endif
     if (inputs_.size() == 1) {
         flagSeries_ = true;
     }
@@ -31,6 +37,10 @@ ImageChain::ImageChain(std::vector<std::shared_ptr<Input>> inputs) : inputs_(inp
 bool ImageChain::Render()
 {
     ProcessData data {srcTextureID_, dstTextureID_, frameBufferID_, 0, 0};
+    if (useCpu_) {
+        data.srcPixels = &srcPixels_;
+        data.dstPixels = &dstPixels_;
+    }
     if (flagSeries_) {
         return SeriesRendering(data);
     }
@@ -53,6 +63,7 @@ bool ImageChain::ParallelRendering()
 
 void ImageChain::CreatTexture(unsigned int& textureID)
 {
+#ifdef EFFECT_ENABLE_GPU
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -60,6 +71,7 @@ void ImageChain::CreatTexture(unsigned int& textureID)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glBindTexture(GL_TEXTURE_2D, 0);
+#endif
 }
 } // namespcae Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -15,6 +15,8 @@
 
 #include "input.h"
 
+#include <cstring>
+
 namespace OHOS {
 namespace Rosen {
 void Input::DoProcess(ProcessData& data)
@@ -52,12 +54,18 @@ void Input::DecodeFromPixelMap(ProcessData& data)
     }
     data.textureWidth = pixelMap_->GetWidth();
     data.textureHeight = pixelMap_->GetHeight();
+    if (data.IsCpu()) {
+        CopyToPixels(data, pixelMap_->GetPixels(), pixelMap_->GetRowBytes());
+        return;
+    }
 
+#ifdef EFFECT_ENABLE_GPU
     glBindTexture(GL_TEXTURE_2D, data.srcTextureID);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.textureWidth, data.textureHeight,
         0, GL_RGBA, GL_UNSIGNED_BYTE, pixelMap_->GetPixels());
     glGenerateMipmap(GL_TEXTURE_2D);
+#endif
 }
 
 void Input::DecodeFromBuffer(ProcessData& data)
@@ -67,12 +75,35 @@ void Input::DecodeFromBuffer(ProcessData& data)
     }
     data.textureWidth = bufferWidth_;
     data.textureHeight = bufferHeight_;
+    if (data.IsCpu()) {
+        CopyToPixels(data, buffer_.get(), bufferWidth_ * COLOR_CHANNEL);
+        return;
+    }
+#ifdef EFFECT_ENABLE_GPU
     glBindTexture(GL_TEXTURE_2D, data.srcTextureID);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.textureWidth, data.textureHeight,
         0, GL_RGBA, GL_UNSIGNED_BYTE, buffer_.get());
     glGenerateMipmap(GL_TEXTURE_2D);
+#endif
+}
+
+void Input::CopyToPixels(ProcessData& data, const uint8_t* pixels, int rowBytes)
+{
+    size_t stride = static_cast<size_t>(data.textureWidth) * COLOR_CHANNEL;
+    if (pixels == nullptr || data.textureWidth <= 0 || data.textureHeight <= 0 ||
+        rowBytes < static_cast<int>(stride)) {
+        LOGE("The input pixels are invalid!");
+        data.textureWidth = 0;
+        data.textureHeight = 0;
+        return;
+    }
+    data.srcPixels->resize(stride * data.textureHeight);
+    for (int y = 0; y < data.textureHeight; y++) {
+        memcpy(data.srcPixels->data() + y * stride, pixels + static_cast<size_t>(y) * rowBytes, stride);
+    }
 }
+
 FILTER_TYPE Input::GetFilterType()
 {
     return FILTER_TYPE::INPUT;
@@ -15,7 +15,9 @@
 
 #include "output.h"
 #include <GLES3/gl32.h>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <memory>
 
 namespace OHOS {
@@ -90,6 +92,11 @@ void Output::WriteToBuffer(ProcessData& data)
         delete[] ptr;
     });
     colorBuffer_ = std::move(colorBuffer);
+    if (data.IsCpu()) {
+        memcpy(colorBuffer_.get(), data.srcPixels->data(), std::min<size_t>(bufferSize, data.srcPixels->size()));
+        return;
+    }
+#ifdef EFFECT_ENABLE_GPU
     glBindFramebuffer(GL_FRAMEBUFFER, data.frameBufferID);
     glBindTexture(GL_TEXTURE_2D, data.dstTextureID);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.textureWidth, data.textureHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
@@ -101,6 +108,7 @@ void Output::WriteToBuffer(ProcessData& data)
     glDrawElements(GL_TRIANGLES, AlgoFilter::DRAW_ELEMENTS_NUMBER, GL_UNSIGNED_INT, 0);
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
     glReadPixels(0, 0, data.textureWidth, data.textureHeight, GL_RGBA, GL_UNSIGNED_BYTE, colorBuffer_.get());
+#endif
 }
 
 void Output::SetValue(const std::string& key, std::shared_ptr<void> value, int size)
@@ -14,6 +14,7 @@
  */
 
 #include "saturation_filter.h"
+#include "cpu_filter_kernels.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -33,9 +34,26 @@ void SaturationFilter::SetValue(const std::string& key, std::shared_ptr<void> va
 
 void SaturationFilter::LoadFilterParams()
 {
+#ifdef EFFECT_ENABLE_GPU
     Use();
     saturationID_ = glGetUniformLocation(program_->programID_, "saturation");
     glUniform1f(saturationID_, saturation_);
+#endif
+}
+
+void SaturationFilter::DoProcessCpu(ProcessData& data)
+{
+    // mix(luminance, color, saturation) with the luminance weighting of the shader.
+    float red = 0.2125f * (1.0f - saturation_);
+    float green = 0.7154f * (1.0f - saturation_);
+    float blue = 0.0721f * (1.0f - saturation_);
+    const float matrix[CpuFilterKernels::COLOR_MATRIX_SIZE] = {
+        red + saturation_, green, blue, 0.0f,
+        red, green + saturation_, blue, 0.0f,
+        red, green, blue + saturation_, 0.0f,
+    };
+    CpuFilterKernels::ColorMatrix(data.srcPixels->data(), data.dstPixels->data(), data.textureWidth,
+        data.textureHeight, matrix);
 }
 
 std::string SaturationFilter::GetVertexShader()
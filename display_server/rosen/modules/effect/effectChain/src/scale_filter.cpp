@@ -14,6 +14,7 @@
  */
 
 #include "scale_filter.h"
+#include "cpu_filter_kernels.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -38,8 +39,18 @@ void ScaleFilter::SetScale(float scale)
 
 void ScaleFilter::DoProcess(ProcessData& data)
 {
+    int width = data.textureWidth;
+    int height = data.textureHeight;
     data.textureHeight = std::floorf(scale_ * data.textureHeight);
     data.textureWidth = std::floorf(scale_ * data.textureWidth);
+    if (data.IsCpu()) {
+        // the GL path only changes the size the next filter samples at, here the pixels are resampled.
+        data.dstPixels->resize(static_cast<size_t>(data.textureWidth) * data.textureHeight *
+            CpuFilterKernels::COLOR_CHANNEL);
+        CpuFilterKernels::Resize(data.srcPixels->data(), width, height, data.dstPixels->data(), data.textureWidth,
+            data.textureHeight);
+        return;
+    }
     std::swap(data.srcTextureID, data.dstTextureID);
 }
 
@@ -14,6 +14,7 @@
  */
 
 #include "vertical_blur_filter.h"
+#include "cpu_filter_kernels.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -40,11 +41,24 @@ void VerticalBlurFilter::SetValue(const std::string& key, std::shared_ptr<void>
 
 void VerticalBlurFilter::LoadFilterParams()
 {
+#ifdef EFFECT_ENABLE_GPU
     Use();
     weightID_ = glGetUniformLocation(program_->programID_, "weight");
     offsetID_ = glGetUniformLocation(program_->programID_, "offset");
     glUniform1fv(weightID_, RADIUS, weight_);
     glUniform1fv(offsetID_, RADIUS, offset_);
+#endif
+}
+
+std::vector<float> VerticalBlurFilter::GetTaps() const
+{
+    return CpuFilterKernels::ExpandBlurTaps(weight_, offset_, RADIUS);
+}
+
+void VerticalBlurFilter::DoProcessCpu(ProcessData& data)
+{
+    CpuFilterKernels::VerticalBlur(data.srcPixels->data(), data.dstPixels->data(), data.textureWidth, data.textureHeight,
+        GetTaps());
 }
 
 std::string VerticalBlurFilter::GetVertexShader()
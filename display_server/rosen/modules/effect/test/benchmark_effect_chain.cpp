@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "egl_manager.h"
+#include "filter_factory.h"
+#include "image_chain.h"
+
+using namespace OHOS;
+using namespace OHOS::Rosen;
+
+namespace {
+constexpr int WIDTH = 1920;
+constexpr int HEIGHT = 1080;
+constexpr int COLOR_CHANNEL = 4;
+constexpr int ITERATIONS = 20;
+const std::vector<std::string> FILTER_TYPES = {
+    "Brightness", "Contrast", "Saturation", "HorizontalBlur", "VerticalBlur", "GaussianBlur",
+};
+
+// milliseconds of a render of input -> filter -> output, the read back of the output included.
+double MeasureFilter(const std::string& filterType, const std::shared_ptr<uint8_t>& pixels, bool useCpu)
+{
+    FilterFactory filterFactory;
+    auto input = filterFactory.GetFilter("Input");
+    input->SetValue("format", std::make_shared<std::string>("buffer"), 1);
+    input->SetValue("src", pixels, 1);
+    input->SetValue("bufferWidth", std::make_shared<int>(WIDTH), 1);
+    input->SetValue("bufferHeight", std::make_shared<int>(HEIGHT), 1);
+    auto filter = filterFactory.GetFilter(filterType);
+    auto output = filterFactory.GetFilter("Output");
+    output->SetValue("format", std::make_shared<std::string>("buffer"), 1);
+    input->AddNextFilter(filter);
+    filter->AddNextFilter(output);
+    ImageChain imageChain({ std::static_pointer_cast<Input>(input) }, useCpu);
+
+    // the first render compiles the programs of the GL path and allocates the buffers.
+    imageChain.Render();
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        imageChain.Render();
+    }
+    std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - begin;
+    return duration.count() / ITERATIONS;
+}
+}
+
+int main()
+{
+    std::shared_ptr<uint8_t> pixels(new uint8_t[WIDTH * HEIGHT * COLOR_CHANNEL], [] (uint8_t* ptr) {
+        delete[] ptr;
+    });
+    for (int i = 0; i < WIDTH * HEIGHT * COLOR_CHANNEL; i++) {
+        pixels.get()[i] = static_cast<uint8_t>(i * 7 + i / WIDTH);
+    }
+
+    EglManager::GetInstance().Init();
+    bool hasGl = eglGetCurrentContext() != EGL_NO_CONTEXT;
+    if (!hasGl) {
+        printf("No EGL context, only the CPU path is measured.\n");
+    }
+    printf("%dx%d, %d renders\n", WIDTH, HEIGHT, ITERATIONS);
+    printf("%-16s %12s %12s %12s %12s\n", "filter", "cpu ms", "cpu MPix/s", "gl ms", "gl MPix/s");
+    constexpr double megaPixels = WIDTH * HEIGHT / 1e6;
+    for (const auto& filterType : FILTER_TYPES) {
+        double cpuTime = MeasureFilter(filterType, pixels, true);
+        printf("%-16s %12.2f %12.1f", filterType.c_str(), cpuTime, megaPixels * 1000 / cpuTime);
+        if (hasGl) {
+            double glTime = MeasureFilter(filterType, pixels, false);
+            printf(" %12.2f %12.1f", glTime, megaPixels * 1000 / glTime);
+        }
+        printf("\n");
+    }
+    return 0;
+}
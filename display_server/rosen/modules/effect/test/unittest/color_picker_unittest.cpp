@@ -14,6 +14,8 @@
  */
 
 #include "color_picker_unittest.h"
+#include <algorithm>
+#include <vector>
 #include "color_picker.h"
 #include "color.h"
 #include "image_source.h"
@@ -273,5 +275,61 @@ HWTEST_F(ColorPickerUnittest, GetMainColorTest003, TestSize.Level1)
     bool ret = color.ColorEqual(ColorManager::Color(0x00000000U));
     EXPECT_EQ(true, ret);
 }
+
+/**
+ * @tc.name: GetPaletteTest001
+ * @tc.desc: Ensure the ability of getting the dominant colors of a pixelmap.
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ColorPickerUnittest, GetPaletteTest001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ColorPickerUnittest GetPaletteTest001 start";
+    /**
+     * @tc.steps: step1. Create a pixelmap, 3/4 red and 1/4 blue
+     */
+    constexpr uint32_t width = 64;
+    constexpr uint32_t height = 64;
+    std::vector<uint32_t> colors(width * height, 0xFFFF0000U);
+    std::fill(colors.begin() + width * height * 3 / 4, colors.end(), 0xFF0000FFU);
+    Media::InitializationOptions opts;
+    opts.size.width = width;
+    opts.size.height = height;
+    opts.pixelFormat = Media::PixelFormat::RGBA_8888;
+    opts.alphaType = Media::AlphaType::IMAGE_ALPHA_TYPE_UNPREMUL;
+    std::unique_ptr<Media::PixelMap> pixmap = Media::PixelMap::Create(colors.data(), colors.size(), opts);
+    ASSERT_NE(pixmap, nullptr);
+
+    uint32_t errorCode = SUCCESS;
+    std::shared_ptr<ColorPicker> pColorPicker = ColorPicker::CreateColorPicker(std::move(pixmap), errorCode);
+    ASSERT_EQ(errorCode, SUCCESS);
+    ASSERT_NE(pColorPicker, nullptr);
+
+    /**
+     * @tc.steps: step2. Get the palette, the most populated color first
+     */
+    std::vector<ColorSwatch> swatches;
+    errorCode = pColorPicker->GetPalette(ColorHistogram::MAX_PALETTE_SIZE, swatches);
+    ASSERT_EQ(errorCode, SUCCESS);
+    ASSERT_EQ(swatches.size(), 2U);
+    EXPECT_EQ(swatches[0].color, 0xFFFF0000U);
+    EXPECT_EQ(swatches[0].population, width * height * 3 / 4);
+    EXPECT_EQ(swatches[1].color, 0xFF0000FFU);
+    EXPECT_GT(swatches[1].whiteContrast, swatches[0].whiteContrast);
+
+    /**
+     * @tc.steps: step3. Sample every other pixel, the main color is the average
+     */
+    pColorPicker->SetSampleStride(2);
+    errorCode = pColorPicker->GetPalette(1, swatches);
+    ASSERT_EQ(errorCode, SUCCESS);
+    ASSERT_EQ(swatches.size(), 1U);
+    EXPECT_EQ(swatches[0].population, width * height / 4);
+    ColorManager::Color color;
+    errorCode = pColorPicker->GetMainColor(color);
+    ASSERT_EQ(errorCode, SUCCESS);
+    EXPECT_TRUE(color.ColorEqual(ColorManager::Color(0xFFBF0040U)));
+}
 } // namespace Rosen
 } // namespace OHOS
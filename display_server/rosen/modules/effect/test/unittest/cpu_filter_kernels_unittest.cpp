@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_filter_kernels_unittest.h"
+#include "cpu_filter_kernels.h"
+#include "horizontal_blur_filter.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+constexpr int WIDTH = 67;
+constexpr int HEIGHT = 45;
+
+std::vector<uint8_t> CreatePixels(int width, int height)
+{
+    std::vector<uint8_t> pixels(width * height * CpuFilterKernels::COLOR_CHANNEL);
+    for (size_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = static_cast<uint8_t>((i * 37 + i / 11) & 0xFF);
+    }
+    return pixels;
+}
+}
+
+/**
+ * @tc.name: ExpandBlurTaps001
+ * @tc.desc: Expand the bilinear taps of the blur shaders into the weights of whole texels
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CpuFilterKernelsUnittest, ExpandBlurTaps001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "CpuFilterKernelsUnittest ExpandBlurTaps001 start";
+    /**
+     * @tc.steps: step1. Expand the default taps of the blur filters
+     */
+    float weight[HorizontalBlurFilter::RADIUS] = { HorizontalBlurFilter::DEFAULT_WEIGHT_ONE,
+        HorizontalBlurFilter::DEFAULT_WEIGHT_TWO, HorizontalBlurFilter::DEFAULT_WEIGHT_THREE };
+    float offset[HorizontalBlurFilter::RADIUS] = { HorizontalBlurFilter::DEFAULT_OFFSET_ONE,
+        HorizontalBlurFilter::DEFAULT_OFFSET_TWO, HorizontalBlurFilter::DEFAULT_OFFSET_THREE };
+    auto taps = CpuFilterKernels::ExpandBlurTaps(weight, offset, HorizontalBlurFilter::RADIUS);
+    /**
+     * @tc.steps: step2. The kernel is symmetric, reaches the last offset and keeps the sum of the weights
+     */
+    ASSERT_EQ(taps.size(), 9u);
+    float sum = 0.0f;
+    for (size_t i = 0; i < taps.size(); i++) {
+        EXPECT_FLOAT_EQ(taps[i], taps[taps.size() - 1 - i]);
+        sum += taps[i];
+    }
+    EXPECT_NEAR(sum, weight[0] + 2 * (weight[1] + weight[2]), 1e-5);
+    EXPECT_FLOAT_EQ(taps[4], weight[0]);
+}
+
+/**
+ * @tc.name: ColorMatrix001
+ * @tc.desc: Apply a color matrix to the pixels, the alpha is kept
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CpuFilterKernelsUnittest, ColorMatrix001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "CpuFilterKernelsUnittest ColorMatrix001 start";
+    /**
+     * @tc.steps: step1. Swap red and blue and brighten green
+     */
+    auto src = CreatePixels(WIDTH, HEIGHT);
+    std::vector<uint8_t> dst(src.size());
+    const float matrix[CpuFilterKernels::COLOR_MATRIX_SIZE] = {
+        0.0f, 0.0f, 1.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 100.0f,
+        1.0f, 0.0f, 0.0f, 0.0f,
+    };
+    CpuFilterKernels::ColorMatrix(src.data(), dst.data(), WIDTH, HEIGHT, matrix);
+    /**
+     * @tc.steps: step2. Check every pixel, green saturates at 255
+     */
+    for (size_t i = 0; i < src.size(); i += CpuFilterKernels::COLOR_CHANNEL) {
+        EXPECT_EQ(dst[i], src[i + 2]);
+        EXPECT_EQ(dst[i + 1], std::min(src[i + 1] + 100, 255));
+        EXPECT_EQ(dst[i + 2], src[i]);
+        EXPECT_EQ(dst[i + 3], src[i + 3]);
+    }
+}
+
+/**
+ * @tc.name: HorizontalBlur001
+ * @tc.desc: Blur a flat image, which stays flat and becomes opaque
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CpuFilterKernelsUnittest, HorizontalBlur001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "CpuFilterKernelsUnittest HorizontalBlur001 start";
+    /**
+     * @tc.steps: step1. Blur a flat image with a normalized kernel
+     */
+    std::vector<uint8_t> src(WIDTH * HEIGHT * CpuFilterKernels::COLOR_CHANNEL, 80);
+    std::vector<uint8_t> dst(src.size());
+    std::vector<float> taps = { 0.25f, 0.5f, 0.25f };
+    CpuFilterKernels::HorizontalBlur(src.data(), dst.data(), WIDTH, HEIGHT, taps);
+    /**
+     * @tc.steps: step2. The edges are clamped, so the colors don't change
+     */
+    for (size_t i = 0; i < dst.size(); i += CpuFilterKernels::COLOR_CHANNEL) {
+        EXPECT_EQ(dst[i], 80);
+        EXPECT_EQ(dst[i + 1], 80);
+        EXPECT_EQ(dst[i + 2], 80);
+        EXPECT_EQ(dst[i + 3], 255);
+    }
+}
+
+/**
+ * @tc.name: SeparableBlur001
+ * @tc.desc: The tiled blur gives the result of a horizontal pass followed by a vertical one
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CpuFilterKernelsUnittest, SeparableBlur001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "CpuFilterKernelsUnittest SeparableBlur001 start";
+    /**
+     * @tc.steps: step1. Blur with both passes, and with the tiled blur
+     */
+    auto src = CreatePixels(WIDTH, HEIGHT);
+    std::vector<uint8_t> horizontal(src.size());
+    std::vector<uint8_t> twoPasses(src.size());
+    std::vector<uint8_t> tiled(src.size());
+    std::vector<float> horizontalTaps = { 0.1f, 0.2f, 0.4f, 0.2f, 0.1f };
+    std::vector<float> verticalTaps = { 0.25f, 0.5f, 0.25f };
+    CpuFilterKernels::HorizontalBlur(src.data(), horizontal.data(), WIDTH, HEIGHT, horizontalTaps);
+    CpuFilterKernels::VerticalBlur(horizontal.data(), twoPasses.data(), WIDTH, HEIGHT, verticalTaps);
+    CpuFilterKernels::SeparableBlur(src.data(), tiled.data(), WIDTH, HEIGHT, horizontalTaps, verticalTaps);
+    /**
+     * @tc.steps: step2. Only the rounding of the intermediate rows differs
+     */
+    for (size_t i = 0; i < src.size(); i++) {
+        EXPECT_NEAR(tiled[i], twoPasses[i], 1);
+    }
+}
+
+/**
+ * @tc.name: Resize001
+ * @tc.desc: Resize the pixels to their own size and to a quarter
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CpuFilterKernelsUnittest, Resize001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "CpuFilterKernelsUnittest Resize001 start";
+    /**
+     * @tc.steps: step1. The same size is a copy
+     */
+    auto src = CreatePixels(WIDTH, HEIGHT);
+    std::vector<uint8_t> dst(src.size());
+    CpuFilterKernels::Resize(src.data(), WIDTH, HEIGHT, dst.data(), WIDTH, HEIGHT);
+    EXPECT_TRUE(dst == src);
+    /**
+     * @tc.steps: step2. A flat image stays flat at a quarter of the size
+     */
+    std::vector<uint8_t> flat(src.size(), 200);
+    std::vector<uint8_t> quarter((WIDTH / 4) * (HEIGHT / 4) * CpuFilterKernels::COLOR_CHANNEL);
+    CpuFilterKernels::Resize(flat.data(), WIDTH, HEIGHT, quarter.data(), WIDTH / 4, HEIGHT / 4);
+    for (auto value : quarter) {
+        EXPECT_EQ(value, 200);
+    }
+}
+
+/**
+ * @tc.name: ParallelStripes001
+ * @tc.desc: Every row is processed once whatever the number of threads
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(CpuFilterKernelsUnittest, ParallelStripes001, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "CpuFilterKernelsUnittest ParallelStripes001 start";
+    /**
+     * @tc.steps: step1. Count the rows of the stripes
+     */
+    std::vector<int> counts(HEIGHT, 0);
+    CpuFilterKernels::ParallelStripes(HEIGHT, 4, [&counts](int begin, int end) {
+        for (int y = begin; y < end; y++) {
+            counts[y]++;
+        }
+    });
+    /**
+     * @tc.steps: step2. The stripes don't overlap and cover all the rows
+     */
+    for (auto count : counts) {
+        EXPECT_EQ(count, 1);
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
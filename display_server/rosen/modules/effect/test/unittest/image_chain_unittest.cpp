@@ -118,5 +118,49 @@ HWTEST_F(ImageChainUnittest, Render003, TestSize.Level1)
     auto testResult2 = imageChain->Render();
     EXPECT_TRUE(testResult2);
 }
+
+/**
+ * @tc.name: Render004
+ * @tc.desc: Render on the CPU when there is no EGL context
+ * @tc.type: FUNC
+ * @tc.require:
+ * @tc.author:
+ */
+HWTEST_F(ImageChainUnittest, Render004, TestSize.Level1)
+{
+    GTEST_LOG_(INFO) << "ImageChainUnittest Render004 start";
+    /**
+     * @tc.steps: step1. Create a ImageChain from a buffer to a buffer through a brightness filter
+     */
+    constexpr int width = 16;
+    constexpr int height = 8;
+    FilterFactory filterFactory;
+    auto input = filterFactory.GetFilter("Input");
+    input->SetValue("format", std::make_shared<std::string>("buffer"), 1);
+    std::shared_ptr<uint8_t> buffer(new uint8_t[width * height * Output::COLOR_CHANNEL], [] (uint8_t* ptr) {
+        delete[] ptr;
+    });
+    std::fill(buffer.get(), buffer.get() + width * height * Output::COLOR_CHANNEL, 100);
+    input->SetValue("src", buffer, 1);
+    input->SetValue("bufferWidth", std::make_shared<int>(width), 1);
+    input->SetValue("bufferHeight", std::make_shared<int>(height), 1);
+    auto brightness = filterFactory.GetFilter("Brightness");
+    brightness->SetValue("brightness", std::make_shared<float>(0.2f), 1);
+    auto output = std::make_shared<Output>();
+    output->SetValue("format", std::make_shared<std::string>("buffer"), 1);
+    input->AddNextFilter(brightness);
+    brightness->AddNextFilter(output);
+    std::vector<std::shared_ptr<Rosen::Input>> inputs;
+    inputs.push_back(std::static_pointer_cast<Rosen::Input>(input));
+    auto imageChain = std::make_shared<ImageChain>(inputs, true);
+    /**
+     * @tc.steps: step2. Call Render to render the resource, the colors are brighter and the alpha is kept
+     */
+    EXPECT_TRUE(imageChain->Render());
+    auto colorBuffer = output->GetColorBuffer();
+    ASSERT_TRUE(colorBuffer != nullptr);
+    EXPECT_EQ(colorBuffer.get()[0], 151);
+    EXPECT_EQ(colorBuffer.get()[3], 100);
+}
 } // namespace Rosen
 } // namespace OHOS
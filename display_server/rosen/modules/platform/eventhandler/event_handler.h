@@ -16,6 +16,9 @@
 #ifndef BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_HANDLER_H
 #define BASE_EVENTHANDLER_INTERFACES_INNER_API_EVENT_HANDLER_H
 
+#include <cstring>
+#include <string_view>
+
 #include "event_runner.h"
 #include "dumper.h"
 
@@ -32,11 +35,12 @@ enum class EventType {
 };
 
 struct Caller {
-    std::string file_ {""};
+    // Literals of the compiler, so that no string is built for a task posted with a name.
+    const char *file_ {""};
     int         line_ {0};
-    std::string func_ {""};
+    const char *func_ {""};
 #if __has_builtin(__builtin_FILE)
-    Caller(std::string file = __builtin_FILE(), int line = __builtin_LINE(), std::string func = __builtin_FUNCTION())
+    Caller(const char *file = __builtin_FILE(), int line = __builtin_LINE(), const char *func = __builtin_FUNCTION())
         : file_(file), line_(line), func_(func) {
     }
 #else
@@ -45,14 +49,20 @@ struct Caller {
 #endif
     std::string ToString()
     {
-        if (file_.empty()) {
+        std::string_view file(file_);
+        if (file.empty()) {
             return "[ ]";
         }
-        size_t split = file_.find_last_of("/\\");
-        if (split == std::string::npos) {
+        size_t split = file.find_last_of("/\\");
+        if (split == std::string_view::npos) {
             split = 0;
+        } else {
+            split += 1;
         }
-        std::string caller("[" + file_.substr(split + 1) + "(" + func_ + ":" + std::to_string(line_) + ")]");
+        std::string line = std::to_string(line_);
+        std::string caller;
+        caller.reserve(file.size() - split + strlen(func_) + line.size() + 5); // 5: "[(:)]"
+        caller.append("[").append(file.substr(split)).append("(").append(func_).append(":").append(line).append(")]");
         return caller;
     }
 };
@@ -409,10 +419,11 @@ public:
      * @param priority Priority of the event queue for this event.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostTask(const Callback &callback, const std::string &name = std::string(), int64_t delayTime = 0,
+    inline bool PostTask(Callback callback, const std::string &name = std::string(), int64_t delayTime = 0,
         Priority priority = Priority::LOW, Caller caller = {})
     {
-        return SendEvent(InnerEvent::Get(callback, name.empty() ? caller.ToString() : name), delayTime, priority);
+        return SendEvent(
+            InnerEvent::Get(std::move(callback), name.empty() ? caller.ToString() : name), delayTime, priority);
     }
 
     /**
@@ -442,9 +453,9 @@ public:
      * @param priority Priority of the event queue for this event.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostTask(const Callback &callback, Priority priority, Caller caller = {})
+    inline bool PostTask(Callback callback, Priority priority, Caller caller = {})
     {
-        return PostTask(callback, caller.ToString(), 0, priority);
+        return PostTask(std::move(callback), caller.ToString(), 0, priority);
     }
 
     /**
@@ -455,10 +466,10 @@ public:
      * @param priority Priority of the event queue for this event.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostTask(const Callback &callback, int64_t delayTime, Priority priority = Priority::LOW,
+    inline bool PostTask(Callback callback, int64_t delayTime, Priority priority = Priority::LOW,
                          Caller caller = {})
     {
-        return PostTask(callback, caller.ToString(), delayTime, priority);
+        return PostTask(std::move(callback), caller.ToString(), delayTime, priority);
     }
 
     /**
@@ -468,10 +479,11 @@ public:
      * @param name Remove events by name of the task.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostImmediateTask(const Callback &callback, const std::string &name = std::string(),
+    inline bool PostImmediateTask(Callback callback, const std::string &name = std::string(),
                                   Caller caller = {})
     {
-        return SendEvent(InnerEvent::Get(callback, name.empty() ? caller.ToString() : name), 0, Priority::IMMEDIATE);
+        return SendEvent(
+            InnerEvent::Get(std::move(callback), name.empty() ? caller.ToString() : name), 0, Priority::IMMEDIATE);
     }
 
     /**
@@ -482,10 +494,10 @@ public:
      * @param delayTime Process the event after 'delayTime' milliseconds.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostHighPriorityTask(const Callback &callback, const std::string &name = std::string(),
+    inline bool PostHighPriorityTask(Callback callback, const std::string &name = std::string(),
                                      int64_t delayTime = 0, Caller caller = {})
     {
-        return PostTask(callback, name.empty() ? caller.ToString() : name, delayTime, Priority::HIGH);
+        return PostTask(std::move(callback), name.empty() ? caller.ToString() : name, delayTime, Priority::HIGH);
     }
 
     /**
@@ -495,9 +507,9 @@ public:
      * @param delayTime Process the event after 'delayTime' milliseconds.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostHighPriorityTask(const Callback &callback, int64_t delayTime, Caller caller = {})
+    inline bool PostHighPriorityTask(Callback callback, int64_t delayTime, Caller caller = {})
     {
-        return PostHighPriorityTask(callback, caller.ToString(), delayTime);
+        return PostHighPriorityTask(std::move(callback), caller.ToString(), delayTime);
     }
 
     /**
@@ -508,10 +520,10 @@ public:
      * @param delayTime Process the event after 'delayTime' milliseconds.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostIdleTask(const Callback &callback, const std::string &name = std::string(), int64_t delayTime = 0,
+    inline bool PostIdleTask(Callback callback, const std::string &name = std::string(), int64_t delayTime = 0,
                              Caller caller = {})
     {
-        return PostTask(callback, name.empty() ? caller.ToString() : name, delayTime, Priority::IDLE);
+        return PostTask(std::move(callback), name.empty() ? caller.ToString() : name, delayTime, Priority::IDLE);
     }
 
     /**
@@ -521,9 +533,9 @@ public:
      * @param delayTime Process the event after 'delayTime' milliseconds.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostIdleTask(const Callback &callback, int64_t delayTime, Caller caller = {})
+    inline bool PostIdleTask(Callback callback, int64_t delayTime, Caller caller = {})
     {
-        return PostIdleTask(callback, caller.ToString(), delayTime);
+        return PostIdleTask(std::move(callback), caller.ToString(), delayTime);
     }
 
     /**
@@ -638,10 +650,10 @@ public:
      * @param priority Priority of the event queue for this event, IDLE is not permitted for sync event.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostSyncTask(const Callback &callback, const std::string &name, Priority priority = Priority::LOW,
+    inline bool PostSyncTask(Callback callback, const std::string &name, Priority priority = Priority::LOW,
                              Caller caller = {})
     {
-        return SendSyncEvent(InnerEvent::Get(callback, name.empty() ? caller.ToString() : name), priority);
+        return SendSyncEvent(InnerEvent::Get(std::move(callback), name.empty() ? caller.ToString() : name), priority);
     }
 
     /**
@@ -651,9 +663,9 @@ public:
      * @param priority Priority of the event queue for this event, IDLE is not permitted for sync event.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostSyncTask(const Callback &callback, Priority priority = Priority::LOW, Caller caller = {})
+    inline bool PostSyncTask(Callback callback, Priority priority = Priority::LOW, Caller caller = {})
     {
-        return PostSyncTask(callback, caller.ToString(), priority);
+        return PostSyncTask(std::move(callback), caller.ToString(), priority);
     }
 
     /**
@@ -793,10 +805,11 @@ public:
      * @param priority Priority of the event queue for this event.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostTimingTask(const Callback &callback, int64_t taskTime, const std::string &name = std::string(),
+    inline bool PostTimingTask(Callback callback, int64_t taskTime, const std::string &name = std::string(),
         Priority priority = Priority::LOW, Caller caller = {})
     {
-        return SendTimingEvent(InnerEvent::Get(callback, name.empty() ? caller.ToString() : name), taskTime, priority);
+        return SendTimingEvent(
+            InnerEvent::Get(std::move(callback), name.empty() ? caller.ToString() : name), taskTime, priority);
     }
 
     /**
@@ -807,10 +820,10 @@ public:
      * @param priority Priority of the event queue for this event.
      * @return Returns true if task has been sent successfully.
      */
-    inline bool PostTimingTask(const Callback &callback, int64_t taskTime, Priority priority = Priority::LOW,
+    inline bool PostTimingTask(Callback callback, int64_t taskTime, Priority priority = Priority::LOW,
                                Caller caller = {})
     {
-        return PostTimingTask(callback, taskTime, caller.ToString(), priority);
+        return PostTimingTask(std::move(callback), taskTime, caller.ToString(), priority);
     }
 
     /**
@@ -18,9 +18,9 @@
 
 #include <array>
 #include <atomic>
-#include <list>
 #include <map>
 #include <mutex>
+#include <vector>
 
 #include "inner_event.h"
 #include "event_handler_errors.h"
@@ -217,14 +217,51 @@ private:
     // Sub event queues for IMMEDIATE, HIGH and LOW priority. So use value of IDLE as size.
     static const uint32_t SUB_EVENT_QUEUE_NUM = static_cast<uint32_t>(Priority::IDLE);
 
+    // An event in a queue, the events with the same handle time are ordered by their sequence of insertion.
+    struct QueuedEvent {
+        InnerEvent::TimePoint handleTime;
+        uint64_t sequence {0};
+        InnerEvent::Pointer event {nullptr, nullptr};
+    };
+    // Binary heap of events, the front is the earliest one.
+    using EventHeap = std::vector<QueuedEvent>;
+
     struct SubEventQueue {
-        std::list<InnerEvent::Pointer> queue;
+        EventHeap queue;
         uint32_t handledEventsCount{0};
         uint32_t maxHandledEventsCount{DEFAULT_MAX_HANDLED_EVENT_COUNT};
     };
 
+    /*
+     * Bounded lock free queue for the IMMEDIATE events without delay, so that the threads posting them do not
+     * contend on the queue lock. Any thread may push, only the owner of the queue lock pops.
+     */
+    class ImmediateEventRing final {
+    public:
+        ImmediateEventRing();
+        ~ImmediateEventRing() = default;
+        DISALLOW_COPY_AND_MOVE(ImmediateEventRing);
+
+        // Returns false and keeps the event if the ring is full.
+        bool Push(InnerEvent::Pointer &event);
+        InnerEvent::Pointer Pop();
+        bool Empty() const;
+
+    private:
+        static const size_t CAPACITY = 256;
+        struct Slot {
+            std::atomic<size_t> sequence {0};
+            InnerEvent::Pointer event {nullptr, nullptr};
+        };
+        std::array<Slot, CAPACITY> slots_;
+        alignas(64) std::atomic<size_t> enqueuePos_ {0};
+        alignas(64) size_t dequeuePos_ {0};
+    };
+
     void Remove(const RemoveFilter &filter);
     bool HasInnerEvent(const HasFilter &filter);
+    void InsertEventsLocked(EventHeap &events, InnerEvent::Pointer &event);
+    void DrainImmediateEventsLocked();
     InnerEvent::Pointer PickEventLocked(const InnerEvent::TimePoint &now, InnerEvent::TimePoint &nextWakeUpTime);
     InnerEvent::Pointer GetExpiredEventLocked(InnerEvent::TimePoint &nextExpiredTime);
     void WaitUntilLocked(const InnerEvent::TimePoint &when, std::unique_lock<std::mutex> &lock);
@@ -239,7 +276,16 @@ private:
     std::array<SubEventQueue, SUB_EVENT_QUEUE_NUM> subEventQueues_;
 
     // Event queue for IDLE events.
-    std::list<InnerEvent::Pointer> idleEvents_;
+    EventHeap idleEvents_;
+
+    // IMMEDIATE events without delay, moved into their sub event queue before picking an event.
+    ImmediateEventRing immediateEvents_;
+
+    // Set while 'GetEvent' is going to wait, the threads pushing into 'immediateEvents_' only notify it then.
+    std::atomic_bool waitingForEvent_ {false};
+
+    // Sequence of the next inserted event.
+    uint64_t insertSequence_ {0};
 
     // Next wake up time when block in 'GetEvent'.
     InnerEvent::TimePoint wakeUpTime_ { InnerEvent::TimePoint::max() };
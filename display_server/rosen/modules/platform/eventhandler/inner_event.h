@@ -200,7 +200,7 @@ public:
      * @param name Name of task.
      * @return Returns the pointer of InnerEvent instance, if callback is invalid, returns nullptr object.
      */
-    static Pointer Get(const Callback &callback, const std::string &name = std::string());
+    static Pointer Get(Callback callback, const std::string &name = std::string());
 
     /**
      * Get InnerEvent instance from pool.
@@ -27,17 +27,14 @@ DEFINE_HILOG_LABEL("EventQueue");
 namespace OHOS {
 namespace AppExecFwk {
 namespace {
-// Help to insert events into the event queue sorted by handle time.
-inline void InsertEventsLocked(std::list<InnerEvent::Pointer> &events, InnerEvent::Pointer &event)
+// Compare function of the event heaps, keeps the earliest event at the front.
+template<typename T>
+inline bool IsLaterEvent(const T &first, const T &second)
 {
-    auto f = [](const InnerEvent::Pointer &first, const InnerEvent::Pointer &second) {
-        if (!first || !second) {
-            return false;
-        }
-        return first->GetHandleTime() < second->GetHandleTime();
-    };
-    auto it = std::upper_bound(events.begin(), events.end(), event, f);
-    events.insert(it, std::move(event));
+    if (first.handleTime != second.handleTime) {
+        return first.handleTime > second.handleTime;
+    }
+    return first.sequence > second.sequence;
 }
 
 // Help to remove file descriptor listeners.
@@ -58,12 +55,13 @@ void RemoveFileDescriptorListenerLocked(std::map<int32_t, std::shared_ptr<FileDe
     }
 }
 
-// Help to check whether there is a valid event in list and update wake up time.
-inline bool CheckEventInListLocked(const std::list<InnerEvent::Pointer> &events, const InnerEvent::TimePoint &now,
+// Help to check whether there is a valid event in heap and update wake up time.
+template<typename T>
+inline bool CheckEventInListLocked(const T &events, const InnerEvent::TimePoint &now,
     InnerEvent::TimePoint &nextWakeUpTime)
 {
     if (!events.empty()) {
-        const auto &handleTime = events.front()->GetHandleTime();
+        const auto &handleTime = events.front().handleTime;
         if (handleTime < nextWakeUpTime) {
             nextWakeUpTime = handleTime;
             return handleTime <= now;
@@ -73,14 +71,100 @@ inline bool CheckEventInListLocked(const std::list<InnerEvent::Pointer> &events,
     return false;
 }
 
-inline InnerEvent::Pointer PopFrontEventFromListLocked(std::list<InnerEvent::Pointer> &events)
+template<typename T>
+inline InnerEvent::Pointer PopFrontEventFromListLocked(T &events)
 {
-    InnerEvent::Pointer event = std::move(events.front());
-    events.pop_front();
+    std::pop_heap(events.begin(), events.end(), IsLaterEvent<typename T::value_type>);
+    InnerEvent::Pointer event = std::move(events.back().event);
+    events.pop_back();
     return event;
 }
+
+// Help to remove the events matching the filter and restore the order of the heap.
+template<typename T, typename F>
+inline void RemoveEventsLocked(T &events, const F &filter)
+{
+    auto it = std::remove_if(events.begin(), events.end(), [&filter](const auto &queued) {
+        return filter(queued.event);
+    });
+    if (it == events.end()) {
+        return;
+    }
+    events.erase(it, events.end());
+    std::make_heap(events.begin(), events.end(), IsLaterEvent<typename T::value_type>);
+}
+
+// Help to list the events of a heap by handle time, for dumping.
+template<typename T>
+inline std::vector<InnerEvent *> SortEventsLocked(const T &events)
+{
+    std::vector<const typename T::value_type *> queued;
+    queued.reserve(events.size());
+    for (const auto &item : events) {
+        queued.push_back(&item);
+    }
+    std::sort(queued.begin(), queued.end(), [](const auto *first, const auto *second) {
+        return IsLaterEvent(*second, *first);
+    });
+    std::vector<InnerEvent *> sorted;
+    sorted.reserve(queued.size());
+    for (const auto *item : queued) {
+        sorted.push_back(item->event.get());
+    }
+    return sorted;
+}
 }  // unnamed namespace
 
+EventQueue::ImmediateEventRing::ImmediateEventRing()
+{
+    for (size_t i = 0; i < CAPACITY; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/*
+ * The sequence of a slot is its position while it is free for the producer of that position, and the position plus
+ * one while it holds the event for the consumer of that position.
+ */
+bool EventQueue::ImmediateEventRing::Push(InnerEvent::Pointer &event)
+{
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    while (true) {
+        Slot &slot = slots_[pos % CAPACITY];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.event = std::move(event);
+                // Sequentially consistent, so that it is ordered with the check of 'waitingForEvent_' after it.
+                slot.sequence.store(pos + 1);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+InnerEvent::Pointer EventQueue::ImmediateEventRing::Pop()
+{
+    Slot &slot = slots_[dequeuePos_ % CAPACITY];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+        return InnerEvent::Pointer(nullptr, nullptr);
+    }
+    InnerEvent::Pointer event = std::move(slot.event);
+    slot.sequence.store(dequeuePos_ + CAPACITY, std::memory_order_release);
+    ++dequeuePos_;
+    return event;
+}
+
+bool EventQueue::ImmediateEventRing::Empty() const
+{
+    return slots_[dequeuePos_ % CAPACITY].sequence.load() != dequeuePos_ + 1;
+}
+
 EventQueue::EventQueue() : ioWaiter_(std::make_shared<NoneIoWaiter>())
 {}
 
@@ -107,11 +191,25 @@ void EventQueue::Insert(InnerEvent::Pointer &event, Priority priority)
         return;
     }
 
+    if ((priority == Priority::IMMEDIATE) && (event->GetHandleTime() <= event->GetSendTime()) && usable_.load() &&
+        immediateEvents_.Push(event)) {
+        // Only a waiting 'GetEvent' may miss the event, it sets the flag before checking the ring the last time.
+        if (waitingForEvent_.load()) {
+            std::lock_guard<std::mutex> lock(queueLock_);
+            ioWaiter_->NotifyOne();
+        }
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(queueLock_);
     if (!usable_.load()) {
         return;
     }
     bool needNotify = false;
+    if (priority == Priority::IMMEDIATE) {
+        // The ring is full or the event is delayed, the events still in the ring were sent before this one.
+        DrainImmediateEventsLocked();
+    }
     switch (priority) {
         case Priority::IMMEDIATE:
         case Priority::HIGH:
@@ -217,10 +315,11 @@ void EventQueue::Remove(const RemoveFilter &filter)
     if (!usable_.load()) {
         return;
     }
+    DrainImmediateEventsLocked();
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        subEventQueues_[i].queue.remove_if(filter);
+        RemoveEventsLocked(subEventQueues_[i].queue, filter);
     }
-    idleEvents_.remove_if(filter);
+    RemoveEventsLocked(idleEvents_, filter);
 }
 
 bool EventQueue::HasInnerEvent(const std::shared_ptr<EventHandler> &owner, uint32_t innerEventId)
@@ -253,15 +352,32 @@ bool EventQueue::HasInnerEvent(const HasFilter &filter)
     if (!usable_.load()) {
         return false;
     }
+    DrainImmediateEventsLocked();
+    auto queuedFilter = [&filter](const QueuedEvent &queued) { return filter(queued.event); };
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
-        std::list<InnerEvent::Pointer>::iterator iter =
-            std::find_if(subEventQueues_[i].queue.begin(), subEventQueues_[i].queue.end(), filter);
-        if (iter != subEventQueues_[i].queue.end()) {
+        if (std::any_of(subEventQueues_[i].queue.begin(), subEventQueues_[i].queue.end(), queuedFilter)) {
             return true;
         }
     }
-    std::list<InnerEvent::Pointer>::iterator iter = std::find_if(idleEvents_.begin(), idleEvents_.end(), filter);
-    return iter != idleEvents_.end();
+    return std::any_of(idleEvents_.begin(), idleEvents_.end(), queuedFilter);
+}
+
+void EventQueue::InsertEventsLocked(EventHeap &events, InnerEvent::Pointer &event)
+{
+    QueuedEvent queued;
+    queued.handleTime = event->GetHandleTime();
+    queued.sequence = insertSequence_++;
+    queued.event = std::move(event);
+    events.push_back(std::move(queued));
+    std::push_heap(events.begin(), events.end(), IsLaterEvent<QueuedEvent>);
+}
+
+void EventQueue::DrainImmediateEventsLocked()
+{
+    auto &immediateQueue = subEventQueues_[static_cast<uint32_t>(Priority::IMMEDIATE)].queue;
+    for (InnerEvent::Pointer event = immediateEvents_.Pop(); event; event = immediateEvents_.Pop()) {
+        InsertEventsLocked(immediateQueue, event);
+    }
 }
 
 InnerEvent::Pointer EventQueue::PickEventLocked(const InnerEvent::TimePoint &now, InnerEvent::TimePoint &nextWakeUpTime)
@@ -302,6 +418,7 @@ InnerEvent::Pointer EventQueue::PickEventLocked(const InnerEvent::TimePoint &now
 
 InnerEvent::Pointer EventQueue::GetExpiredEventLocked(InnerEvent::TimePoint &nextExpiredTime)
 {
+    DrainImmediateEventsLocked();
     auto now = InnerEvent::Clock::now();
     wakeUpTime_ = InnerEvent::TimePoint::max();
     // Find an event which could be distributed right now.
@@ -319,7 +436,7 @@ InnerEvent::Pointer EventQueue::GetExpiredEventLocked(InnerEvent::TimePoint &nex
     }
 
     if (!idleEvents_.empty()) {
-        const auto &idleEvent = idleEvents_.front();
+        const auto &idleEvent = idleEvents_.front().event;
 
         // Return the idle event that has been sent before time stamp and reaches its handle time.
         if ((idleEvent->GetSendTime() <= idleTimeStamp_) && (idleEvent->GetHandleTime() <= now)) {
@@ -341,7 +458,12 @@ InnerEvent::Pointer EventQueue::GetEvent()
         if (event) {
             return event;
         }
-        WaitUntilLocked(nextWakeUpTime, lock);
+        // An immediate event pushed before the flag is set is found here, the ones pushed after it notify.
+        waitingForEvent_.store(true);
+        if (immediateEvents_.Empty()) {
+            WaitUntilLocked(nextWakeUpTime, lock);
+        }
+        waitingForEvent_.store(false);
     }
 
     HILOGD("GetEvent: Break out");
@@ -539,14 +661,15 @@ void EventQueue::Dump(Dumper &dumper)
     if (!usable_.load()) {
         return;
     }
+    DrainImmediateEventsLocked();
     std::string priority[] = {"Immediate", "High", "Low"};
     uint32_t total = 0;
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
         uint32_t n = 0;
         dumper.Dump(dumper.GetTag() + " " + priority[i] + " priority event queue information:" + LINE_SEPARATOR);
-        for (auto it = subEventQueues_[i].queue.begin(); it != subEventQueues_[i].queue.end(); ++it) {
+        for (auto *event : SortEventsLocked(subEventQueues_[i].queue)) {
             ++n;
-            dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + (*it)->Dump());
+            dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + event->Dump());
             ++total;
         }
         dumper.Dump(
@@ -555,9 +678,9 @@ void EventQueue::Dump(Dumper &dumper)
 
     dumper.Dump(dumper.GetTag() + " Idle priority event queue information:" + LINE_SEPARATOR);
     int n = 0;
-    for (auto it = idleEvents_.begin(); it != idleEvents_.end(); ++it) {
+    for (auto *event : SortEventsLocked(idleEvents_)) {
         ++n;
-        dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + (*it)->Dump());
+        dumper.Dump(dumper.GetTag() + " No." + std::to_string(n) + " : " + event->Dump());
         ++total;
     }
     dumper.Dump(dumper.GetTag() + " Total size of Idle events : " + std::to_string(n) + LINE_SEPARATOR);
@@ -571,14 +694,15 @@ void EventQueue::DumpQueueInfo(std::string& queueInfo)
     if (!usable_.load()) {
         return;
     }
+    DrainImmediateEventsLocked();
     std::string priority[] = {"Immediate", "High", "Low"};
     uint32_t total = 0;
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
         uint32_t n = 0;
         queueInfo +=  "            " + priority[i] + " priority event queue:" + LINE_SEPARATOR;
-        for (auto it = subEventQueues_[i].queue.begin(); it != subEventQueues_[i].queue.end(); ++it) {
+        for (auto *event : SortEventsLocked(subEventQueues_[i].queue)) {
             ++n;
-            queueInfo +=  "            No." + std::to_string(n) + " : " + (*it)->Dump();
+            queueInfo +=  "            No." + std::to_string(n) + " : " + event->Dump();
             ++total;
         }
         queueInfo +=  "              Total size of " + priority[i] + " events : " + std::to_string(n) + LINE_SEPARATOR;
@@ -587,9 +711,9 @@ void EventQueue::DumpQueueInfo(std::string& queueInfo)
     queueInfo += "            Idle priority event queue:" + LINE_SEPARATOR;
 
     int n = 0;
-    for (auto it = idleEvents_.begin(); it != idleEvents_.end(); ++it) {
+    for (auto *event : SortEventsLocked(idleEvents_)) {
         ++n;
-        queueInfo += "            No." + std::to_string(n) + " : " + (*it)->Dump();
+        queueInfo += "            No." + std::to_string(n) + " : " + event->Dump();
         ++total;
     }
     queueInfo += "              Total size of Idle events : " + std::to_string(n) + LINE_SEPARATOR;
@@ -608,6 +732,9 @@ bool EventQueue::IsQueueEmpty()
     if (!usable_.load()) {
         return false;
     }
+    if (!immediateEvents_.Empty()) {
+        return false;
+    }
     for (uint32_t i = 0; i < SUB_EVENT_QUEUE_NUM; ++i) {
         uint32_t queueSize = subEventQueues_[i].queue.size();
         if (queueSize != 0) {
@@ -171,7 +171,7 @@ InnerEvent::Pointer InnerEvent::Get(uint32_t innerEventId, int64_t param)
     return event;
 }
 
-InnerEvent::Pointer InnerEvent::Get(const Callback &callback, const std::string &name)
+InnerEvent::Pointer InnerEvent::Get(Callback callback, const std::string &name)
 {
     // Returns nullptr while callback is invalid.
     if (!callback) {
@@ -181,7 +181,8 @@ InnerEvent::Pointer InnerEvent::Get(const Callback &callback, const std::string
 
     auto event = InnerEventPool::GetInstance().Get();
     if (event != nullptr) {
-        event->taskCallback_ = callback;
+        event->taskCallback_ = std::move(callback);
+        // Copied into the name of the pooled event, which keeps its capacity.
         event->taskName_ = name;
     }
     return event;
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmark of the event handler, producer threads post tasks to one runner which handles them.
+// usage: event_handler_perf_test [tasks per producer]
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "event_handler.h"
+#include "event_runner.h"
+
+using namespace OHOS::AppExecFwk;
+
+namespace {
+constexpr int DEFAULT_TASKS = 20000;
+constexpr int PRODUCERS = 8;
+// a capture larger than the small buffer of std::function, like most tasks of the render service
+constexpr size_t PAYLOAD_SIZE = 4;
+
+struct Case {
+    const char* name;
+    EventQueue::Priority priority;
+    bool named;
+};
+constexpr Case CASES[] = {
+    { "immediate", EventQueue::Priority::IMMEDIATE, false },
+    { "immediate named", EventQueue::Priority::IMMEDIATE, true },
+    { "low", EventQueue::Priority::LOW, false },
+    { "high named", EventQueue::Priority::HIGH, true },
+};
+
+class Counter {
+public:
+    explicit Counter(int total) : remaining_(total) {}
+
+    void Done()
+    {
+        if (remaining_.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cond_.notify_all();
+        }
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [this]() { return remaining_.load() == 0; });
+    }
+
+private:
+    std::atomic<int> remaining_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+};
+
+// returns the handled tasks per second
+double Measure(const std::shared_ptr<EventHandler>& handler, const Case& testCase, int tasks)
+{
+    Counter counter(tasks * PRODUCERS);
+    std::atomic<uint64_t> checksum = 0;
+    std::atomic<bool> go = false;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p]() {
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            const std::string name = "perf_task_" + std::to_string(p);
+            for (int i = 0; i < tasks; ++i) {
+                std::array<uint64_t, PAYLOAD_SIZE> payload = { static_cast<uint64_t>(i), 1, 2, 3 };
+                auto task = [&counter, &checksum, payload]() {
+                    checksum.fetch_add(payload[0], std::memory_order_relaxed);
+                    counter.Done();
+                };
+                if (testCase.named) {
+                    handler->PostTask(task, name, 0, testCase.priority);
+                } else {
+                    handler->PostTask(task, testCase.priority);
+                }
+            }
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    counter.Wait();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    uint64_t expected = static_cast<uint64_t>(tasks) * (tasks - 1) / 2 * PRODUCERS; // 2: sum of 0 .. tasks - 1
+    if (checksum.load() != expected) {
+        printf("%s: checksum mismatch\n", testCase.name);
+        return -1;
+    }
+    return tasks * PRODUCERS / elapsed.count();
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int tasks = (argc > 1) ? atoi(argv[1]) : DEFAULT_TASKS;
+    if (tasks <= 0) {
+        printf("usage: %s [tasks per producer]\n", argv[0]);
+        return -1;
+    }
+
+    auto runner = EventRunner::Create("EventHandlerPerfTest");
+    auto handler = std::make_shared<EventHandler>(runner);
+    int ret = 0;
+    for (const auto& testCase : CASES) {
+        Measure(handler, testCase, tasks / 10); // 10: warm up with a tenth of the tasks
+        double tasksPerSecond = Measure(handler, testCase, tasks);
+        if (tasksPerSecond < 0) {
+            ret = -1;
+            continue;
+        }
+        printf("%-16s: %d producers, %d tasks, %8.0f k tasks/s, %6.0f ns/task\n", testCase.name, PRODUCERS,
+            tasks * PRODUCERS, tasksPerSecond / 1000, 1e9 / tasksPerSecond); // 1000 tasks per k, 1e9 ns per second
+    }
+    runner->Stop();
+    return ret;
+}
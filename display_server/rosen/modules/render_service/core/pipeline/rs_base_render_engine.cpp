@@ -36,6 +36,11 @@
 
 namespace OHOS {
 namespace Rosen {
+namespace {
+// the conversion buffer of a thread is kept up to a full HD RGBA layer
+constexpr size_t MAX_KEPT_CONVERSION_BUFFER_SIZE = 1920 * 1080 * 4;
+}
+
 RSBaseRenderEngine::RSBaseRenderEngine()
 {
 }
@@ -309,13 +314,20 @@ void RSBaseRenderEngine::DrawBuffer(RSPaintFilterCanvas& canvas, BufferDrawParam
 {
     RS_TRACE_NAME("RSBaseRenderEngine::DrawBuffer(CPU)");
     SkBitmap bitmap;
-    std::vector<uint8_t> newBuffer;
+    // reused by the frames of this thread to avoid a full size allocation per layer, the bitmap is mutable so it is
+    // copied if the canvas keeps it after the draw.
+    thread_local std::vector<uint8_t> newBuffer;
     if (!RSBaseRenderUtil::ConvertBufferToBitmap(params.buffer, newBuffer, params.targetColorGamut, bitmap,
         params.metaDatas)) {
         RS_LOGE("RSDividedRenderUtil::DrawBuffer: create bitmap failed.");
         return;
     }
     canvas.drawBitmapRect(bitmap, params.srcRect, params.dstRect, &(params.paint));
+    // a larger layer, or a much smaller one after it, does not keep its peak allocation alive on this thread
+    size_t capacity = newBuffer.capacity();
+    if (capacity > MAX_KEPT_CONVERSION_BUFFER_SIZE || capacity > 2 * newBuffer.size()) { // 2: slack kept
+        std::vector<uint8_t>().swap(newBuffer);
+    }
 }
 
 void RSBaseRenderEngine::DrawImage(RSPaintFilterCanvas& canvas, BufferDrawParam& params)
@@ -15,17 +15,29 @@
 
 #include "rs_base_render_util.h"
 
+#include <cstring>
+#include <map>
+#include <mutex>
 #include <sys/time.h>
+#include <tuple>
 #include <unordered_set>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "common/rs_matrix3.h"
 #include "common/rs_obj_abs_geometry.h"
 #include "common/rs_vector2.h"
 #include "common/rs_vector3.h"
 #include "include/utils/SkCamera.h"
+#include "pipeline/rs_hardware_thread.h"
+#include "pipeline/rs_yuv_converter.h"
 #include "platform/common/rs_log.h"
 #include "png.h"
 #include "rs_trace.h"
+#include "transaction/rs_ashmem_helper.h"
 #include "transaction/rs_transaction_data.h"
 
 namespace OHOS {
@@ -34,9 +46,6 @@ namespace Detail {
 // [PLANNING]: Use GPU to do the gamut conversion instead of these following works.
 using PixelTransformFunc = std::function<float(float)>;
 
-using Offset = std::pair<uint8_t, uint8_t>; // first: offsetSrc; second: offsetDst
-const int dstLength = 3;
-using Array3ptr = std::array<uint8_t*, dstLength>;
 const uint32_t STUB_PIXEL_FMT_RGBA_16161616 = 0X7fff0001;
 const uint32_t STUB_PIXEL_FMT_RGBA_1010102 = 0X7fff0002;
 constexpr uint32_t MATRIX_SIZE = 20; // colorMatrix size
@@ -347,6 +356,22 @@ public:
         return ApplyTransForm(FromLinear(xyzToRgb_ * xyz), clamper_);
     }
 
+    // the channel by channel parts of RGBToXYZ and XYZToRGB, and the product of their matrices.
+    float ChannelToLinear(float val) const
+    {
+        return transEOTF_(val);
+    }
+
+    float ChannelFromLinear(float val) const
+    {
+        return clamper_(transOETF_(val));
+    }
+
+    Matrix3f LinearMatrixTo(const SimpleColorSpace& dst) const
+    {
+        return dst.xyzToRgb_ * rgbToXyz_;
+    }
+
 private:
     Matrix3f rgbToXyz_;
     Matrix3f xyzToRgb_;
@@ -413,13 +438,13 @@ bool IsValidMetaData(const std::vector<GraphicHDRMetaData> &metaDatas)
     return (validFlag & bitsToCheck) == bitsToCheck;
 }
 
-SimpleColorSpace &GetColorSpaceFromMetaData(const std::vector<GraphicHDRMetaData> &metaDatas, float targetLum = 0)
+SimpleColorSpace GetColorSpaceFromMetaData(const std::vector<GraphicHDRMetaData> &metaDatas, float targetLum = 0)
 {
     std::vector<GraphicHDRMetaData> metaDataSorted = metaDatas;
     std::sort(metaDataSorted.begin(), metaDataSorted.end(), [&](const GraphicHDRMetaData &a, const GraphicHDRMetaData &b)->bool {
             return a.key < b.key;
     });
-    static SimpleColorSpace hdrPq {
+    SimpleColorSpace hdrPq {
          // rgb base points.
         {{Vector2f{metaDataSorted[GraphicHDRMetadataKey::GRAPHIC_MATAKEY_RED_PRIMARY_X].value,
                    metaDataSorted[GraphicHDRMetadataKey::GRAPHIC_MATAKEY_RED_PRIMARY_Y].value},
@@ -433,7 +458,7 @@ SimpleColorSpace &GetColorSpaceFromMetaData(const std::vector<GraphicHDRMetaData
     return hdrPq;
 }
 
-SimpleColorSpace &GetHdrPqColorSpace(const std::vector<GraphicHDRMetaData> &metaData, float targetLum = 0.f)
+SimpleColorSpace GetHdrPqColorSpace(const std::vector<GraphicHDRMetaData> &metaData, float targetLum = 0.f)
 {
     if (metaData.size() > 0 && IsValidMetaData(metaData)) {
         return GetColorSpaceFromMetaData(metaData, targetLum);
@@ -472,7 +497,7 @@ bool IsSupportedColorGamut(ColorGamut colorGamut)
     return supportedColorGamuts.count(colorGamut) > 0;
 }
 
-SimpleColorSpace& GetColorSpaceOfCertainGamut(ColorGamut colorGamut, const std::vector<GraphicHDRMetaData> &metaData = {})
+SimpleColorSpace GetColorSpaceOfCertainGamut(ColorGamut colorGamut, const std::vector<GraphicHDRMetaData> &metaData = {})
 {
     switch (colorGamut) {
         case ColorGamut::COLOR_GAMUT_SRGB: {
@@ -519,87 +544,369 @@ uint16_t RGBFloatToUint10(float val)
     return static_cast<uint16_t>(Saturate(val) * maxUint10 + 0.5f);
 }
 
-Offset RGBUintToFloat(uint8_t* dst, uint8_t* src, int32_t pixelFormat, Vector3f &srcColor,
-    Array3ptr &colorDst)
+constexpr int UINT8_LEVELS = 256;
+constexpr int UINT10_LEVELS = 1024;
+// the linear values are rounded to ENCODE_MANTISSA_BITS bits of mantissa to look up their outputs, so that the
+// entries are dense near 0 where the transfer functions are the steepest, like PQ. the values below
+// ENCODE_MIN_LINEAR give the output of 0, and the ones above 1.0f reach 255 in all supported color spaces.
+constexpr int ENCODE_MANTISSA_BITS = 10;
+constexpr int ENCODE_MIN_EXPONENT = -28;
+constexpr float ENCODE_MIN_LINEAR = 1.0f / (1 << -ENCODE_MIN_EXPONENT);
+constexpr int FLOAT_MANTISSA_BITS = 23;
+constexpr int FLOAT_EXPONENT_BIAS = 127;
+constexpr int ENCODE_SHIFT = FLOAT_MANTISSA_BITS - ENCODE_MANTISSA_BITS;
+constexpr int32_t ENCODE_MIN_BITS = (FLOAT_EXPONENT_BIAS + ENCODE_MIN_EXPONENT) << FLOAT_MANTISSA_BITS;
+constexpr int32_t ENCODE_ONE_BITS = FLOAT_EXPONENT_BIAS << FLOAT_MANTISSA_BITS;
+// 1 << (ENCODE_SHIFT - 1) rounds to the nearest entry
+constexpr int32_t ENCODE_ROUNDING = (1 << (ENCODE_SHIFT - 1)) - ENCODE_MIN_BITS;
+constexpr int ENCODE_TABLE_SIZE = ((ENCODE_ONE_BITS - ENCODE_MIN_BITS) >> ENCODE_SHIFT) + 1;
+// the pixels converted together, each channel of them in one vector
+constexpr uint32_t PIXELS_PER_BATCH = 4;
+constexpr size_t MAX_GAMUT_LUT_CACHE_SIZE = 16;
+
+float BitsToFloat(int32_t bits)
+{
+    float val = 0.0f;
+    static_assert(sizeof(val) == sizeof(bits), "float is not 32 bits");
+    (void)memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+int32_t FloatToBits(float val)
+{
+    int32_t bits = 0;
+    (void)memcpy(&bits, &val, sizeof(bits));
+    return bits;
+}
+
+// The conversion from one color space to another for 8-bit outputs. The transfer functions are turned into tables and
+// the two matrices through XYZ into one:
+// - decode: the linear value of every 8-bit and 10-bit input;
+// - encode: the output of every linear value rounded to ENCODE_MANTISSA_BITS of mantissa.
+// The matrix and the rounding run on PIXELS_PER_BATCH pixels at a time with NEON or SSE2.
+class GamutConversionLut {
+public:
+    GamutConversionLut(const SimpleColorSpace& srcColorSpace, const SimpleColorSpace& dstColorSpace);
+    ~GamutConversionLut() = default;
+
+    float DecodeUint8(uint8_t val) const
+    {
+        return decode8_[val];
+    }
+
+    float DecodeUint10(uint16_t val) const
+    {
+        // the 16-bit stub format holds 10-bit values, the larger ones are not in the table
+        return val <= maxUint10 ? decode10_[val] : srcColorSpace_.ChannelToLinear(RGBUint10ToFloat(val));
+    }
+
+    // the linear source channels of a batch of pixels to the indices of their outputs in the encode table.
+    void Transform(const float (&rgb)[3][PIXELS_PER_BATCH], int32_t (&indices)[3][PIXELS_PER_BATCH]) const;
+
+    uint8_t Encode(int32_t index) const
+    {
+        return encodeTable_[index];
+    }
+
+private:
+    SimpleColorSpace srcColorSpace_;
+    std::array<float, UINT8_LEVELS> decode8_ = {};
+    std::array<float, UINT10_LEVELS> decode10_ = {};
+    float rows_[3][3] = {}; // 3 rows, 3 columns
+    std::array<uint8_t, ENCODE_TABLE_SIZE> encodeTable_ = {};
+};
+
+GamutConversionLut::GamutConversionLut(const SimpleColorSpace& srcColorSpace, const SimpleColorSpace& dstColorSpace)
+    : srcColorSpace_(srcColorSpace)
+{
+    for (int i = 0; i < UINT8_LEVELS; i++) {
+        decode8_[i] = srcColorSpace.ChannelToLinear(RGBUint8ToFloat(static_cast<uint8_t>(i)));
+    }
+    for (int i = 0; i < UINT10_LEVELS; i++) {
+        decode10_[i] = srcColorSpace.ChannelToLinear(RGBUint10ToFloat(static_cast<uint16_t>(i)));
+    }
+
+    Matrix3f matrix = srcColorSpace.LinearMatrixTo(dstColorSpace);
+    const float* data = matrix.GetData(); // column major
+    for (int col = 0; col < 3; col++) { // 3 columns
+        for (int row = 0; row < 3; row++) { // 3 rows
+            rows_[row][col] = data[col * 3 + row]; // 3 rows
+        }
+    }
+
+    encodeTable_[0] = RGBFloatToUint8(dstColorSpace.ChannelFromLinear(0.0f));
+    for (int i = 1; i < ENCODE_TABLE_SIZE; i++) {
+        float linear = BitsToFloat(ENCODE_MIN_BITS + (i << ENCODE_SHIFT));
+        encodeTable_[i] = RGBFloatToUint8(dstColorSpace.ChannelFromLinear(linear));
+    }
+}
+
+void GamutConversionLut::Transform(const float (&rgb)[3][PIXELS_PER_BATCH],
+    int32_t (&indices)[3][PIXELS_PER_BATCH]) const
+{
+    // the linear value is clamped to [ENCODE_MIN_LINEAR, 1.0f], NaN to ENCODE_MIN_LINEAR, and its bits are rounded to
+    // the entry.
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    const float32x4_t red = vld1q_f32(rgb[0]);
+    const float32x4_t green = vld1q_f32(rgb[1]);
+    const float32x4_t blue = vld1q_f32(rgb[2]); // 2 is index
+    const float32x4_t minLinear = vdupq_n_f32(ENCODE_MIN_LINEAR);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const int32x4_t rounding = vdupq_n_s32(ENCODE_ROUNDING);
+    for (int row = 0; row < 3; row++) { // 3 rows
+        float32x4_t linear = vmulq_n_f32(red, rows_[row][0]);
+        linear = vmlaq_n_f32(linear, green, rows_[row][1]);
+        linear = vmlaq_n_f32(linear, blue, rows_[row][2]); // 2 is index
+        linear = vminq_f32(vbslq_f32(vcgeq_f32(linear, minLinear), linear, minLinear), one);
+        int32x4_t bits = vaddq_s32(vreinterpretq_s32_f32(linear), rounding);
+        vst1q_s32(indices[row], vshrq_n_s32(bits, ENCODE_SHIFT));
+    }
+#elif defined(__SSE2__)
+    const __m128 red = _mm_loadu_ps(rgb[0]);
+    const __m128 green = _mm_loadu_ps(rgb[1]);
+    const __m128 blue = _mm_loadu_ps(rgb[2]); // 2 is index
+    const __m128 minLinear = _mm_set1_ps(ENCODE_MIN_LINEAR);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128i rounding = _mm_set1_epi32(ENCODE_ROUNDING);
+    for (int row = 0; row < 3; row++) { // 3 rows
+        __m128 linear = _mm_mul_ps(red, _mm_set1_ps(rows_[row][0]));
+        linear = _mm_add_ps(linear, _mm_mul_ps(green, _mm_set1_ps(rows_[row][1])));
+        linear = _mm_add_ps(linear, _mm_mul_ps(blue, _mm_set1_ps(rows_[row][2]))); // 2 is index
+        // maxps returns its second operand for NaN
+        linear = _mm_min_ps(_mm_max_ps(linear, minLinear), one);
+        __m128i bits = _mm_add_epi32(_mm_castps_si128(linear), rounding);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(indices[row]), _mm_srai_epi32(bits, ENCODE_SHIFT));
+    }
+#else
+    for (int row = 0; row < 3; row++) { // 3 rows
+        for (uint32_t i = 0; i < PIXELS_PER_BATCH; i++) {
+            float linear = rows_[row][0] * rgb[0][i] + rows_[row][1] * rgb[1][i] +
+                rows_[row][2] * rgb[2][i]; // 2 is index
+            linear = (linear >= ENCODE_MIN_LINEAR) ? std::min(linear, 1.0f) : ENCODE_MIN_LINEAR;
+            indices[row][i] = (FloatToBits(linear) + ENCODE_ROUNDING) >> ENCODE_SHIFT;
+        }
+    }
+#endif
+}
+
+using RgbBatch = float[3][PIXELS_PER_BATCH];
+using IndexBatch = int32_t[3][PIXELS_PER_BATCH];
+
+// The pixel formats of the conversion, ConvertPixels is instantiated for each of them. Load decodes the pixel i of a
+// batch and Store encodes it.
+struct Rgba8888Format {
+    static constexpr uint32_t SRC_BYTES = 4;
+    static constexpr uint32_t DST_BYTES = 4;
+    static void Load(const GamutConversionLut& lut, const uint8_t* src, RgbBatch& rgb, uint32_t i)
+    {
+        // R: src[0], G: src[1], B: src[2]
+        rgb[0][i] = lut.DecodeUint8(src[0]);
+        rgb[1][i] = lut.DecodeUint8(src[1]);
+        rgb[2][i] = lut.DecodeUint8(src[2]); // 2 is index
+    }
+    static void Store(const GamutConversionLut& lut, const IndexBatch& indices, uint32_t i, const uint8_t* src,
+        uint8_t* dst)
+    {
+        dst[0] = lut.Encode(indices[0][i]);
+        dst[1] = lut.Encode(indices[1][i]);
+        dst[2] = lut.Encode(indices[2][i]); // 2 is index
+        dst[3] = src[3]; // Alpha: copy src[3] to dst[3]
+    }
+};
+
+struct Rgb888Format {
+    static constexpr uint32_t SRC_BYTES = 3;
+    static constexpr uint32_t DST_BYTES = 3;
+    static void Load(const GamutConversionLut& lut, const uint8_t* src, RgbBatch& rgb, uint32_t i)
+    {
+        Rgba8888Format::Load(lut, src, rgb, i);
+    }
+    static void Store(const GamutConversionLut& lut, const IndexBatch& indices, uint32_t i, const uint8_t*,
+        uint8_t* dst)
+    {
+        dst[0] = lut.Encode(indices[0][i]);
+        dst[1] = lut.Encode(indices[1][i]);
+        dst[2] = lut.Encode(indices[2][i]); // 2 is index
+    }
+};
+
+struct Bgra8888Format {
+    static constexpr uint32_t SRC_BYTES = 4;
+    static constexpr uint32_t DST_BYTES = 4;
+    static void Load(const GamutConversionLut& lut, const uint8_t* src, RgbBatch& rgb, uint32_t i)
+    {
+        // R: src[2], G: src[1], B: src[0]
+        rgb[0][i] = lut.DecodeUint8(src[2]); // 2 is index
+        rgb[1][i] = lut.DecodeUint8(src[1]);
+        rgb[2][i] = lut.DecodeUint8(src[0]); // 2 is index
+    }
+    static void Store(const GamutConversionLut& lut, const IndexBatch& indices, uint32_t i, const uint8_t* src,
+        uint8_t* dst)
+    {
+        dst[2] = lut.Encode(indices[0][i]); // 2 is index
+        dst[1] = lut.Encode(indices[1][i]);
+        dst[0] = lut.Encode(indices[2][i]); // 2 is index
+        dst[3] = src[3]; // Alpha: copy src[3] to dst[3]
+    }
+};
+
+// 8 bytes per pixel and HDR pictures are always redrawn as sRGB
+struct Rgba16161616Format {
+    static constexpr uint32_t SRC_BYTES = 8;
+    static constexpr uint32_t DST_BYTES = 4;
+    static void Load(const GamutConversionLut& lut, const uint8_t* src, RgbBatch& rgb, uint32_t i)
+    {
+        auto src16 = reinterpret_cast<const uint16_t*>(src);
+        rgb[0][i] = lut.DecodeUint10(src16[0]);
+        rgb[1][i] = lut.DecodeUint10(src16[1]);
+        rgb[2][i] = lut.DecodeUint10(src16[2]); // 2 is index
+    }
+    static void Store(const GamutConversionLut& lut, const IndexBatch& indices, uint32_t i, const uint8_t* src,
+        uint8_t* dst)
+    {
+        auto src16 = reinterpret_cast<const uint16_t*>(src);
+        dst[0] = lut.Encode(indices[0][i]);
+        dst[1] = lut.Encode(indices[1][i]);
+        dst[2] = lut.Encode(indices[2][i]); // 2 is index
+        // Alpha: linear transfer src[3] to dst[3]
+        dst[3] = RGBFloatToUint8(RGBUint10ToFloat(src16[3])); // 3 is index
+    }
+};
+
+struct Rgba1010102Format {
+    static constexpr uint32_t SRC_BYTES = 4;
+    static constexpr uint32_t DST_BYTES = 4;
+    static void Load(const GamutConversionLut& lut, const uint8_t* src, RgbBatch& rgb, uint32_t i)
+    {
+        uint32_t src32 = *reinterpret_cast<const uint32_t*>(src);
+        // R: 0-9 bits, G: 10-19 bits, B: 20-29 bits
+        rgb[0][i] = lut.DecodeUint10(src32 & 0x3FF);
+        rgb[1][i] = lut.DecodeUint10((src32 >> 10) & 0x3FF); // 10 bits of red
+        rgb[2][i] = lut.DecodeUint10((src32 >> 20) & 0x3FF); // 2 is index, 20 bits of red and green
+    }
+    static void Store(const GamutConversionLut& lut, const IndexBatch& indices, uint32_t i, const uint8_t* src,
+        uint8_t* dst)
+    {
+        const uint8_t rbgBitsNum = 30;
+        const uint8_t alphaBitMask = 0x3;
+        dst[0] = lut.Encode(indices[0][i]);
+        dst[1] = lut.Encode(indices[1][i]);
+        dst[2] = lut.Encode(indices[2][i]); // 2 is index
+        // Alpha: copy src[3] to dst[3]
+        dst[3] = static_cast<uint8_t>((*reinterpret_cast<const uint32_t*>(src) >> rbgBitsNum) & alphaBitMask);
+    }
+};
+
+template<typename Format>
+void ConvertPixels(const GamutConversionLut& lut, const uint8_t* src, uint32_t srcSize, std::vector<uint8_t>& dstBuf)
+{
+    uint32_t pixelCount = srcSize / Format::SRC_BYTES;
+    // a dstBuf kept by the caller is only reallocated when it grows
+    dstBuf.resize(static_cast<size_t>(pixelCount) * Format::DST_BYTES);
+    uint8_t* dst = dstBuf.data();
+    // the lanes past the last pixel keep the values of the previous batch, they are not stored
+    RgbBatch rgb = {};
+    IndexBatch indices;
+    for (uint32_t begin = 0; begin < pixelCount; begin += PIXELS_PER_BATCH) {
+        uint32_t count = std::min(PIXELS_PER_BATCH, pixelCount - begin);
+        for (uint32_t i = 0; i < count; i++) {
+            Format::Load(lut, src + i * Format::SRC_BYTES, rgb, i);
+        }
+        lut.Transform(rgb, indices);
+        for (uint32_t i = 0; i < count; i++) {
+            Format::Store(lut, indices, i, src + i * Format::SRC_BYTES, dst + i * Format::DST_BYTES);
+        }
+        src += count * Format::SRC_BYTES;
+        dst += count * Format::DST_BYTES;
+    }
+}
+
+bool ConvertPixelsOfFormat(const GamutConversionLut& lut, int32_t pixelFormat, const uint8_t* src, uint32_t srcSize,
+    std::vector<uint8_t>& dstBuf)
 {
     // Because PixelFormat does not have enumeration for RGBA_16 or RGBA_1010102,
     // we use two special IF statements here to realize the transfer process.
     // They should to be adjusted to the SWITCH process after the enumerations are added.
     if (pixelFormat == STUB_PIXEL_FMT_RGBA_16161616) {
-        auto src16 = reinterpret_cast<const uint16_t*>(src);
-        // R: src[0], G: src[1], B: src[2]
-        srcColor = {RGBUint10ToFloat(src16[0]), RGBUint10ToFloat(src16[1]), RGBUint10ToFloat(src16[2])};
-        // R: dst + 0, G: dst + 1, B: dst + 2
-        colorDst = {dst + 0, dst + 1, dst + 2};
-        // Alpha: linear transfer src[3] to dst[3]
-        dst[3] = RGBFloatToUint8(RGBUint10ToFloat(src16[3]));
-        const uint8_t outPixelBits = 4;
-        const uint8_t inPixelBits = 8;
-        // 8 bytes per pixel and HDR pictures are always redrawn as sRGB
-        return std::make_pair(inPixelBits, outPixelBits);
+        ConvertPixels<Rgba16161616Format>(lut, src, srcSize, dstBuf);
+        return true;
     }
     if (pixelFormat == STUB_PIXEL_FMT_RGBA_1010102) {
-        auto src32 = reinterpret_cast<const uint32_t*>(src);
-        // R: 0-9 bits, G: 10-19 ts, B: 20-29bits
-        srcColor = {RGBUint10ToFloat((*src32) & 0x3FF), RGBUint10ToFloat(((*src32) >> 10) & 0x3FF),
-             RGBUint10ToFloat(((*src32) >> 20) & 0x3FF)};
-        // R: dst + 0, G: dst + 1, B: dst + 2
-        colorDst = {dst + 0, dst + 1, dst + 2};
-        // Alpha: copy src[3] to dst[3]
-        const uint8_t rbgBitsNum = 30;
-        const uint8_t alphaBitMask = 0x3;
-        const uint8_t alphaPos = 3;
-        dst[alphaPos] = static_cast<uint8_t>(((*src32) >> rbgBitsNum) & alphaBitMask);
-        return std::make_pair(4, 4); // 4 bytes per pixel and HDR pictures are always redrawn as sRGB
+        ConvertPixels<Rgba1010102Format>(lut, src, srcSize, dstBuf);
+        return true;
     }
     switch (static_cast<PixelFormat>(pixelFormat)) {
         case PixelFormat::PIXEL_FMT_RGBX_8888:
         case PixelFormat::PIXEL_FMT_RGBA_8888: {
-            // R: src[0], G: src[1], B: src[2]
-            srcColor = {RGBUint8ToFloat(src[0]), RGBUint8ToFloat(src[1]), RGBUint8ToFloat(src[2])};
-            // R: dst + 0, G: dst + 1, B: dst + 2
-            colorDst = {dst + 0, dst + 1, dst + 2};
-            // Alpha: copy src[3] to dst[3]
-            dst[3] = src[3];
-            return std::make_pair(4, 4); // 4 bytes per pixel.
+            ConvertPixels<Rgba8888Format>(lut, src, srcSize, dstBuf);
+            return true;
         }
         case PixelFormat::PIXEL_FMT_RGB_888: {
-            // R: src[0], G: src[1], B: src[2]
-            srcColor = {RGBUint8ToFloat(src[0]), RGBUint8ToFloat(src[1]), RGBUint8ToFloat(src[2])};
-            // R: dst + 0, G: dst + 1, B: dst + 2
-            colorDst = {dst + 0, dst + 1, dst + 2};
-            return std::make_pair(3, 3); // 3 bytes per pixel.
+            ConvertPixels<Rgb888Format>(lut, src, srcSize, dstBuf);
+            return true;
         }
         case PixelFormat::PIXEL_FMT_BGRX_8888:
         case PixelFormat::PIXEL_FMT_BGRA_8888: {
-            // R: src[2], G: src[1], B: src[0]
-            srcColor = {RGBUint8ToFloat(src[2]), RGBUint8ToFloat(src[1]), RGBUint8ToFloat(src[0])};
-            // R: dst + 2, G: dst + 1, B: dst + 0
-            colorDst = {dst + 2, dst + 1, dst + 0};
-            // Alpha: copy src[3] to dst[3]
-            dst[3] = src[3];
-            return std::make_pair(4, 4); // 4 bytes per pixel.
+            ConvertPixels<Bgra8888Format>(lut, src, srcSize, dstBuf);
+            return true;
         }
         default: {
-            RS_LOGE("RGBUintToFloat: unexpected pixelFormat(%d).", pixelFormat);
-            return std::make_pair(0, 0);
+            RS_LOGE("ConvertPixelsOfFormat: unexpected pixelFormat(%d).", pixelFormat);
+            return false;
         }
     }
 }
 
-Offset ConvertColorGamut(uint8_t* dst, uint8_t* src, int32_t pixelFormat, SimpleColorSpace& srcColorSpace,
-    SimpleColorSpace& dstColorSpace)
+bool IsHdrGamut(ColorGamut colorGamut)
+{
+    return colorGamut == ColorGamut::COLOR_GAMUT_BT2020 || colorGamut == ColorGamut::COLOR_GAMUT_BT2100_PQ;
+}
+
+size_t HashMetaData(const std::vector<GraphicHDRMetaData>& metaDatas)
+{
+    size_t hash = metaDatas.size();
+    for (const auto& metaData : metaDatas) {
+        // 31: the multiplier of a polynomial hash
+        hash = hash * 31 + static_cast<size_t>(metaData.key);
+        hash = hash * 31 + std::hash<float>()(metaData.value);
+    }
+    return hash;
+}
+
+bool IsSameMetaData(const std::vector<GraphicHDRMetaData>& lhs, const std::vector<GraphicHDRMetaData>& rhs)
 {
-    Vector3f srcColor;
-    Array3ptr colorDst; // color dst, 3 bytes (R G B).
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+        [](const GraphicHDRMetaData& a, const GraphicHDRMetaData& b) { return a.key == b.key && a.value == b.value; });
+}
 
-    Offset len = RGBUintToFloat(dst, src, pixelFormat, srcColor, colorDst);
-    Vector3f outColor = dstColorSpace.XYZToRGB(srcColorSpace.RGBToXYZ(srcColor));
-    *(colorDst[0]) = RGBFloatToUint8(outColor[0]); // outColor 0 to colorDst[0]
-    *(colorDst[1]) = RGBFloatToUint8(outColor[1]); // outColor 1 to colorDst[1]
-    *(colorDst[2]) = RGBFloatToUint8(outColor[2]); // outColor 2 to colorDst[2]
+// The tables of the recently used pairs of gamuts. The metadata only matter for the HDR gamuts, they are kept to
+// tell the colliding hashes apart.
+std::shared_ptr<const GamutConversionLut> GetGamutConversionLut(ColorGamut srcGamut, ColorGamut dstGamut,
+    const std::vector<GraphicHDRMetaData>& metaDatas)
+{
+    struct CacheEntry {
+        std::vector<GraphicHDRMetaData> metaDatas;
+        std::shared_ptr<const GamutConversionLut> lut;
+    };
+    using CacheKey = std::tuple<ColorGamut, ColorGamut, size_t>;
+    static std::mutex cacheMutex;
+    static std::map<CacheKey, CacheEntry> cache;
 
-    return len;
+    bool useMetaData = IsHdrGamut(srcGamut) || IsHdrGamut(dstGamut);
+    CacheKey key { srcGamut, dstGamut, useMetaData ? HashMetaData(metaDatas) : 0 };
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto iter = cache.find(key);
+    if (iter != cache.end() && (!useMetaData || IsSameMetaData(iter->second.metaDatas, metaDatas))) {
+        return iter->second.lut;
+    }
+    RS_TRACE_NAME("GenerateGamutConversionLut");
+    if (cache.size() >= MAX_GAMUT_LUT_CACHE_SIZE) {
+        cache.clear();
+    }
+    auto lut = std::make_shared<const GamutConversionLut>(GetColorSpaceOfCertainGamut(srcGamut, metaDatas),
+        GetColorSpaceOfCertainGamut(dstGamut, metaDatas));
+    cache[key] = CacheEntry { useMetaData ? metaDatas : std::vector<GraphicHDRMetaData>(), lut };
+    return lut;
 }
 
 bool ConvertBufferColorGamut(std::vector<uint8_t>& dstBuf, const sptr<OHOS::SurfaceBuffer>& srcBuf,
@@ -617,27 +924,16 @@ bool ConvertBufferColorGamut(std::vector<uint8_t>& dstBuf, const sptr<OHOS::Surf
     }
 
     uint32_t bufferSize = srcBuf->GetSize();
-    dstBuf.resize(bufferSize);
-
     auto bufferAddr = srcBuf->GetVirAddr();
-    uint8_t* srcStart = static_cast<uint8_t*>(bufferAddr);
-
-    uint32_t offsetDst = 0, offsetSrc = 0;
-    auto& srcColorSpace = GetColorSpaceOfCertainGamut(srcGamut, metaDatas);
-    auto& dstColorSpace = GetColorSpaceOfCertainGamut(dstGamut, metaDatas);
-    while (offsetSrc < bufferSize) {
-        uint8_t* dst = &dstBuf[offsetDst];
-        uint8_t* src = srcStart + offsetSrc;
-        Offset len = ConvertColorGamut(dst, src, pixelFormat, srcColorSpace, dstColorSpace);
-        if (len.first == 0 || len.second == 0) {
-            return false;
-        }
-        offsetSrc += len.first;
-        offsetDst += len.second;
+    const uint8_t* srcStart = static_cast<const uint8_t*>(bufferAddr);
+    if (srcStart == nullptr) {
+        RS_LOGE("ConvertBufferColorGamut: null buffer ptr.");
+        return false;
     }
-    dstBuf.resize(offsetDst); // dstBuf size might not be as large ad srcBuf in HDR
 
-    return true;
+    auto lut = GetGamutConversionLut(srcGamut, dstGamut, metaDatas);
+    // dstBuf size might not be as large ad srcBuf in HDR
+    return ConvertPixelsOfFormat(*lut, pixelFormat, srcStart, bufferSize, dstBuf);
 }
 
 SkImageInfo GenerateSkImageInfo(const sptr<OHOS::SurfaceBuffer>& buffer)
@@ -648,57 +944,6 @@ SkImageInfo GenerateSkImageInfo(const sptr<OHOS::SurfaceBuffer>& buffer)
         colorType, kPremul_SkAlphaType);
 }
 
-// YUV to RGBA: Pixel value conversion table
-static int Table_fv1[256] = { -180, -179, -177, -176, -174, -173, -172, -170, -169, -167, -166, -165, -163, -162,
-    -160, -159, -158, -156, -155, -153, -152, -151, -149, -148, -146, -145, -144, -142, -141, -139,
-    -138, -137,  -135, -134, -132, -131, -130, -128, -127, -125, -124, -123, -121, -120, -118,
-    -117, -115, -114, -113, -111, -110, -108, -107, -106, -104, -103, -101, -100, -99, -97, -96,
-    -94, -93, -92, -90,  -89, -87, -86, -85, -83, -82, -80, -79, -78, -76, -75, -73, -72, -71,
-    -69, -68, -66, -65, -64, -62, -61, -59, -58, -57, -55, -54, -52, -51, -50, -48, -47, -45,
-    -44, -43, -41, -40, -38, -37,  -36, -34, -33, -31, -30, -29, -27, -26, -24, -23, -22, -20,
-    -19, -17, -16, -15, -13, -12, -10, -9, -8, -6, -5, -3, -2, 0, 1, 2, 4, 5, 7, 8, 9, 11, 12,
-    14, 15, 16, 18, 19, 21, 22, 23, 25, 26, 28, 29, 30, 32, 33, 35, 36, 37, 39, 40, 42, 43, 44,
-    46, 47, 49, 50, 51, 53, 54, 56, 57, 58, 60, 61, 63, 64, 65, 67, 68, 70, 71, 72, 74, 75, 77,
-    78, 79, 81, 82, 84, 85, 86, 88, 89, 91, 92, 93, 95, 96, 98, 99, 100, 102, 103, 105, 106, 107,
-    109, 110, 112, 113, 114, 116, 117, 119, 120, 122, 123, 124, 126, 127, 129, 130, 131, 133, 134,
-    136, 137, 138, 140, 141, 143, 144, 145, 147, 148,  150, 151, 152, 154, 155, 157, 158, 159, 161,
-    162, 164, 165, 166, 168, 169, 171, 172, 173, 175, 176, 178 };
-static int Table_fv2[256] = { -92, -91, -91, -90, -89, -88, -88, -87, -86, -86, -85, -84, -83, -83, -82, -81,
-    -81, -80, -79, -78, -78, -77, -76, -76, -75, -74, -73, -73, -72, -71, -71, -70, -69, -68, -68, -67, -66,
-    -66, -65, -64, -63, -63, -62, -61, -61, -60, -59, -58, -58, -57, -56, -56, -55, -54, -53, -53, -52, -51,
-    -51, -50, -49, -48, -48, -47, -46, -46, -45, -44, -43, -43, -42, -41, -41, -40, -39, -38, -38, -37, -36,
-    -36, -35, -34, -33, -33, -32, -31, -31, -30, -29, -28, -28, -27, -26, -26, -25, -24, -23, -23, -22, -21,
-    -21, -20, -19, -18, -18, -17, -16, -16, -15, -14, -13, -13, -12, -11, -11, -10, -9, -8, -8, -7, -6, -6,
-    -5, -4, -3, -3, -2, -1, 0, 0, 1, 2, 2, 3, 4, 5, 5, 6, 7, 7, 8, 9, 10, 10, 11, 12, 12, 13, 14, 15, 15, 16,
-    17, 17, 18, 19, 20, 20, 21, 22, 22, 23, 24, 25, 25, 26, 27, 27, 28, 29, 30, 30, 31, 32, 32, 33, 34, 35, 35,
-    36, 37, 37, 38, 39, 40, 40, 41, 42, 42, 43, 44, 45, 45, 46, 47, 47, 48, 49, 50, 50, 51, 52, 52, 53, 54, 55,
-    55, 56, 57, 57, 58, 59, 60, 60, 61, 62, 62, 63, 64, 65, 65, 66, 67, 67, 68, 69, 70, 70, 71, 72, 72, 73, 74,
-    75, 75, 76, 77, 77, 78, 79, 80, 80, 81, 82, 82, 83, 84, 85, 85, 86, 87, 87, 88, 89, 90, 90 };
-static int Table_fu1[256] = { -44, -44, -44, -43, -43, -43, -42, -42, -42, -41, -41, -41, -40, -40, -40, -39, -39,
-    -39, -38, -38, -38, -37, -37, -37, -36, -36, -36, -35, -35, -35, -34, -34, -33, -33, -33, -32, -32, -32, -31,
-    -31, -31, -30, -30, -30, -29, -29, -29, -28, -28, -28, -27, -27, -27, -26, -26, -26, -25, -25, -25, -24, -24,
-    -24, -23, -23, -22, -22, -22, -21, -21, -21, -20, -20, -20, -19, -19, -19, -18, -18, -18, -17, -17, -17, -16,
-    -16, -16, -15, -15, -15, -14, -14, -14, -13, -13, -13, -12, -12, -11, -11, -11, -10, -10, -10, -9, -9, -9, -8,
-    -8, -8, -7, -7, -7, -6, -6, -6, -5, -5, -5, -4, -4, -4, -3, -3, -3, -2, -2, -2, -1, -1, 0, 0, 0, 1, 1, 1, 2, 2,
-    2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 11, 11, 11, 12, 12, 12, 13, 13, 13,
-    14, 14, 14, 15, 15, 15, 16, 16, 16, 17, 17, 17, 18, 18, 18, 19, 19, 19, 20, 20, 20, 21, 21, 22, 22, 22, 23,
-    23, 23, 24, 24, 24, 25, 25, 25, 26, 26, 26, 27, 27, 27, 28, 28, 28, 29, 29, 29, 30, 30, 30, 31, 31, 31, 32,
-    32, 33, 33, 33, 34, 34, 34, 35, 35, 35, 36, 36, 36, 37, 37, 37, 38, 38, 38, 39, 39, 39, 40, 40, 40, 41, 41,
-    41, 42, 42, 42, 43, 43 };
-static int Table_fu2[256] = { -227, -226, -224, -222, -220, -219, -217, -215, -213, -212, -210, -208, -206, -204,
-    -203, -201, -199, -197, -196, -194, -192, -190, -188, -187, -185, -183, -181, -180, -178, -176, -174, -173,
-    -171, -169, -167, -165, -164, -162, -160, -158, -157, -155, -153, -151, -149, -148, -146, -144, -142, -141,
-    -139, -137, -135, -134, -132, -130, -128, -126, -125, -123, -121, -119, -118, -116, -114, -112, -110, -109,
-    -107, -105, -103, -102, -100, -98, -96, -94, -93, -91, -89, -87, -86, -84, -82, -80, -79, -77, -75, -73,
-    -71, -70, -68, -66, -64, -63, -61, -59, -57, -55, -54, -52, -50, -48, -47, -45, -43, -41, -40, -38, -36,
-    -34, -32, -31, -29, -27, -25, -24, -22, -20, -18, -16, -15, -13, -11, -9, -8, -6, -4, -2, 0, 1, 3, 5, 7, 8,
-    10, 12, 14, 15, 17, 19, 21, 23, 24, 26, 28, 30, 31, 33, 35, 37, 39, 40, 42, 44, 46, 47, 49, 51, 53, 54, 56,
-    58, 60, 62, 63, 65, 67, 69, 70, 72, 74, 76, 78, 79, 81, 83, 85, 86, 88, 90, 92, 93, 95, 97, 99, 101, 102,
-    104, 106, 108, 109, 111, 113, 115, 117, 118, 120, 122, 124, 125, 127, 129, 131, 133, 134, 136, 138, 140, 141,
-    143, 145, 147, 148, 150, 152, 154, 156, 157, 159, 161, 163, 164, 166, 168, 170, 172, 173, 175, 177, 179, 180,
-    182, 184, 186, 187, 189, 191, 193, 195, 196, 198, 200, 202, 203, 205, 207, 209, 211, 212, 214, 216, 218,
-    219, 221, 223, 225 };
-
 bool ConvertYUV420SPToRGBA(std::vector<uint8_t>& rgbaBuf, const sptr<OHOS::SurfaceBuffer>& srcBuf)
 {
     if (srcBuf == nullptr || rgbaBuf.empty()) {
@@ -736,42 +981,21 @@ bool ConvertYUV420SPToRGBA(std::vector<uint8_t>& rgbaBuf, const sptr<OHOS::Surfa
             bufferWidth, srcBuf->GetHeight(), bufferStride, bufferSize, totalLen);
         return false;
     }
-    uint8_t* ybase = src;
-    uint8_t* ubase = &src[len];
-
-    int rgb[3] = {0, 0, 0};
-    int idx = 0;
-    int rdif = 0;
-    int invgdif = 0;
-    int bdif = 0;
-    for (int i = 0; i < bufferHeight; i++) {
-        for (int j = 0; j < bufferWidth; j++) {
-            int Y = static_cast<int>(ybase[i * bufferStride + j]);
-            int U = static_cast<int>(ubase[i / 2 * bufferStride + (j / 2) * 2 + 1]);
-            int V = static_cast<int>(ubase[i / 2 * bufferStride + (j / 2) * 2]);
-            if (srcBuf->GetFormat() == PIXEL_FMT_YCBCR_420_SP) {
-                std::swap(U, V);
-            }
-            rdif = Table_fv1[V];
-            invgdif = Table_fu1[U] + Table_fv2[V];
-            bdif = Table_fu2[U];
-
-            rgb[0] = Y + rdif;
-            rgb[1] = Y - invgdif;
-            rgb[2] = Y + bdif; // 2 is index
-
-            for (int k = 0; k < 3; k++) { // 3 is index
-                idx = (i * bufferWidth + j) * 4 + k; // 4 is color channel
-                if (rgb[k] >= 0 && rgb[k] <= 255) { // 255 is upper threshold
-                    rgbaDst[idx] = static_cast<uint8_t>(rgb[k]);
-                } else {
-                    rgbaDst[idx] = (rgb[k] < 0) ? 0 : 255; // 255 is upper threshold
-                }
-            }
-            ++idx;
-            rgbaDst[idx] = 255; // 255 is upper threshold
-        }
+    if (rgbaBuf.size() < static_cast<size_t>(bufferWidth) * srcBuf->GetHeight() * 4) { // 4 is color channel
+        RS_LOGE("RSBaseRenderUtil::ConvertYUV420SPToRGBA rgba buffer too small, size = %zu", rgbaBuf.size());
+        return false;
     }
+
+    RS_TRACE_NAME("ConvertYUV420SPToRGBA");
+    YUV420SPImage image;
+    image.yPlane = src;
+    image.uvPlane = &src[len];
+    image.stride = bufferStride;
+    image.width = bufferWidth;
+    // the padding rows only move the chroma plane, they are not converted
+    image.height = srcBuf->GetHeight();
+    image.vFirst = srcBuf->GetFormat() != PIXEL_FMT_YCBCR_420_SP;
+    RSYuvConverter::Instance().ConvertYUV420SPToRGBA(image, rgbaDst);
     return true;
 }
 } // namespace Detail
@@ -870,6 +1094,12 @@ bool RSBaseRenderUtil::ReleaseBuffer(RSSurfaceHandler& surfaceHandler)
 
     auto& preBuffer = surfaceHandler.GetPreBuffer();
     if (preBuffer.buffer != nullptr) {
+        if (RSHardwareThread::Instance().IsStarted()) {
+            // the buffer may be on the screen until the commits which are posted before are done.
+            RSHardwareThread::Instance().ReleaseBuffer(consumer, preBuffer.buffer, preBuffer.releaseFence);
+            preBuffer.Reset();
+            return true;
+        }
         auto ret = consumer->ReleaseBuffer(preBuffer.buffer, preBuffer.releaseFence);
         if (ret != OHOS::SURFACE_ERROR_OK) {
             RS_LOGE("RsDebug surfaceHandler(id: %" PRIu64 ") ReleaseBuffer failed(ret: %d)!",
@@ -1148,7 +1378,14 @@ bool RSBaseRenderUtil::CreateNewColorGamutBitmap(sptr<OHOS::SurfaceBuffer> buffe
 std::unique_ptr<RSTransactionData> RSBaseRenderUtil::ParseTransactionData(MessageParcel& parcel)
 {
     RS_TRACE_NAME("UnMarsh RSTransactionData: data size:" + std::to_string(parcel.GetDataSize()));
-    auto transactionData = parcel.ReadParcelable<RSTransactionData>();
+    // the blobs are read in place from the slabs of the writer, which are held until the main thread is done with the
+    // transaction data, or right away if the parse fails.
+    auto slabHolder = std::make_shared<RSParcelSlabHolder>(parcel);
+    RSTransactionData* transactionData = nullptr;
+    {
+        RSParcelSlabHolder::Scope slabScope(*slabHolder);
+        transactionData = parcel.ReadParcelable<RSTransactionData>();
+    }
     if (!transactionData) {
         RS_TRACE_NAME("UnMarsh RSTransactionData fail!");
         RS_LOGE("UnMarsh RSTransactionData fail!");
@@ -1156,6 +1393,7 @@ std::unique_ptr<RSTransactionData> RSBaseRenderUtil::ParseTransactionData(Messag
     }
     RS_TRACE_NAME("UnMarsh RSTransactionData: recv data from " + std::to_string(transactionData->GetSendingPid()));
     std::unique_ptr<RSTransactionData> transData(transactionData);
+    transData->SetParcelSlabHolder(std::move(slabHolder));
     return transData;
 }
 
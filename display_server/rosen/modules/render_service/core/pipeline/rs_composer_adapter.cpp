@@ -20,13 +20,14 @@
 #include "platform/common/rs_log.h"
 #include "rs_base_render_util.h"
 #include "rs_divided_render_util.h"
+#include "rs_hardware_thread.h"
 #include "rs_trace.h"
 #include "string_utils.h"
 
 namespace OHOS {
 namespace Rosen {
 bool RSComposerAdapter::Init(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY,
-    float mirrorAdaptiveCoefficient, const FallbackCallback& cb)
+    float mirrorAdaptiveCoefficient, const FallbackCallback& cb, bool asyncCommit)
 {
     hdiBackend_ = HdiBackend::GetInstance();
     if (hdiBackend_ == nullptr) {
@@ -45,29 +46,43 @@ bool RSComposerAdapter::Init(const ScreenInfo& screenInfo, int32_t offsetX, int3
     }
 
     fallbackCb_ = cb;
-    auto onPrepareCompleteFunc = [this](auto& surface, const auto& param, void* data) {
-        OnPrepareComplete(surface, param, data);
-    };
-    hdiBackend_->RegPrepareComplete(onPrepareCompleteFunc, this);
+    isAsyncCommit_ = asyncCommit && RSHardwareThread::Instance().IsStarted();
+    if (!isAsyncCommit_) {
+        if (RSHardwareThread::Instance().IsStarted()) {
+            // the output and the backend are used on this thread from now on.
+            RSHardwareThread::Instance().WaitForIdle();
+        }
+        auto onPrepareCompleteFunc = [this](auto& surface, const auto& param, void* data) {
+            OnPrepareComplete(surface, param, data);
+        };
+        hdiBackend_->RegPrepareComplete(onPrepareCompleteFunc, this);
+    }
 
     offsetX_ = offsetX;
     offsetY_ = offsetY;
     mirrorAdaptiveCoefficient_ = mirrorAdaptiveCoefficient;
     screenInfo_ = screenInfo;
+    directClientCompEnableStatus_ = RSSystemProperties::GetDirectClientCompEnableStatus();
+    if (!isAsyncCommit_) {
+        SetOutputConfig(*output_, screenInfo_, directClientCompEnableStatus_);
+    }
 
-    IRect damageRect {0, 0, static_cast<int32_t>(screenInfo_.width), static_cast<int32_t>(screenInfo_.height)};
-    output_->SetOutputDamage(1, damageRect);
-    bool directClientCompEnableStatus = RSSystemProperties::GetDirectClientCompEnableStatus();
-    output_->SetDirectClientCompEnableStatus(directClientCompEnableStatus);
+    return true;
+}
+
+void RSComposerAdapter::SetOutputConfig(HdiOutput& output, const ScreenInfo& screenInfo,
+    bool directClientCompEnableStatus)
+{
+    IRect damageRect {0, 0, static_cast<int32_t>(screenInfo.width), static_cast<int32_t>(screenInfo.height)};
+    output.SetOutputDamage(1, damageRect);
+    output.SetDirectClientCompEnableStatus(directClientCompEnableStatus);
 
 #if (defined RS_ENABLE_GL) && (defined RS_ENABLE_EGLIMAGE)
     // enable direct GPU composition.
-    output_->SetLayerCompCapacity(LAYER_COMPOSITION_CAPACITY);
+    output.SetLayerCompCapacity(LAYER_COMPOSITION_CAPACITY);
 #else // (defined RS_ENABLE_GL) && (defined RS_ENABLE_EGLIMAGE)
-    output_->SetLayerCompCapacity(LAYER_COMPOSITION_CAPACITY_INVALID);
+    output.SetLayerCompCapacity(LAYER_COMPOSITION_CAPACITY_INVALID);
 #endif // (defined RS_ENABLE_GL) && (defined RS_ENABLE_EGLIMAGE)
-
-    return true;
 }
 
 void RSComposerAdapter::CommitLayers(const std::vector<LayerInfoPtr>& layers)
@@ -82,6 +97,19 @@ void RSComposerAdapter::CommitLayers(const std::vector<LayerInfoPtr>& layers)
         return;
     }
 
+    if (isAsyncCommit_) {
+        // the release fences are kept by the hardware thread for the buffers released after this commit.
+        RSHardwareCommit commit;
+        commit.output = output_;
+        commit.layers = layers;
+        commit.prepareOutput = [screenInfo = screenInfo_, status = directClientCompEnableStatus_](auto& output) {
+            SetOutputConfig(output, screenInfo, status);
+        };
+        commit.redraw = fallbackCb_;
+        RSHardwareThread::Instance().CommitLayers(std::move(commit));
+        return;
+    }
+
     // do composition.
     output_->SetLayerInfo(layers);
     std::vector<std::shared_ptr<HdiOutput>> outputs {output_};
@@ -702,7 +730,7 @@ void RSComposerAdapter::LayerScaleDown(const LayerInfoPtr& layer)
     }
 }
 
-// private func, guarantee the layer and surface are valid
+// guarantee the layer and surface are valid
 void RSComposerAdapter::LayerPresentTimestamp(const LayerInfoPtr& layer, const sptr<Surface>& surface)
 {
     if (!layer->IsSupportedPresentTimestamp()) {
@@ -47,13 +47,17 @@ public:
     RSComposerAdapter(const RSComposerAdapter&) = delete;
     void operator=(const RSComposerAdapter&) = delete;
 
+    // with asyncCommit, the layers are committed on the hardware thread if it is started and the fallback callback
+    // is called on this thread while the commit waits, so it must not use the objects of this frame.
     bool Init(const ScreenInfo& screenInfo, int32_t offsetX, int32_t offsetY, float mirrorAdaptiveCoefficient,
-        const FallbackCallback& cb);
+        const FallbackCallback& cb, bool asyncCommit = false);
 
     LayerInfoPtr CreateLayer(RSSurfaceRenderNode& node);
     LayerInfoPtr CreateLayer(RSDisplayRenderNode& node);
     void CommitLayers(const std::vector<LayerInfoPtr>& layers);
 
+    static void LayerPresentTimestamp(const LayerInfoPtr& layer, const sptr<Surface>& surface);
+
 private:
     // check if the node is out of the screen region.
     bool IsOutOfScreenRegion(const ComposeInfo& info) const;
@@ -71,7 +75,7 @@ private:
     void LayerRotate(const LayerInfoPtr& layer, RSBaseRenderNode& node) const;
     void LayerCrop(const LayerInfoPtr& layer) const;
     static void LayerScaleDown(const LayerInfoPtr& layer);
-    static void LayerPresentTimestamp(const LayerInfoPtr& layer, const sptr<Surface>& surface);
+    static void SetOutputConfig(HdiOutput& output, const ScreenInfo& screenInfo, bool directClientCompEnableStatus);
 
     void OnPrepareComplete(sptr<Surface>& surface, const PrepareCompleteParam& param, void* data);
     static void GetComposerInfoSrcRect(ComposeInfo &info, const RSSurfaceRenderNode& node);
@@ -87,6 +91,8 @@ private:
 
     float mirrorAdaptiveCoefficient_ = 1.0f;
     FallbackCallback fallbackCb_;
+    bool directClientCompEnableStatus_ = true;
+    bool isAsyncCommit_ = false;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_hardware_thread.h"
+
+#include <cinttypes>
+
+#include "rs_trace.h"
+
+#include "pipeline/rs_composer_adapter.h"
+#include "pipeline/rs_main_thread.h"
+#include "platform/common/rs_log.h"
+
+namespace OHOS::Rosen {
+RSHardwareThread& RSHardwareThread::Instance()
+{
+    static RSHardwareThread instance;
+    return instance;
+}
+
+void RSHardwareThread::Start()
+{
+    if (started_) {
+        return;
+    }
+    hdiBackend_ = HdiBackend::GetInstance();
+    if (hdiBackend_ == nullptr) {
+        RS_LOGE("RSHardwareThread::Start: hdiBackend is nullptr");
+        return;
+    }
+    runner_ = AppExecFwk::EventRunner::Create("RSHardwareThread");
+    handler_ = std::make_shared<AppExecFwk::EventHandler>(runner_);
+    started_ = true;
+    RS_LOGI("RSHardwareThread::Start");
+}
+
+bool RSHardwareThread::IsStarted() const
+{
+    return started_.load();
+}
+
+template<typename Predicate>
+void RSHardwareThread::WaitOnMainThread(std::unique_lock<std::mutex>& lock, Predicate condition)
+{
+    while (true) {
+        RunMainThreadTasks(lock);
+        if (condition()) {
+            return;
+        }
+        cond_.wait(lock);
+    }
+}
+
+void RSHardwareThread::RunMainThreadTasks(std::unique_lock<std::mutex>& lock)
+{
+    while (!mainThreadTasks_.empty()) {
+        MainThreadTask mainThreadTask = std::move(mainThreadTasks_.front());
+        mainThreadTasks_.pop();
+        lock.unlock();
+        mainThreadTask.task();
+        lock.lock();
+        *mainThreadTask.done = true;
+        cond_.notify_all();
+    }
+}
+
+void RSHardwareThread::CommitLayers(RSHardwareCommit&& commit)
+{
+    if (commit.output == nullptr) {
+        RS_LOGE("RSHardwareThread::CommitLayers: output is nullptr");
+        return;
+    }
+    uint32_t screenId = commit.output->GetScreenId();
+    {
+        RS_TRACE_NAME("RSHardwareThread::WaitForPendingCommits");
+        std::unique_lock<std::mutex> lock(mutex_);
+        WaitOnMainThread(lock, [this, screenId]() { return pendingCommits_[screenId] < MAX_PENDING_COMMITS; });
+        ++pendingCommits_[screenId];
+    }
+    auto task = [this, screenId, commit = std::move(commit)]() {
+        Commit(commit);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --pendingCommits_[screenId];
+        }
+        cond_.notify_all();
+    };
+    handler_->PostTask(task, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+}
+
+void RSHardwareThread::ReleaseBuffer(const sptr<Surface>& consumer, const sptr<SurfaceBuffer>& buffer,
+    const sptr<SyncFence>& releaseFence)
+{
+    auto task = [this, consumer, buffer, releaseFence]() {
+        sptr<SyncFence> fence = releaseFence;
+        // the fence of a synchronous commit is set to the buffer already, otherwise it is in the last commit.
+        // either way the fence of the last commit is for this buffer, the next buffer gets the one of its commit.
+        auto iter = releaseFences_.find(consumer->GetUniqueId());
+        if (iter != releaseFences_.end()) {
+            if (fence == nullptr || !fence->IsValid()) {
+                fence = iter->second.fence;
+            }
+            releaseFences_.erase(iter);
+        }
+        auto ret = consumer->ReleaseBuffer(buffer, fence);
+        if (ret != OHOS::SURFACE_ERROR_OK) {
+            RS_LOGE("RSHardwareThread::ReleaseBuffer: surface(id: %" PRIu64 ") ReleaseBuffer failed(ret: %d)!",
+                consumer->GetUniqueId(), ret);
+        }
+    };
+    handler_->PostTask(task, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+}
+
+void RSHardwareThread::WaitForIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    WaitOnMainThread(lock, [this]() {
+        for (const auto& [screenId, count] : pendingCommits_) {
+            if (count > 0) {
+                return false;
+            }
+        }
+        return true;
+    });
+}
+
+void RSHardwareThread::Commit(const RSHardwareCommit& commit)
+{
+    RS_TRACE_NAME("RSHardwareThread::Commit");
+    const auto& output = commit.output;
+    if (commit.prepareOutput != nullptr) {
+        commit.prepareOutput(*output);
+    }
+    // the backend has a single callback, the composer adapters of a synchronous commit replace it on the main
+    // thread while no commit is pending.
+    hdiBackend_->RegPrepareComplete([this](auto& surface, const auto& param, void*) {
+        OnPrepareComplete(surface, param);
+    }, this);
+    currentCommit_ = &commit;
+    output->SetLayerInfo(commit.layers);
+    std::vector<OutputPtr> outputs {output};
+    hdiBackend_->Repaint(outputs);
+    currentCommit_ = nullptr;
+
+    // get present timestamp from and set present timestamp to surface
+    for (const auto& layer : commit.layers) {
+        if (layer == nullptr || layer->GetSurface() == nullptr) {
+            RS_LOGW("RSHardwareThread::Commit: layer or layer's cSurface is nullptr");
+            continue;
+        }
+        RSComposerAdapter::LayerPresentTimestamp(layer, layer->GetSurface());
+    }
+
+    // keep the release fences for the buffers of the layers which are replaced in this frame,
+    // they are released after this commit.
+    const auto layersReleaseFence = hdiBackend_->GetLayersReleaseFence(output);
+    for (const auto& [layer, fence] : layersReleaseFence) {
+        if (layer == nullptr || layer->GetSurface() == nullptr) {
+            continue;
+        }
+        releaseFences_[layer->GetSurface()->GetUniqueId()] = { layer->GetSurface(), fence };
+    }
+    DropReleaseFencesOfDestroyedSurfaces();
+}
+
+void RSHardwareThread::DropReleaseFencesOfDestroyedSurfaces()
+{
+    for (auto iter = releaseFences_.begin(); iter != releaseFences_.end();) {
+        if (iter->second.surface.promote() == nullptr) {
+            iter = releaseFences_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void RSHardwareThread::OnPrepareComplete(sptr<Surface>& surface, const PrepareCompleteParam& param)
+{
+    if (!param.needFlushFramebuffer) {
+        RS_LOGD("RsDebug RSHardwareThread::OnPrepareComplete: no need to flush frame buffer");
+        return;
+    }
+    if (currentCommit_ == nullptr || currentCommit_->redraw == nullptr) {
+        return;
+    }
+    // the render context belongs to the main thread
+    RS_TRACE_NAME("RSHardwareThread::Redraw");
+    const auto& redraw = currentCommit_->redraw;
+    RunOnMainThread([&redraw, &surface, &param]() { redraw(surface, param.layers); });
+}
+
+void RSHardwareThread::RunOnMainThread(const std::function<void()>& task)
+{
+    bool done = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        mainThreadTasks_.push({ task, &done });
+    }
+    // wakes the main thread if it is waiting for this thread, otherwise runs the task after its current one
+    cond_.notify_all();
+    RSMainThread::Instance()->PostTask([this]() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        RunMainThreadTasks(lock);
+    });
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [&done]() { return done; });
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_HARDWARE_THREAD_H
+#define RS_HARDWARE_THREAD_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "event_handler.h"
+#include "hdi_backend.h"
+
+namespace OHOS::Rosen {
+// the layers of a frame for one output
+struct RSHardwareCommit {
+    OutputPtr output;
+    std::vector<LayerInfoPtr> layers;
+    // sets the damage and the composition options of the output, called on the hardware thread before the layers
+    std::function<void(HdiOutput& output)> prepareOutput;
+    // draws the layers the device can not compose into the framebuffer, called on the main thread
+    std::function<void(const sptr<Surface>& surface, const std::vector<LayerInfoPtr>& layers)> redraw;
+};
+
+// Commits the layers of the uni render to the screens on a dedicated thread, so that the main thread can go on with
+// the next frame while the device commits the last one. At most MAX_PENDING_COMMITS frames of an output wait for
+// their commit, beyond that the main thread waits for the oldest one. The buffers of the surfaces are released on
+// the same thread after the commits posted before them, with the release fences of these commits.
+class RSHardwareThread {
+public:
+    static RSHardwareThread& Instance();
+    // does nothing if the thread is already started
+    void Start();
+    bool IsStarted() const;
+
+    // called on the main thread
+    void CommitLayers(RSHardwareCommit&& commit);
+    void ReleaseBuffer(const sptr<Surface>& consumer, const sptr<SurfaceBuffer>& buffer,
+        const sptr<SyncFence>& releaseFence);
+    // called on the main thread before it uses the backend itself, waits until every commit posted is done
+    void WaitForIdle();
+
+    static constexpr uint32_t MAX_PENDING_COMMITS = 2;
+
+private:
+    RSHardwareThread() = default;
+    ~RSHardwareThread() = default;
+    RSHardwareThread(const RSHardwareThread&) = delete;
+    RSHardwareThread(const RSHardwareThread&&) = delete;
+    RSHardwareThread& operator=(const RSHardwareThread&) = delete;
+    RSHardwareThread& operator=(const RSHardwareThread&&) = delete;
+
+    // only called on the hardware thread
+    void Commit(const RSHardwareCommit& commit);
+    void OnPrepareComplete(sptr<Surface>& surface, const PrepareCompleteParam& param);
+    void DropReleaseFencesOfDestroyedSurfaces();
+    // runs the task on the main thread and waits for it
+    void RunOnMainThread(const std::function<void()>& task);
+
+    // only called on the main thread, runs the tasks of RunOnMainThread while waiting for the condition
+    template<typename Predicate>
+    void WaitOnMainThread(std::unique_lock<std::mutex>& lock, Predicate condition);
+    void RunMainThreadTasks(std::unique_lock<std::mutex>& lock);
+
+    std::shared_ptr<AppExecFwk::EventRunner> runner_ = nullptr;
+    std::shared_ptr<AppExecFwk::EventHandler> handler_ = nullptr;
+    HdiBackend* hdiBackend_ = nullptr;
+    std::atomic<bool> started_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    // the commits posted and not done of each screen, guarded by mutex_
+    std::unordered_map<uint32_t, uint32_t> pendingCommits_;
+    struct MainThreadTask {
+        std::function<void()> task;
+        bool* done = nullptr;
+    };
+    std::queue<MainThreadTask> mainThreadTasks_; // guarded by mutex_
+
+    // only used on the hardware thread
+    const RSHardwareCommit* currentCommit_ = nullptr;
+    // the release fence of the last commit of each surface, by the unique id of its consumer. an entry is consumed by
+    // the release of the buffer it is for, the ones of the destroyed surfaces are dropped after the next commit.
+    struct ReleaseFence {
+        wptr<Surface> surface;
+        sptr<SyncFence> fence;
+    };
+    std::unordered_map<uint64_t, ReleaseFence> releaseFences_;
+};
+} // namespace OHOS::Rosen
+#endif // RS_HARDWARE_THREAD_H
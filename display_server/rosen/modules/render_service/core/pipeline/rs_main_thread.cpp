@@ -14,6 +14,9 @@
  */
 #include "pipeline/rs_main_thread.h"
 
+#include <algorithm>
+#include <chrono>
+#include <unistd.h>
 #include <SkGraphics.h>
 #include <securec.h>
 #include "rs_trace.h"
@@ -27,6 +30,7 @@
 #include "pipeline/rs_base_render_util.h"
 #include "pipeline/rs_cold_start_thread.h"
 #include "pipeline/rs_divided_render_util.h"
+#include "pipeline/rs_hardware_thread.h"
 #include "pipeline/rs_render_engine.h"
 #include "pipeline/rs_render_service_visitor.h"
 #include "pipeline/rs_root_render_node.h"
@@ -77,20 +81,11 @@ const std::map<int, int32_t> BLUR_CNT_TO_BLUR_CODE {
     { 3, 10023 },
 };
 
-bool Compare(const std::unique_ptr<RSTransactionData>& data1, const std::unique_ptr<RSTransactionData>& data2)
+// the same clock as the vsync timestamps.
+int64_t GetMonotonicTimeNs()
 {
-    if (!data1 || !data2) {
-        RS_LOGW("Compare RSTransactionData: nullptr!");
-        return true;
-    }
-    return data1->GetIndex() < data2->GetIndex();
-}
-
-void InsertToEnd(std::vector<std::unique_ptr<RSTransactionData>>& source,
-    std::vector<std::unique_ptr<RSTransactionData>>& target)
-{
-    target.insert(target.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
-    source.clear();
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
 }
 }
 
@@ -173,16 +168,11 @@ void RSMainThread::Init()
     };
 
     if (isUniRender_) {
-        unmarshalBarrierTask_ = [this]() {
-            auto cachedTransactionData = RSUnmarshalThread::Instance().GetCachedTransactionData();
-            MergeToEffectiveTransactionDataMap(cachedTransactionData);
-            {
-                std::lock_guard<std::mutex> lock(unmarshalMutex_);
-                ++unmarshalFinishedCount_;
-            }
-            unmarshalTaskCond_.notify_all();
-        };
         RSUnmarshalThread::Instance().Start();
+        unmarshalPassedGenerations_.assign(RSUnmarshalThread::Instance().GetWorkerCount(), 0);
+        if (RSSystemProperties::GetHardwareThreadEnabled()) {
+            RSHardwareThread::Instance().Start();
+        }
     }
 
     runner_ = AppExecFwk::EventRunner::Create(false);
@@ -192,7 +182,7 @@ void RSMainThread::Init()
         RS_LOGW("Add watchdog thread failed");
     }
     InitRSEventDetector();
-    sptr<VSyncConnection> conn = new VSyncConnection(rsVSyncDistributor_, "rs");
+    sptr<VSyncConnection> conn = new VSyncConnection(rsVSyncDistributor_, "rs", getpid());
     rsVSyncDistributor_->AddConnection(conn);
     receiver_ = std::make_shared<VSyncReceiver>(conn, handler_);
     receiver_->Init();
@@ -313,48 +303,44 @@ void RSMainThread::ProcessCommand()
 
 void RSMainThread::ProcessCommandForUniRender()
 {
+    CollectTransactionData();
     TransactionDataMap transactionDataEffective;
+    bool traceEnabled = RS_TRACE_ENABLED();
     std::string transactionFlags;
-    {
-        std::lock_guard<std::mutex> lock(transitionDataMutex_);
-
-        for (auto& elem: effectiveTransactionDataIndexMap_) {
-            auto& transactionVec = elem.second.second;
-            std::sort(transactionVec.begin(), transactionVec.end(), Compare);
-        }
-
-        for (auto& rsTransactionElem: effectiveTransactionDataIndexMap_) {
-            auto pid = rsTransactionElem.first;
-            auto& lastIndex = rsTransactionElem.second.first;
-            auto& transactionVec = rsTransactionElem.second.second;
-            auto iter = transactionVec.begin();
-            for (; iter != transactionVec.end(); ++iter) {
-                if ((*iter) == nullptr) {
-                    continue;
-                }
-                auto curIndex = (*iter)->GetIndex();
-                if (curIndex == lastIndex + 1) {
-                    ++lastIndex;
+    for (auto& [pid, queue] : transactionDataQueues_) {
+        auto& lastIndex = queue.lastIndex;
+        auto& pending = queue.pending;
+        auto iter = pending.begin();
+        for (; iter != pending.end(); ++iter) {
+            auto curIndex = (*iter)->GetIndex();
+            if (curIndex == lastIndex + 1) {
+                ++lastIndex;
+                if (traceEnabled) {
                     transactionFlags += ", [" + std::to_string(pid) + ", " + std::to_string(curIndex) + "]";
-                } else {
-                    RS_LOGE("RSMainThread::ProcessCommandForUniRender wait curIndex:%llu, lastIndex:%llu, pid:%d",
-                        curIndex, lastIndex, pid);
-                    if (transactionDataLastWaitTime_[pid] == 0) {
-                        transactionDataLastWaitTime_[pid] = timestamp_;
-                    }
-                    if ((timestamp_ - transactionDataLastWaitTime_[pid]) / REFRESH_PERIOD > SKIP_COMMAND_FREQ_LIMIT) {
-                        transactionDataLastWaitTime_[pid] = 0;
-                        lastIndex = curIndex;
+                }
+            } else {
+                RS_LOGE("RSMainThread::ProcessCommandForUniRender wait curIndex:%llu, lastIndex:%llu, pid:%d",
+                    curIndex, lastIndex, pid);
+                if (queue.lastWaitTime == 0) {
+                    queue.lastWaitTime = timestamp_;
+                }
+                if ((timestamp_ - queue.lastWaitTime) / REFRESH_PERIOD > SKIP_COMMAND_FREQ_LIMIT) {
+                    queue.lastWaitTime = 0;
+                    lastIndex = curIndex;
+                    if (traceEnabled) {
                         transactionFlags += ", skip to[" + std::to_string(pid) + ", " + std::to_string(curIndex) + "]";
-                        RS_LOGE("RSMainThread::ProcessCommandForUniRender skip to index:%llu, pid:%d", curIndex, pid);
-                        continue;
                     }
-                    break;
+                    RS_LOGE("RSMainThread::ProcessCommandForUniRender skip to index:%llu, pid:%d", curIndex, pid);
+                    continue;
                 }
+                break;
             }
-            transactionDataEffective[pid].insert(transactionDataEffective[pid].end(),
-                std::make_move_iterator(transactionVec.begin()), std::make_move_iterator(iter));
-            transactionVec.erase(transactionVec.begin(), iter);
+        }
+        if (iter != pending.begin()) {
+            auto& transactionVec = transactionDataEffective[pid];
+            transactionVec.insert(transactionVec.end(),
+                std::make_move_iterator(pending.begin()), std::make_move_iterator(iter));
+            pending.erase(pending.begin(), iter);
         }
     }
     RS_TRACE_NAME("RSMainThread::ProcessCommandUni" + transactionFlags);
@@ -480,23 +466,94 @@ void RSMainThread::WaitUntilUnmarshallingTaskFinished()
         return;
     }
     RS_TRACE_NAME("RSMainThread::WaitUntilUnmarshallingTaskFinished");
+    // wait until every worker has passed the last barrier, older barriers still in flight do not count
+    uint64_t generation = unmarshalBarrierGeneration_;
     std::unique_lock<std::mutex> lock(unmarshalMutex_);
-    unmarshalTaskCond_.wait(lock, [this]() { return unmarshalFinishedCount_ > 0; });
-    --unmarshalFinishedCount_;
+    unmarshalTaskCond_.wait(lock, [this, generation]() {
+        return std::all_of(unmarshalPassedGenerations_.begin(), unmarshalPassedGenerations_.end(),
+            [generation](uint64_t passed) { return passed >= generation; });
+    });
 }
 
-void RSMainThread::MergeToEffectiveTransactionDataMap(TransactionDataMap& cachedTransactionDataMap)
+void RSMainThread::PostUnmarshalBarrier()
 {
-    std::lock_guard<std::mutex> lock(transitionDataMutex_);
-    for (auto& elem : cachedTransactionDataMap) {
-        auto pid = elem.first;
-        if (effectiveTransactionDataIndexMap_.count(pid) == 0) {
-            RS_LOGE("RSMainThread::MergeToEffectiveTransactionDataMap pid:%d not valid, skip it", pid);
-            continue;
+    uint64_t generation = ++unmarshalBarrierGeneration_;
+    RSUnmarshalThread::Instance().PostTaskToAllWorkers([this, generation](size_t workerIndex) {
+        // the transaction data unmarshalled by this worker before this task are all in the rings now
+        {
+            std::lock_guard<std::mutex> lock(unmarshalMutex_);
+            auto& passed = unmarshalPassedGenerations_[workerIndex];
+            passed = std::max(passed, generation);
+        }
+        unmarshalTaskCond_.notify_all();
+    });
+}
+
+void RSMainThread::CollectTransactionData()
+{
+    SyncTransactionDataQueues();
+    // transaction data not unmarshalled in the unmarshal thread
+    if (hasCachedTransactionData_.exchange(false)) {
+        TransactionDataMap cachedTransactionDataMap;
+        {
+            std::lock_guard<std::mutex> lock(transitionDataMutex_);
+            std::swap(cachedTransactionDataMap, cachedTransactionDataMap_);
+        }
+        for (auto& [pid, transactionVec] : cachedTransactionDataMap) {
+            auto iter = transactionDataQueues_.find(pid);
+            if (iter == transactionDataQueues_.end()) {
+                RS_LOGE("RSMainThread::CollectTransactionData pid:%d not valid, skip it", pid);
+                continue;
+            }
+            for (auto& transactionData : transactionVec) {
+                InsertTransactionData(iter->second, std::move(transactionData));
+            }
         }
-        InsertToEnd(elem.second, effectiveTransactionDataIndexMap_[pid].second);
     }
-    cachedTransactionDataMap.clear();
+
+    std::vector<std::unique_ptr<RSTransactionData>> transactionVec;
+    for (auto& [pid, queue] : transactionDataQueues_) {
+        queue.ring->PopAll(transactionVec);
+        for (auto& transactionData : transactionVec) {
+            InsertTransactionData(queue, std::move(transactionData));
+        }
+        transactionVec.clear();
+    }
+}
+
+void RSMainThread::SyncTransactionDataQueues()
+{
+    RSUnmarshalThread::TransactionDataRingMap rings;
+    if (!RSUnmarshalThread::Instance().GetTransactionDataRings(transactionDataRingsVersion_, rings)) {
+        return;
+    }
+    for (auto iter = transactionDataQueues_.begin(); iter != transactionDataQueues_.end();) {
+        auto ringIter = rings.find(iter->first);
+        if (ringIter == rings.end() || ringIter->second != iter->second.ring) {
+            iter = transactionDataQueues_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    for (auto& [pid, ring] : rings) {
+        if (transactionDataQueues_.count(pid) == 0) {
+            transactionDataQueues_[pid].ring = ring;
+        }
+    }
+}
+
+void RSMainThread::InsertTransactionData(TransactionDataQueue& queue, std::unique_ptr<RSTransactionData>&& data)
+{
+    if (data == nullptr) {
+        return;
+    }
+    // transaction data mostly come in order, so this is usually an append
+    auto index = data->GetIndex();
+    auto iter = queue.pending.end();
+    while (iter != queue.pending.begin() && (*std::prev(iter))->GetIndex() > index) {
+        --iter;
+    }
+    queue.pending.insert(iter, std::move(data));
 }
 
 void RSMainThread::NotifyUniRenderFinish()
@@ -642,89 +699,169 @@ void RSMainThread::CalcOcclusion()
         node->CollectSurface(node, curAllSurfaces, IfUseUniVisitor());
     }
 
-    // 1. Judge whether it is dirty
-    // Surface cnt changed or surface DstRectChanged or surface ZorderChanged
-    bool winDirty = (lastSurfaceCnt_ != curAllSurfaces.size() || isDirty_);
-    lastSurfaceCnt_ = curAllSurfaces.size();
-    if (!winDirty) {
-        for (auto it = curAllSurfaces.rbegin(); it != curAllSurfaces.rend(); ++it) {
-            auto surface = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(*it);
-            if (surface == nullptr) {
-                continue;
-            }
-            if (surface->GetZorderChanged() || surface->GetDstRectChanged() ||
-                surface->IsOpaqueRegionChanged() ||
-                surface->GetAlphaChanged() || (IfUseUniVisitor() && surface->IsDirtyRegionUpdated())) {
-                winDirty = true;
-            }
-            surface->CleanDstRectChanged();
-            surface->CleanAlphaChanged();
+    std::vector<std::shared_ptr<RSSurfaceRenderNode>> surfaces;
+    surfaces.reserve(curAllSurfaces.size());
+    for (auto it = curAllSurfaces.rbegin(); it != curAllSurfaces.rend(); ++it) {
+        auto surface = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(*it);
+        if (surface != nullptr) {
+            surfaces.emplace_back(surface);
+        }
+    }
+
+    // 1. Judge whether it is dirty, and find the topmost dirty surface.
+    // Surface at this z-position changed or surface DstRectChanged or surface ZorderChanged
+    // The surfaces above the topmost dirty one keep their visible region of the last calculation.
+    size_t firstDirty = surfaces.size();
+    size_t lastDirty = 0;
+    bool hasNestedSurface = false;
+    bool fullRecalc = isDirty_ || qosPidCal_ != lastQosPidCal_;
+    lastQosPidCal_ = qosPidCal_;
+    for (size_t i = 0; i < surfaces.size(); ++i) {
+        auto& surface = surfaces[i];
+        bool surfaceDirty = surface->GetZorderChanged() || surface->GetDstRectChanged() ||
+            surface->IsOpaqueRegionChanged() ||
+            surface->GetAlphaChanged() || (IfUseUniVisitor() && surface->IsDirtyRegionUpdated());
+        surface->CleanDstRectChanged();
+        surface->CleanAlphaChanged();
+
+        auto parentPtr = surface->GetParent().lock();
+        if (parentPtr != nullptr && parentPtr->IsInstanceOf<RSSurfaceRenderNode>() &&
+            RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(parentPtr)->GetSurfaceNodeType() !=
+            RSSurfaceNodeType::LEASH_WINDOW_NODE) {
+            hasNestedSurface = true;
+        }
+        if (!surfaceDirty && i < occlusionCache_.size()) {
+            const auto& entry = occlusionCache_[i];
+            bool isEmpty = surface->GetDstRect().IsEmpty();
+            surfaceDirty = entry.id != surface->GetId() ||
+                entry.rect != (isEmpty ? Occlusion::Rect{} : GetOcclusionRect(surface)) ||
+                entry.isOccluder != (!isEmpty && IsOccluder(surface)) ||
+                entry.isWholeRectOccluder != (!isEmpty && IsWholeRectOccluder(surface));
+        }
+        if (surfaceDirty || i >= occlusionCache_.size()) {
+            firstDirty = std::min(firstDirty, i);
+            lastDirty = i;
         }
     }
-    if (!winDirty) {
+    if (fullRecalc) {
+        firstDirty = 0;
+        lastDirty = surfaces.size();
+    }
+    if (firstDirty == surfaces.size() && surfaces.size() == occlusionCache_.size()) {
         return;
     }
 
-    RS_TRACE_NAME("RSMainThread::CalcOcclusion");
-    // 2. Calc occlusion
+    RS_TRACE_NAME_FMT("RSMainThread::CalcOcclusion from %zu of %zu", firstDirty, surfaces.size());
+    // 2. Calc occlusion, from the topmost dirty surface down, until the occluded region is the same as the last
+    // calculation and there is no dirty surface below. Nested surfaces set the visible region of their children,
+    // so they always go to the bottom.
+    size_t oldCacheSize = occlusionCache_.size();
+    occlusionCache_.resize(surfaces.size());
+    bool visibleChanged = oldCacheSize != surfaces.size();
     Occlusion::Region curRegion;
-    VisibleData curVisVec;
-    std::map<uint32_t, bool> pidVisMap;
-    for (auto it = curAllSurfaces.rbegin(); it != curAllSurfaces.rend(); ++it) {
-        auto surface = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(*it);
-        if (surface == nullptr || surface->GetDstRect().IsEmpty()) {
-            continue;
+    if (firstDirty > 0 && firstDirty < surfaces.size()) {
+        curRegion = occlusionCache_[firstDirty - 1].regionAfter;
+    }
+    for (size_t i = firstDirty; i < surfaces.size(); ++i) {
+        auto& surface = surfaces[i];
+        auto& entry = occlusionCache_[i];
+        bool sameSurface = i < oldCacheSize && entry.id == surface->GetId();
+        entry.id = surface->GetId();
+        entry.rect = Occlusion::Rect{};
+        entry.isOccluder = false;
+        entry.isWholeRectOccluder = false;
+        VisibleData visibleIds;
+        std::map<uint32_t, bool> pidVisMap;
+        if (!surface->GetDstRect().IsEmpty()) {
+            entry.rect = GetOcclusionRect(surface);
+            entry.isOccluder = IsOccluder(surface);
+            entry.isWholeRectOccluder = IsWholeRectOccluder(surface);
+            Occlusion::Region curSurface { entry.rect };
+            // Current surface subtract current region, if result region is empty that means it's covered
+            Occlusion::Region subResult = curSurface.Sub(curRegion);
+            // Set result to SurfaceRenderNode and its children
+            surface->setQosCal(qosPidCal_);
+            surface->SetVisibleRegionRecursive(subResult, visibleIds, pidVisMap);
+
+            // Current region need to merge current surface for next calculation(ignore alpha surface)
+            if (entry.isOccluder) {
+                if (IfUseUniVisitor()) {
+                    curRegion.OrSelf(surface->GetOpaqueRegion());
+                }
+                if (entry.isWholeRectOccluder) {
+                    curRegion.OrSelf(curSurface);
+                }
+            }
         }
-        Occlusion::Rect rect;
-        if (!surface->GetOldDirtyInSurface().IsEmpty() && IfUseUniVisitor()) {
-            rect = Occlusion::Rect{surface->GetOldDirtyInSurface()};
-        } else {
-            rect = Occlusion::Rect{surface->GetDstRect()};
+        if (!sameSurface || visibleIds != entry.visibleIds || pidVisMap != entry.pidVisMap) {
+            visibleChanged = true;
+            entry.visibleIds.swap(visibleIds);
+            entry.pidVisMap.swap(pidVisMap);
         }
-        Occlusion::Region curSurface { rect };
-        // Current surface subtract current region, if result region is empty that means it's covered
-        Occlusion::Region subResult = curSurface.Sub(curRegion);
-        // Set result to SurfaceRenderNode and its children
-        surface->setQosCal(qosPidCal_);
-        surface->SetVisibleRegionRecursive(subResult, curVisVec, pidVisMap);
-
-        // when surface is in starting window stage, do not occlude other window surfaces
-        // fix grey block when directly open app (i.e. setting) from notification center
-        auto parentPtr = surface->GetParent().lock();
-        if (parentPtr != nullptr && parentPtr->IsInstanceOf<RSSurfaceRenderNode>()) {
-            auto surfaceParentPtr = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(parentPtr);
-            if (surfaceParentPtr->GetSurfaceNodeType() == RSSurfaceNodeType::LEASH_WINDOW_NODE &&
-                !surface->IsNotifyUIBufferAvailable()) {
-                continue;
-            }
+        bool sameRegion = sameSurface && curRegion.GetRegionRects() == entry.regionAfter.GetRegionRects();
+        entry.regionAfter = curRegion;
+        if (sameRegion && i >= lastDirty && !hasNestedSurface) {
+            break;
         }
+    }
 
-        // Current region need to merge current surface for next calculation(ignore alpha surface)
-        if (IfUseUniVisitor()) {
-            curRegion.OrSelf(surface->GetOpaqueRegion());
-            if (RSOcclusionConfig::GetInstance().IsDividerBar(surface->GetName())) {
-                curRegion.OrSelf(curSurface);
-            }
-        } else {
-            const uint8_t opacity = 255;
-            bool diff = (surface->GetDstRect().width_ > surface->GetBuffer()->GetWidth() ||
-                        surface->GetDstRect().height_ > surface->GetBuffer()->GetHeight()) &&
-                        surface->GetRenderProperties().GetFrameGravity() != Gravity::RESIZE &&
-                        surface->GetRenderProperties().GetAlpha() != opacity;
-            if ((!surface->IsTransparent() && !diff) ||
-                RSOcclusionConfig::GetInstance().IsDividerBar(surface->GetName())) {
-                curRegion.OrSelf(curSurface);
-            }
+    // 3. Callback to WMS, only if the visible surfaces changed
+    VisibleData curVisVec;
+    std::map<uint32_t, bool> pidVisMap;
+    for (const auto& entry : occlusionCache_) {
+        curVisVec.insert(curVisVec.end(), entry.visibleIds.begin(), entry.visibleIds.end());
+        for (const auto& [pid, vis] : entry.pidVisMap) {
+            pidVisMap[pid] |= vis;
         }
     }
-
-    // 3. Callback to WMS
-    CallbackToWMS(curVisVec);
+    if (visibleChanged) {
+        CallbackToWMS(curVisVec);
+    }
 
     // 4. Callback to QOS
     CallbackToQOS(pidVisMap);
 }
 
+Occlusion::Rect RSMainThread::GetOcclusionRect(const std::shared_ptr<RSSurfaceRenderNode>& surface) const
+{
+    if (!surface->GetOldDirtyInSurface().IsEmpty() && IfUseUniVisitor()) {
+        return Occlusion::Rect{surface->GetOldDirtyInSurface()};
+    }
+    return Occlusion::Rect{surface->GetDstRect()};
+}
+
+bool RSMainThread::IsOccluder(const std::shared_ptr<RSSurfaceRenderNode>& surface) const
+{
+    // when surface is in starting window stage, do not occlude other window surfaces
+    // fix grey block when directly open app (i.e. setting) from notification center
+    auto parentPtr = surface->GetParent().lock();
+    if (parentPtr != nullptr && parentPtr->IsInstanceOf<RSSurfaceRenderNode>()) {
+        auto surfaceParentPtr = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(parentPtr);
+        if (surfaceParentPtr->GetSurfaceNodeType() == RSSurfaceNodeType::LEASH_WINDOW_NODE &&
+            !surface->IsNotifyUIBufferAvailable()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RSMainThread::IsWholeRectOccluder(const std::shared_ptr<RSSurfaceRenderNode>& surface) const
+{
+    if (RSOcclusionConfig::GetInstance().IsDividerBar(surface->GetName())) {
+        return true;
+    }
+    if (IfUseUniVisitor()) {
+        // uni render merges the opaque region instead.
+        return false;
+    }
+    const uint8_t opacity = 255;
+    bool diff = (surface->GetDstRect().width_ > surface->GetBuffer()->GetWidth() ||
+                surface->GetDstRect().height_ > surface->GetBuffer()->GetHeight()) &&
+                surface->GetRenderProperties().GetFrameGravity() != Gravity::RESIZE &&
+                surface->GetRenderProperties().GetAlpha() != opacity;
+    return !surface->IsTransparent() && !diff;
+}
+
 bool RSMainThread::CheckQosVisChanged(std::map<uint32_t, bool>& pidVisMap)
 {
     bool isVisibleChanged = pidVisMap.size() != lastPidVisMap_.size();
@@ -810,10 +947,14 @@ void RSMainThread::OnVsync(uint64_t timestamp, void* data)
     timestamp_ = timestamp;
     requestNextVsyncNum_ = 0;
     if (isUniRender_) {
-        MergeToEffectiveTransactionDataMap(cachedTransactionDataMap_);
-        RSUnmarshalThread::Instance().PostTask(unmarshalBarrierTask_);
+        PostUnmarshalBarrier();
     }
     mainLoop_();
+    if (vsyncPhaseTuner_ != nullptr) {
+        // the render service frame lasts from its vsync to the commit at the end of the main loop.
+        rsVSyncDistributor_->ReportFrameDuration(getpid(), GetMonotonicTimeNs() - static_cast<int64_t>(timestamp));
+        vsyncPhaseTuner_->OnFrameCommitted();
+    }
     if (handler_) {
         auto screenManager_ = CreateOrGetScreenManager();
         if (screenManager_ != nullptr) {
@@ -909,15 +1050,26 @@ void RSMainThread::RecvRSTransactionData(std::unique_ptr<RSTransactionData>& rsT
     if (!rsTransactionData) {
         return;
     }
+    ReportAppFrameDuration(*rsTransactionData);
     if (rsTransactionData->GetUniRender()) {
         std::lock_guard<std::mutex> lock(transitionDataMutex_);
         cachedTransactionDataMap_[rsTransactionData->GetSendingPid()].emplace_back(std::move(rsTransactionData));
+        hasCachedTransactionData_ = true;
     } else {
         ClassifyRSTransactionData(rsTransactionData);
     }
     RequestNextVSync();
 }
 
+void RSMainThread::ReportAppFrameDuration(const RSTransactionData& rsTransactionData)
+{
+    if (vsyncPhaseTuner_ != nullptr && appVSyncDistributor_ != nullptr) {
+        // the app frame lasts from its vsync to the flush of its transaction.
+        appVSyncDistributor_->ReportFrameDuration(rsTransactionData.GetSendingPid(),
+            GetMonotonicTimeNs() - static_cast<int64_t>(rsTransactionData.GetTimestamp()));
+    }
+}
+
 void RSMainThread::ClassifyRSTransactionData(std::unique_ptr<RSTransactionData>& rsTransactionData)
 {
     const auto& nodeMap = context_->GetNodeMap();
@@ -1128,13 +1280,13 @@ void RSMainThread::ClearTransactionDataPidInfo(pid_t remotePid)
     if (!isUniRender_) {
         return;
     }
-    std::lock_guard<std::mutex> lock(transitionDataMutex_);
-    if (effectiveTransactionDataIndexMap_.count(remotePid) > 0 &&
-        !effectiveTransactionDataIndexMap_[remotePid].second.empty()) {
+    // called in main thread
+    auto iter = transactionDataQueues_.find(remotePid);
+    if (iter != transactionDataQueues_.end() && !iter->second.pending.empty()) {
         RS_LOGD("RSMainThread::ClearTransactionDataPidInfo process:%d destroyed, skip commands", remotePid);
     }
-    effectiveTransactionDataIndexMap_.erase(remotePid);
-    transactionDataLastWaitTime_.erase(remotePid);
+    transactionDataQueues_.erase(remotePid);
+    RSUnmarshalThread::Instance().RemoveTransactionDataRing(remotePid);
 
     // clear cpu cache when process exit
     // CLEAN_CACHE_FREQ to prevent multiple cleanups in a short period of time
@@ -1155,11 +1307,7 @@ void RSMainThread::AddTransactionDataPidInfo(pid_t remotePid)
     if (!isUniRender_) {
         return;
     }
-    std::lock_guard<std::mutex> lock(transitionDataMutex_);
-    if (effectiveTransactionDataIndexMap_.count(remotePid) > 0) {
-        RS_LOGW("RSMainThread::AddTransactionDataPidInfo remotePid:%d already exists", remotePid);
-    }
-    effectiveTransactionDataIndexMap_[remotePid].first = 0;
+    RSUnmarshalThread::Instance().AddTransactionDataRing(remotePid);
 }
 
 void RSMainThread::ClearDisplayBuffer()
@@ -1204,8 +1352,7 @@ void RSMainThread::ForceRefreshForUni()
 {
     if (isUniRender_) {
         PostTask([=]() {
-            MergeToEffectiveTransactionDataMap(cachedTransactionDataMap_);
-            RSUnmarshalThread::Instance().PostTask(unmarshalBarrierTask_);
+            PostUnmarshalBarrier();
             mainLoop_();
         });
         if (handler_) {
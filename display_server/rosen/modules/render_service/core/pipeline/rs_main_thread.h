@@ -16,19 +16,23 @@
 #ifndef RS_MAIN_THREAD
 #define RS_MAIN_THREAD
 
+#include <deque>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "refbase.h"
 #include "rs_base_render_engine.h"
 #include "vsync_distributor.h"
+#include "vsync_phase_tuner.h"
 #include <event_handler.h>
 #include "vsync_receiver.h"
 
 #include "command/rs_command.h"
+#include "common/rs_occlusion_region.h"
 #include "common/rs_thread_handler.h"
 #include "common/rs_thread_looper.h"
 #include "ipc_callbacks/iapplication_agent.h"
@@ -41,6 +45,8 @@
 #include "transaction/rs_transaction_data.h"
 
 namespace OHOS::Rosen {
+class RSSurfaceRenderNode;
+class RSTransactionDataRing;
 #if defined(ACCESSIBILITY_ENABLE)
 class AccessibilityObserver;
 #endif
@@ -75,6 +81,8 @@ public:
     void Init();
     void Start();
     void RecvRSTransactionData(std::unique_ptr<RSTransactionData>& rsTransactionData);
+    // called on the arrival of the transaction data, in the main thread or in an unmarshal worker
+    void ReportAppFrameDuration(const RSTransactionData& rsTransactionData);
     void RequestNextVSync();
     void PostTask(RSTaskMessage::RSTask task);
     void PostSyncTask(RSTaskMessage::RSTask task);
@@ -124,13 +132,20 @@ public:
         int32_t pid, int32_t uid, const std::string &bundleName, const std::string &abilityName);
 
     sptr<VSyncDistributor> rsVSyncDistributor_;
+    sptr<VSyncDistributor> appVSyncDistributor_;
+    std::unique_ptr<VSyncPhaseTuner> vsyncPhaseTuner_; // nullptr if the phase offsets are fixed
 
     void SetDirtyFlag();
     void ForceRefreshForUni();
     void SetAppWindowNum(uint32_t num);
 private:
-    using TransactionDataIndexMap = std::unordered_map<pid_t,
-        std::pair<uint64_t, std::vector<std::unique_ptr<RSTransactionData>>>>;
+    // uni render transaction data of one process, ordered by index, only used in main thread
+    struct TransactionDataQueue {
+        std::shared_ptr<RSTransactionDataRing> ring;
+        uint64_t lastIndex = 0;
+        uint64_t lastWaitTime = 0;
+        std::deque<std::unique_ptr<RSTransactionData>> pending;
+    };
 
     RSMainThread();
     ~RSMainThread() noexcept;
@@ -146,6 +161,9 @@ private:
     void ReleaseAllNodesBuffer();
     void Render();
     void CalcOcclusion();
+    Occlusion::Rect GetOcclusionRect(const std::shared_ptr<RSSurfaceRenderNode>& surface) const;
+    bool IsOccluder(const std::shared_ptr<RSSurfaceRenderNode>& surface) const;
+    bool IsWholeRectOccluder(const std::shared_ptr<RSSurfaceRenderNode>& surface) const;
     bool CheckQosVisChanged(std::map<uint32_t, bool>& pidVisMap);
     void CallbackToQOS(std::map<uint32_t, bool>& pidVisMap);
     void CallbackToWMS(VisibleData& curVisVec);
@@ -162,7 +180,10 @@ private:
     void ProcessCommandForDividedRender();
     void ProcessCommandForUniRender();
     void WaitUntilUnmarshallingTaskFinished();
-    void MergeToEffectiveTransactionDataMap(TransactionDataMap& cachedTransactionDataMap);
+    void PostUnmarshalBarrier();
+    void CollectTransactionData();
+    void SyncTransactionDataQueues();
+    static void InsertTransactionData(TransactionDataQueue& queue, std::unique_ptr<RSTransactionData>&& data);
 
     void CheckBufferAvailableIfNeed();
     void CheckUpdateSurfaceNodeIfNeed();
@@ -188,9 +209,10 @@ private:
     std::map<uint64_t, std::vector<std::unique_ptr<RSCommand>>> pendingEffectiveCommands_;
     std::map<uint64_t, std::vector<std::unique_ptr<RSCommand>>> followVisitorCommands_;
 
-    TransactionDataMap cachedTransactionDataMap_;
-    TransactionDataIndexMap effectiveTransactionDataIndexMap_;
-    std::unordered_map<pid_t, uint64_t> transactionDataLastWaitTime_;
+    TransactionDataMap cachedTransactionDataMap_; // guarded by transitionDataMutex_
+    std::atomic_bool hasCachedTransactionData_ = false;
+    std::unordered_map<pid_t, TransactionDataQueue> transactionDataQueues_;
+    uint64_t transactionDataRingsVersion_ = 0;
 
     uint64_t timestamp_ = 0;
     uint64_t lastAnimateTimestamp_ = 0;
@@ -210,10 +232,12 @@ private:
     std::atomic_bool useUniVisitor_ = isUniRender_;
     std::atomic_bool delayedTargetUniVisitor_ = isUniRender_;
     std::atomic_bool switchDelayed_ = false;
-    RSTaskMessage::RSTask unmarshalBarrierTask_;
     std::condition_variable unmarshalTaskCond_;
     std::mutex unmarshalMutex_;
-    int32_t unmarshalFinishedCount_ = 0;
+    // generation of the last barrier posted to the unmarshal workers, only used in main thread
+    uint64_t unmarshalBarrierGeneration_ = 0;
+    // the last barrier generation each unmarshal worker has passed, guarded by unmarshalMutex_
+    std::vector<uint64_t> unmarshalPassedGenerations_;
 
     mutable std::mutex uniRenderMutex_;
     bool uniRenderFinished_ = false;
@@ -223,7 +247,21 @@ private:
     bool qosPidCal_ = false;
     bool isDirty_ = false;
     std::atomic_bool doWindowAnimate_ = false;
-    uint32_t lastSurfaceCnt_ = 0;
+
+    // occlusion result of every surface of the last CalcOcclusion, top-down, so that only the surfaces below the
+    // topmost changed one need to be recalculated.
+    struct OcclusionCacheEntry {
+        NodeId id = 0;
+        Occlusion::Rect rect;
+        bool isOccluder = false;
+        bool isWholeRectOccluder = false;
+        Occlusion::Region regionAfter; // occluded region of this surface and all surfaces above it
+        VisibleData visibleIds;
+        std::map<uint32_t, bool> pidVisMap;
+    };
+    std::vector<OcclusionCacheEntry> occlusionCache_;
+    bool lastQosPidCal_ = false;
+
     int32_t focusAppPid_ = -1;
     int32_t focusAppUid_ = -1;
     std::string focusAppBundleName_ = "";
@@ -20,6 +20,7 @@
 #include "vsync_generator.h"
 #include "pipeline/rs_surface_render_node.h"
 #include "pipeline/rs_uni_render_judgement.h"
+#include "platform/common/rs_system_properties.h"
 
 #include <string>
 #include <unistd.h>
@@ -64,12 +65,21 @@ bool RSRenderService::Init()
     appVSyncController_ = new VSyncController(generator, offset);
     rsVSyncDistributor_ = new VSyncDistributor(rsVSyncController_, "rs");
     appVSyncDistributor_ = new VSyncDistributor(appVSyncController_, "app");
+    if (RSSystemProperties::GetVSyncTimelineEnabled()) {
+        rsVSyncDistributor_->EnableTimeline();
+        appVSyncDistributor_->EnableTimeline();
+    }
 
     mainThread_ = RSMainThread::Instance();
     if (mainThread_ == nullptr) {
         return false;
     }
     mainThread_->rsVSyncDistributor_ = rsVSyncDistributor_;
+    mainThread_->appVSyncDistributor_ = appVSyncDistributor_;
+    if (RSSystemProperties::GetVSyncAdaptivePhaseEnabled()) {
+        mainThread_->vsyncPhaseTuner_ =
+            std::make_unique<VSyncPhaseTuner>(rsVSyncDistributor_, appVSyncDistributor_, offset);
+    }
     mainThread_->Init();
 
     RSQosThread::GetInstance()->appVSyncDistributor_ = appVSyncDistributor_;
@@ -245,6 +255,8 @@ void RSRenderService::DumpHelpInfo(std::string& dumpString) const
         .append("|dump RSTree info\n")
         .append("EventParamList                 ")
         .append("|dump EventParamList info\n")
+        .append("vsync                          ")
+        .append("|dump vsync generator info\n")
         .append("allInfo                        ")
         .append("|dump all info\n");
 }
@@ -298,6 +310,27 @@ void RSRenderService::DumpRenderServiceTree(std::string& dumpString) const
     mainThread_->RenderServiceTreeDump(dumpString);
 }
 
+void RSRenderService::DumpVSyncInfo(std::string& dumpString) const
+{
+    dumpString.append("\n");
+    dumpString.append("-- VSyncDump: \n");
+    auto generator = CreateVSyncGenerator();
+    if (generator != nullptr) {
+        generator->Dump(dumpString);
+    }
+    for (const auto& distributor : { rsVSyncDistributor_, appVSyncDistributor_ }) {
+        std::vector<ConnectionInfo> infos;
+        if (distributor == nullptr || distributor->GetVSyncConnectionInfos(infos) != VSYNC_ERROR_OK) {
+            continue;
+        }
+        for (const auto& info : infos) {
+            dumpString += "VSyncConnection: " + info.name_ + ", postVSyncCount: " +
+                std::to_string(info.postVSyncCount_) + ", frameDuration: " + std::to_string(info.frameDuration_) +
+                "ns, phaseOffset: " + std::to_string(info.phaseOffset_) + "ns\n";
+        }
+    }
+}
+
 void RSRenderService::DoDump(std::unordered_set<std::u16string>& argSets, std::string& dumpString) const
 {
     std::u16string arg1(u"screen");
@@ -310,6 +343,7 @@ void RSRenderService::DoDump(std::unordered_set<std::u16string>& argSets, std::s
     std::u16string arg8(u"h");
     std::u16string arg9(u"allInfo");
     std::u16string arg13(u"fpsClear");
+    std::u16string arg14(u"vsync");
     if (argSets.count(arg9) || argSets.count(arg1) != 0) {
         mainThread_->ScheduleTask([this, &dumpString]() {
             screenManager_->DisplayDump(dumpString);
@@ -340,6 +374,9 @@ void RSRenderService::DoDump(std::unordered_set<std::u16string>& argSets, std::s
             DumpRSEvenParam(dumpString);
         }).wait();
     }
+    if (argSets.count(arg9) || argSets.count(arg14) != 0) {
+        DumpVSyncInfo(dumpString);
+    }
     FPSDUMPProcess(argSets, dumpString, arg3);
     FPSDUMPClearProcess(argSets, dumpString, arg13);
     if (argSets.size() == 0 || argSets.count(arg8) != 0 || dumpString.empty()) {
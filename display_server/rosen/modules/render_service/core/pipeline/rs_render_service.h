@@ -55,6 +55,7 @@ private:
     void DumpHelpInfo(std::string& dumpString) const;
     void DumpRSEvenParam(std::string& dumpString) const;
     void DumpRenderServiceTree(std::string& dumpString) const;
+    void DumpVSyncInfo(std::string& dumpString) const;
     void FPSDUMPProcess(std::unordered_set<std::u16string>& argSets, std::string& dumpString,
         const std::u16string& arg) const;
     void FPSDUMPClearProcess(std::unordered_set<std::u16string>& argSets,
@@ -21,8 +21,10 @@
 #include "pipeline/rs_surface_render_node.h"
 #include "pipeline/rs_uni_render_judgement.h"
 #include "platform/common/rs_log.h"
+#include "render/rs_image_cache.h"
 #include "rs_main_thread.h"
 #include "rs_trace.h"
+#include "transaction/rs_ashmem_helper.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -47,6 +49,7 @@ RSRenderServiceConnection::RSRenderServiceConnection(
     if (!token_->AddDeathRecipient(connDeathRecipient_)) {
         RS_LOGW("RSRenderServiceConnection: Failed to set death recipient.");
     }
+    RSParcelSlabCache::Instance().AddClient();
 }
 
 RSRenderServiceConnection::~RSRenderServiceConnection() noexcept
@@ -90,6 +93,7 @@ void RSRenderServiceConnection::CleanAll(bool toDelete) noexcept
         CleanVirtualScreens();
         CleanRenderNodes();
         mainThread_->ClearTransactionDataPidInfo(remotePid_);
+        RSImageCache::Instance().ReleaseTransferredImages(imageTransferOwner_);
     }).wait();
 
     for (auto& conn : vsyncConnections_) {
@@ -101,6 +105,7 @@ void RSRenderServiceConnection::CleanAll(bool toDelete) noexcept
         vsyncConnections_.clear();
         cleanDone_ = true;
     }
+    RSParcelSlabCache::Instance().RemoveClient();
 
     if (toDelete) {
         auto renderService = renderService_.promote();
@@ -256,7 +261,7 @@ sptr<Surface> RSRenderServiceConnection::CreateNodeAndSurface(const RSSurfaceRen
 
 sptr<IVSyncConnection> RSRenderServiceConnection::CreateVSyncConnection(const std::string& name)
 {
-    sptr<VSyncConnection> conn = new VSyncConnection(appVSyncDistributor_, name);
+    sptr<VSyncConnection> conn = new VSyncConnection(appVSyncDistributor_, name, remotePid_);
     appVSyncDistributor_->AddConnection(conn);
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_transaction_data_ring.h"
+
+#include <iterator>
+
+namespace OHOS::Rosen {
+RSTransactionDataRing::RSTransactionDataRing(size_t capacity)
+{
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    slots_.resize(size);
+    mask_ = size - 1;
+}
+
+void RSTransactionDataRing::Push(std::unique_ptr<RSTransactionData>&& transactionData)
+{
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= slots_.size()) {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        overflow_.emplace_back(std::move(transactionData));
+        hasOverflow_.store(true, std::memory_order_release);
+        return;
+    }
+    slots_[tail & mask_] = std::move(transactionData);
+    tail_.store(tail + 1, std::memory_order_release);
+}
+
+void RSTransactionDataRing::PopAll(std::vector<std::unique_ptr<RSTransactionData>>& target)
+{
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    for (; head != tail; ++head) {
+        target.emplace_back(std::move(slots_[head & mask_]));
+    }
+    head_.store(head, std::memory_order_release);
+
+    if (hasOverflow_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        target.insert(target.end(), std::make_move_iterator(overflow_.begin()),
+            std::make_move_iterator(overflow_.end()));
+        overflow_.clear();
+        hasOverflow_.store(false, std::memory_order_relaxed);
+    }
+}
+} // namespace OHOS::Rosen
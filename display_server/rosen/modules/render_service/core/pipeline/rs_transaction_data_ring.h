@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RS_TRANSACTION_DATA_RING_H
+#define RS_TRANSACTION_DATA_RING_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "transaction/rs_transaction_data.h"
+
+namespace OHOS::Rosen {
+// Single-producer/single-consumer ring of the transaction data of one process, from RSUnmarshalThread to
+// RSMainThread. Neither side takes a lock in the common case, when the ring is full the producer falls back to an
+// overflow list guarded by a mutex, which the consumer only locks if there is something in it.
+class RSTransactionDataRing {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 128;
+
+    explicit RSTransactionDataRing(size_t capacity = DEFAULT_CAPACITY);
+    ~RSTransactionDataRing() = default;
+
+    RSTransactionDataRing(const RSTransactionDataRing&) = delete;
+    RSTransactionDataRing& operator=(const RSTransactionDataRing&) = delete;
+
+    // only called by the producer
+    void Push(std::unique_ptr<RSTransactionData>&& transactionData);
+    // only called by the consumer, appends all pushed transaction data to target
+    void PopAll(std::vector<std::unique_ptr<RSTransactionData>>& target);
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    std::vector<std::unique_ptr<RSTransactionData>> slots_;
+    size_t mask_ = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_ { 0 }; // next slot to pop, written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_ { 0 }; // next slot to push, written by the producer
+    alignas(CACHE_LINE_SIZE) std::atomic_bool hasOverflow_ { false };
+    std::mutex overflowMutex_;
+    std::vector<std::unique_ptr<RSTransactionData>> overflow_; // guarded by overflowMutex_
+};
+} // namespace OHOS::Rosen
+#endif // RS_TRANSACTION_DATA_RING_H
@@ -41,10 +41,10 @@ bool RSUniRenderProcessor::Init(RSDisplayRenderNode& node, int32_t offsetX, int3
     // so we do not need to handle rotation in composer adapter any more,
     // just pass the buffer to composer straightly.
     screenInfo_.rotation = ScreenRotation::ROTATION_0;
+    // the layers may be committed after this processor is gone, so the fallback keeps what it uses.
     return composerAdapter_->Init(screenInfo_, offsetX, offsetY, mirrorAdaptiveCoefficient_,
-        [this](const auto& surface, const auto& layers) {
-        Redraw(surface, layers);
-    });
+        [renderEngine = renderEngine_, renderFrameConfig = renderFrameConfig_](const auto& surface,
+            const auto& layers) { Redraw(renderEngine, renderFrameConfig, surface, layers); }, true);
 }
 
 void RSUniRenderProcessor::PostProcess()
@@ -85,7 +85,8 @@ void RSUniRenderProcessor::ProcessDisplaySurface(RSDisplayRenderNode& node)
     layerNum += node.GetCurAllSurfaces().size();
 }
 
-void RSUniRenderProcessor::Redraw(const sptr<Surface>& surface, const std::vector<LayerInfoPtr>& layers)
+void RSUniRenderProcessor::Redraw(const std::shared_ptr<RSBaseRenderEngine>& renderEngine,
+    const BufferRequestConfig& renderFrameConfig, const sptr<Surface>& surface, const std::vector<LayerInfoPtr>& layers)
 {
     if (surface == nullptr) {
         RS_LOGE("RSUniRenderProcessor::Redraw: surface is null.");
@@ -94,7 +95,7 @@ void RSUniRenderProcessor::Redraw(const sptr<Surface>& surface, const std::vecto
 
     RS_LOGD("RsDebug RSUniRenderProcessor::Redraw flush frame buffer start");
     bool forceCPU = RSBaseRenderEngine::NeedForceCPU(layers);
-    auto renderFrame = renderEngine_->RequestFrame(surface, renderFrameConfig_, forceCPU);
+    auto renderFrame = renderEngine->RequestFrame(surface, renderFrameConfig, forceCPU);
     if (renderFrame == nullptr) {
         RS_LOGE("RsDebug RSUniRenderProcessor::Redraw：failed to request frame.");
         return;
@@ -105,8 +106,8 @@ void RSUniRenderProcessor::Redraw(const sptr<Surface>& surface, const std::vecto
         RS_LOGE("RsDebug RSUniRenderProcessor::Redraw：canvas is nullptr.");
         return;
     }
-    renderEngine_->DrawLayers(*canvas, layers, forceCPU);
-    renderEngine_->PostProcessOutput(*canvas, forceCPU);
+    renderEngine->DrawLayers(*canvas, layers, forceCPU);
+    renderEngine->PostProcessOutput(*canvas, forceCPU);
     renderFrame->Flush();
     RS_LOGD("RsDebug RSUniRenderProcessor::Redraw flush frame buffer end");
 }
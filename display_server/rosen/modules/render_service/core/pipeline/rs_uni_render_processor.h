@@ -32,7 +32,9 @@ public:
     void ProcessDisplaySurface(RSDisplayRenderNode& node) override;
     void PostProcess() override;
 private:
-    void Redraw(const sptr<Surface>& surface, const std::vector<LayerInfoPtr>& layers);
+    static void Redraw(const std::shared_ptr<RSBaseRenderEngine>& renderEngine,
+        const BufferRequestConfig& renderFrameConfig, const sptr<Surface>& surface,
+        const std::vector<LayerInfoPtr>& layers);
 
     std::unique_ptr<RSComposerAdapter> composerAdapter_;
     std::vector<LayerInfoPtr> layers_;
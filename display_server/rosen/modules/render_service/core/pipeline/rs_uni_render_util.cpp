@@ -16,6 +16,7 @@
 #include "rs_uni_render_util.h"
 
 #include "pipeline/rs_base_render_util.h"
+#include "pipeline/rs_hardware_thread.h"
 #include "pipeline/rs_main_thread.h"
 #include "platform/common/rs_log.h"
 
@@ -83,11 +84,14 @@ Occlusion::Region RSUniRenderUtil::MergeVisibleDirtyRegion(std::shared_ptr<RSDis
             continue;
         }
         auto surfaceDirtyManager = surfaceNode->GetDirtyManager();
-        auto surfaceDirtyRect = surfaceDirtyManager->GetDirtyRegion();
-        Occlusion::Rect dirtyRect { surfaceDirtyRect.left_, surfaceDirtyRect.top_,
-            surfaceDirtyRect.GetRight(), surfaceDirtyRect.GetBottom() };
+        Occlusion::Region surfaceDirtyRegion;
+        for (const auto& surfaceDirtyRect : surfaceDirtyManager->GetDirtyRects()) {
+            Occlusion::Rect dirtyRect { surfaceDirtyRect.left_, surfaceDirtyRect.top_,
+                surfaceDirtyRect.GetRight(), surfaceDirtyRect.GetBottom() };
+            Occlusion::Region dirtyRectRegion { dirtyRect };
+            surfaceDirtyRegion.OrSelf(dirtyRectRegion);
+        }
         auto visibleRegion = surfaceNode->GetVisibleRegion();
-        Occlusion::Region surfaceDirtyRegion { dirtyRect };
         Occlusion::Region surfaceVisibleDirtyRegion = surfaceDirtyRegion.And(visibleRegion);
         surfaceNode->SetVisibleDirtyRegion(surfaceVisibleDirtyRegion);
         allSurfaceVisibleDirtyRegion = allSurfaceVisibleDirtyRegion.Or(surfaceVisibleDirtyRegion);
@@ -182,6 +186,10 @@ bool RSUniRenderUtil::ReleaseBuffer(RSSurfaceHandler& surfaceHandler)
             // [planning] delete this function after Repaint parallelization.
             firstEntry = false;
             firstBufferRelease = [consumer, buffer = preBuffer.buffer, fence = preBuffer.releaseFence]() mutable {
+                if (RSHardwareThread::Instance().IsStarted()) {
+                    RSHardwareThread::Instance().ReleaseBuffer(consumer, buffer, fence);
+                    return;
+                }
                 auto ret = consumer->ReleaseBuffer(buffer, fence);
                 if (ret != OHOS::SURFACE_ERROR_OK) {
                     RS_LOGE("RsDebug firstBufferRelease failed(ret: %d)!", ret);
@@ -194,6 +202,12 @@ bool RSUniRenderUtil::ReleaseBuffer(RSSurfaceHandler& surfaceHandler)
             firstBufferRelease();
             firstBufferRelease = nullptr;
         }
+        if (RSHardwareThread::Instance().IsStarted()) {
+            // the buffer may be on the screen until the commits which are posted before are done.
+            RSHardwareThread::Instance().ReleaseBuffer(consumer, preBuffer.buffer, preBuffer.releaseFence);
+            preBuffer.Reset();
+            return true;
+        }
         auto ret = consumer->ReleaseBuffer(preBuffer.buffer, preBuffer.releaseFence);
         if (ret != OHOS::SURFACE_ERROR_OK) {
             RS_LOGE("RsDebug surfaceHandler(id: %" PRIu64 ") ReleaseBuffer failed(ret: %d)!",
@@ -181,6 +181,8 @@ void RSUniRenderVisitor::PrepareDisplayRenderNode(RSDisplayRenderNode& node)
     currentVisitDisplay_ = node.GetScreenId();
     displayHasSecSurface_.emplace(currentVisitDisplay_, false);
     dirtySurfaceNodeMap_.clear();
+    filterBackdropDirtyManagers_.clear();
+    filterBackdropDirtyManagers_.emplace_back(curSurfaceDirtyManager_);
 
     RS_TRACE_NAME("RSUniRender:PrepareDisplay " + std::to_string(currentVisitDisplay_));
     curDisplayDirtyManager_ = node.GetDirtyManager();
@@ -257,6 +259,7 @@ void RSUniRenderVisitor::PrepareSurfaceRenderNode(RSSurfaceRenderNode& node)
         curSurfaceDirtyManager_ = node.GetDirtyManager();
         curSurfaceDirtyManager_->Clear();
         curSurfaceDirtyManager_->SetSurfaceSize(screenInfo_.width, screenInfo_.height);
+        filterBackdropDirtyManagers_.emplace_back(curSurfaceDirtyManager_);
         if (auto parentNode = node.GetParent().lock()) {
             auto rsParent = RSBaseRenderNode::ReinterpretCast<RSRenderNode>(parentNode);
             dirtyFlag_ = node.Update(*curSurfaceDirtyManager_, &(rsParent->GetRenderProperties()), dirtyFlag_);
@@ -277,6 +280,7 @@ void RSUniRenderVisitor::PrepareSurfaceRenderNode(RSSurfaceRenderNode& node)
         if (node.GetSurfaceNodeType() == RSSurfaceNodeType::SELF_DRAWING_WINDOW_NODE) {
             curSurfaceDirtyManager_ = node.GetDirtyManager();
             curSurfaceDirtyManager_->Clear();
+            filterBackdropDirtyManagers_.emplace_back(curSurfaceDirtyManager_);
             curDisplayNode_->UpdateSurfaceNodePos(node.GetId(), node.GetDstRect());
         }
         if (node.GetBuffer() != nullptr) {
@@ -291,6 +295,9 @@ void RSUniRenderVisitor::PrepareSurfaceRenderNode(RSSurfaceRenderNode& node)
     if (node.GetRenderProperties().NeedFilter() && !node.IsAppFreeze()) {
         needFilter_ = true;
     }
+    if (isPartialRenderEnabled_) {
+        MarkFilterBackdrop(node, node.GetOldDirtyInSurface());
+    }
     dirtyFlag_ = dirtyFlag_ || node.GetDstRectChanged();
     parentSurfaceNodeMatrix_ = geoPtr->GetAbsMatrix();
     node.ResetSurfaceOpaqueRegion(RectI(0, 0, screenInfo_.width, screenInfo_.height), geoPtr->GetAbsRect(),
@@ -385,6 +392,10 @@ void RSUniRenderVisitor::PrepareCanvasRenderNode(RSCanvasRenderNode &node)
         dirtyFlag_);
     float alpha = curAlpha_;
     curAlpha_ *= node.GetRenderProperties().GetAlpha();
+    // before the children, which are drawn over the filter
+    if (isPartialRenderEnabled_) {
+        MarkFilterBackdrop(node, node.GetOldDirtyInSurface());
+    }
 
     PrepareBaseRenderNode(node);
     // attention: accumulate direct parent's childrenRect
@@ -553,6 +564,9 @@ void RSUniRenderVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
 #ifdef RS_ENABLE_EGLQUERYSURFACE
         if (isPartialRenderEnabled_) {
             curDisplayDirtyManager_->SetSurfaceSize(screenInfo_.width, screenInfo_.height);
+            if (IsSurfaceCompositionChanged(displayNodePtr)) {
+                RSSkiaFilter::InvalidateCachedImages();
+            }
             CalcDirtyDisplayRegion(displayNodePtr);
             CalcDirtyRegionForFilterNode(displayNodePtr);
             displayNodePtr->ClearCurrentSurfacePos();
@@ -591,6 +605,8 @@ void RSUniRenderVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
         // Get displayNode buffer age in order to merge visible dirty region for displayNode.
         // And then set egl damage region to improve uni_render efficiency.
         if (isPartialRenderEnabled_) {
+            // the backdrops of the filters are tracked with the dirty regions
+            canvas_->SetFilterCacheEnabled(true);
             // Early history buffer Merging will have impact on Overdraw display, so we need to
             // set the full screen dirty to avoid this impact.
             if (RSOverdrawController::GetInstance().IsEnabled()) {
@@ -602,8 +618,7 @@ void RSUniRenderVisitor::ProcessDisplayRenderNode(RSDisplayRenderNode& node)
             dirtyRegionTest = dirtyRegion;
             SetSurfaceGlobalDirtyRegion(displayNodePtr);
             std::vector<RectI> rects = GetDirtyRects(dirtyRegion);
-            RectI rect = node.GetDirtyManager()->GetDirtyRegionFlipWithinSurface();
-            if (!rect.IsEmpty()) {
+            for (const auto& rect : node.GetDirtyManager()->GetDirtyRectsFlipWithinSurface()) {
                 rects.emplace_back(rect);
             }
             auto disH = screenInfo_.GetRotatedHeight();
@@ -863,6 +878,41 @@ void RSUniRenderVisitor::CalcDirtyRegionForFilterNode(std::shared_ptr<RSDisplayR
     }
 }
 
+void RSUniRenderVisitor::MarkFilterBackdrop(const RSRenderNode& node, const RectI& rect) const
+{
+    auto filter = std::static_pointer_cast<RSSkiaFilter>(node.GetRenderProperties().GetBackgroundFilter());
+    if (filter == nullptr) {
+        return;
+    }
+    // the dirty regions of the surfaces are conservative, they also contain the nodes drawn after this one.
+    bool isBackdropChanged = !curDisplayDirtyManager_->GetDirtyRegion().IntersectRect(rect).IsEmpty();
+    for (auto& dirtyManager : filterBackdropDirtyManagers_) {
+        if (isBackdropChanged) {
+            break;
+        }
+        isBackdropChanged = !dirtyManager->GetDirtyRegion().IntersectRect(rect).IsEmpty();
+    }
+    filter->MarkBackdrop(isBackdropChanged);
+}
+
+bool RSUniRenderVisitor::IsSurfaceCompositionChanged(std::shared_ptr<RSDisplayRenderNode>& node) const
+{
+    if (!node->GetSurfaceChangedRects().empty()) {
+        return true;
+    }
+    for (auto& child : node->GetCurAllSurfaces()) {
+        auto surfaceNode = RSBaseRenderNode::ReinterpretCast<RSSurfaceRenderNode>(child);
+        if (surfaceNode == nullptr) {
+            continue;
+        }
+        NodeId id = surfaceNode->GetId();
+        if (surfaceNode->GetZorderChanged() || node->GetLastFrameSurfacePos(id) != node->GetCurrentFrameSurfacePos(id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void RSUniRenderVisitor::SetSurfaceGlobalDirtyRegion(std::shared_ptr<RSDisplayRenderNode>& node)
 {
     RS_TRACE_FUNC();
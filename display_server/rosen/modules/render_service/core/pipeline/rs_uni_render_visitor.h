@@ -79,6 +79,10 @@ private:
     void CalcDirtyRegionForFilterNode(std::shared_ptr<RSDisplayRenderNode>& node) const;
     // set global dirty region to each surface node
     void SetSurfaceGlobalDirtyRegion(std::shared_ptr<RSDisplayRenderNode>& node);
+    // tell the background filter of node whether anything prepared under it is dirty, to reuse its filtered backdrop
+    void MarkFilterBackdrop(const RSRenderNode& node, const RectI& rect) const;
+    // surfaces added, removed, moved or reordered change the backdrops out of the dirty region of the surfaces
+    bool IsSurfaceCompositionChanged(std::shared_ptr<RSDisplayRenderNode>& node) const;
 
     void InitCacheSurface(RSSurfaceRenderNode& node, int width, int height);
     void SetPaintOutOfParentFlag(RSBaseRenderNode& node);
@@ -129,6 +133,8 @@ private:
     bool isDirty_ = false;
     bool needFilter_ = false;
     std::unordered_map<NodeId, std::vector<RectI>> filterRects_;
+    // the dirty managers of the surfaces prepared so far in the current display
+    std::vector<std::shared_ptr<RSDirtyRegionManager>> filterBackdropDirtyManagers_;
     ColorGamut newColorSpace_ = ColorGamut::COLOR_GAMUT_SRGB;
     std::vector<ScreenColorGamut> colorGamutmodes_;
     ContainerWindowConfigType containerWindowConfig_;
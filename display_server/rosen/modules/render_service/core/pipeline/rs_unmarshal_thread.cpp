@@ -15,9 +15,13 @@
 
 #include "pipeline/rs_unmarshal_thread.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "pipeline/rs_base_render_util.h"
 #include "pipeline/rs_main_thread.h"
 #include "platform/common/rs_log.h"
+#include "render/rs_image_cache.h"
 #include "transaction/rs_transaction_data.h"
 
 namespace OHOS::Rosen {
@@ -29,46 +33,104 @@ RSUnmarshalThread& RSUnmarshalThread::Instance()
 
 void RSUnmarshalThread::Start()
 {
-    runner_ = AppExecFwk::EventRunner::Create("RSUnmarshalThread");
-    handler_ = std::make_shared<AppExecFwk::EventHandler>(runner_);
+    // leave the other cores to the main thread and the render threads
+    size_t workerCount = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, MAX_WORKER_COUNT);
+    for (size_t i = 0; i < workerCount; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->runner = AppExecFwk::EventRunner::Create("RSUnmarshalThread" + std::to_string(i));
+        worker->handler = std::make_shared<AppExecFwk::EventHandler>(worker->runner);
+        workers_.emplace_back(std::move(worker));
+    }
+    RS_LOGI("RSUnmarshalThread::Start with %zu workers", workerCount);
 }
 
-void RSUnmarshalThread::PostTask(const std::function<void()>& task)
+void RSUnmarshalThread::PostTaskToAllWorkers(const std::function<void(size_t)>& task)
 {
-    if (handler_) {
-        handler_->PostTask(task, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->handler->PostTask([task, i]() { task(i); }, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     }
 }
 
-void RSUnmarshalThread::RecvParcel(std::shared_ptr<MessageParcel>& parcel)
+size_t RSUnmarshalThread::GetWorkerCount() const
+{
+    return workers_.size();
+}
+
+size_t RSUnmarshalThread::GetWorkerIndex(pid_t pid) const
 {
-    if (!handler_) {
-        RS_LOGE("RSUnmarshalThread::RecvParcel handler_ is nullptr");
+    return static_cast<size_t>(pid) % workers_.size();
+}
+
+void RSUnmarshalThread::RecvParcel(
+    std::shared_ptr<MessageParcel>& parcel, pid_t callingPid, uint64_t imageTransferOwner)
+{
+    if (workers_.empty()) {
+        RS_LOGE("RSUnmarshalThread::RecvParcel no worker started");
         return;
     }
-    RSTaskMessage::RSTask task = [this, parcel = parcel]() {
-        auto transData = RSBaseRenderUtil::ParseTransactionData(*parcel);
+    size_t index = GetWorkerIndex(callingPid);
+    Worker& worker = *workers_[index];
+    RSTaskMessage::RSTask task = [this, &worker, index, imageTransferOwner, parcel = parcel]() {
+        std::unique_ptr<RSTransactionData> transData;
+        {
+            RSImageCache::TransferOwnerScope ownerScope(imageTransferOwner);
+            transData = RSBaseRenderUtil::ParseTransactionData(*parcel);
+        }
         if (!transData) {
             return;
         }
-        if (!transData->GetUniRender()) {
+        auto pid = transData->GetSendingPid();
+        if (!transData->GetUniRender() || GetWorkerIndex(pid) != index) {
+            // the ring of the sending pid belongs to another worker, let the main thread order it
             RSMainThread::Instance()->RecvRSTransactionData(transData);
             return;
         }
-        std::lock_guard<std::mutex> lock(transactionDataMutex_);
-        cachedTransactionDataMap_[transData->GetSendingPid()].emplace_back(std::move(transData));
+        auto ring = GetProducerRing(worker, pid);
+        if (ring == nullptr) {
+            RS_LOGE("RSUnmarshalThread::RecvParcel pid:%d not valid, skip it", pid);
+            return;
+        }
+        // the main thread does not see this data until its vsync, so measure the app frame here
+        RSMainThread::Instance()->ReportAppFrameDuration(*transData);
+        ring->Push(std::move(transData));
     };
-    PostTask(task);
+    worker.handler->PostTask(task, AppExecFwk::EventQueue::Priority::IMMEDIATE);
     RSMainThread::Instance()->RequestNextVSync();
 }
 
-TransactionDataMap RSUnmarshalThread::GetCachedTransactionData()
+void RSUnmarshalThread::AddTransactionDataRing(pid_t pid)
 {
-    TransactionDataMap transactionData;
-    {
-        std::lock_guard<std::mutex> lock(transactionDataMutex_);
-        std::swap(transactionData, cachedTransactionDataMap_);
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    if (rings_.count(pid) > 0) {
+        RS_LOGW("RSUnmarshalThread::AddTransactionDataRing pid:%d already exists", pid);
     }
-    return transactionData;
+    rings_[pid] = std::make_shared<RSTransactionDataRing>();
+    ++ringsVersion_;
+}
+
+void RSUnmarshalThread::RemoveTransactionDataRing(pid_t pid)
+{
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    if (rings_.erase(pid) > 0) {
+        ++ringsVersion_;
+    }
+}
+
+bool RSUnmarshalThread::GetTransactionDataRings(uint64_t& version, TransactionDataRingMap& rings)
+{
+    if (ringsVersion_.load() == version) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    version = ringsVersion_.load();
+    rings = rings_;
+    return true;
+}
+
+std::shared_ptr<RSTransactionDataRing> RSUnmarshalThread::GetProducerRing(Worker& worker, pid_t pid)
+{
+    GetTransactionDataRings(worker.producerRingsVersion, worker.producerRings);
+    auto iter = worker.producerRings.find(pid);
+    return (iter != worker.producerRings.end()) ? iter->second : nullptr;
 }
 }
@@ -16,21 +16,36 @@
 #ifndef RS_UNMARSHAL_THREAD_H
 #define RS_UNMARSHAL_THREAD_H
 
+#include <atomic>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "event_handler.h"
 #include "message_parcel.h"
 
+#include "pipeline/rs_transaction_data_ring.h"
 #include "transaction/rs_transaction_data.h"
 
 namespace OHOS::Rosen {
+// A small pool of unmarshal workers. The parcels of a process always go to the same worker, so that its
+// transaction data keep their order and each RSTransactionDataRing has a single producer.
 class RSUnmarshalThread {
 public:
     static RSUnmarshalThread& Instance();
     void Start();
-    void PostTask(const std::function<void()>& task);
-    void RecvParcel(std::shared_ptr<MessageParcel>& parcel);
-    TransactionDataMap GetCachedTransactionData();
+    // post the task to every worker, e.g. a barrier, the task is called with the index of the worker
+    void PostTaskToAllWorkers(const std::function<void(size_t)>& task);
+    size_t GetWorkerCount() const;
+    // imageTransferOwner: the connection which owns the images pinned while unmarshalling, see RSImageCache
+    void RecvParcel(std::shared_ptr<MessageParcel>& parcel, pid_t callingPid, uint64_t imageTransferOwner);
+
+    using TransactionDataRingMap = std::unordered_map<pid_t, std::shared_ptr<RSTransactionDataRing>>;
+    // called when a process connects or disconnects
+    void AddTransactionDataRing(pid_t pid);
+    void RemoveTransactionDataRing(pid_t pid);
+    // for the consumer, get the rings of all processes if they changed since version
+    bool GetTransactionDataRings(uint64_t& version, TransactionDataRingMap& rings);
 
 private:
     RSUnmarshalThread() = default;
@@ -40,11 +55,25 @@ private:
     RSUnmarshalThread& operator=(const RSUnmarshalThread&);
     RSUnmarshalThread& operator=(const RSUnmarshalThread&&);
 
-    std::shared_ptr<AppExecFwk::EventRunner> runner_ = nullptr;
-    std::shared_ptr<AppExecFwk::EventHandler> handler_ = nullptr;
+    static constexpr size_t MAX_WORKER_COUNT = 4;
+
+    struct Worker {
+        std::shared_ptr<AppExecFwk::EventRunner> runner = nullptr;
+        std::shared_ptr<AppExecFwk::EventHandler> handler = nullptr;
+        // snapshot of rings_, only used in this worker
+        TransactionDataRingMap producerRings;
+        uint64_t producerRingsVersion = 0;
+    };
+
+    size_t GetWorkerIndex(pid_t pid) const;
+    // only called in the worker
+    std::shared_ptr<RSTransactionDataRing> GetProducerRing(Worker& worker, pid_t pid);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
 
-    std::mutex transactionDataMutex_;
-    TransactionDataMap cachedTransactionDataMap_;
+    std::mutex ringsMutex_;
+    TransactionDataRingMap rings_; // guarded by ringsMutex_
+    std::atomic<uint64_t> ringsVersion_ = 0;
 };
 }
 #endif // RS_UNMARSHAL_THREAD_H
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/rs_yuv_converter.h"
+
+#include <algorithm>
+
+#include "worker_pool.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RS_YUV_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define RS_YUV_SSE2
+#endif
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int COLOR_CHANNEL = 4;
+constexpr int UPPER_THRESHOLD = 255;
+
+// YUV to RGBA: Pixel value conversion table
+const int Table_fv1[256] = { -180, -179, -177, -176, -174, -173, -172, -170, -169, -167, -166, -165, -163, -162,
+    -160, -159, -158, -156, -155, -153, -152, -151, -149, -148, -146, -145, -144, -142, -141, -139,
+    -138, -137,  -135, -134, -132, -131, -130, -128, -127, -125, -124, -123, -121, -120, -118,
+    -117, -115, -114, -113, -111, -110, -108, -107, -106, -104, -103, -101, -100, -99, -97, -96,
+    -94, -93, -92, -90,  -89, -87, -86, -85, -83, -82, -80, -79, -78, -76, -75, -73, -72, -71,
+    -69, -68, -66, -65, -64, -62, -61, -59, -58, -57, -55, -54, -52, -51, -50, -48, -47, -45,
+    -44, -43, -41, -40, -38, -37,  -36, -34, -33, -31, -30, -29, -27, -26, -24, -23, -22, -20,
+    -19, -17, -16, -15, -13, -12, -10, -9, -8, -6, -5, -3, -2, 0, 1, 2, 4, 5, 7, 8, 9, 11, 12,
+    14, 15, 16, 18, 19, 21, 22, 23, 25, 26, 28, 29, 30, 32, 33, 35, 36, 37, 39, 40, 42, 43, 44,
+    46, 47, 49, 50, 51, 53, 54, 56, 57, 58, 60, 61, 63, 64, 65, 67, 68, 70, 71, 72, 74, 75, 77,
+    78, 79, 81, 82, 84, 85, 86, 88, 89, 91, 92, 93, 95, 96, 98, 99, 100, 102, 103, 105, 106, 107,
+    109, 110, 112, 113, 114, 116, 117, 119, 120, 122, 123, 124, 126, 127, 129, 130, 131, 133, 134,
+    136, 137, 138, 140, 141, 143, 144, 145, 147, 148,  150, 151, 152, 154, 155, 157, 158, 159, 161,
+    162, 164, 165, 166, 168, 169, 171, 172, 173, 175, 176, 178 };
+const int Table_fv2[256] = { -92, -91, -91, -90, -89, -88, -88, -87, -86, -86, -85, -84, -83, -83, -82, -81,
+    -81, -80, -79, -78, -78, -77, -76, -76, -75, -74, -73, -73, -72, -71, -71, -70, -69, -68, -68, -67, -66,
+    -66, -65, -64, -63, -63, -62, -61, -61, -60, -59, -58, -58, -57, -56, -56, -55, -54, -53, -53, -52, -51,
+    -51, -50, -49, -48, -48, -47, -46, -46, -45, -44, -43, -43, -42, -41, -41, -40, -39, -38, -38, -37, -36,
+    -36, -35, -34, -33, -33, -32, -31, -31, -30, -29, -28, -28, -27, -26, -26, -25, -24, -23, -23, -22, -21,
+    -21, -20, -19, -18, -18, -17, -16, -16, -15, -14, -13, -13, -12, -11, -11, -10, -9, -8, -8, -7, -6, -6,
+    -5, -4, -3, -3, -2, -1, 0, 0, 1, 2, 2, 3, 4, 5, 5, 6, 7, 7, 8, 9, 10, 10, 11, 12, 12, 13, 14, 15, 15, 16,
+    17, 17, 18, 19, 20, 20, 21, 22, 22, 23, 24, 25, 25, 26, 27, 27, 28, 29, 30, 30, 31, 32, 32, 33, 34, 35, 35,
+    36, 37, 37, 38, 39, 40, 40, 41, 42, 42, 43, 44, 45, 45, 46, 47, 47, 48, 49, 50, 50, 51, 52, 52, 53, 54, 55,
+    55, 56, 57, 57, 58, 59, 60, 60, 61, 62, 62, 63, 64, 65, 65, 66, 67, 67, 68, 69, 70, 70, 71, 72, 72, 73, 74,
+    75, 75, 76, 77, 77, 78, 79, 80, 80, 81, 82, 82, 83, 84, 85, 85, 86, 87, 87, 88, 89, 90, 90 };
+const int Table_fu1[256] = { -44, -44, -44, -43, -43, -43, -42, -42, -42, -41, -41, -41, -40, -40, -40, -39, -39,
+    -39, -38, -38, -38, -37, -37, -37, -36, -36, -36, -35, -35, -35, -34, -34, -33, -33, -33, -32, -32, -32, -31,
+    -31, -31, -30, -30, -30, -29, -29, -29, -28, -28, -28, -27, -27, -27, -26, -26, -26, -25, -25, -25, -24, -24,
+    -24, -23, -23, -22, -22, -22, -21, -21, -21, -20, -20, -20, -19, -19, -19, -18, -18, -18, -17, -17, -17, -16,
+    -16, -16, -15, -15, -15, -14, -14, -14, -13, -13, -13, -12, -12, -11, -11, -11, -10, -10, -10, -9, -9, -9, -8,
+    -8, -8, -7, -7, -7, -6, -6, -6, -5, -5, -5, -4, -4, -4, -3, -3, -3, -2, -2, -2, -1, -1, 0, 0, 0, 1, 1, 1, 2, 2,
+    2, 3, 3, 3, 4, 4, 4, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 11, 11, 11, 12, 12, 12, 13, 13, 13,
+    14, 14, 14, 15, 15, 15, 16, 16, 16, 17, 17, 17, 18, 18, 18, 19, 19, 19, 20, 20, 20, 21, 21, 22, 22, 22, 23,
+    23, 23, 24, 24, 24, 25, 25, 25, 26, 26, 26, 27, 27, 27, 28, 28, 28, 29, 29, 29, 30, 30, 30, 31, 31, 31, 32,
+    32, 33, 33, 33, 34, 34, 34, 35, 35, 35, 36, 36, 36, 37, 37, 37, 38, 38, 38, 39, 39, 39, 40, 40, 40, 41, 41,
+    41, 42, 42, 42, 43, 43 };
+const int Table_fu2[256] = { -227, -226, -224, -222, -220, -219, -217, -215, -213, -212, -210, -208, -206, -204,
+    -203, -201, -199, -197, -196, -194, -192, -190, -188, -187, -185, -183, -181, -180, -178, -176, -174, -173,
+    -171, -169, -167, -165, -164, -162, -160, -158, -157, -155, -153, -151, -149, -148, -146, -144, -142, -141,
+    -139, -137, -135, -134, -132, -130, -128, -126, -125, -123, -121, -119, -118, -116, -114, -112, -110, -109,
+    -107, -105, -103, -102, -100, -98, -96, -94, -93, -91, -89, -87, -86, -84, -82, -80, -79, -77, -75, -73,
+    -71, -70, -68, -66, -64, -63, -61, -59, -57, -55, -54, -52, -50, -48, -47, -45, -43, -41, -40, -38, -36,
+    -34, -32, -31, -29, -27, -25, -24, -22, -20, -18, -16, -15, -13, -11, -9, -8, -6, -4, -2, 0, 1, 3, 5, 7, 8,
+    10, 12, 14, 15, 17, 19, 21, 23, 24, 26, 28, 30, 31, 33, 35, 37, 39, 40, 42, 44, 46, 47, 49, 51, 53, 54, 56,
+    58, 60, 62, 63, 65, 67, 69, 70, 72, 74, 76, 78, 79, 81, 83, 85, 86, 88, 90, 92, 93, 95, 97, 99, 101, 102,
+    104, 106, 108, 109, 111, 113, 115, 117, 118, 120, 122, 124, 125, 127, 129, 131, 133, 134, 136, 138, 140, 141,
+    143, 145, 147, 148, 150, 152, 154, 156, 157, 159, 161, 163, 164, 166, 168, 170, 172, 173, 175, 177, 179, 180,
+    182, 184, 186, 187, 189, 191, 193, 195, 196, 198, 200, 202, 203, 205, 207, 209, 211, 212, 214, 216, 218,
+    219, 221, 223, 225 };
+
+#if defined(RS_YUV_NEON) || defined(RS_YUV_SSE2)
+// The tables are (c * (x - 128)) >> 8 with these factors, the vector paths compute them exactly.
+constexpr int16_t CHROMA_BIAS = 128;
+constexpr int16_t FACTOR_FV1 = 359;
+constexpr int16_t FACTOR_FV2 = 183;
+constexpr int16_t FACTOR_FU1 = 88;
+constexpr int16_t FACTOR_FU2 = 454;
+constexpr int32_t VECTOR_PIXELS = 16;
+#endif
+
+#if defined(RS_YUV_NEON)
+// converts the pixels [col, col + 16) of a row with the chroma differences of its 8 pairs of pixels.
+inline void StoreRGBA(const uint8_t* yRow, uint8_t* dst, int32_t col, const int16x8x2_t& rdif,
+    const int16x8x2_t& gdif, const int16x8x2_t& bdif)
+{
+    uint8x16_t y = vld1q_u8(yRow + col);
+    int16x8_t yLow = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y)));
+    int16x8_t yHigh = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y)));
+    uint8x16x4_t pixels;
+    pixels.val[0] = vcombine_u8(vqmovun_s16(vaddq_s16(yLow, rdif.val[0])), vqmovun_s16(vaddq_s16(yHigh, rdif.val[1])));
+    pixels.val[1] = vcombine_u8(vqmovun_s16(vsubq_s16(yLow, gdif.val[0])), vqmovun_s16(vsubq_s16(yHigh, gdif.val[1])));
+    pixels.val[2] = vcombine_u8(vqmovun_s16(vaddq_s16(yLow, bdif.val[0])), vqmovun_s16(vaddq_s16(yHigh, bdif.val[1])));
+    pixels.val[3] = vdupq_n_u8(UPPER_THRESHOLD);
+    vst4q_u8(dst + col * COLOR_CHANNEL, pixels);
+}
+
+int32_t ConvertRowPairVector(const uint8_t* yRow0, const uint8_t* yRow1, const uint8_t* uvRow, int32_t width,
+    bool vFirst, uint8_t* dst0, uint8_t* dst1)
+{
+    const int16x8_t bias = vdupq_n_s16(CHROMA_BIAS);
+    int32_t col = 0;
+    for (; col + VECTOR_PIXELS <= width; col += VECTOR_PIXELS) {
+        uint8x8x2_t uv = vld2_u8(uvRow + col);
+        int16x8_t u = vreinterpretq_s16_u16(vmovl_u8(vFirst ? uv.val[1] : uv.val[0]));
+        int16x8_t v = vreinterpretq_s16_u16(vmovl_u8(vFirst ? uv.val[0] : uv.val[1]));
+        // vqdmulh is (2 * a * b) >> 16, so (x - 128) << 7 times the factor is the table value.
+        int16x8_t du = vshlq_n_s16(vsubq_s16(u, bias), 7);
+        int16x8_t dv = vshlq_n_s16(vsubq_s16(v, bias), 7);
+        int16x8_t rdif = vqdmulhq_n_s16(dv, FACTOR_FV1);
+        int16x8_t gdif = vaddq_s16(vqdmulhq_n_s16(du, FACTOR_FU1), vqdmulhq_n_s16(dv, FACTOR_FV2));
+        int16x8_t bdif = vqdmulhq_n_s16(du, FACTOR_FU2);
+        // each pair of chroma samples covers two pixels of the row
+        int16x8x2_t rdifs = vzipq_s16(rdif, rdif);
+        int16x8x2_t gdifs = vzipq_s16(gdif, gdif);
+        int16x8x2_t bdifs = vzipq_s16(bdif, bdif);
+        StoreRGBA(yRow0, dst0, col, rdifs, gdifs, bdifs);
+        StoreRGBA(yRow1, dst1, col, rdifs, gdifs, bdifs);
+    }
+    return col;
+}
+#elif defined(RS_YUV_SSE2)
+inline void StoreRGBA(const uint8_t* yRow, uint8_t* dst, int32_t col, const __m128i (&rdif)[2],
+    const __m128i (&gdif)[2], const __m128i (&bdif)[2])
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow + col));
+    __m128i yLow = _mm_unpacklo_epi8(y, zero);
+    __m128i yHigh = _mm_unpackhi_epi8(y, zero);
+    __m128i r = _mm_packus_epi16(_mm_add_epi16(yLow, rdif[0]), _mm_add_epi16(yHigh, rdif[1]));
+    __m128i g = _mm_packus_epi16(_mm_sub_epi16(yLow, gdif[0]), _mm_sub_epi16(yHigh, gdif[1]));
+    __m128i b = _mm_packus_epi16(_mm_add_epi16(yLow, bdif[0]), _mm_add_epi16(yHigh, bdif[1]));
+    __m128i a = _mm_set1_epi8(static_cast<char>(UPPER_THRESHOLD));
+    __m128i rgLow = _mm_unpacklo_epi8(r, g);
+    __m128i rgHigh = _mm_unpackhi_epi8(r, g);
+    __m128i baLow = _mm_unpacklo_epi8(b, a);
+    __m128i baHigh = _mm_unpackhi_epi8(b, a);
+    __m128i* out = reinterpret_cast<__m128i*>(dst + col * COLOR_CHANNEL);
+    _mm_storeu_si128(out, _mm_unpacklo_epi16(rgLow, baLow));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(rgLow, baLow));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(rgHigh, baHigh)); // 2 is the third quarter
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(rgHigh, baHigh)); // 3 is the last quarter
+}
+
+int32_t ConvertRowPairVector(const uint8_t* yRow0, const uint8_t* yRow1, const uint8_t* uvRow, int32_t width,
+    bool vFirst, uint8_t* dst0, uint8_t* dst1)
+{
+    const __m128i lowBytes = _mm_set1_epi16(0xff);
+    const __m128i bias = _mm_set1_epi16(CHROMA_BIAS);
+    int32_t col = 0;
+    for (; col + VECTOR_PIXELS <= width; col += VECTOR_PIXELS) {
+        __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(uvRow + col));
+        __m128i even = _mm_and_si128(uv, lowBytes);
+        __m128i odd = _mm_srli_epi16(uv, 8); // 8 bits, the second sample of each pair
+        __m128i u = vFirst ? odd : even;
+        __m128i v = vFirst ? even : odd;
+        // mulhi is (a * b) >> 16, so (x - 128) << 8 times the factor is the table value.
+        __m128i du = _mm_slli_epi16(_mm_sub_epi16(u, bias), 8);
+        __m128i dv = _mm_slli_epi16(_mm_sub_epi16(v, bias), 8);
+        __m128i rdif = _mm_mulhi_epi16(dv, _mm_set1_epi16(FACTOR_FV1));
+        __m128i gdif = _mm_add_epi16(_mm_mulhi_epi16(du, _mm_set1_epi16(FACTOR_FU1)),
+            _mm_mulhi_epi16(dv, _mm_set1_epi16(FACTOR_FV2)));
+        __m128i bdif = _mm_mulhi_epi16(du, _mm_set1_epi16(FACTOR_FU2));
+        // each pair of chroma samples covers two pixels of the row
+        const __m128i rdifs[2] = { _mm_unpacklo_epi16(rdif, rdif), _mm_unpackhi_epi16(rdif, rdif) };
+        const __m128i gdifs[2] = { _mm_unpacklo_epi16(gdif, gdif), _mm_unpackhi_epi16(gdif, gdif) };
+        const __m128i bdifs[2] = { _mm_unpacklo_epi16(bdif, bdif), _mm_unpackhi_epi16(bdif, bdif) };
+        StoreRGBA(yRow0, dst0, col, rdifs, gdifs, bdifs);
+        StoreRGBA(yRow1, dst1, col, rdifs, gdifs, bdifs);
+    }
+    return col;
+}
+#else
+int32_t ConvertRowPairVector(const uint8_t*, const uint8_t*, const uint8_t*, int32_t, bool, uint8_t*, uint8_t*)
+{
+    return 0;
+}
+#endif
+
+inline uint8_t ClampColor(int value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0, UPPER_THRESHOLD));
+}
+} // namespace
+
+RSYuvConverter& RSYuvConverter::Instance()
+{
+    static RSYuvConverter instance;
+    return instance;
+}
+
+void RSYuvConverter::ConvertPixel(uint8_t y, uint8_t u, uint8_t v, uint8_t* rgba)
+{
+    int rdif = Table_fv1[v];
+    int invgdif = Table_fu1[u] + Table_fv2[v];
+    int bdif = Table_fu2[u];
+    rgba[0] = ClampColor(y + rdif);
+    rgba[1] = ClampColor(y - invgdif);
+    rgba[2] = ClampColor(y + bdif); // 2 is index
+    rgba[3] = UPPER_THRESHOLD; // 3 is index
+}
+
+void RSYuvConverter::ConvertRows(const YUV420SPImage& src, uint8_t* rgba, int32_t rowBegin, int32_t rowEnd)
+{
+    const int32_t dstStride = src.width * COLOR_CHANNEL;
+    const int32_t uIndex = src.vFirst ? 1 : 0;
+    for (int32_t row = rowBegin; row < rowEnd; row += 2) { // 2 rows share a row of chroma
+        const uint8_t* uvRow = src.uvPlane + (row / 2) * src.stride;
+        const uint8_t* yRow0 = src.yPlane + row * src.stride;
+        uint8_t* dst0 = rgba + row * dstStride;
+        // the last row of an odd height is converted alone
+        bool hasSecondRow = row + 1 < rowEnd;
+        const uint8_t* yRow1 = hasSecondRow ? yRow0 + src.stride : yRow0;
+        uint8_t* dst1 = hasSecondRow ? dst0 + dstStride : dst0;
+
+        int32_t col = ConvertRowPairVector(yRow0, yRow1, uvRow, src.width, src.vFirst, dst0, dst1);
+        for (; col < src.width; col++) {
+            const uint8_t* uv = uvRow + (col / 2) * 2; // 2 samples per pair of pixels
+            uint8_t u = uv[uIndex];
+            uint8_t v = uv[1 - uIndex];
+            ConvertPixel(yRow0[col], u, v, dst0 + col * COLOR_CHANNEL);
+            ConvertPixel(yRow1[col], u, v, dst1 + col * COLOR_CHANNEL);
+        }
+    }
+}
+
+void RSYuvConverter::ConvertYUV420SPToRGBA(const YUV420SPImage& src, uint8_t* rgba)
+{
+    if (src.yPlane == nullptr || src.uvPlane == nullptr || rgba == nullptr || src.width < 1 || src.height < 1) {
+        return;
+    }
+    int32_t stripeCount = (src.height + STRIPE_ROWS - 1) / STRIPE_ROWS;
+    WorkerPool::Instance().ParallelFor(stripeCount, [&src, rgba](int32_t stripe) {
+        int32_t rowBegin = stripe * STRIPE_ROWS;
+        ConvertRows(src, rgba, rowBegin, std::min(rowBegin + STRIPE_ROWS, src.height));
+    });
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CORE_PIPELINE_RS_YUV_CONVERTER_H
+#define RENDER_SERVICE_CORE_PIPELINE_RS_YUV_CONVERTER_H
+
+#include <cstdint>
+
+namespace OHOS::Rosen {
+struct YUV420SPImage {
+    const uint8_t* yPlane = nullptr;
+    // the interleaved chroma plane, one pair of samples for 2x2 pixels
+    const uint8_t* uvPlane = nullptr;
+    int32_t stride = 0; // of both planes, in bytes
+    int32_t width = 0;
+    int32_t height = 0;
+    // V before U (NV21, PIXEL_FMT_YCRCB_420_SP), otherwise U before V (NV12, PIXEL_FMT_YCBCR_420_SP)
+    bool vFirst = true;
+};
+
+// Converts YUV420SP buffers to RGBA8888 for the CPU composition of video layers. The two rows which share a row of
+// chroma are converted together, 16 pixels at a time with NEON or SSE2, and the row pairs are split into stripes
+// that run on the WorkerPool of the process. The result is the same as the one of the conversion tables for every
+// pixel.
+class RSYuvConverter {
+public:
+    static RSYuvConverter& Instance();
+
+    // rgba is tightly packed, width * height * 4 bytes.
+    void ConvertYUV420SPToRGBA(const YUV420SPImage& src, uint8_t* rgba);
+    // converts the rows [rowBegin, rowEnd) on the calling thread, rowBegin must be even.
+    static void ConvertRows(const YUV420SPImage& src, uint8_t* rgba, int32_t rowBegin, int32_t rowEnd);
+    // the reference conversion of a single pixel with the tables.
+    static void ConvertPixel(uint8_t y, uint8_t u, uint8_t v, uint8_t* rgba);
+
+    static constexpr int32_t STRIPE_ROWS = 64;
+
+private:
+    RSYuvConverter() = default;
+    ~RSYuvConverter() = default;
+    RSYuvConverter(const RSYuvConverter&) = delete;
+    RSYuvConverter(const RSYuvConverter&&) = delete;
+    RSYuvConverter& operator=(const RSYuvConverter&) = delete;
+    RSYuvConverter& operator=(const RSYuvConverter&&) = delete;
+};
+} // namespace OHOS::Rosen
+#endif // RENDER_SERVICE_CORE_PIPELINE_RS_YUV_CONVERTER_H
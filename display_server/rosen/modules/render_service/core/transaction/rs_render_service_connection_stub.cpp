@@ -14,6 +14,9 @@
  */
 
 #include "rs_render_service_connection_stub.h"
+
+#include <atomic>
+
 #include "ivsync_connection.h"
 #include "securec.h"
 #include "sys_binder.h"
@@ -24,6 +27,7 @@
 #include "pipeline/rs_uni_render_judgement.h"
 #include "pipeline/rs_unmarshal_thread.h"
 #include "platform/common/rs_log.h"
+#include "render/rs_image_cache.h"
 #include "transaction/rs_ashmem_helper.h"
 #include "rs_trace.h"
 
@@ -88,7 +92,15 @@ std::shared_ptr<MessageParcel> CopyParcelIfNeed(MessageParcel& old)
     }
     return parcelCopied;
 }
+
+uint64_t GenerateImageTransferOwner()
+{
+    static std::atomic<uint64_t> ownerCount = 0;
+    return ++ownerCount;
 }
+} // namespace
+
+RSRenderServiceConnectionStub::RSRenderServiceConnectionStub() : imageTransferOwner_(GenerateImageTransferOwner()) {}
 
 int RSRenderServiceConnectionStub::OnRemoteRequest(
     uint32_t code, MessageParcel& data, MessageParcel& reply, MessageOption& option)
@@ -97,6 +109,7 @@ int RSRenderServiceConnectionStub::OnRemoteRequest(
     switch (code) {
         case COMMIT_TRANSACTION: {
             RS_ASYNC_TRACE_END("RSProxySendRequest", data.GetDataSize());
+            RSImageCache::TransferOwnerScope ownerScope(imageTransferOwner_);
             static bool isUniRender = RSUniRenderJudgement::IsUniRender();
             std::shared_ptr<MessageParcel> parsedParcel;
             if (data.ReadInt32() == 0) { // indicate normal parcel
@@ -121,11 +134,13 @@ int RSRenderServiceConnectionStub::OnRemoteRequest(
             }
             if (parsedParcel == nullptr) {
                 RS_LOGE("RSRenderServiceConnectionStub::COMMIT_TRANSACTION failed");
+                // the fds of the slabs are carried next to the ashmem
+                RSParcelSlabCache::Instance().ReleaseParcel(data);
                 return ERR_INVALID_DATA;
             }
             if (RSMainThread::Instance()->QueryIfUseUniVisitor()) {
                 // post Unmarshalling task to RSUnmarshalThread
-                RSUnmarshalThread::Instance().RecvParcel(parsedParcel);
+                RSUnmarshalThread::Instance().RecvParcel(parsedParcel, GetCallingPid(), imageTransferOwner_);
             } else {
                 // execute Unmarshalling immediately
                 auto transactionData = RSBaseRenderUtil::ParseTransactionData(*parsedParcel);
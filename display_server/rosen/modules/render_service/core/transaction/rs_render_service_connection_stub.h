@@ -26,10 +26,14 @@ namespace OHOS {
 namespace Rosen {
 class RSRenderServiceConnectionStub : public IRemoteStub<RSIRenderServiceConnection> {
 public:
-    RSRenderServiceConnectionStub() = default;
+    RSRenderServiceConnectionStub();
     ~RSRenderServiceConnectionStub() noexcept = default;
 
     int OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply, MessageOption& option) override;
+
+protected:
+    // owns the images pinned while unmarshalling the transaction data of this connection, see RSImageCache
+    const uint64_t imageTransferOwner_;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -38,6 +38,8 @@ enum RSCommandType : uint16_t {
     ANIMATION,
     // read showing properties (deprecated, will be removed later)
     RS_NODE_SYNCHRONOUS_READ_PROPERTY,
+    // image transfer cache commands
+    IMAGE_CACHE,
 };
 
 class RSCommand : public Parcelable {
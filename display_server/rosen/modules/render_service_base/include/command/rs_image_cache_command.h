@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ROSEN_RENDER_SERVICE_BASE_COMMAND_RS_IMAGE_CACHE_COMMAND_H
+#define ROSEN_RENDER_SERVICE_BASE_COMMAND_RS_IMAGE_CACHE_COMMAND_H
+
+#include "include/core/SkImage.h"
+
+#include "command/rs_command_templates.h"
+#include "common/rs_macros.h"
+
+namespace OHOS {
+namespace Rosen {
+enum RSImageCacheCommandType : uint16_t {
+    // UI operation, the render service holds the image
+    IMAGE_CACHE_ACKNOWLEDGE,
+    // the client does not use the image anymore
+    IMAGE_CACHE_RELEASE,
+    // UI operation, the render service lost an image sent by id, the client sends its pixels again
+    IMAGE_CACHE_MISS,
+    // the pixels of a missed image
+    IMAGE_CACHE_RESEND,
+};
+
+class RSB_EXPORT ImageCacheCommandHelper {
+public:
+    static void Acknowledge(RSContext& context, uint64_t uniqueId, uint32_t sequence, uint64_t bytes, uint64_t budget);
+    static void Release(RSContext& context, uint64_t uniqueId, uint32_t sequence);
+    static void Miss(RSContext& context, uint64_t uniqueId);
+    static void Resend(RSContext& context, uint64_t uniqueId, sk_sp<SkImage> image);
+};
+
+ADD_COMMAND(RSImageCacheAcknowledge, ARG(IMAGE_CACHE, IMAGE_CACHE_ACKNOWLEDGE, ImageCacheCommandHelper::Acknowledge,
+    uint64_t, uint32_t, uint64_t, uint64_t))
+ADD_COMMAND(RSImageCacheRelease,
+    ARG(IMAGE_CACHE, IMAGE_CACHE_RELEASE, ImageCacheCommandHelper::Release, uint64_t, uint32_t))
+ADD_COMMAND(RSImageCacheMiss, ARG(IMAGE_CACHE, IMAGE_CACHE_MISS, ImageCacheCommandHelper::Miss, uint64_t))
+ADD_COMMAND(RSImageCacheResend,
+    ARG(IMAGE_CACHE, IMAGE_CACHE_RESEND, ImageCacheCommandHelper::Resend, uint64_t, sk_sp<SkImage>))
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // ROSEN_RENDER_SERVICE_BASE_COMMAND_RS_IMAGE_CACHE_COMMAND_H
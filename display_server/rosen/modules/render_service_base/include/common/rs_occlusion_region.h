@@ -297,8 +297,8 @@ private:
         int preY = 0;
         int curY = 0;
     };
-    // get ranges from segmentTree node according to logical operation type
-    void getRange(std::vector<Range>& ranges, Node& node, OP op);
+    // per-thread scratch memory of RegionOpLocal, reused by every op so that it runs without heap allocation.
+    class OpScratch;
     // update tmp rects and region according to current ranges
     void UpdateRects(Rects& r, std::vector<Range>& ranges, std::vector<int>& indexAt, Region& res);
     
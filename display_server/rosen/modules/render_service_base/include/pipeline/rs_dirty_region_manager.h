@@ -35,6 +35,8 @@ enum DebugRegionType {
 class RSB_EXPORT RSDirtyRegionManager final {
 public:
     static constexpr int32_t ALIGNED_BITS = 32;
+    // max count of disjoint dirty rects, beyond it the cheapest pair is merged.
+    static constexpr size_t MAX_DIRTY_RECT_COUNT = 8;
     RSDirtyRegionManager();
     ~RSDirtyRegionManager() = default;
     void MergeDirtyRect(const RectI& rect);
@@ -42,8 +44,12 @@ public:
     // Clip dirtyRegion intersected with surfaceRect
     void ClipDirtyRectWithinSurface();
     void Clear();
-    // return merged historical region
+    // return bounding rect of merged historical region
     const RectI& GetDirtyRegion() const;
+    // return merged historical region as disjoint rects, at most MAX_DIRTY_RECT_COUNT
+    const std::vector<RectI>& GetDirtyRects() const;
+    // return merged historical region as disjoint rects upsize down in surface
+    std::vector<RectI> GetDirtyRectsFlipWithinSurface() const;
     // return merged historical region upsize down in surface
     RectI GetDirtyRegionFlipWithinSurface() const;
     // return current frame's region
@@ -83,17 +89,23 @@ public:
     }
 
 private:
-    RectI MergeHistory(unsigned int age, RectI rect) const;
-    void PushHistory(RectI rect);
-    // get his rect according to index offset
-    RectI GetHistory(unsigned int i) const;
+    std::vector<RectI> MergeHistory(unsigned int age, std::vector<RectI> rects) const;
+    void PushHistory(const std::vector<RectI>& rects);
+    // get his rects according to index offset
+    const std::vector<RectI>& GetHistoryRects(unsigned int i) const;
+    unsigned int GetHistoryIndex(unsigned int i) const;
+    // add rect to the disjoint rects, joining it with the rects it overlaps or is close to
+    static void MergeRectInto(std::vector<RectI>& rects, const RectI& rect);
+    void UpdateDirtyBound();
 
     RectI surfaceRect_;
-    RectI dirtyRegion_;
+    RectI dirtyRegion_; // bounding rect of dirtyRects_
+    std::vector<RectI> dirtyRects_;
     std::map<NodeId, RectI> dirtyCanvasNodes_;
     std::map<NodeId, RectI> dirtySurfaceNodes_;
     std::vector<bool> debugRegionEnabled_;
     std::vector<RectI> dirtyHistory_;
+    std::vector<std::vector<RectI>> dirtyRectsHistory_;
     int historyHead_ = -1;
     unsigned int historySize_ = 0;
     const unsigned HISTORY_QUEUE_MAX_SIZE = 4;
@@ -90,6 +90,8 @@ public:
 
     virtual void Draw(RSPaintFilterCanvas& canvas, const SkRect* rect) const {};
     virtual RSOpType GetType() const = 0;
+    // draws the op of the type through a table instead of the virtual Draw, the type must be the one of the op
+    static void DrawByType(RSOpType type, const OpItem& op, RSPaintFilterCanvas& canvas, const SkRect* rect);
 
     std::unique_ptr<OpItem> GenerateCachedOpItem(SkSurface* surface) const;
     virtual std::optional<SkRect> GetCacheBounds() const
@@ -125,7 +127,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRect rect_;
@@ -143,7 +145,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRRect rrect_;
@@ -166,7 +168,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     std::shared_ptr<RSImage> rsImage_;
@@ -184,7 +186,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRRect outer_;
@@ -207,7 +209,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRect rect_;
@@ -225,7 +227,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRegion region_;
@@ -243,7 +245,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRect rect_;
@@ -263,7 +265,7 @@ public:
         return RSOpType::SAVE_OPITEM;
     }
 
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 };
 
 class RestoreOpItem : public OpItem {
@@ -277,7 +279,7 @@ public:
         return RSOpType::RESTORE_OPITEM;
     }
 
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 };
 
 class FlushOpItem : public OpItem {
@@ -291,7 +293,7 @@ public:
         return RSOpType::FLUSH_OPITEM;
     }
 
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 };
 
 class MatrixOpItem : public OpItem {
@@ -306,7 +308,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkMatrix matrix_;
@@ -324,7 +326,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRect rect_;
@@ -344,7 +346,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRRect rrect_;
@@ -364,7 +366,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRegion region_;
@@ -383,7 +385,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     float distanceX_;
@@ -406,7 +408,7 @@ public:
         return RSOpType::TEXTBLOB_OPITEM;
     }
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     sk_sp<SkTextBlob> textBlob_;
@@ -426,7 +428,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     float left_;
@@ -447,7 +449,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRect rectSrc_;
@@ -467,7 +469,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     std::shared_ptr<Media::PixelMap> pixelmap_;
@@ -488,7 +490,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     std::shared_ptr<Media::PixelMap> pixelmap_;
@@ -509,7 +511,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkIRect center_;
@@ -529,7 +531,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     float radius_;
@@ -548,7 +550,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     float radiusRatio_;
@@ -567,7 +569,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkVector radius_[4];
@@ -585,7 +587,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     float dx_;
@@ -608,7 +610,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkPath path_;
@@ -626,7 +628,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkPath path_;
@@ -646,7 +648,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 };
 
 class ConcatOpItem : public OpItem {
@@ -661,7 +663,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkMatrix matrix_;
@@ -679,7 +681,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkRect* rectPtr_ = nullptr;
@@ -702,7 +704,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     sk_sp<SkDrawable> drawable_;
@@ -721,7 +723,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     sk_sp<SkPicture> picture_ { nullptr };
@@ -743,7 +745,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkCanvas::PointMode mode_;
@@ -764,7 +766,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     sk_sp<SkVertices> vertices_;
@@ -785,7 +787,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     SkPath path_;
@@ -804,7 +806,7 @@ public:
     }
 
     bool Marshalling(Parcel& parcel) const override;
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 
 private:
     float alpha_;
@@ -821,7 +823,7 @@ public:
         return RSOpType::SAVE_ALPHA_OPITEM;
     }
 
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 };
 
 class RestoreAlphaOpItem : public OpItem {
@@ -835,7 +837,7 @@ public:
         return RSOpType::RESTORE_ALPHA_OPITEM;
     }
 
-    static OpItem* Unmarshalling(Parcel& parcel);
+    static OpItem* Unmarshalling(Parcel& parcel, OpItemArena* arena = nullptr);
 };
 
 } // namespace Rosen
@@ -17,9 +17,12 @@
 #define RENDER_SERVICE_CLIENT_CORE_PIPELINE_RS_DRAW_CMD_LIST_H
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "common/rs_common_def.h"
@@ -33,6 +36,38 @@ namespace OHOS {
 namespace Rosen {
 class OpItem;
 class RSPaintFilterCanvas;
+enum RSOpType : uint16_t;
+
+// Memory of the ops of a DrawCmdList. The ops are constructed back to back in chunks, so that a list is built with a
+// few allocations and played back in the order of its memory. The arena does not destroy the ops, its owner does.
+class RSB_EXPORT OpItemArena {
+public:
+    OpItemArena() = default;
+    ~OpItemArena() = default;
+
+    template<typename T, typename... Args>
+    T* New(Args&&... args)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over aligned op");
+        // the global placement new, OpItem has its own operator new
+        return ::new (Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+    }
+    // keeps the last chunk for the next ops, the ops constructed before must be destroyed
+    void Reset();
+    void Swap(OpItemArena& other);
+
+private:
+    OpItemArena(const OpItemArena&) = delete;
+    OpItemArena& operator=(const OpItemArena&) = delete;
+
+    void* Allocate(size_t size);
+
+    static constexpr size_t MIN_CHUNK_SIZE = 4 * 1024;
+    static constexpr size_t MAX_CHUNK_SIZE = 64 * 1024;
+    std::vector<std::unique_ptr<std::max_align_t[]>> chunks_;
+    size_t chunkSize_ = 0;
+    size_t offset_ = 0;
+};
 
 class RSB_EXPORT DrawCmdList : public Parcelable {
 public:
@@ -40,6 +75,14 @@ public:
     DrawCmdList& operator=(DrawCmdList&& that);
     virtual ~DrawCmdList();
 
+    // constructs the op in the memory of the list
+    template<typename T, typename... Args>
+    void AddOp(Args&&... args)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        T* op = arena_.New<T>(std::forward<Args>(args)...);
+        ops_.push_back({ op, op->GetType(), true });
+    }
     void AddOp(std::unique_ptr<OpItem>&& op);
     void ClearOp();
 
@@ -57,12 +100,22 @@ public:
     static RSB_EXPORT DrawCmdList* Unmarshalling(Parcel& parcel);
 
 private:
-    std::vector<std::unique_ptr<OpItem>> ops_;
+    struct OpEntry {
+        OpItem* op;
+        RSOpType type;
+        // constructed in arena_, otherwise owned on the heap
+        bool inArena;
+    };
+    static void DestroyOp(const OpEntry& entry);
+
+    // the type tags and the ops in the order of drawing, most ops are in arena_ in the same order
+    std::vector<OpEntry> ops_;
+    OpItemArena arena_;
     mutable std::mutex mutex_;
     int width_;
     int height_;
 
-    std::unordered_map<int, std::unique_ptr<OpItem>> opReplacedByCache_;
+    std::unordered_map<int, OpEntry> opReplacedByCache_;
 #ifdef ROSEN_OHOS
     bool isCached_ = false;
 #endif
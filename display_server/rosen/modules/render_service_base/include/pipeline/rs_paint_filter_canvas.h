@@ -64,6 +64,16 @@ public:
         return isCacheEnabled_;
     }
 
+    // the filtered backdrops are only reused on the canvas of the screen, whose backdrops are tracked by the visitor.
+    void SetFilterCacheEnabled(bool enabled)
+    {
+        isFilterCacheEnabled_ = enabled;
+    }
+    bool isFilterCacheEnabled() const
+    {
+        return isFilterCacheEnabled_;
+    }
+
     void SetVisibleRect(SkRect visibleRect)
     {
         visibleRect_ = visibleRect;
@@ -83,6 +93,7 @@ private:
     std::stack<float> alphaStack_;
     std::atomic_bool isHighContrastEnabled_ { false };
     bool isCacheEnabled_ { false };
+    bool isFilterCacheEnabled_ { false };
     SkRect visibleRect_ = SkRect::MakeEmpty();
 };
 
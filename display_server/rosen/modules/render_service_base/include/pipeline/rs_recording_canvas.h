@@ -128,6 +128,9 @@ public:
                               const SkMatrix[], const SkPaint*, SrcRectConstraint) override {}
 
 private:
+    // constructs the op in the draw cmd list, only used by the draw calls
+    template<typename T, typename... Args>
+    void AddOp(Args&&... args);
     void DrawImageLatticeAsBitmap(
         const SkImage* image, const SkCanvas::Lattice& lattice, const SkRect& dst, const SkPaint* paint);
 
@@ -43,6 +43,12 @@ enum class PartialRenderType {
     SET_DAMAGE_AND_DROP_OP_NOT_VISIBLEDIRTY     // 4, drop draw_op if node is not in visible dirty region (unirender)
 };
 
+enum class BlurQualityType {
+    HIGH = 0,                                   // 0, blur at full resolution
+    BALANCED,                                   // 1, downsample the large radius blurs, hardly visible
+    FAST                                        // 2, downsample further, for the low end devices
+};
+
 enum class DumpSurfaceType {
     DISABLED = 0,
     SINGLESURFACE,
@@ -77,6 +83,9 @@ public:
     static PartialRenderType GetUniPartialRenderEnabled();
     static ContainerWindowConfigType GetContainerWindowConfig();
     static bool GetOcclusionEnabled();
+    static bool GetVSyncTimelineEnabled();
+    static bool GetVSyncAdaptivePhaseEnabled();
+    static BlurQualityType GetBlurQuality();
     static std::string GetRSEventProperty(const std::string &paraName);
     static bool GetDirectClientCompEnableStatus();
     static bool GetHighContrastStatus();
@@ -91,6 +100,7 @@ public:
     static bool GetDrawTextAsBitmap();
 
     static bool GetColdStartThreadEnabled();
+    static bool GetHardwareThreadEnabled();
     static float GetAnimationScale();
 
     static bool GetBoolSystemProperty(const char* name, bool defaultValue);
@@ -47,6 +47,9 @@ public:
     static int GetAndResetBlurCnt();
     static SkColor CalcAverageColor(sk_sp<SkImage> imageSnapshot);
 private:
+    static void DrawCachedFilter(
+        RSPaintFilterCanvas& canvas, const sk_sp<SkImage>& cachedImage, const SkIRect& cacheRect);
+
     inline static int g_blurCnt = 0;
 };
 } // namespace Rosen
@@ -26,6 +26,9 @@ public:
     ~RSBlurFilter() override;
     float GetBlurRadiusX();
     float GetBlurRadiusY();
+    // the large radii are blurred at a lower resolution, see RSDualBlur.
+    void DrawImageRect(
+        SkCanvas& canvas, const sk_sp<SkImage>& image, const SkRect& src, const SkRect& dst) const override;
 
     std::shared_ptr<RSFilter> Add(const std::shared_ptr<RSFilter>& rhs) override;
     std::shared_ptr<RSFilter> Sub(const std::shared_ptr<RSFilter>& rhs) override;
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RENDER_SERVICE_CLIENT_CORE_RENDER_RS_DUAL_BLUR_H
+#define RENDER_SERVICE_CLIENT_CORE_RENDER_RS_DUAL_BLUR_H
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPaint.h"
+
+#include "common/rs_macros.h"
+#include "platform/common/rs_system_properties.h"
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Blur of a large sigma at a lower resolution: the image is halved a few times, blurred with the remaining sigma,
+ * then scaled back with bilinear filtering. The halvings and the upscale blur a little by themselves, their variance
+ * is subtracted from the sigma, so the result stays close to the full resolution blur while its cost hardly grows
+ * with the sigma. Raster surfaces are used if the canvas has no GPU context.
+ */
+class RSB_EXPORT RSDualBlur {
+public:
+    // the count of halvings for the sigma, 0 if it is blurred at full resolution.
+    static int GetDownsampleLevels(float sigmaX, float sigmaY, BlurQualityType quality);
+    // "rosen.blur.quality", read once.
+    static BlurQualityType GetQuality();
+
+    // draw the src rect of the image into the dst rect of the canvas, blurred at 1 / 2^levels of the resolution.
+    // the paint is used for the upscale, e.g. for its color filter. returns false if nothing is drawn.
+    static bool Draw(SkCanvas& canvas, const sk_sp<SkImage>& image, const SkRect& src, const SkRect& dst,
+        float sigmaX, float sigmaY, int levels, const SkPaint& paint);
+
+private:
+    RSDualBlur() = delete;
+};
+} // namespace Rosen
+} // namespace OHOS
+
+#endif // RENDER_SERVICE_CLIENT_CORE_RENDER_RS_DUAL_BLUR_H
@@ -88,6 +88,10 @@ private:
     void ApplyCanvasClip(SkCanvas& canvas);
     void DrawImageRepeatRect(const SkPaint& paint, SkCanvas& canvas);
     void UploadGpu(SkCanvas& canvas);
+    void ResolveMissingImage();
+#ifdef ROSEN_OHOS
+    static void AcknowledgeTransfer(uint64_t uniqueId, const sk_sp<SkImage>& img);
+#endif
 
     mutable std::mutex mutex_;
     sk_sp<SkImage> image_;
@@ -102,6 +106,8 @@ private:
     RectF frameRect_;
     double scale_ = 1.0;
     uint64_t uniqueId_;
+    // sent by id but not found in RSImageCache, the client sends the pixels again
+    bool isImageMissing_ = false;
 };
 
 template<>
@@ -30,6 +30,29 @@ public:
     sk_sp<SkImage> GetSkiaImageCache(uint64_t uniqueId) const;
     void ReleaseSkiaImageCache(uint64_t uniqueId);
 
+    // the connection unmarshalling transaction data on the current thread, it owns the images pinned meanwhile.
+    class TransferOwnerScope {
+    public:
+        explicit TransferOwnerScope(uint64_t owner);
+        ~TransferOwnerScope();
+
+    private:
+        uint64_t prevOwner_;
+    };
+
+    // the images transferred by the clients are kept until the client releases them, see RSImageTransferCache.
+    // return the sequence to acknowledge to the client, 0 if the client is over its budget or no connection owns the
+    // image on this thread, then it must keep sending it.
+    uint32_t PinTransferredImage(uint64_t uniqueId, sk_sp<SkImage> img);
+    // only release the pin of sequence, the image may be pinned again since the client decided to release it.
+    void ReleaseTransferredImage(uint64_t uniqueId, uint32_t sequence);
+    // called when the owning connection is cleaned up, the other connections of the same process keep their pins.
+    void ReleaseTransferredImages(uint64_t owner);
+    size_t GetTransferredBytes(uint64_t owner) const;
+
+    // the budget reported to each client, which evicts its least recently used images past it.
+    static constexpr size_t TRANSFER_BUDGET = 32 * 1024 * 1024;
+
     RSImageCache() = default;
     ~RSImageCache() = default;
 
@@ -39,8 +62,19 @@ private:
     RSImageCache& operator=(const RSImageCache&) = delete;
     RSImageCache& operator=(const RSImageCache&&) = delete;
 
+    struct TransferredImage {
+        sk_sp<SkImage> image;
+        uint32_t sequence;
+        size_t bytes;
+        uint64_t owner;
+    };
+    void UnpinLocked(std::unordered_map<uint64_t, TransferredImage>::iterator it);
+
     mutable std::mutex mutex_;
     std::unordered_map<uint64_t, sk_sp<SkImage>> skiaImageCache_;
+    std::unordered_map<uint64_t, TransferredImage> transferredImages_;
+    std::unordered_map<uint64_t, size_t> transferredBytes_; // by owner
+    uint32_t transferSequence_ = 0;
 };
 } // namespace Rosen
 } // namespace OHOS
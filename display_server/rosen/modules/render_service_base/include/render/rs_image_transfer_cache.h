@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RENDER_SERVICE_CLIENT_CORE_RENDER_RS_IMAGE_TRANSFER_CACHE_H
+#define RENDER_SERVICE_CLIENT_CORE_RENDER_RS_IMAGE_TRANSFER_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "include/core/SkImage.h"
+
+#include "common/rs_macros.h"
+
+namespace OHOS {
+namespace Rosen {
+// The client side of the image transfer cache, tracks the images the render service has acknowledged, so that
+// RSImage::Marshalling sends only their ids. The client evicts the least recently used ones past the budget reported
+// by the render service and tells it with RSImageCacheRelease, the render service never evicts them by itself.
+class RSB_EXPORT RSImageTransferCache {
+public:
+    static RSImageTransferCache& Instance();
+
+    // whether the render service holds the image, marks it as recently used if so. The image is kept to send its
+    // pixels again if the render service misses it.
+    bool IsHeldByService(uint64_t uniqueId, const sk_sp<SkImage>& image = nullptr);
+    void OnAcknowledged(uint64_t uniqueId, uint32_t sequence, uint64_t bytes, uint64_t budget);
+    // the render service did not find an image sent by id, send its pixels again and forget it.
+    void OnMissed(uint64_t uniqueId);
+    // the connection to the render service is lost, the new one holds nothing.
+    void Reset();
+    uint64_t GetHeldBytes() const;
+
+private:
+    RSImageTransferCache() = default;
+    ~RSImageTransferCache() = default;
+    RSImageTransferCache(const RSImageTransferCache&) = delete;
+    RSImageTransferCache(const RSImageTransferCache&&) = delete;
+    RSImageTransferCache& operator=(const RSImageTransferCache&) = delete;
+    RSImageTransferCache& operator=(const RSImageTransferCache&&) = delete;
+
+    struct Entry {
+        uint64_t uniqueId;
+        uint32_t sequence;
+        uint64_t bytes;
+        sk_sp<SkImage> image; // set once it is sent by id
+    };
+
+    mutable std::mutex mutex_;
+    std::list<Entry> lru_; // the most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> entries_;
+    uint64_t heldBytes_ = 0;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // RENDER_SERVICE_CLIENT_CORE_RENDER_RS_IMAGE_TRANSFER_CACHE_H
@@ -50,6 +50,8 @@ public:
     ~RSMaterialFilter() override;
     void PreProcess(sk_sp<SkImage> image) override;
     void PostProcess(RSPaintFilterCanvas& canvas) override;
+    void DrawImageRect(
+        SkCanvas& canvas, const sk_sp<SkImage>& image, const SkRect& src, const SkRect& dst) const override;
 
     std::shared_ptr<RSFilter> Add(const std::shared_ptr<RSFilter>& rhs) override;
     std::shared_ptr<RSFilter> Sub(const std::shared_ptr<RSFilter>& rhs) override;
@@ -60,6 +62,8 @@ private:
     MATERIAL_BLUR_STYLE style_;
     BLUR_COLOR_MODE colorMode_;
     SkColor maskColor_;
+    float blurSigma_ = 0.0f;
+    float saturation_ = 1.0f;
 
     sk_sp<SkImageFilter> CreateMaterialStyle(MATERIAL_BLUR_STYLE style, float dipScale);
     sk_sp<SkImageFilter> CreateMaterialFilter(float radius, float sat, SkColor maskColor);
@@ -15,7 +15,10 @@
 #ifndef RENDER_SERVICE_CLIENT_CORE_RENDER_SKIA_RS_SKIA_FILTER_H
 #define RENDER_SERVICE_CLIENT_CORE_RENDER_SKIA_RS_SKIA_FILTER_H
 
+#include <cstdint>
+
 #include "include/core/SkCanvas.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkPaint.h"
 
@@ -30,12 +33,33 @@ public:
     SkPaint GetPaint() const;
     virtual void PreProcess(sk_sp<SkImage> image) {};
     virtual void PostProcess(RSPaintFilterCanvas& canvas) {};
+    // draw the src rect of the image into the dst rect of the canvas through the filter.
+    virtual void DrawImageRect(
+        SkCanvas& canvas, const sk_sp<SkImage>& image, const SkRect& src, const SkRect& dst) const;
+
+    // the filtered backdrop is reused by the next frame if the visitor marks the backdrop unchanged before it.
+    void MarkBackdrop(bool changed);
+    // the cached image of the device rect, nullptr if the backdrop is not marked unchanged since it is cached.
+    sk_sp<SkImage> GetCachedImage(const SkIRect& rect) const;
+    bool IsBackdropStable() const
+    {
+        return isBackdropStable_;
+    }
+    void SetCachedImage(sk_sp<SkImage> image, const SkIRect& rect);
+    // called after each draw, the backdrop must be marked again for the next frame.
+    void ConsumeBackdropMark();
+    // drop the cached images of all the filters, e.g. when the surfaces are moved or removed.
+    static void InvalidateCachedImages();
 
 protected:
     RSSkiaFilter(sk_sp<SkImageFilter> imagefilter);
 
 private:
     sk_sp<SkImageFilter> imageFilter_;
+    sk_sp<SkImage> cachedImage_;
+    SkIRect cachedRect_ = SkIRect::MakeEmpty();
+    uint32_t cachedEpoch_ = 0;
+    bool isBackdropStable_ = false;
 };
 } // namespace Rosen
 } // namespace OHOS
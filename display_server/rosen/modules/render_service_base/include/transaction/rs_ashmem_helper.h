@@ -16,7 +16,10 @@
 #ifndef RENDER_SERVICE_BASE_TRANSACTION_RS_ASHMEM_HELPER_H
 #define RENDER_SERVICE_BASE_TRANSACTION_RS_ASHMEM_HELPER_H
 
+#include <map>
 #include <message_parcel.h>
+#include <mutex>
+#include <vector>
 #include "common/rs_common_def.h"
 #include "common/rs_macros.h"
 
@@ -46,6 +49,189 @@ private:
     void* data_ = nullptr;
 };
 
+/*
+ * A sealed memfd shared by the writer and the reader processes of the parcels, the large blobs are bump allocated in
+ * it so that the shared memory is created and mapped once instead of per blob. The header of the slab counts the
+ * parcels with blocks in it that the reader has not released yet, the writer starts over from the beginning once the
+ * count drops to zero. The reader reads the blocks in place and releases the parcel once it is processed, see
+ * RSParcelSlabHolder.
+ */
+class RSB_EXPORT RSParcelSlab {
+public:
+    static constexpr size_t SLAB_SIZE = 4 * 1024 * 1024; // 4M
+    static constexpr size_t HEADER_SIZE = 64;
+
+    // the blocks start after the page of the header, so that the reader can copy the pages of a block out of the
+    // slab without the header.
+    static size_t GetFirstBlockOffset();
+
+    // the writer side, create a new slab.
+    static std::shared_ptr<RSParcelSlab> Create();
+    // the reader side, map the slab of fd, nullptr if fd is not a sealed slab. the fd is not kept.
+    static std::shared_ptr<RSParcelSlab> Map(int fd);
+    ~RSParcelSlab();
+
+    // nocopyable
+    RSParcelSlab(const RSParcelSlab&) = delete;
+    RSParcelSlab& operator=(const RSParcelSlab&) = delete;
+
+    int GetFd() const; // -1 on the reader side
+    uint8_t* GetData(size_t offset) const;
+    uint32_t GetPendingCount() const;
+
+    // reserve a block of size bytes, false if the slab is full. the block stays valid while the slab is held.
+    bool Reserve(size_t size, size_t& offset);
+    // the writer holds the slab once for each parcel with blocks in it.
+    void Hold();
+    // called by the reader once it has processed the parcel, or by the writer if the parcel is not sent.
+    void Release();
+    bool IsValidBlock(size_t offset, size_t size) const;
+    // the reader side, replace the pages of the block in this mapping with a private copy at the same address, so
+    // that the block stays valid once the writer starts the slab over. false if the pages are still shared.
+    bool CopyOutBlock(size_t offset, size_t size);
+
+private:
+    struct Header;
+    RSParcelSlab(int fd, void* data);
+    Header* GetHeader() const;
+
+    int fd_;
+    void* data_;
+    size_t used_ = HEADER_SIZE; // only used by the writer side
+};
+
+// the slabs holding the blocks of one parcel
+using RSParcelSlabList = std::vector<std::shared_ptr<RSParcelSlab>>;
+
+// the reader side, a block read in place, it keeps its slab mapped.
+class RSB_EXPORT RSParcelSlabBlock {
+public:
+    RSParcelSlabBlock(std::shared_ptr<RSParcelSlab> slab, size_t offset, size_t size);
+    ~RSParcelSlabBlock() = default;
+
+    const uint8_t* GetData() const;
+    size_t GetSize() const;
+
+private:
+    friend class RSParcelSlabHolder;
+
+    std::shared_ptr<RSParcelSlab> slab_;
+    size_t offset_;
+    size_t size_;
+};
+
+/*
+ * The reader side, holds the slabs of a received parcel until the parcel is processed, the blocks are read in place
+ * meanwhile. The blocks still in use once the parcel is released, like the pixels of the images kept by the nodes or
+ * by RSImageCache, are copied out of their slab then, so that they never keep the slab from starting over.
+ */
+class RSB_EXPORT RSParcelSlabHolder {
+public:
+    class RSB_EXPORT Scope {
+    public:
+        // the blocks read in place on this thread in the scope are added to holder.
+        explicit Scope(RSParcelSlabHolder& holder);
+        ~Scope();
+
+    private:
+        RSParcelSlabHolder* previous_;
+    };
+
+    // hold the slabs referenced by the fds of parcel.
+    explicit RSParcelSlabHolder(MessageParcel& parcel);
+    // copy the blocks still in use out of their slab and release the slabs.
+    ~RSParcelSlabHolder();
+
+    // nocopyable
+    RSParcelSlabHolder(const RSParcelSlabHolder&) = delete;
+    RSParcelSlabHolder& operator=(const RSParcelSlabHolder&) = delete;
+
+    // the holder of the innermost Scope on this thread, nullptr if none.
+    static RSParcelSlabHolder* GetCurrent();
+    void AddBlock(const std::shared_ptr<RSParcelSlabBlock>& block);
+
+private:
+    RSParcelSlabList slabs_;
+    std::vector<std::weak_ptr<RSParcelSlabBlock>> blocks_;
+};
+
+// the writer side, a ring of slabs owned by a connection, the large blobs of the parcels written on the thread in a
+// Scope of the ring are allocated in it.
+class RSB_EXPORT RSParcelSlabRing {
+public:
+    static constexpr size_t SLAB_COUNT = 4;
+
+    class RSB_EXPORT Scope {
+    public:
+        // the slabs holding the blocks written in the scope are added to slabs, the writer releases them with
+        // ReleaseParcel if the parcel is not sent.
+        Scope(RSParcelSlabRing& ring, RSParcelSlabList& slabs);
+        ~Scope();
+
+        std::shared_ptr<RSParcelSlab> Allocate(size_t size, size_t& offset);
+
+    private:
+        RSParcelSlabRing& ring_;
+        RSParcelSlabList& slabs_;
+        Scope* previous_;
+    };
+
+    RSParcelSlabRing() = default;
+    ~RSParcelSlabRing() = default;
+
+    // nocopyable
+    RSParcelSlabRing(const RSParcelSlabRing&) = delete;
+    RSParcelSlabRing& operator=(const RSParcelSlabRing&) = delete;
+
+    // the innermost Scope on this thread, nullptr if none.
+    static Scope* GetCurrentScope();
+    // return the slab the block is reserved in, nullptr if the size is too large or all the slabs are in use.
+    // the slab is held and added to slabs for its first block of the parcel.
+    std::shared_ptr<RSParcelSlab> Allocate(size_t size, size_t& offset, RSParcelSlabList& slabs);
+    // the parcel is not sent, release its slabs.
+    static void ReleaseParcel(RSParcelSlabList& slabs);
+
+private:
+    std::mutex mutex_;
+    std::vector<std::shared_ptr<RSParcelSlab>> slabs_;
+    size_t current_ = 0;
+};
+
+// the reader side, the slabs are mapped once and looked up by the inode of the fd received with each block.
+class RSB_EXPORT RSParcelSlabCache {
+public:
+    // the ring of each connected client is kept mapped.
+    static constexpr size_t MAX_CACHED_SLABS_PER_CLIENT = RSParcelSlabRing::SLAB_COUNT;
+
+    static RSParcelSlabCache& Instance();
+    // take the ownership of fd.
+    std::shared_ptr<RSParcelSlab> Get(int fd);
+    // the distinct slabs referenced by the fds of parcel.
+    RSParcelSlabList GetParcelSlabs(MessageParcel& parcel);
+    // the parcel is dropped before it is parsed, release each slab it holds.
+    void ReleaseParcel(MessageParcel& parcel);
+    // the mapping has private pages, the next blocks of its slab are read from a new mapping.
+    void Remove(const std::shared_ptr<RSParcelSlab>& slab);
+    // the cache holds MAX_CACHED_SLABS_PER_CLIENT slabs for each connected client.
+    void AddClient();
+    void RemoveClient();
+
+private:
+    RSParcelSlabCache() = default;
+    ~RSParcelSlabCache() = default;
+    RSParcelSlabCache(const RSParcelSlabCache&) = delete;
+    RSParcelSlabCache& operator=(const RSParcelSlabCache&) = delete;
+
+    struct Entry {
+        std::shared_ptr<RSParcelSlab> slab;
+        uint64_t lastUsed;
+    };
+    std::mutex mutex_;
+    std::map<std::pair<uint64_t, uint64_t>, Entry> slabs_; // keyed by the device and inode of the memfd
+    uint64_t useCount_ = 0;
+    size_t clientCount_ = 0;
+};
+
 class RSB_EXPORT RSAshmemHelper {
 public:
     static std::shared_ptr<MessageParcel> CreateAshmemParcel(std::shared_ptr<MessageParcel>& dataParcel);
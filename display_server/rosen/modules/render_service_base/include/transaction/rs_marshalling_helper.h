@@ -213,7 +213,8 @@ public:
 
 private:
     static bool WriteToParcel(Parcel& parcel, const void* data, size_t size);
-    static const void* ReadFromParcel(Parcel& parcel, size_t size);
+    // the data of a blob written by WriteToParcel, the small ones point into the parcel.
+    static sk_sp<SkData> ReadDataFromParcel(Parcel& parcel, size_t size);
     static bool SkipFromParcel(Parcel& parcel, size_t size);
     static sk_sp<SkData> SerializeTypeface(SkTypeface* tf, void* ctx);
     static sk_sp<SkTypeface> DeserializeTypeface(const void* data, size_t length, void* ctx);
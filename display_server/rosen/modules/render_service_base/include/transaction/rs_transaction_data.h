@@ -27,11 +27,14 @@
 
 namespace OHOS {
 namespace Rosen {
+class RSParcelSlabHolder;
+
 class RSB_EXPORT RSTransactionData : public Parcelable {
 public:
     RSTransactionData() = default;
     RSTransactionData(RSTransactionData&& other)
-        : payload_(std::move(other.payload_)), timestamp_(std::move(other.timestamp_)),
+        : parcelSlabHolder_(std::move(other.parcelSlabHolder_)), payload_(std::move(other.payload_)),
+          timestamp_(std::move(other.timestamp_)),
           abilityName_(std::move(other.abilityName_)), pid_(other.pid_), index_(other.index_)
     {}
     ~RSTransactionData() noexcept = default;
@@ -103,11 +106,19 @@ public:
         return payload_;
     }
 
+    // the slabs holding the blobs of the commands, released with the data once the main thread is done with it.
+    void SetParcelSlabHolder(std::shared_ptr<RSParcelSlabHolder> holder)
+    {
+        parcelSlabHolder_ = std::move(holder);
+    }
+
 private:
     void AddCommand(std::unique_ptr<RSCommand>& command, NodeId nodeId, FollowType followType);
     void AddCommand(std::unique_ptr<RSCommand>&& command, NodeId nodeId, FollowType followType);
 
     bool UnmarshallingCommand(Parcel& parcel);
+    // declared before the commands, so that it is released after them
+    std::shared_ptr<RSParcelSlabHolder> parcelSlabHolder_;
     std::vector<std::tuple<NodeId, FollowType, std::unique_ptr<RSCommand>>> payload_;
     uint64_t timestamp_ = 0;
     std::string abilityName_;
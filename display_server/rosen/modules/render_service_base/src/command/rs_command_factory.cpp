@@ -29,6 +29,8 @@
 #include "command/rs_surface_node_command.h"
 // animation
 #include "command/rs_animation_command.h"
+// image cache
+#include "command/rs_image_cache_command.h"
 #undef ROSEN_INSTANTIATE_COMMAND_TEMPLATE
 
 namespace OHOS {
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "command/rs_image_cache_command.h"
+
+#include "render/rs_image_cache.h"
+#include "render/rs_image_transfer_cache.h"
+
+namespace OHOS {
+namespace Rosen {
+void ImageCacheCommandHelper::Acknowledge(
+    RSContext& context, uint64_t uniqueId, uint32_t sequence, uint64_t bytes, uint64_t budget)
+{
+    RSImageTransferCache::Instance().OnAcknowledged(uniqueId, sequence, bytes, budget);
+}
+
+void ImageCacheCommandHelper::Release(RSContext& context, uint64_t uniqueId, uint32_t sequence)
+{
+    RSImageCache::Instance().ReleaseTransferredImage(uniqueId, sequence);
+}
+
+void ImageCacheCommandHelper::Miss(RSContext& context, uint64_t uniqueId)
+{
+    RSImageTransferCache::Instance().OnMissed(uniqueId);
+}
+
+void ImageCacheCommandHelper::Resend(RSContext& context, uint64_t uniqueId, sk_sp<SkImage> image)
+{
+    // the RSImage which missed it picks it up when drawn, and releases it with itself
+    RSImageCache::Instance().CacheSkiaImage(uniqueId, image);
+}
+} // namespace Rosen
+} // namespace OHOS
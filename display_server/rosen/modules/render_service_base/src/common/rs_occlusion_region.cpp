@@ -15,8 +15,6 @@
 
 #include "common/rs_occlusion_region.h"
 
-#include <map>
-#include <set>
 #include "platform/common/rs_log.h"
 #include "platform/common/rs_innovation.h"
 
@@ -134,38 +132,131 @@ void Node::GetSubRange(std::vector<Range>& res, bool isParentNodePos = false, bo
     }
 }
 
-void MakeEnumerate(std::set<int>& ys, std::map<int, int>& indexOf, std::vector<int>& indexAt)
-{
-    auto it = ys.begin();
-    int index = 0;
-    while (it != ys.end()) {
-        indexOf[*it] = index++;
-        indexAt.push_back(*it);
-        ++it;
+/*
+    Flat segment tree over the elementary x intervals [xs[i], xs[i + 1]), nodes are stored in an array
+    (children of node i are 2i and 2i + 1) which is part of the per-thread scratch memory, so building and
+    updating the tree costs no heap allocation once the arrays are big enough.
+*/
+class Region::OpScratch {
+public:
+    static OpScratch& Get()
+    {
+        static thread_local OpScratch scratch;
+        return scratch;
     }
-    return;
-}
 
-void Region::getRange(std::vector<Range>& ranges, Node& node, Region::OP op)
-{
-    switch (op) {
-        case Region::OP::AND:
-            node.GetAndRange(ranges);
-            break;
-        case Region::OP::OR:
-            node.GetOrRange(ranges);
-            break;
-        case Region::OP::XOR:
-            node.GetXOrRange(ranges);
-            break;
-        case Region::OP::SUB:
-            node.GetSubRange(ranges);
-            break;
-        default:
-            break;
+    // build an empty tree of leafCount elementary intervals.
+    void ResetTree(int leafCount)
+    {
+        leafCount_ = leafCount;
+        nodes_.assign(leafCount > 0 ? static_cast<size_t>(leafCount) * 4 : 0, TreeNode {});
+    }
+
+    void Update(int updateStart, int updateEnd, Event::Type type)
+    {
+        if (updateStart < updateEnd && leafCount_ > 0) {
+            Update(1, 0, leafCount_, updateStart, updateEnd, type);
+        }
+    }
+
+    // get ranges of the elementary intervals whose lhs/rhs coverage state is accepted by op.
+    void GetRanges(std::vector<Range>& res, Region::OP op) const
+    {
+        if (leafCount_ > 0) {
+            GetRanges(res, static_cast<uint32_t>(op), 1, 0, leafCount_, false, false);
+        }
+    }
+
+    // x coordinates, sorted and unique, index of x is its compressed coordinate.
+    int IndexOf(int x) const
+    {
+        return static_cast<int>(std::lower_bound(xs.begin(), xs.end(), x) - xs.begin());
+    }
+
+    std::vector<Event> events;
+    std::vector<int> xs;
+    std::vector<Range> ranges;
+    Rects rects;
+    Region lhs; // copy of lhs for OperationSelf
+
+private:
+    struct TreeNode {
+        int positiveCount = 0; // used for counting current lhs ranges
+        int negativeCount = 0; // used for counting current rhs ranges
+        bool hasPositive = false; // some interval in the subtree is covered by lhs
+        bool hasNegative = false; // some interval in the subtree is covered by rhs
+    };
+
+    // state bits, same as Region::OP: bit 0: lhs only, bit 1: lhs & rhs, bit 2: rhs only.
+    static uint32_t StateMask(bool maybePos, bool maybeNotPos, bool maybeNeg, bool maybeNotNeg)
+    {
+        uint32_t mask = 0;
+        mask |= (maybePos && maybeNotNeg) ? 0x1u : 0u;
+        mask |= (maybePos && maybeNeg) ? 0x2u : 0u;
+        mask |= (maybeNotPos && maybeNeg) ? 0x4u : 0u;
+        return mask;
+    }
+
+    static void PushRange(std::vector<Range>& res, int start, int end)
+    {
+        if (res.size() > 0 && start == res.back().end_) {
+            // merge range with previous range if their end and start share same point
+            res.back().end_ = end;
+        } else {
+            res.emplace_back(Range { start, end });
+        }
+    }
+
+    void Update(size_t idx, int start, int end, int updateStart, int updateEnd, Event::Type type)
+    {
+        TreeNode& node = nodes_[idx];
+        bool isLeaf = end - start == 1;
+        if (updateStart <= start && end <= updateEnd) {
+            if (type == Event::Type::OPEN || type == Event::Type::CLOSE) {
+                node.positiveCount += type;
+            } else {
+                node.negativeCount += type;
+            }
+        } else {
+            int mid = (start + end) >> 1;
+            if (updateStart < mid) {
+                Update(idx * 2, start, mid, updateStart, updateEnd, type);
+            }
+            if (updateEnd > mid) {
+                Update(idx * 2 + 1, mid, end, updateStart, updateEnd, type);
+            }
+        }
+        node.hasPositive = node.positiveCount > 0 ||
+            (!isLeaf && (nodes_[idx * 2].hasPositive || nodes_[idx * 2 + 1].hasPositive));
+        node.hasNegative = node.negativeCount > 0 ||
+            (!isLeaf && (nodes_[idx * 2].hasNegative || nodes_[idx * 2 + 1].hasNegative));
+    }
+
+    void GetRanges(std::vector<Range>& res, uint32_t op, size_t idx, int start, int end,
+        bool isParentNodePos, bool isParentNodeNeg) const
+    {
+        const TreeNode& node = nodes_[idx];
+        bool isPos = isParentNodePos || node.positiveCount > 0;
+        bool isNeg = isParentNodeNeg || node.negativeCount > 0;
+        bool maybePos = isPos || node.hasPositive;
+        bool maybeNeg = isNeg || node.hasNegative;
+        uint32_t reachable = StateMask(maybePos, !isPos, maybeNeg, !isNeg);
+        if ((reachable & op) == 0) {
+            return;
+        }
+        bool isUniform = (isPos || !maybePos) && (isNeg || !maybeNeg);
+        if (isUniform || end - start == 1) {
+            PushRange(res, start, end);
+            return;
+        }
+        int mid = (start + end) >> 1;
+        GetRanges(res, op, idx * 2, start, mid, isPos, isNeg);
+        GetRanges(res, op, idx * 2 + 1, mid, end, isPos, isNeg);
     }
-    return;
-}
+
+    std::vector<TreeNode> nodes_;
+    int leafCount_ = 0;
+};
 
 void Region::UpdateRects(Rects& r, std::vector<Range>& ranges, std::vector<int>& indexAt, Region& res)
 {
@@ -249,45 +340,49 @@ void Region::RegionOpLocal(Region& r1, Region& r2, Region& res, Region::OP op)
     r1.MakeBound();
     r2.MakeBound();
     res.GetRegionRects().clear();
-    std::vector<Event> events;
-    std::set<int> xs;
+
+    OpScratch& scratch = OpScratch::Get();
+    std::vector<Event>& events = scratch.events;
+    std::vector<int>& xs = scratch.xs;
+    events.clear();
+    xs.clear();
 
     for (auto& r : r1.GetRegionRects()) {
         events.emplace_back(Event { r.top_, Event::Type::OPEN, r.left_, r.right_ });
         events.emplace_back(Event { r.bottom_, Event::Type::CLOSE, r.left_, r.right_ });
-        xs.insert(r.left_);
-        xs.insert(r.right_);
+        xs.push_back(r.left_);
+        xs.push_back(r.right_);
     }
     for (auto& r : r2.GetRegionRects()) {
         events.emplace_back(Event { r.top_, Event::Type::VOID_OPEN, r.left_, r.right_ });
         events.emplace_back(Event { r.bottom_, Event::Type::VOID_CLOSE, r.left_, r.right_ });
-        xs.insert(r.left_);
-        xs.insert(r.right_);
+        xs.push_back(r.left_);
+        xs.push_back(r.right_);
     }
 
     if (events.size() == 0) {
         return;
     }
 
-    std::map<int, int> indexOf;
-    std::vector<int> indexAt;
-    MakeEnumerate(xs, indexOf, indexAt);
-    sort(events.begin(), events.end(), EventSortByY);
-
-    Node rootNode { 0, static_cast<int>(indexOf.size() - 1) };
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    std::sort(events.begin(), events.end(), EventSortByY);
+    scratch.ResetTree(static_cast<int>(xs.size()) - 1);
 
-    std::vector<Range> ranges;
-    Rects r;
+    std::vector<Range>& ranges = scratch.ranges;
+    Rects& r = scratch.rects;
+    r.preRects.clear();
+    r.curRects.clear();
     r.preY = events[0].y_;
     r.curY = events[0].y_;
     for (auto& e : events) {
         r.curY = e.y_;
         ranges.clear();
-        getRange(ranges, rootNode, op);
+        scratch.GetRanges(ranges, op);
         if (r.curY > r.preY) {
-            UpdateRects(r, ranges, indexAt, res);
+            UpdateRects(r, ranges, xs, res);
         }
-        rootNode.Update(indexOf[e.left_], indexOf[e.right_], e.type_);
+        scratch.Update(scratch.IndexOf(e.left_), scratch.IndexOf(e.right_), e.type_);
         r.preY = r.curY;
     }
     copy(r.preRects.begin(), r.preRects.end(), back_inserter(res.GetRegionRects()));
@@ -296,8 +391,18 @@ void Region::RegionOpLocal(Region& r1, Region& r2, Region& res, Region::OP op)
 
 Region& Region::OperationSelf(Region& r, Region::OP op)
 {
-    Region r1(*this);
-    RegionOp(r1, r, *this, op);
+    if (&r == this) {
+        Region rhs(r);
+        Region lhs(*this);
+        RegionOp(lhs, rhs, *this, op);
+        return *this;
+    }
+    // move the rects into the scratch lhs instead of copying them, *this takes over the old scratch storage.
+    Region& lhs = OpScratch::Get().lhs;
+    lhs.rects_.swap(rects_);
+    lhs.bound_ = bound_;
+    rects_.clear();
+    RegionOp(lhs, r, *this, op);
     return *this;
 }
 
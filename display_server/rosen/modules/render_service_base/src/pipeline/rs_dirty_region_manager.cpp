@@ -15,11 +15,51 @@
 
 #include "pipeline/rs_dirty_region_manager.h"
 
+#include <algorithm>
+
 namespace OHOS {
 namespace Rosen {
+namespace {
+// a separate dirty rect costs an extra scissor/clip pass, keep it separate only if it saves more than this area
+constexpr int64_t MIN_SEPARATE_AREA = 128 * 128;
+// or more than 1/JOIN_WASTE_RATIO of the area of the two rects
+constexpr int64_t JOIN_WASTE_RATIO = 4;
+
+int64_t GetArea(const RectI& rect)
+{
+    return rect.IsEmpty() ? 0 : static_cast<int64_t>(rect.width_) * rect.height_;
+}
+
+// area drawn in vain if the two rects are joined
+int64_t GetJoinWaste(const RectI& a, const RectI& b)
+{
+    return GetArea(a.JoinRect(b)) - GetArea(a) - GetArea(b) + GetArea(a.IntersectRect(b));
+}
+
+bool ShouldJoin(const RectI& a, const RectI& b)
+{
+    if (!a.IntersectRect(b).IsEmpty()) {
+        return true;
+    }
+    int64_t waste = GetJoinWaste(a, b);
+    return waste <= MIN_SEPARATE_AREA || waste * JOIN_WASTE_RATIO <= GetArea(a) + GetArea(b);
+}
+
+RectI ClipRect(const RectI& rect, const RectI& surfaceRect)
+{
+    int left = std::max(std::max(rect.left_, 0), surfaceRect.left_);
+    int top = std::max(std::max(rect.top_, 0), surfaceRect.top_);
+    int width = std::min(rect.GetRight(), surfaceRect.GetRight()) - left;
+    int height = std::min(rect.GetBottom(), surfaceRect.GetBottom()) - top;
+    // If new region is invalid, dirtyRegion would be reset as [0, 0, 0, 0]
+    return ((width <= 0) || (height <= 0)) ? RectI() : RectI(left, top, width, height);
+}
+} // namespace
+
 RSDirtyRegionManager::RSDirtyRegionManager()
 {
     dirtyHistory_.resize(HISTORY_QUEUE_MAX_SIZE);
+    dirtyRectsHistory_.resize(HISTORY_QUEUE_MAX_SIZE);
     debugRegionEnabled_.resize(DebugRegionType::TYPE_MAX);
 }
 
@@ -28,26 +68,34 @@ void RSDirtyRegionManager::MergeDirtyRect(const RectI& rect)
     if (rect.IsEmpty()) {
         return;
     }
-    if (dirtyRegion_.IsEmpty()) {
-        dirtyRegion_ = rect;
-    } else {
-        dirtyRegion_ = dirtyRegion_.JoinRect(rect);
-    }
+    MergeRectInto(dirtyRects_, rect);
+    UpdateDirtyBound();
 }
 
 void RSDirtyRegionManager::IntersectDirtyRect(const RectI& rect)
 {
-    dirtyRegion_ = dirtyRegion_.IntersectRect(rect);
+    std::vector<RectI> rects;
+    rects.swap(dirtyRects_);
+    for (const auto& subRect : rects) {
+        RectI intersectRect = subRect.IntersectRect(rect);
+        if (!intersectRect.IsEmpty()) {
+            dirtyRects_.emplace_back(intersectRect);
+        }
+    }
+    UpdateDirtyBound();
 }
 
 void RSDirtyRegionManager::ClipDirtyRectWithinSurface()
 {
-    int left = std::max(std::max(dirtyRegion_.left_, 0), surfaceRect_.left_);
-    int top = std::max(std::max(dirtyRegion_.top_, 0), surfaceRect_.top_);
-    int width = std::min(dirtyRegion_.GetRight(), surfaceRect_.GetRight()) - left;
-    int height = std::min(dirtyRegion_.GetBottom(), surfaceRect_.GetBottom()) - top;
-    // If new region is invalid, dirtyRegion would be reset as [0, 0, 0, 0]
-    dirtyRegion_ = ((width <= 0) || (height <= 0)) ? RectI() : RectI(left, top, width, height);
+    std::vector<RectI> rects;
+    rects.swap(dirtyRects_);
+    for (const auto& subRect : rects) {
+        RectI clipRect = ClipRect(subRect, surfaceRect_);
+        if (!clipRect.IsEmpty()) {
+            dirtyRects_.emplace_back(clipRect);
+        }
+    }
+    UpdateDirtyBound();
 }
 
 const RectI& RSDirtyRegionManager::GetDirtyRegion() const
@@ -55,6 +103,21 @@ const RectI& RSDirtyRegionManager::GetDirtyRegion() const
     return dirtyRegion_;
 }
 
+const std::vector<RectI>& RSDirtyRegionManager::GetDirtyRects() const
+{
+    return dirtyRects_;
+}
+
+std::vector<RectI> RSDirtyRegionManager::GetDirtyRectsFlipWithinSurface() const
+{
+    std::vector<RectI> glRects;
+    glRects.reserve(dirtyRects_.size());
+    for (const auto& rect : dirtyRects_) {
+        glRects.emplace_back(GetRectFlipWithinSurface(rect));
+    }
+    return glRects;
+}
+
 RectI RSDirtyRegionManager::GetDirtyRegionFlipWithinSurface() const
 {
     RectI glRect = dirtyRegion_;
@@ -95,6 +158,7 @@ RectI RSDirtyRegionManager::GetPixelAlignedRect(const RectI& rect, int32_t align
 void RSDirtyRegionManager::Clear()
 {
     dirtyRegion_.Clear();
+    dirtyRects_.clear();
     dirtyCanvasNodes_.clear();
     dirtySurfaceNodes_.clear();
     UpdateDebugRegionTypeEnable();
@@ -107,13 +171,20 @@ bool RSDirtyRegionManager::IsDirty() const
 
 void RSDirtyRegionManager::UpdateDirty()
 {
-    PushHistory(dirtyRegion_);
-    dirtyRegion_ = MergeHistory(bufferAge_, dirtyRegion_);
+    PushHistory(dirtyRects_);
+    dirtyRects_ = MergeHistory(bufferAge_, std::move(dirtyRects_));
+    UpdateDirtyBound();
 }
 
 void RSDirtyRegionManager::UpdateDirtyByAligned(int32_t alignedBits)
 {
-    dirtyRegion_ = GetPixelAlignedRect(dirtyRegion_, alignedBits);
+    // aligned rects may overlap, merge them again to keep them disjoint
+    std::vector<RectI> rects;
+    rects.swap(dirtyRects_);
+    for (const auto& rect : rects) {
+        MergeRectInto(dirtyRects_, GetPixelAlignedRect(rect, alignedBits));
+    }
+    UpdateDirtyBound();
 }
 
 void RSDirtyRegionManager::UpdateDirtyCanvasNodes(NodeId id, const RectI& rect)
@@ -157,6 +228,10 @@ bool RSDirtyRegionManager::SetSurfaceSize(const int32_t width, const int32_t hei
 
 void RSDirtyRegionManager::ResetDirtyAsSurfaceSize()
 {
+    dirtyRects_.clear();
+    if (!surfaceRect_.IsEmpty()) {
+        dirtyRects_.emplace_back(surfaceRect_);
+    }
     dirtyRegion_ = surfaceRect_;
 }
 
@@ -191,40 +266,43 @@ void RSDirtyRegionManager::UpdateDebugRegionTypeEnable()
     }
 }
 
-RectI RSDirtyRegionManager::MergeHistory(unsigned int age, RectI rect) const
+std::vector<RectI> RSDirtyRegionManager::MergeHistory(unsigned int age, std::vector<RectI> rects) const
 {
     if (age == 0 || age > historySize_) {
-        return surfaceRect_;
+        rects.clear();
+        if (!surfaceRect_.IsEmpty()) {
+            rects.emplace_back(surfaceRect_);
+        }
+        return rects;
     }
-    // GetHistory(historySize_) is equal to dirtyHistory_[historyHead_] (latest his rect)
-    // therefore, this loop merges rect with age frames' dirtyRect
+    // GetHistoryRects(historySize_) is equal to dirtyRectsHistory_[historyHead_] (latest his rects)
+    // therefore, this loop merges rects with age frames' dirtyRects
     // Attention: should not set i >= 0 for unsigned int!!!!!
     for (unsigned int i = historySize_; i > historySize_ - age; --i) {
-        auto subRect = GetHistory((i - 1));
-        if (subRect.IsEmpty()) {
-            continue;
-        }
-        if (rect.IsEmpty()) {
-            rect = subRect;
-            continue;
-        }
         // only join valid his dirty region
-        rect = rect.JoinRect(subRect);
+        for (const auto& subRect : GetHistoryRects(i - 1)) {
+            MergeRectInto(rects, subRect);
+        }
     }
-    return rect;
+    return rects;
 }
 
-void RSDirtyRegionManager::PushHistory(RectI rect)
+void RSDirtyRegionManager::PushHistory(const std::vector<RectI>& rects)
 {
     int next = (historyHead_ + 1) % HISTORY_QUEUE_MAX_SIZE;
-    dirtyHistory_[next] = rect;
+    RectI bound;
+    for (const auto& rect : rects) {
+        bound = bound.IsEmpty() ? rect : bound.JoinRect(rect);
+    }
+    dirtyHistory_[next] = bound;
+    dirtyRectsHistory_[next] = rects;
     if (historySize_ < HISTORY_QUEUE_MAX_SIZE) {
         ++historySize_;
     }
     historyHead_ = next;
 }
 
-RectI RSDirtyRegionManager::GetHistory(unsigned int i) const
+unsigned int RSDirtyRegionManager::GetHistoryIndex(unsigned int i) const
 {
     if (i >= HISTORY_QUEUE_MAX_SIZE) {
         i %= HISTORY_QUEUE_MAX_SIZE;
@@ -232,7 +310,63 @@ RectI RSDirtyRegionManager::GetHistory(unsigned int i) const
     if (historySize_ == HISTORY_QUEUE_MAX_SIZE) {
         i = (i + historyHead_) % HISTORY_QUEUE_MAX_SIZE;
     }
-    return dirtyHistory_[i];
+    return i;
+}
+
+const std::vector<RectI>& RSDirtyRegionManager::GetHistoryRects(unsigned int i) const
+{
+    return dirtyRectsHistory_[GetHistoryIndex(i)];
+}
+
+void RSDirtyRegionManager::MergeRectInto(std::vector<RectI>& rects, const RectI& rect)
+{
+    if (rect.IsEmpty()) {
+        return;
+    }
+    // join rect with the rects it overlaps or is close to, until it is disjoint with all of them
+    RectI curRect = rect;
+    bool joined = true;
+    while (joined) {
+        joined = false;
+        for (auto it = rects.begin(); it != rects.end(); ++it) {
+            if (ShouldJoin(*it, curRect)) {
+                curRect = curRect.JoinRect(*it);
+                rects.erase(it);
+                joined = true;
+                break;
+            }
+        }
+    }
+    rects.emplace_back(curRect);
+    if (rects.size() <= MAX_DIRTY_RECT_COUNT) {
+        return;
+    }
+    // too many rects, join the pair wasting the least area
+    size_t first = 0;
+    size_t second = 1;
+    int64_t minWaste = GetJoinWaste(rects[first], rects[second]);
+    for (size_t i = 0; i < rects.size(); ++i) {
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            int64_t waste = GetJoinWaste(rects[i], rects[j]);
+            if (waste < minWaste) {
+                minWaste = waste;
+                first = i;
+                second = j;
+            }
+        }
+    }
+    RectI joinRect = rects[first].JoinRect(rects[second]);
+    rects.erase(rects.begin() + second);
+    rects.erase(rects.begin() + first);
+    MergeRectInto(rects, joinRect);
+}
+
+void RSDirtyRegionManager::UpdateDirtyBound()
+{
+    dirtyRegion_.Clear();
+    for (const auto& rect : dirtyRects_) {
+        dirtyRegion_ = dirtyRegion_.IsEmpty() ? rect : dirtyRegion_.JoinRect(rect);
+    }
 }
 } // namespace Rosen
 } // namespace OHOS
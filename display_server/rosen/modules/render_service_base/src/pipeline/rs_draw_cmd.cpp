@@ -36,6 +36,16 @@ void SimplifyPaint(uint32_t color, SkPaint* paint)
     paint->setStrokeWidth(1.04); // 1.04 is empirical value
     paint->setStrokeJoin(SkPaint::kRound_Join);
 }
+
+// constructs the unmarshalled op in the arena of its list, or on the heap without one
+template<typename T, typename... Args>
+OpItem* NewOpItem(OpItemArena* arena, Args&&... args)
+{
+    if (arena != nullptr) {
+        return arena->New<T>(std::forward<Args>(args)...);
+    }
+    return new T(std::forward<Args>(args)...);
+}
 } // namespace
 
 std::unique_ptr<OpItem> OpItem::GenerateCachedOpItem(SkSurface* surface) const
@@ -600,7 +610,7 @@ bool RectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* RectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* RectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRect rect;
     SkPaint paint;
@@ -610,7 +620,7 @@ OpItem* RectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("RectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new RectOpItem(rect, paint);
+    return NewOpItem<RectOpItem>(arena, rect, paint);
 }
 
 // RoundRectOpItem
@@ -625,7 +635,7 @@ bool RoundRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* RoundRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* RoundRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRRect rrect;
     SkPaint paint;
@@ -635,7 +645,7 @@ OpItem* RoundRectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("RoundRectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new RoundRectOpItem(rrect, paint);
+    return NewOpItem<RoundRectOpItem>(arena, rrect, paint);
 }
 
 // ImageWithParmOpItem
@@ -650,7 +660,7 @@ bool ImageWithParmOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ImageWithParmOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ImageWithParmOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     std::shared_ptr<RSImage> rsImage;
     SkPaint paint;
@@ -660,7 +670,7 @@ OpItem* ImageWithParmOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ImageWithParmOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ImageWithParmOpItem(rsImage, paint);
+    return NewOpItem<ImageWithParmOpItem>(arena, rsImage, paint);
 }
 
 // DRRectOpItem
@@ -676,7 +686,7 @@ bool DRRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* DRRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* DRRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRRect outer;
     SkRRect inner;
@@ -688,7 +698,7 @@ OpItem* DRRectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("DRRectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new DRRectOpItem(outer, inner, paint);
+    return NewOpItem<DRRectOpItem>(arena, outer, inner, paint);
 }
 
 // OvalOpItem
@@ -703,7 +713,7 @@ bool OvalOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* OvalOpItem::Unmarshalling(Parcel& parcel)
+OpItem* OvalOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRect rect;
     SkPaint paint;
@@ -713,7 +723,7 @@ OpItem* OvalOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("OvalOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new OvalOpItem(rect, paint);
+    return NewOpItem<OvalOpItem>(arena, rect, paint);
 }
 
 // RegionOpItem
@@ -728,7 +738,7 @@ bool RegionOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* RegionOpItem::Unmarshalling(Parcel& parcel)
+OpItem* RegionOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRegion region;
     SkPaint paint;
@@ -738,7 +748,7 @@ OpItem* RegionOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("RegionOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new RegionOpItem(region, paint);
+    return NewOpItem<RegionOpItem>(arena, region, paint);
 }
 
 // ArcOpItem
@@ -756,7 +766,7 @@ bool ArcOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ArcOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ArcOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRect rect;
     float startAngle;
@@ -772,25 +782,25 @@ OpItem* ArcOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ArcOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ArcOpItem(rect, startAngle, sweepAngle, useCenter, paint);
+    return NewOpItem<ArcOpItem>(arena, rect, startAngle, sweepAngle, useCenter, paint);
 }
 
 // SaveOpItem
-OpItem* SaveOpItem::Unmarshalling(Parcel& parcel)
+OpItem* SaveOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
-    return new SaveOpItem();
+    return NewOpItem<SaveOpItem>(arena);
 }
 
 // RestoreOpItem
-OpItem* RestoreOpItem::Unmarshalling(Parcel& parcel)
+OpItem* RestoreOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
-    return new RestoreOpItem();
+    return NewOpItem<RestoreOpItem>(arena);
 }
 
 // FlushOpItem
-OpItem* FlushOpItem::Unmarshalling(Parcel& parcel)
+OpItem* FlushOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
-    return new FlushOpItem();
+    return NewOpItem<FlushOpItem>(arena);
 }
 
 // MatrixOpItem
@@ -804,7 +814,7 @@ bool MatrixOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* MatrixOpItem::Unmarshalling(Parcel& parcel)
+OpItem* MatrixOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkMatrix matrix;
     bool success = RSMarshallingHelper::Unmarshalling(parcel, matrix);
@@ -812,7 +822,7 @@ OpItem* MatrixOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("MatrixOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new MatrixOpItem(matrix);
+    return NewOpItem<MatrixOpItem>(arena, matrix);
 }
 
 // ClipRectOpItem
@@ -828,7 +838,7 @@ bool ClipRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ClipRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ClipRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRect rect;
     SkClipOp clipOp;
@@ -840,7 +850,7 @@ OpItem* ClipRectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ClipRectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ClipRectOpItem(rect, clipOp, doAA);
+    return NewOpItem<ClipRectOpItem>(arena, rect, clipOp, doAA);
 }
 
 // ClipRRectOpItem
@@ -856,7 +866,7 @@ bool ClipRRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ClipRRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ClipRRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRRect rrect;
     SkClipOp clipOp;
@@ -868,7 +878,7 @@ OpItem* ClipRRectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ClipRRectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ClipRRectOpItem(rrect, clipOp, doAA);
+    return NewOpItem<ClipRRectOpItem>(arena, rrect, clipOp, doAA);
 }
 
 // ClipRegionOpItem
@@ -883,7 +893,7 @@ bool ClipRegionOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ClipRegionOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ClipRegionOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkRegion region;
     SkClipOp clipOp;
@@ -893,7 +903,7 @@ OpItem* ClipRegionOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ClipRegionOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ClipRegionOpItem(region, clipOp);
+    return NewOpItem<ClipRegionOpItem>(arena, region, clipOp);
 }
 
 // TranslateOpItem
@@ -908,7 +918,7 @@ bool TranslateOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* TranslateOpItem::Unmarshalling(Parcel& parcel)
+OpItem* TranslateOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     float distanceX;
     float distanceY;
@@ -918,7 +928,7 @@ OpItem* TranslateOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("TranslateOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new TranslateOpItem(distanceX, distanceY);
+    return NewOpItem<TranslateOpItem>(arena, distanceX, distanceY);
 }
 
 // TextBlobOpItem
@@ -935,7 +945,7 @@ bool TextBlobOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* TextBlobOpItem::Unmarshalling(Parcel& parcel)
+OpItem* TextBlobOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     sk_sp<SkTextBlob> textBlob;
     float x;
@@ -949,7 +959,7 @@ OpItem* TextBlobOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("TextBlobOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new TextBlobOpItem(textBlob, x, y, paint);
+    return NewOpItem<TextBlobOpItem>(arena, textBlob, x, y, paint);
 }
 
 // BitmapOpItem
@@ -966,7 +976,7 @@ bool BitmapOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* BitmapOpItem::Unmarshalling(Parcel& parcel)
+OpItem* BitmapOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     sk_sp<SkImage> bitmapInfo;
     float left;
@@ -980,7 +990,7 @@ OpItem* BitmapOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("BitmapOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new BitmapOpItem(bitmapInfo, left, top, &paint);
+    return NewOpItem<BitmapOpItem>(arena, bitmapInfo, left, top, &paint);
 }
 
 // BitmapRectOpItem
@@ -997,7 +1007,7 @@ bool BitmapRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* BitmapRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* BitmapRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     sk_sp<SkImage> bitmapInfo;
     SkRect rectSrc;
@@ -1011,7 +1021,7 @@ OpItem* BitmapRectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("BitmapRectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new BitmapRectOpItem(bitmapInfo, &rectSrc, rectDst, &paint);
+    return NewOpItem<BitmapRectOpItem>(arena, bitmapInfo, &rectSrc, rectDst, &paint);
 }
 
 // PixelMapOpItem
@@ -1028,7 +1038,7 @@ bool PixelMapOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* PixelMapOpItem::Unmarshalling(Parcel& parcel)
+OpItem* PixelMapOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     std::shared_ptr<Media::PixelMap> pixelmap;
     float left;
@@ -1042,7 +1052,7 @@ OpItem* PixelMapOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("PixelMapOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new PixelMapOpItem(pixelmap, left, top, &paint);
+    return NewOpItem<PixelMapOpItem>(arena, pixelmap, left, top, &paint);
 }
 
 // PixelMapRectOpItem
@@ -1059,7 +1069,7 @@ bool PixelMapRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* PixelMapRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* PixelMapRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     std::shared_ptr<Media::PixelMap> pixelmap;
     SkRect rectSrc;
@@ -1073,7 +1083,7 @@ OpItem* PixelMapRectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("PixelMapRectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new PixelMapRectOpItem(pixelmap, rectSrc, rectDst, &paint);
+    return NewOpItem<PixelMapRectOpItem>(arena, pixelmap, rectSrc, rectDst, &paint);
 }
 
 // BitmapNineOpItem
@@ -1090,7 +1100,7 @@ bool BitmapNineOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* BitmapNineOpItem::Unmarshalling(Parcel& parcel)
+OpItem* BitmapNineOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     sk_sp<SkImage> bitmapInfo;
     SkIRect center;
@@ -1104,7 +1114,7 @@ OpItem* BitmapNineOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("BitmapNineOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new BitmapNineOpItem(bitmapInfo, center, rectDst, &paint);
+    return NewOpItem<BitmapNineOpItem>(arena, bitmapInfo, center, rectDst, &paint);
 }
 
 // AdaptiveRRectOpItem
@@ -1119,7 +1129,7 @@ bool AdaptiveRRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* AdaptiveRRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* AdaptiveRRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     float radius;
     SkPaint paint;
@@ -1129,7 +1139,7 @@ OpItem* AdaptiveRRectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("AdaptiveRRectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new AdaptiveRRectOpItem(radius, paint);
+    return NewOpItem<AdaptiveRRectOpItem>(arena, radius, paint);
 }
 
 // AdaptiveRRectScaleOpItem
@@ -1144,7 +1154,7 @@ bool AdaptiveRRectScaleOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* AdaptiveRRectScaleOpItem::Unmarshalling(Parcel& parcel)
+OpItem* AdaptiveRRectScaleOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     float radiusRatio;
     SkPaint paint;
@@ -1154,7 +1164,7 @@ OpItem* AdaptiveRRectScaleOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("AdaptiveRRectScaleOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new AdaptiveRRectScaleOpItem(radiusRatio, paint);
+    return NewOpItem<AdaptiveRRectScaleOpItem>(arena, radiusRatio, paint);
 }
 
 // ClipAdaptiveRRectOpItem
@@ -1168,7 +1178,7 @@ bool ClipAdaptiveRRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ClipAdaptiveRRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ClipAdaptiveRRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkVector radius[CORNER_SIZE];
     for (auto i = 0; i < CORNER_SIZE; i++) {
@@ -1177,7 +1187,7 @@ OpItem* ClipAdaptiveRRectOpItem::Unmarshalling(Parcel& parcel)
             return nullptr;
         }
     }
-    return new ClipAdaptiveRRectOpItem(radius);
+    return NewOpItem<ClipAdaptiveRRectOpItem>(arena, radius);
 }
 
 // ClipOutsetRectOpItem
@@ -1192,7 +1202,7 @@ bool ClipOutsetRectOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ClipOutsetRectOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ClipOutsetRectOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     float dx;
     float dy;
@@ -1202,7 +1212,7 @@ OpItem* ClipOutsetRectOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ClipOutsetRectOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ClipOutsetRectOpItem(dx, dy);
+    return NewOpItem<ClipOutsetRectOpItem>(arena, dx, dy);
 }
 
 // PathOpItem
@@ -1217,7 +1227,7 @@ bool PathOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* PathOpItem::Unmarshalling(Parcel& parcel)
+OpItem* PathOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkPath path;
     SkPaint paint;
@@ -1227,7 +1237,7 @@ OpItem* PathOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("PathOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new PathOpItem(path, paint);
+    return NewOpItem<PathOpItem>(arena, path, paint);
 }
 
 // ClipPathOpItem
@@ -1243,7 +1253,7 @@ bool ClipPathOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ClipPathOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ClipPathOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkPath path;
     SkClipOp clipOp;
@@ -1255,7 +1265,7 @@ OpItem* ClipPathOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ClipPathOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ClipPathOpItem(path, clipOp, doAA);
+    return NewOpItem<ClipPathOpItem>(arena, path, clipOp, doAA);
 }
 
 // PaintOpItem
@@ -1269,7 +1279,7 @@ bool PaintOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* PaintOpItem::Unmarshalling(Parcel& parcel)
+OpItem* PaintOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkPaint paint;
     bool success = RSMarshallingHelper::Unmarshalling(parcel, paint);
@@ -1277,7 +1287,7 @@ OpItem* PaintOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("PaintOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new PaintOpItem(paint);
+    return NewOpItem<PaintOpItem>(arena, paint);
 }
 
 // ConcatOpItem
@@ -1291,7 +1301,7 @@ bool ConcatOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ConcatOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ConcatOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkMatrix matrix;
     bool success = RSMarshallingHelper::Unmarshalling(parcel, matrix);
@@ -1299,7 +1309,7 @@ OpItem* ConcatOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ConcatOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ConcatOpItem(matrix);
+    return NewOpItem<ConcatOpItem>(arena, matrix);
 }
 
 // SaveLayerOpItem
@@ -1321,7 +1331,7 @@ bool SaveLayerOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* SaveLayerOpItem::Unmarshalling(Parcel& parcel)
+OpItem* SaveLayerOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     bool isRectExist;
     SkRect rect;
@@ -1346,7 +1356,7 @@ OpItem* SaveLayerOpItem::Unmarshalling(Parcel& parcel)
         return nullptr;
     }
     SkCanvas::SaveLayerRec rec = { rectPtr, &paint, backdrop.get(), mask.get(), &matrix, flags };
-    return new SaveLayerOpItem(rec);
+    return NewOpItem<SaveLayerOpItem>(arena, rec);
 }
 
 // DrawableOpItem
@@ -1361,7 +1371,7 @@ bool DrawableOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* DrawableOpItem::Unmarshalling(Parcel& parcel)
+OpItem* DrawableOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     sk_sp<SkDrawable> drawable;
     SkMatrix matrix;
@@ -1371,7 +1381,7 @@ OpItem* DrawableOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("DrawableOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new DrawableOpItem(drawable.release(), &matrix);
+    return NewOpItem<DrawableOpItem>(arena, drawable.release(), &matrix);
 }
 
 // PictureOpItem
@@ -1387,7 +1397,7 @@ bool PictureOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* PictureOpItem::Unmarshalling(Parcel& parcel)
+OpItem* PictureOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     sk_sp<SkPicture> picture;
     SkMatrix matrix;
@@ -1399,7 +1409,7 @@ OpItem* PictureOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("PictureOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new PictureOpItem(picture, &matrix, &paint);
+    return NewOpItem<PictureOpItem>(arena, picture, &matrix, &paint);
 }
 
 // PointsOpItem
@@ -1416,7 +1426,7 @@ bool PointsOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* PointsOpItem::Unmarshalling(Parcel& parcel)
+OpItem* PointsOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkCanvas::PointMode mode;
     int count;
@@ -1430,7 +1440,7 @@ OpItem* PointsOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("PointsOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new PointsOpItem(mode, count, processedPoints, paint);
+    return NewOpItem<PointsOpItem>(arena, mode, count, processedPoints, paint);
 }
 
 // VerticesOpItem
@@ -1448,7 +1458,7 @@ bool VerticesOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* VerticesOpItem::Unmarshalling(Parcel& parcel)
+OpItem* VerticesOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     sk_sp<SkVertices> vertices;
     const SkVertices::Bone* bones = nullptr;
@@ -1464,7 +1474,7 @@ OpItem* VerticesOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("VerticesOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new VerticesOpItem(vertices.get(), bones, boneCount, mode, paint);
+    return NewOpItem<VerticesOpItem>(arena, vertices.get(), bones, boneCount, mode, paint);
 }
 
 // ShadowRecOpItem
@@ -1479,7 +1489,7 @@ bool ShadowRecOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* ShadowRecOpItem::Unmarshalling(Parcel& parcel)
+OpItem* ShadowRecOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     SkPath path;
     SkDrawShadowRec rec;
@@ -1489,7 +1499,7 @@ OpItem* ShadowRecOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("ShadowRecOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new ShadowRecOpItem(path, rec);
+    return NewOpItem<ShadowRecOpItem>(arena, path, rec);
 }
 
 // MultiplyAlphaOpItem
@@ -1503,7 +1513,7 @@ bool MultiplyAlphaOpItem::Marshalling(Parcel& parcel) const
     return success;
 }
 
-OpItem* MultiplyAlphaOpItem::Unmarshalling(Parcel& parcel)
+OpItem* MultiplyAlphaOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
     float alpha;
     bool success = RSMarshallingHelper::Unmarshalling(parcel, alpha);
@@ -1511,19 +1521,88 @@ OpItem* MultiplyAlphaOpItem::Unmarshalling(Parcel& parcel)
         ROSEN_LOGE("MultiplyAlphaOpItem::Unmarshalling failed!");
         return nullptr;
     }
-    return new MultiplyAlphaOpItem(alpha);
+    return NewOpItem<MultiplyAlphaOpItem>(arena, alpha);
 }
 
 // SaveAlphaOpItem
-OpItem* SaveAlphaOpItem::Unmarshalling(Parcel& parcel)
+OpItem* SaveAlphaOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
-    return new SaveAlphaOpItem();
+    return NewOpItem<SaveAlphaOpItem>(arena);
 }
 
 // RestoreAlphaOpItem
-OpItem* RestoreAlphaOpItem::Unmarshalling(Parcel& parcel)
+OpItem* RestoreAlphaOpItem::Unmarshalling(Parcel& parcel, OpItemArena* arena)
 {
-    return new RestoreAlphaOpItem();
+    return NewOpItem<RestoreAlphaOpItem>(arena);
+}
+namespace {
+using DrawOpFunc = void (*)(const OpItem& op, RSPaintFilterCanvas& canvas, const SkRect* rect);
+
+// a direct call of the Draw of the type, which can be inlined here
+template<typename T>
+void DrawOp(const OpItem& op, RSPaintFilterCanvas& canvas, const SkRect* rect)
+{
+    static_cast<const T&>(op).T::Draw(canvas, rect);
+}
+
+// indexed by the type of the op
+struct DrawOpFuncTable {
+    static constexpr size_t SIZE = RSOpType::RESTORE_ALPHA_OPITEM + 1;
+    DrawOpFunc funcs[SIZE] = {};
+
+    DrawOpFuncTable()
+    {
+        funcs[RECT_OPITEM] = DrawOp<RectOpItem>;
+        funcs[ROUND_RECT_OPITEM] = DrawOp<RoundRectOpItem>;
+        funcs[IMAGE_WITH_PARM_OPITEM] = DrawOp<ImageWithParmOpItem>;
+        funcs[DRRECT_OPITEM] = DrawOp<DRRectOpItem>;
+        funcs[OVAL_OPITEM] = DrawOp<OvalOpItem>;
+        funcs[REGION_OPITEM] = DrawOp<RegionOpItem>;
+        funcs[ARC_OPITEM] = DrawOp<ArcOpItem>;
+        funcs[SAVE_OPITEM] = DrawOp<SaveOpItem>;
+        funcs[RESTORE_OPITEM] = DrawOp<RestoreOpItem>;
+        funcs[FLUSH_OPITEM] = DrawOp<FlushOpItem>;
+        funcs[MATRIX_OPITEM] = DrawOp<MatrixOpItem>;
+        funcs[CLIP_RECT_OPITEM] = DrawOp<ClipRectOpItem>;
+        funcs[CLIP_RRECT_OPITEM] = DrawOp<ClipRRectOpItem>;
+        funcs[CLIP_REGION_OPITEM] = DrawOp<ClipRegionOpItem>;
+        funcs[TRANSLATE_OPITEM] = DrawOp<TranslateOpItem>;
+        funcs[TEXTBLOB_OPITEM] = DrawOp<TextBlobOpItem>;
+        funcs[BITMAP_OPITEM] = DrawOp<BitmapOpItem>;
+        funcs[BITMAP_RECT_OPITEM] = DrawOp<BitmapRectOpItem>;
+        funcs[BITMAP_NINE_OPITEM] = DrawOp<BitmapNineOpItem>;
+        funcs[PIXELMAP_OPITEM] = DrawOp<PixelMapOpItem>;
+        funcs[PIXELMAP_RECT_OPITEM] = DrawOp<PixelMapRectOpItem>;
+        funcs[ADAPTIVE_RRECT_OPITEM] = DrawOp<AdaptiveRRectOpItem>;
+        funcs[ADAPTIVE_RRECT_SCALE_OPITEM] = DrawOp<AdaptiveRRectScaleOpItem>;
+        funcs[CLIP_ADAPTIVE_RRECT_OPITEM] = DrawOp<ClipAdaptiveRRectOpItem>;
+        funcs[CLIP_OUTSET_RECT_OPITEM] = DrawOp<ClipOutsetRectOpItem>;
+        funcs[PATH_OPITEM] = DrawOp<PathOpItem>;
+        funcs[CLIP_PATH_OPITEM] = DrawOp<ClipPathOpItem>;
+        funcs[PAINT_OPITEM] = DrawOp<PaintOpItem>;
+        funcs[CONCAT_OPITEM] = DrawOp<ConcatOpItem>;
+        funcs[SAVE_LAYER_OPITEM] = DrawOp<SaveLayerOpItem>;
+        funcs[DRAWABLE_OPITEM] = DrawOp<DrawableOpItem>;
+        funcs[PICTURE_OPITEM] = DrawOp<PictureOpItem>;
+        funcs[POINTS_OPITEM] = DrawOp<PointsOpItem>;
+        funcs[VERTICES_OPITEM] = DrawOp<VerticesOpItem>;
+        funcs[SHADOW_REC_OPITEM] = DrawOp<ShadowRecOpItem>;
+        funcs[MULTIPLY_ALPHA_OPITEM] = DrawOp<MultiplyAlphaOpItem>;
+        funcs[SAVE_ALPHA_OPITEM] = DrawOp<SaveAlphaOpItem>;
+        funcs[RESTORE_ALPHA_OPITEM] = DrawOp<RestoreAlphaOpItem>;
+    }
+};
+const DrawOpFuncTable DRAW_OP_FUNC_TABLE;
+} // namespace
+
+void OpItem::DrawByType(RSOpType type, const OpItem& op, RSPaintFilterCanvas& canvas, const SkRect* rect)
+{
+    DrawOpFunc func = (type < DrawOpFuncTable::SIZE) ? DRAW_OP_FUNC_TABLE.funcs[type] : nullptr;
+    if (func == nullptr) {
+        op.Draw(canvas, rect);
+        return;
+    }
+    func(op, canvas, rect);
 }
 } // namespace Rosen
 } // namespace OHOS
@@ -15,7 +15,7 @@
 
 #include "pipeline/rs_draw_cmd_list.h"
 
-#include <unordered_map>
+#include <algorithm>
 
 #include "rs_trace.h"
 
@@ -27,56 +27,97 @@
 
 namespace OHOS {
 namespace Rosen {
-using OpUnmarshallingFunc = OpItem* (*)(Parcel& parcel);
-
-static std::unordered_map<RSOpType, OpUnmarshallingFunc> opUnmarshallingFuncLUT = {
-    { RECT_OPITEM,                 RectOpItem::Unmarshalling },
-    { ROUND_RECT_OPITEM,           RoundRectOpItem::Unmarshalling },
-    { IMAGE_WITH_PARM_OPITEM,      ImageWithParmOpItem::Unmarshalling },
-    { DRRECT_OPITEM,               DRRectOpItem::Unmarshalling },
-    { OVAL_OPITEM,                 OvalOpItem::Unmarshalling },
-    { REGION_OPITEM,               RegionOpItem::Unmarshalling },
-    { ARC_OPITEM,                  ArcOpItem::Unmarshalling },
-    { SAVE_OPITEM,                 SaveOpItem::Unmarshalling },
-    { RESTORE_OPITEM,              RestoreOpItem::Unmarshalling },
-    { FLUSH_OPITEM,                FlushOpItem::Unmarshalling },
-    { MATRIX_OPITEM,               MatrixOpItem::Unmarshalling },
-    { CLIP_RECT_OPITEM,            ClipRectOpItem::Unmarshalling },
-    { CLIP_RRECT_OPITEM,           ClipRRectOpItem::Unmarshalling },
-    { CLIP_REGION_OPITEM,          ClipRegionOpItem::Unmarshalling },
-    { TRANSLATE_OPITEM,            TranslateOpItem::Unmarshalling },
-    { TEXTBLOB_OPITEM,             TextBlobOpItem::Unmarshalling },
-    { BITMAP_OPITEM,               BitmapOpItem::Unmarshalling },
-    { BITMAP_RECT_OPITEM,          BitmapRectOpItem::Unmarshalling },
-    { BITMAP_NINE_OPITEM,          BitmapNineOpItem::Unmarshalling },
-    { PIXELMAP_OPITEM,             PixelMapOpItem::Unmarshalling },
-    { PIXELMAP_RECT_OPITEM,        PixelMapRectOpItem::Unmarshalling },
-    { ADAPTIVE_RRECT_OPITEM,       AdaptiveRRectOpItem::Unmarshalling },
-    { ADAPTIVE_RRECT_SCALE_OPITEM, AdaptiveRRectScaleOpItem::Unmarshalling },
-    { CLIP_ADAPTIVE_RRECT_OPITEM,  ClipAdaptiveRRectOpItem::Unmarshalling },
-    { CLIP_OUTSET_RECT_OPITEM,     ClipOutsetRectOpItem::Unmarshalling },
-    { PATH_OPITEM,                 PathOpItem::Unmarshalling },
-    { CLIP_PATH_OPITEM,            ClipPathOpItem::Unmarshalling },
-    { PAINT_OPITEM,                PaintOpItem::Unmarshalling },
-    { CONCAT_OPITEM,               ConcatOpItem::Unmarshalling },
-    { SAVE_LAYER_OPITEM,           SaveLayerOpItem::Unmarshalling },
-    { DRAWABLE_OPITEM,             DrawableOpItem::Unmarshalling },
-    { PICTURE_OPITEM,              PictureOpItem::Unmarshalling },
-    { POINTS_OPITEM,               PointsOpItem::Unmarshalling },
-    { VERTICES_OPITEM,             VerticesOpItem::Unmarshalling },
-    { SHADOW_REC_OPITEM,           ShadowRecOpItem::Unmarshalling },
-    { MULTIPLY_ALPHA_OPITEM,       MultiplyAlphaOpItem::Unmarshalling },
-    { SAVE_ALPHA_OPITEM,           SaveAlphaOpItem::Unmarshalling },
-    { RESTORE_ALPHA_OPITEM,        RestoreAlphaOpItem::Unmarshalling },
+namespace {
+using OpUnmarshallingFunc = OpItem* (*)(Parcel& parcel, OpItemArena* arena);
+
+// indexed by the type of the op
+struct OpUnmarshallingFuncTable {
+    static constexpr size_t SIZE = RSOpType::RESTORE_ALPHA_OPITEM + 1;
+    OpUnmarshallingFunc funcs[SIZE] = {};
+
+    OpUnmarshallingFuncTable()
+    {
+        funcs[RECT_OPITEM] = RectOpItem::Unmarshalling;
+        funcs[ROUND_RECT_OPITEM] = RoundRectOpItem::Unmarshalling;
+        funcs[IMAGE_WITH_PARM_OPITEM] = ImageWithParmOpItem::Unmarshalling;
+        funcs[DRRECT_OPITEM] = DRRectOpItem::Unmarshalling;
+        funcs[OVAL_OPITEM] = OvalOpItem::Unmarshalling;
+        funcs[REGION_OPITEM] = RegionOpItem::Unmarshalling;
+        funcs[ARC_OPITEM] = ArcOpItem::Unmarshalling;
+        funcs[SAVE_OPITEM] = SaveOpItem::Unmarshalling;
+        funcs[RESTORE_OPITEM] = RestoreOpItem::Unmarshalling;
+        funcs[FLUSH_OPITEM] = FlushOpItem::Unmarshalling;
+        funcs[MATRIX_OPITEM] = MatrixOpItem::Unmarshalling;
+        funcs[CLIP_RECT_OPITEM] = ClipRectOpItem::Unmarshalling;
+        funcs[CLIP_RRECT_OPITEM] = ClipRRectOpItem::Unmarshalling;
+        funcs[CLIP_REGION_OPITEM] = ClipRegionOpItem::Unmarshalling;
+        funcs[TRANSLATE_OPITEM] = TranslateOpItem::Unmarshalling;
+        funcs[TEXTBLOB_OPITEM] = TextBlobOpItem::Unmarshalling;
+        funcs[BITMAP_OPITEM] = BitmapOpItem::Unmarshalling;
+        funcs[BITMAP_RECT_OPITEM] = BitmapRectOpItem::Unmarshalling;
+        funcs[BITMAP_NINE_OPITEM] = BitmapNineOpItem::Unmarshalling;
+        funcs[PIXELMAP_OPITEM] = PixelMapOpItem::Unmarshalling;
+        funcs[PIXELMAP_RECT_OPITEM] = PixelMapRectOpItem::Unmarshalling;
+        funcs[ADAPTIVE_RRECT_OPITEM] = AdaptiveRRectOpItem::Unmarshalling;
+        funcs[ADAPTIVE_RRECT_SCALE_OPITEM] = AdaptiveRRectScaleOpItem::Unmarshalling;
+        funcs[CLIP_ADAPTIVE_RRECT_OPITEM] = ClipAdaptiveRRectOpItem::Unmarshalling;
+        funcs[CLIP_OUTSET_RECT_OPITEM] = ClipOutsetRectOpItem::Unmarshalling;
+        funcs[PATH_OPITEM] = PathOpItem::Unmarshalling;
+        funcs[CLIP_PATH_OPITEM] = ClipPathOpItem::Unmarshalling;
+        funcs[PAINT_OPITEM] = PaintOpItem::Unmarshalling;
+        funcs[CONCAT_OPITEM] = ConcatOpItem::Unmarshalling;
+        funcs[SAVE_LAYER_OPITEM] = SaveLayerOpItem::Unmarshalling;
+        funcs[DRAWABLE_OPITEM] = DrawableOpItem::Unmarshalling;
+        funcs[PICTURE_OPITEM] = PictureOpItem::Unmarshalling;
+        funcs[POINTS_OPITEM] = PointsOpItem::Unmarshalling;
+        funcs[VERTICES_OPITEM] = VerticesOpItem::Unmarshalling;
+        funcs[SHADOW_REC_OPITEM] = ShadowRecOpItem::Unmarshalling;
+        funcs[MULTIPLY_ALPHA_OPITEM] = MultiplyAlphaOpItem::Unmarshalling;
+        funcs[SAVE_ALPHA_OPITEM] = SaveAlphaOpItem::Unmarshalling;
+        funcs[RESTORE_ALPHA_OPITEM] = RestoreAlphaOpItem::Unmarshalling;
+    }
 };
+const OpUnmarshallingFuncTable OP_UNMARSHALLING_FUNC_TABLE;
 
-static OpUnmarshallingFunc GetOpUnmarshallingFunc(RSOpType type)
+OpUnmarshallingFunc GetOpUnmarshallingFunc(RSOpType type)
 {
-    auto it = opUnmarshallingFuncLUT.find(type);
-    if (it == opUnmarshallingFuncLUT.end()) {
+    if (type >= OpUnmarshallingFuncTable::SIZE) {
         return nullptr;
     }
-    return it->second;
+    return OP_UNMARSHALLING_FUNC_TABLE.funcs[type];
+}
+} // namespace
+
+void* OpItemArena::Allocate(size_t size)
+{
+    // keeps every op aligned as the chunks
+    size = (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    if (chunks_.empty() || offset_ + size > chunkSize_) {
+        size_t chunkSize = chunks_.empty() ? MIN_CHUNK_SIZE : std::min(chunkSize_ * 2, MAX_CHUNK_SIZE);
+        size_t count = (std::max(chunkSize, size) + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+        // not value initialized, the ops are constructed in it
+        chunks_.emplace_back(new std::max_align_t[count]);
+        chunkSize_ = count * sizeof(std::max_align_t);
+        offset_ = 0;
+    }
+    void* ptr = reinterpret_cast<uint8_t*>(chunks_.back().get()) + offset_;
+    offset_ += size;
+    return ptr;
+}
+
+void OpItemArena::Reset()
+{
+    if (chunks_.size() > 1) {
+        chunks_.erase(chunks_.begin(), chunks_.end() - 1);
+    }
+    offset_ = 0;
+}
+
+void OpItemArena::Swap(OpItemArena& other)
+{
+    chunks_.swap(other.chunks_);
+    std::swap(chunkSize_, other.chunkSize_);
+    std::swap(offset_, other.offset_);
 }
 
 DrawCmdList::DrawCmdList(int w, int h) : width_(w), height_(h) {}
@@ -88,20 +129,46 @@ DrawCmdList::~DrawCmdList()
 
 void DrawCmdList::AddOp(std::unique_ptr<OpItem>&& op)
 {
+    if (op == nullptr) {
+        return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
-    ops_.push_back(std::move(op));
+    RSOpType type = op->GetType();
+    ops_.push_back({ op.release(), type, false });
+}
+
+void DrawCmdList::DestroyOp(const OpEntry& entry)
+{
+    if (entry.inArena) {
+        entry.op->~OpItem();
+    } else {
+        delete entry.op;
+    }
 }
 
 void DrawCmdList::ClearOp()
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& entry : ops_) {
+        DestroyOp(entry);
+    }
     ops_.clear();
+    for (const auto& [index, entry] : opReplacedByCache_) {
+        DestroyOp(entry);
+    }
+    opReplacedByCache_.clear();
+    arena_.Reset();
 }
 
 DrawCmdList& DrawCmdList::operator=(DrawCmdList&& that)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     ops_.swap(that.ops_);
+    arena_.Swap(that.arena_);
+    opReplacedByCache_.swap(that.opReplacedByCache_);
+#ifdef ROSEN_OHOS
+    std::swap(isCached_, that.isCached_);
+#endif
     return *this;
 }
 
@@ -117,11 +184,8 @@ void DrawCmdList::Playback(RSPaintFilterCanvas& canvas, const SkRect* rect) cons
         return;
     }
     std::lock_guard<std::mutex> lock(mutex_);
-    for (auto& it : ops_) {
-        if (it == nullptr) {
-            continue;
-        }
-        it->Draw(canvas, rect);
+    for (const auto& entry : ops_) {
+        OpItem::DrawByType(entry.type, *entry.op, canvas, rect);
     }
 }
 
@@ -150,8 +214,8 @@ bool DrawCmdList::Marshalling(Parcel& parcel) const
         ROSEN_LOGE("DrawCmdList::Marshalling failed!");
         return false;
     }
-    for (const auto& item : ops_) {
-        auto type = item->GetType();
+    for (const auto& entry : ops_) {
+        auto type = entry.type;
         success = success && RSMarshallingHelper::Marshalling(parcel, type);
         auto func = GetOpUnmarshallingFunc(type);
         if (!func) {
@@ -159,7 +223,7 @@ bool DrawCmdList::Marshalling(Parcel& parcel) const
             continue;
         }
 
-        success = success && item->Marshalling(parcel);
+        success = success && entry.op->Marshalling(parcel);
         if (!success) {
             ROSEN_LOGE("unirender: failed opItem Marshalling, optype = %d", type);
             return success;
@@ -192,13 +256,14 @@ DrawCmdList* DrawCmdList::Unmarshalling(Parcel& parcel)
             continue;
         }
 
-        OpItem* item = (*func)(parcel);
+        OpItem* item = (*func)(parcel, &drawCmdList->arena_);
         if (!item) {
             ROSEN_LOGE("unirender: failed opItem Unmarshalling, optype = %d", type);
             return nullptr;
         }
 
-        drawCmdList->AddOp(std::unique_ptr<OpItem>(item));
+        // the list is not shared yet
+        drawCmdList->ops_.push_back({ item, item->GetType(), true });
     }
     return drawCmdList.release();
 }
@@ -214,12 +279,13 @@ void DrawCmdList::GenerateCache(SkSurface* surface)
     std::lock_guard<std::mutex> lock(mutex_);
 
     for (auto index = 0u; index < ops_.size(); index++) {
-        auto& op = ops_[index];
-        if (auto cached_op = op->GenerateCachedOpItem(surface)) {
+        auto& entry = ops_[index];
+        if (auto cached_op = entry.op->GenerateCachedOpItem(surface)) {
             // backup the original op and position
-            opReplacedByCache_.emplace(index, op.release());
+            opReplacedByCache_.emplace(index, entry);
             // replace the original op with the cached op
-            op.reset(cached_op.release());
+            RSOpType type = cached_op->GetType();
+            entry = { cached_op.release(), type, false };
         }
     }
 #endif
@@ -237,7 +303,8 @@ void DrawCmdList::ClearCache()
 
     // restore the original op
     for (auto& it : opReplacedByCache_) {
-        ops_[it.first] = std::move(it.second);
+        DestroyOp(ops_[it.first]);
+        ops_[it.first] = it.second;
     }
     opReplacedByCache_.clear();
 #endif
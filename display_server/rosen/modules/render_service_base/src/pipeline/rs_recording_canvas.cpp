@@ -50,6 +50,16 @@ void RSRecordingCanvas::AddOp(std::unique_ptr<OpItem>&& opItem)
     drawCmdList_->AddOp(std::move(opItem));
 }
 
+template<typename T, typename... Args>
+void RSRecordingCanvas::AddOp(Args&&... args)
+{
+    if (drawCmdList_ == nullptr) {
+        ROSEN_LOGE("RSRecordingCanvas:AddOp, drawCmdList_ is nullptr");
+        return;
+    }
+    drawCmdList_->AddOp<T>(std::forward<Args>(args)...);
+}
+
 GrContext* RSRecordingCanvas::getGrContext()
 {
     return grContext_;
@@ -67,21 +77,18 @@ sk_sp<SkSurface> RSRecordingCanvas::onNewSurface(const SkImageInfo& info, const
 
 void RSRecordingCanvas::onFlush()
 {
-    std::unique_ptr<OpItem> op = std::make_unique<FlushOpItem>();
-    AddOp(std::move(op));
+    AddOp<FlushOpItem>();
 }
 
 void RSRecordingCanvas::willSave()
 {
-    std::unique_ptr<OpItem> op = std::make_unique<SaveOpItem>();
-    AddOp(std::move(op));
+    AddOp<SaveOpItem>();
     saveCount_++;
 }
 
 SkCanvas::SaveLayerStrategy RSRecordingCanvas::getSaveLayerStrategy(const SaveLayerRec& rec)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<SaveLayerOpItem>(rec);
-    AddOp(std::move(op));
+    AddOp<SaveLayerOpItem>(rec);
     saveCount_++;
     return SkCanvas::kNoLayer_SaveLayerStrategy;
 }
@@ -89,79 +96,67 @@ SkCanvas::SaveLayerStrategy RSRecordingCanvas::getSaveLayerStrategy(const SaveLa
 void RSRecordingCanvas::willRestore()
 {
     if (saveCount_ > 0) {
-        std::unique_ptr<OpItem> op = std::make_unique<RestoreOpItem>();
-        AddOp(std::move(op));
+        AddOp<RestoreOpItem>();
         --saveCount_;
     }
 }
 
 void RSRecordingCanvas::didConcat(const SkMatrix& matrix)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ConcatOpItem>(matrix);
-    AddOp(std::move(op));
+    AddOp<ConcatOpItem>(matrix);
 }
 
 void RSRecordingCanvas::didSetMatrix(const SkMatrix& matrix)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<MatrixOpItem>(matrix);
-    AddOp(std::move(op));
+    AddOp<MatrixOpItem>(matrix);
 }
 
 void RSRecordingCanvas::didTranslate(SkScalar dx, SkScalar dy)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<TranslateOpItem>(dx, dy);
-    AddOp(std::move(op));
+    AddOp<TranslateOpItem>(dx, dy);
 }
 
 void RSRecordingCanvas::onClipRect(const SkRect& rect, SkClipOp clipOp, ClipEdgeStyle style)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ClipRectOpItem>(rect, clipOp, style == kSoft_ClipEdgeStyle);
-    AddOp(std::move(op));
+    AddOp<ClipRectOpItem>(rect, clipOp, style == kSoft_ClipEdgeStyle);
 }
 
 void RSRecordingCanvas::onClipRRect(const SkRRect& rrect, SkClipOp clipOp, ClipEdgeStyle style)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ClipRRectOpItem>(rrect, clipOp, style == kSoft_ClipEdgeStyle);
-    AddOp(std::move(op));
+    AddOp<ClipRRectOpItem>(rrect, clipOp, style == kSoft_ClipEdgeStyle);
 }
 
 void RSRecordingCanvas::onClipPath(const SkPath& path, SkClipOp clipOp, ClipEdgeStyle style)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ClipPathOpItem>(path, clipOp, style == kSoft_ClipEdgeStyle);
-    AddOp(std::move(op));
+    AddOp<ClipPathOpItem>(path, clipOp, style == kSoft_ClipEdgeStyle);
 }
 
 void RSRecordingCanvas::onClipRegion(const SkRegion& region, SkClipOp clipop)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ClipRegionOpItem>(region, clipop);
-    AddOp(std::move(op));
+    AddOp<ClipRegionOpItem>(region, clipop);
 }
 
 void RSRecordingCanvas::onDrawPaint(const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<PaintOpItem>(paint);
-    AddOp(std::move(op));
+    AddOp<PaintOpItem>(paint);
 }
 
 void RSRecordingCanvas::DrawImageWithParm(const sk_sp<SkImage>img, const sk_sp<SkData> data,
     const Rosen::RsImageInfo& rsimageInfo, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ImageWithParmOpItem>(img, data, rsimageInfo, paint);
-    AddOp(std::move(op));
+    AddOp<ImageWithParmOpItem>(img, data, rsimageInfo, paint);
 }
 
 void RSRecordingCanvas::DrawPixelMap(
     const std::shared_ptr<Media::PixelMap>& pixelmap, SkScalar x, SkScalar y, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<PixelMapOpItem>(pixelmap, x, y, paint);
-    AddOp(std::move(op));
+    AddOp<PixelMapOpItem>(pixelmap, x, y, paint);
 }
 
 void RSRecordingCanvas::DrawPixelMapRect(const std::shared_ptr<Media::PixelMap>& pixelmap, const SkRect& src,
     const SkRect& dst, const SkPaint* paint, SrcRectConstraint constraint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<PixelMapRectOpItem>(pixelmap, src, dst, paint);
-    AddOp(std::move(op));
+    AddOp<PixelMapRectOpItem>(pixelmap, src, dst, paint);
 }
 
 void RSRecordingCanvas::DrawPixelMapRect(
@@ -173,8 +168,7 @@ void RSRecordingCanvas::DrawPixelMapRect(
 void RSRecordingCanvas::DrawPixelMapWithParm(
     const std::shared_ptr<Media::PixelMap>& pixelmap, const Rosen::RsImageInfo& rsImageInfo, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ImageWithParmOpItem>(pixelmap, rsImageInfo, paint);
-    AddOp(std::move(op));
+    AddOp<ImageWithParmOpItem>(pixelmap, rsImageInfo, paint);
 }
 
 void RSRecordingCanvas::onDrawBehind(const SkPaint& paint)
@@ -185,61 +179,53 @@ void RSRecordingCanvas::onDrawBehind(const SkPaint& paint)
 
 void RSRecordingCanvas::onDrawPath(const SkPath& path, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<PathOpItem>(path, paint);
     if (RSSystemProperties::GetDrawTextAsBitmap()) {
         // replace drawOpItem with cached one (generated by CPU)
-        op = op->GenerateCachedOpItem(nullptr);
+        AddOp(PathOpItem(path, paint).GenerateCachedOpItem(nullptr));
+        return;
     }
-    AddOp(std::move(op));
+    AddOp<PathOpItem>(path, paint);
 }
 
 void RSRecordingCanvas::onDrawRect(const SkRect& rect, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<RectOpItem>(rect, paint);
-    AddOp(std::move(op));
+    AddOp<RectOpItem>(rect, paint);
 }
 
 void RSRecordingCanvas::onDrawRegion(const SkRegion& region, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<RegionOpItem>(region, paint);
-    AddOp(std::move(op));
+    AddOp<RegionOpItem>(region, paint);
 }
 
 void RSRecordingCanvas::onDrawOval(const SkRect& oval, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<OvalOpItem>(oval, paint);
-    AddOp(std::move(op));
+    AddOp<OvalOpItem>(oval, paint);
 }
 
 void RSRecordingCanvas::onDrawArc(
     const SkRect& oval, SkScalar startAngle, SkScalar sweepAngle, bool useCenter, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ArcOpItem>(oval, startAngle, sweepAngle, useCenter, paint);
-    AddOp(std::move(op));
+    AddOp<ArcOpItem>(oval, startAngle, sweepAngle, useCenter, paint);
 }
 
 void RSRecordingCanvas::onDrawRRect(const SkRRect& rrect, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<RoundRectOpItem>(rrect, paint);
-    AddOp(std::move(op));
+    AddOp<RoundRectOpItem>(rrect, paint);
 }
 
 void RSRecordingCanvas::onDrawDRRect(const SkRRect& out, const SkRRect& in, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<DRRectOpItem>(out, in, paint);
-    AddOp(std::move(op));
+    AddOp<DRRectOpItem>(out, in, paint);
 }
 
 void RSRecordingCanvas::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<DrawableOpItem>(drawable, matrix);
-    AddOp(std::move(op));
+    AddOp<DrawableOpItem>(drawable, matrix);
 }
 
 void RSRecordingCanvas::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<PictureOpItem>(sk_ref_sp(picture), matrix, paint);
-    AddOp(std::move(op));
+    AddOp<PictureOpItem>(sk_ref_sp(picture), matrix, paint);
 }
 
 void RSRecordingCanvas::onDrawAnnotation(const SkRect& rect, const char key[], SkData* val)
@@ -250,32 +236,29 @@ void RSRecordingCanvas::onDrawAnnotation(const SkRect& rect, const char key[], S
 
 void RSRecordingCanvas::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<TextBlobOpItem>(sk_ref_sp(blob), x, y, paint);
     if (RSSystemProperties::GetDrawTextAsBitmap()) {
         // replace drawOpItem with cached one (generated by CPU)
-        op = op->GenerateCachedOpItem(nullptr);
+        AddOp(TextBlobOpItem(sk_ref_sp(blob), x, y, paint).GenerateCachedOpItem(nullptr));
+        return;
     }
-    AddOp(std::move(op));
+    AddOp<TextBlobOpItem>(sk_ref_sp(blob), x, y, paint);
 }
 
 void RSRecordingCanvas::onDrawBitmap(const SkBitmap& bm, SkScalar x, SkScalar y, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapOpItem>(SkImage::MakeFromBitmap(bm), x, y, paint);
-    AddOp(std::move(op));
+    AddOp<BitmapOpItem>(SkImage::MakeFromBitmap(bm), x, y, paint);
 }
 
 void RSRecordingCanvas::onDrawBitmapNine(
     const SkBitmap& bm, const SkIRect& center, const SkRect& dst, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapNineOpItem>(SkImage::MakeFromBitmap(bm), center, dst, paint);
-    AddOp(std::move(op));
+    AddOp<BitmapNineOpItem>(SkImage::MakeFromBitmap(bm), center, dst, paint);
 }
 
 void RSRecordingCanvas::onDrawBitmapRect(
     const SkBitmap& bm, const SkRect* src, const SkRect& dst, const SkPaint* paint, SrcRectConstraint constraint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapRectOpItem>(SkImage::MakeFromBitmap(bm), src, dst, paint);
-    AddOp(std::move(op));
+    AddOp<BitmapRectOpItem>(SkImage::MakeFromBitmap(bm), src, dst, paint);
 }
 
 void RSRecordingCanvas::onDrawBitmapLattice(
@@ -288,22 +271,19 @@ void RSRecordingCanvas::onDrawBitmapLattice(
 
 void RSRecordingCanvas::onDrawImage(const SkImage* img, SkScalar x, SkScalar y, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapOpItem>(sk_ref_sp(img), x, y, paint);
-    AddOp(std::move(op));
+    AddOp<BitmapOpItem>(sk_ref_sp(img), x, y, paint);
 }
 
 void RSRecordingCanvas::onDrawImageNine(
     const SkImage* img, const SkIRect& center, const SkRect& dst, const SkPaint* paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapNineOpItem>(sk_ref_sp(img), center, dst, paint);
-    AddOp(std::move(op));
+    AddOp<BitmapNineOpItem>(sk_ref_sp(img), center, dst, paint);
 }
 
 void RSRecordingCanvas::onDrawImageRect(
     const SkImage* img, const SkRect* src, const SkRect& dst, const SkPaint* paint, SrcRectConstraint constraint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<BitmapRectOpItem>(sk_ref_sp(img), src, dst, paint);
-    AddOp(std::move(op));
+    AddOp<BitmapRectOpItem>(sk_ref_sp(img), src, dst, paint);
 }
 
 void RSRecordingCanvas::onDrawImageLattice(
@@ -330,26 +310,22 @@ void RSRecordingCanvas::DrawImageLatticeAsBitmap(
 
 void RSRecordingCanvas::DrawAdaptiveRRect(float radius, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<AdaptiveRRectOpItem>(radius, paint);
-    AddOp(std::move(op));
+    AddOp<AdaptiveRRectOpItem>(radius, paint);
 }
 
 void RSRecordingCanvas::DrawAdaptiveRRectScale(float radiusRatio, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<AdaptiveRRectScaleOpItem>(radiusRatio, paint);
-    AddOp(std::move(op));
+    AddOp<AdaptiveRRectScaleOpItem>(radiusRatio, paint);
 }
 
 void RSRecordingCanvas::ClipAdaptiveRRect(const SkVector radius[])
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ClipAdaptiveRRectOpItem>(radius);
-    AddOp(std::move(op));
+    AddOp<ClipAdaptiveRRectOpItem>(radius);
 }
 
 void RSRecordingCanvas::ClipOutsetRect(float dx, float dy)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ClipOutsetRectOpItem>(dx, dy);
-    AddOp(std::move(op));
+    AddOp<ClipOutsetRectOpItem>(dx, dy);
 }
 
 void RSRecordingCanvas::onDrawPatch(const SkPoint cubics[12], const SkColor colors[4], const SkPoint texCoords[4],
@@ -361,15 +337,13 @@ void RSRecordingCanvas::onDrawPatch(const SkPoint cubics[12], const SkColor colo
 
 void RSRecordingCanvas::onDrawPoints(SkCanvas::PointMode mode, size_t count, const SkPoint pts[], const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<PointsOpItem>(mode, count, pts, paint);
-    AddOp(std::move(op));
+    AddOp<PointsOpItem>(mode, count, pts, paint);
 }
 
 void RSRecordingCanvas::onDrawVerticesObject(
     const SkVertices* vertices, const SkVertices::Bone bones[], int boneCount, SkBlendMode mode, const SkPaint& paint)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<VerticesOpItem>(vertices, bones, boneCount, mode, paint);
-    AddOp(std::move(op));
+    AddOp<VerticesOpItem>(vertices, bones, boneCount, mode, paint);
 }
 
 void RSRecordingCanvas::onDrawAtlas(const SkImage* atlas, const SkRSXform xforms[], const SkRect texs[],
@@ -381,26 +355,22 @@ void RSRecordingCanvas::onDrawAtlas(const SkImage* atlas, const SkRSXform xforms
 
 void RSRecordingCanvas::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<ShadowRecOpItem>(path, rec);
-    AddOp(std::move(op));
+    AddOp<ShadowRecOpItem>(path, rec);
 }
 
 void RSRecordingCanvas::MultiplyAlpha(float alpha)
 {
-    std::unique_ptr<OpItem> op = std::make_unique<MultiplyAlphaOpItem>(alpha);
-    AddOp(std::move(op));
+    AddOp<MultiplyAlphaOpItem>(alpha);
 }
 
 void RSRecordingCanvas::SaveAlpha()
 {
-    std::unique_ptr<OpItem> op = std::make_unique<SaveAlphaOpItem>();
-    AddOp(std::move(op));
+    AddOp<SaveAlphaOpItem>();
 }
 
 void RSRecordingCanvas::RestoreAlpha()
 {
-    std::unique_ptr<OpItem> op = std::make_unique<RestoreAlphaOpItem>();
-    AddOp(std::move(op));
+    AddOp<RestoreAlphaOpItem>();
 }
 } // namespace Rosen
 } // namespace OHOS
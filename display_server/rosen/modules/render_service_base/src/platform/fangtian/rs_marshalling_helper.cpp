@@ -15,6 +15,7 @@
 
 #include "transaction/rs_marshalling_helper.h"
 
+#include <cinttypes>
 #include <memory>
 #include <message_parcel.h>
 #include <sys/mman.h>
@@ -92,6 +93,17 @@ static inline sk_sp<T> sk_reinterpret_cast(sk_sp<P> ptr)
 {
     return sk_sp<T>(static_cast<T*>(SkSafeRef(ptr.get())));
 }
+
+// the slab of a block written by RSMarshallingHelper::WriteToParcel, nullptr if the block is out of the slab.
+std::shared_ptr<RSParcelSlab> GetSlabOfBlock(int fd, uint64_t offset, size_t size)
+{
+    auto slab = RSParcelSlabCache::Instance().Get(fd);
+    if (slab == nullptr || offset > RSParcelSlab::SLAB_SIZE || !slab->IsValidBlock(offset, size)) {
+        ROSEN_LOGE("GetSlabOfBlock invalid block, offset:%" PRIu64 ", size:%zu", offset, size);
+        return nullptr;
+    }
+    return slab;
+}
 } // namespace
 
 // SkData
@@ -126,18 +138,12 @@ bool RSMarshallingHelper::Unmarshalling(Parcel& parcel, sk_sp<SkData>& val)
         return true;
     }
 
-    const void* data = RSMarshallingHelper::ReadFromParcel(parcel, size);
-    if (data == nullptr) {
+    val = RSMarshallingHelper::ReadDataFromParcel(parcel, size);
+    if (val == nullptr) {
         ROSEN_LOGE("unirender: failed RSMarshallingHelper::Unmarshalling SkData");
         return false;
     }
-
-    if (static_cast<uint32_t>(size) < MIN_DATA_SIZE) {
-        val = SkData::MakeWithoutCopy(data, size);
-    } else {
-        val = SkData::MakeFromMalloc(data, size);
-    }
-    return val != nullptr;
+    return true;
 }
 bool RSMarshallingHelper::SkipSkData(Parcel& parcel)
 {
@@ -308,11 +314,15 @@ bool RSMarshallingHelper::Unmarshalling(Parcel& parcel, sk_sp<SkImage>& val)
         return val != nullptr;
     } else {
         size_t pixmapSize = parcel.ReadUint32();
-        const void* addr = RSMarshallingHelper::ReadFromParcel(parcel, pixmapSize);
-        if (addr == nullptr) {
+        sk_sp<SkData> skData = RSMarshallingHelper::ReadDataFromParcel(parcel, pixmapSize);
+        if (skData == nullptr) {
             ROSEN_LOGE("failed RSMarshallingHelper::Unmarshalling SkData addr");
             return false;
         }
+        if (pixmapSize < MIN_DATA_SIZE) {
+            // the image outlives the parcel
+            skData = SkData::MakeWithCopy(skData->data(), skData->size());
+        }
 
         size_t rb = parcel.ReadUint32();
         int width = parcel.ReadInt32();
@@ -326,20 +336,15 @@ bool RSMarshallingHelper::Unmarshalling(Parcel& parcel, sk_sp<SkImage>& val)
         if (size == 0) {
             colorSpace = nullptr;
         } else {
-            const void* data = RSMarshallingHelper::ReadFromParcel(parcel, size);
+            sk_sp<SkData> data = RSMarshallingHelper::ReadDataFromParcel(parcel, size);
             if (data == nullptr) {
                 ROSEN_LOGE("failed RSMarshallingHelper::Unmarshalling SkData data");
                 return false;
             }
-            colorSpace = SkColorSpace::Deserialize(data, size);
-            if (size >= MIN_DATA_SIZE) {
-                free(const_cast<void*>(data));
-            }
+            colorSpace = SkColorSpace::Deserialize(data->data(), data->size());
         }
 
         SkImageInfo imageInfo = SkImageInfo::Make(width, height, colorType, alphaType, colorSpace);
-        auto skData = pixmapSize < MIN_DATA_SIZE ? SkData::MakeWithCopy(addr, pixmapSize)
-                                                 : SkData::MakeFromMalloc(addr, pixmapSize);
         val = SkImage::MakeRasterData(imageInfo, skData, rb);
         return val != nullptr;
     }
@@ -856,6 +861,20 @@ bool RSMarshallingHelper::WriteToParcel(Parcel& parcel, const void* data, size_t
         return parcel.WriteUnpadBuffer(data, size);
     }
 
+    // write to a slab of the connection, the offset of the block follows the fd, 0 for a dedicated ashmem
+    size_t offset = 0;
+    auto slabScope = RSParcelSlabRing::GetCurrentScope();
+    auto slab = slabScope ? slabScope->Allocate(size, offset) : nullptr;
+    if (slab != nullptr) {
+        // the slab is held for the whole parcel, the owner of the scope releases it if the parcel is not sent.
+        if (memcpy_s(slab->GetData(offset), size, data, size) != EOK ||
+            !static_cast<MessageParcel*>(&parcel)->WriteFileDescriptor(slab->GetFd()) || !parcel.WriteUint64(offset)) {
+            ROSEN_LOGE("RSMarshallingHelper::WriteToParcel write slab block failed");
+            return false;
+        }
+        return true;
+    }
+
     // write to ashmem
     auto ashmemAllocator = AshmemAllocator::CreateAshmemAllocator(size, PROT_READ | PROT_WRITE);
     if (!ashmemAllocator) {
@@ -863,7 +882,7 @@ bool RSMarshallingHelper::WriteToParcel(Parcel& parcel, const void* data, size_t
         return false;
     }
     int fd = ashmemAllocator->GetFd();
-    if (!(static_cast<MessageParcel*>(&parcel)->WriteFileDescriptor(fd))) {
+    if (!(static_cast<MessageParcel*>(&parcel)->WriteFileDescriptor(fd)) || !parcel.WriteUint64(0)) {
         ROSEN_LOGE("RSMarshallingHelper::WriteToParcel WriteFileDescriptor error");
         return false;
     }
@@ -874,25 +893,47 @@ bool RSMarshallingHelper::WriteToParcel(Parcel& parcel, const void* data, size_t
     return true;
 }
 
-const void* RSMarshallingHelper::ReadFromParcel(Parcel& parcel, size_t size)
+sk_sp<SkData> RSMarshallingHelper::ReadDataFromParcel(Parcel& parcel, size_t size)
 {
     uint32_t bufferSize = parcel.ReadUint32();
     if (static_cast<unsigned int>(bufferSize) != size) {
-        ROSEN_LOGE("RSMarshallingHelper::ReadFromParcel size mismatch");
+        ROSEN_LOGE("RSMarshallingHelper::ReadDataFromParcel size mismatch");
         return nullptr;
     }
 
     if (static_cast<unsigned int>(bufferSize) < MIN_DATA_SIZE) {
-        return parcel.ReadUnpadBuffer(size);
+        const void* data = parcel.ReadUnpadBuffer(size);
+        return data == nullptr ? nullptr : SkData::MakeWithoutCopy(data, size);
     }
-    // read from ashmem
     int fd = static_cast<MessageParcel*>(&parcel)->ReadFileDescriptor();
+    uint64_t offset = parcel.ReadUint64();
+    if (offset != 0) {
+        auto slab = GetSlabOfBlock(fd, offset, size);
+        if (slab == nullptr) {
+            return nullptr;
+        }
+        auto holder = RSParcelSlabHolder::GetCurrent();
+        if (holder == nullptr) {
+            // nothing holds the slab once the parcel is read
+            return SkData::MakeWithCopy(slab->GetData(offset), size);
+        }
+        // read in place, the holder copies the block out of the slab if it is still in use once the parcel is
+        // processed.
+        auto block = std::make_shared<RSParcelSlabBlock>(slab, offset, size);
+        holder->AddBlock(block);
+        auto context = new std::shared_ptr<RSParcelSlabBlock>(std::move(block));
+        return SkData::MakeWithProc((*context)->GetData(), size, [](const void* ptr, void* ctx) {
+            delete static_cast<std::shared_ptr<RSParcelSlabBlock>*>(ctx);
+        }, context);
+    }
+    // read from ashmem
     auto ashmemAllocator = AshmemAllocator::CreateAshmemAllocatorWithFd(fd, size, PROT_READ);
     if (!ashmemAllocator) {
-        ROSEN_LOGE("RSMarshallingHelper::ReadFromParcel CreateAshmemAllocator fail");
+        ROSEN_LOGE("RSMarshallingHelper::ReadDataFromParcel CreateAshmemAllocator fail");
         return nullptr;
     }
-    return ashmemAllocator->CopyFromAshmem(size);
+    void* data = ashmemAllocator->CopyFromAshmem(size);
+    return data == nullptr ? nullptr : SkData::MakeFromMalloc(data, size);
 }
 
 bool RSMarshallingHelper::SkipFromParcel(Parcel& parcel, size_t size)
@@ -907,8 +948,12 @@ bool RSMarshallingHelper::SkipFromParcel(Parcel& parcel, size_t size)
         parcel.SkipBytes(size);
         return true;
     }
-    // read from ashmem
     int fd = static_cast<MessageParcel*>(&parcel)->ReadFileDescriptor();
+    uint64_t offset = parcel.ReadUint64();
+    if (offset != 0) {
+        return GetSlabOfBlock(fd, offset, size) != nullptr;
+    }
+    // read from ashmem
     auto ashmemAllocator = AshmemAllocator::CreateAshmemAllocatorWithFd(fd, size, PROT_READ);
     return ashmemAllocator != nullptr;
 }
@@ -25,6 +25,7 @@
 #include "message_parcel.h"
 //#include "pipeline/rs_render_thread.h"
 #include "platform/common/rs_log.h"
+#include "render/rs_image_transfer_cache.h"
 #include "rs_render_service_connection_proxy.h"
 #include "rs_render_service_proxy.h"
 
@@ -159,6 +160,8 @@ void RSRenderServiceConnectHub::ConnectDied()
     deathRecipient_ = nullptr;
     token_ = nullptr;
     mutex_.unlock();
+    // the images acknowledged by the dead render service are gone with it.
+    RSImageTransferCache::Instance().Reset();
     RS_LOGI("RSRenderServiceConnectHub::ConnectDied unlock pid: %d", getpid());
 }
 
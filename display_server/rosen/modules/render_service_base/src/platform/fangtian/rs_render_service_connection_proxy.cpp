@@ -45,35 +45,48 @@ void RSRenderServiceConnectionProxy::CommitTransaction(std::unique_ptr<RSTransac
     transactionData->SetSendingPid(pid_);
 
     // split to several parcels if parcel size > PARCEL_SPLIT_THRESHOLD during marshalling
+    // the slabs held by each parcel, the service releases them once it parsed the parcel
     std::vector<std::shared_ptr<MessageParcel>> parcelVector;
+    std::vector<RSParcelSlabList> slabsVector;
     while (transactionData->GetMarshallingIndex() < transactionData->GetCommandCount()) {
         if (isUniMode) {
             ++transactionDataIndex_;
         }
         transactionData->SetIndex(transactionDataIndex_);
         std::shared_ptr<MessageParcel> parcel = std::make_shared<MessageParcel>();
-        if (!FillParcelWithTransactionData(transactionData, parcel)) {
+        RSParcelSlabList slabs;
+        if (!FillParcelWithTransactionData(transactionData, parcel, slabs)) {
             ROSEN_LOGE("FillParcelWithTransactionData failed!");
+            RSParcelSlabRing::ReleaseParcel(slabs);
+            for (auto& sentSlabs : slabsVector) {
+                RSParcelSlabRing::ReleaseParcel(sentSlabs);
+            }
             return;
         }
         parcelVector.emplace_back(parcel);
+        slabsVector.emplace_back(std::move(slabs));
     }
 
     MessageOption option;
     option.SetFlags(MessageOption::TF_ASYNC);
-    for (auto& parcel : parcelVector) {
+    for (size_t i = 0; i < parcelVector.size(); ++i) {
+        auto& parcel = parcelVector[i];
         MessageParcel reply;
         RS_ASYNC_TRACE_BEGIN("RSProxySendRequest", parcel->GetDataSize());
         int32_t err = Remote()->SendRequest(RSIRenderServiceConnection::COMMIT_TRANSACTION, *parcel, reply, option);
         if (err != NO_ERROR) {
             ROSEN_LOGE("RSRenderServiceConnectionProxy::CommitTransaction SendRequest failed, err = %d", err);
+            // this parcel and the following ones never reach the service
+            for (size_t j = i; j < slabsVector.size(); ++j) {
+                RSParcelSlabRing::ReleaseParcel(slabsVector[j]);
+            }
             return;
         }
     }
 }
 
-bool RSRenderServiceConnectionProxy::FillParcelWithTransactionData(
-    std::unique_ptr<RSTransactionData>& transactionData, std::shared_ptr<MessageParcel>& data)
+bool RSRenderServiceConnectionProxy::FillParcelWithTransactionData(std::unique_ptr<RSTransactionData>& transactionData,
+    std::shared_ptr<MessageParcel>& data, RSParcelSlabList& slabs)
 {
     // write a flag at the begin of parcel to identify parcel type
     // 0: indicate normal parcel
@@ -84,7 +97,11 @@ bool RSRenderServiceConnectionProxy::FillParcelWithTransactionData(
     RS_TRACE_BEGIN("Marsh RSTransactionData: cmd count:" + std::to_string(transactionData->GetCommandCount()) +
         " transactionFlag:[" + std::to_string(pid_) + ", " + std::to_string(transactionData->GetIndex()) + "],isUni:" +
         std::to_string(transactionData->GetUniRender()));
-    bool success = data->WriteParcelable(transactionData.get());
+    bool success = false;
+    {
+        RSParcelSlabRing::Scope slabScope(slabRing_, slabs);
+        success = data->WriteParcelable(transactionData.get());
+    }
     RS_TRACE_END();
     if (!success) {
         ROSEN_LOGE("FillParcelWithTransactionData data.WriteParcelable failed!");
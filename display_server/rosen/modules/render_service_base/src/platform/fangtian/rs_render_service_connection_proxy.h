@@ -19,6 +19,7 @@
 #include <iremote_proxy.h>
 #include <platform/ohos/rs_irender_service_connection.h>
 #include "sandbox_utils.h"
+#include "transaction/rs_ashmem_helper.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -28,8 +29,8 @@ public:
     virtual ~RSRenderServiceConnectionProxy() noexcept = default;
 
     void CommitTransaction(std::unique_ptr<RSTransactionData>& transactionData) override;
-    bool FillParcelWithTransactionData(
-        std::unique_ptr<RSTransactionData>& transactionData, std::shared_ptr<MessageParcel>& data);
+    bool FillParcelWithTransactionData(std::unique_ptr<RSTransactionData>& transactionData,
+        std::shared_ptr<MessageParcel>& data, RSParcelSlabList& slabs);
 
     void ExecuteSynchronousTask(const std::shared_ptr<RSSyncTask>& task) override;
 
@@ -121,6 +122,8 @@ private:
 
     pid_t pid_ = GetRealPid();
     uint32_t transactionDataIndex_ = 0;
+    // the large blobs of the transactions, the render service releases them after processing.
+    RSParcelSlabRing slabRing_;
 };
 } // namespace Rosen
 } // namespace OHOS
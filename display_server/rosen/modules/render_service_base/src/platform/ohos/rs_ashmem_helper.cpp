@@ -15,8 +15,12 @@
 
 #include "transaction/rs_ashmem_helper.h"
 
+#include <algorithm>
+#include <atomic>
+#include <fcntl.h>
 #include <memory>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include "ashmem.h"
@@ -173,6 +177,401 @@ void* AshmemAllocator::Realloc(void* data, size_t newSize)
     return nullptr;
 }
 
+namespace {
+constexpr int SLAB_SEALS = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+constexpr size_t BLOCK_ALIGNMENT = 64;
+constexpr size_t DEFAULT_PAGE_SIZE = 4096;
+
+size_t GetPageSize()
+{
+    static const size_t pageSize = [] {
+        long size = sysconf(_SC_PAGESIZE);
+        return size > 0 ? static_cast<size_t>(size) : DEFAULT_PAGE_SIZE;
+    }();
+    return pageSize;
+}
+}
+
+struct RSParcelSlab::Header {
+    // the parcels held by the writer and not released by the reader yet, written by both processes.
+    std::atomic<uint32_t> pendingCount;
+};
+
+namespace {
+bool IsSealedSlab(int fd)
+{
+    struct stat st = {};
+    int seals = fcntl(fd, F_GET_SEALS);
+    return seals >= 0 && (seals & SLAB_SEALS) == SLAB_SEALS && fstat(fd, &st) == 0 &&
+        static_cast<size_t>(st.st_size) == RSParcelSlab::SLAB_SIZE;
+}
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlab::Create()
+{
+    static_assert(sizeof(Header) <= HEADER_SIZE, "the header must fit before the first block");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "the header is shared between processes");
+    static pid_t pid = GetRealPid();
+    static std::atomic<uint32_t> slabCount = 0;
+    std::string name = "RSParcelSlab" + std::to_string(pid) + "_" + std::to_string(slabCount++);
+
+    int fd = memfd_create(name.c_str(), MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        ROSEN_LOGE("RSParcelSlab::Create memfd_create failed, errno:%d", errno);
+        return nullptr;
+    }
+    // the size is sealed, so that the reader never faults on a page truncated by the writer.
+    if (ftruncate(fd, SLAB_SIZE) != 0 || fcntl(fd, F_ADD_SEALS, SLAB_SEALS) != 0) {
+        ROSEN_LOGE("RSParcelSlab::Create seal failed, errno:%d", errno);
+        ::close(fd);
+        return nullptr;
+    }
+    void* data = ::mmap(nullptr, SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        ROSEN_LOGE("RSParcelSlab::Create MAP_FAILED");
+        ::close(fd);
+        return nullptr;
+    }
+    // the zero filled header is a slab without pending blocks.
+    return std::shared_ptr<RSParcelSlab>(new RSParcelSlab(fd, data));
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlab::Map(int fd)
+{
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (!IsSealedSlab(fd)) {
+        ROSEN_LOGE("RSParcelSlab::Map fd:%d is not a sealed slab", fd);
+        ::close(fd);
+        return nullptr;
+    }
+    void* data = ::mmap(nullptr, SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        ROSEN_LOGE("RSParcelSlab::Map MAP_FAILED");
+        return nullptr;
+    }
+    return std::shared_ptr<RSParcelSlab>(new RSParcelSlab(-1, data));
+}
+
+RSParcelSlab::RSParcelSlab(int fd, void* data) : fd_(fd), data_(data) {}
+
+RSParcelSlab::~RSParcelSlab()
+{
+    ::munmap(data_, SLAB_SIZE);
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+int RSParcelSlab::GetFd() const
+{
+    return fd_;
+}
+
+uint8_t* RSParcelSlab::GetData(size_t offset) const
+{
+    return static_cast<uint8_t*>(data_) + offset;
+}
+
+RSParcelSlab::Header* RSParcelSlab::GetHeader() const
+{
+    return static_cast<Header*>(data_);
+}
+
+uint32_t RSParcelSlab::GetPendingCount() const
+{
+    return GetHeader()->pendingCount.load(std::memory_order_acquire);
+}
+
+size_t RSParcelSlab::GetFirstBlockOffset()
+{
+    return std::max(HEADER_SIZE, GetPageSize());
+}
+
+bool RSParcelSlab::Reserve(size_t size, size_t& offset)
+{
+    if (GetPendingCount() == 0) {
+        // all the parcels are released, start over.
+        used_ = HEADER_SIZE;
+    }
+    size_t begin = (std::max(used_, GetFirstBlockOffset()) + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+    if (size > SLAB_SIZE || begin > SLAB_SIZE - size) {
+        return false;
+    }
+    offset = begin;
+    used_ = begin + size;
+    return true;
+}
+
+void RSParcelSlab::Hold()
+{
+    GetHeader()->pendingCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RSParcelSlab::Release()
+{
+    // a peer releasing more than it is sent only breaks its own connection.
+    uint32_t count = GetHeader()->pendingCount.load(std::memory_order_relaxed);
+    while (count > 0 && !GetHeader()->pendingCount.compare_exchange_weak(count, count - 1,
+        std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+bool RSParcelSlab::IsValidBlock(size_t offset, size_t size) const
+{
+    return offset >= GetFirstBlockOffset() && offset <= SLAB_SIZE && size <= SLAB_SIZE - offset;
+}
+
+bool RSParcelSlab::CopyOutBlock(size_t offset, size_t size)
+{
+    if (!IsValidBlock(offset, size)) {
+        return false;
+    }
+    // the pages are copied whole, the other blocks in them are not changed by the writer until their parcels are
+    // released either, and the next blocks of the slab are read from another mapping.
+    size_t pageSize = GetPageSize();
+    size_t begin = offset & ~(pageSize - 1);
+    size_t end = std::min((offset + size + pageSize - 1) & ~(pageSize - 1), SLAB_SIZE);
+    size_t length = end - begin;
+    void* copy = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (copy == MAP_FAILED) {
+        ROSEN_LOGE("RSParcelSlab::CopyOutBlock MAP_FAILED, errno:%d", errno);
+        return false;
+    }
+    if (memcpy_s(copy, length, GetData(begin), length) != EOK) {
+        ::munmap(copy, length);
+        return false;
+    }
+    // moving the copy over the shared pages is atomic, the readers of the block never see it unmapped.
+    if (::mremap(copy, length, length, MREMAP_MAYMOVE | MREMAP_FIXED, GetData(begin)) == MAP_FAILED) {
+        ROSEN_LOGE("RSParcelSlab::CopyOutBlock mremap failed, errno:%d", errno);
+        ::munmap(copy, length);
+        return false;
+    }
+    return true;
+}
+
+RSParcelSlabBlock::RSParcelSlabBlock(std::shared_ptr<RSParcelSlab> slab, size_t offset, size_t size)
+    : slab_(std::move(slab)), offset_(offset), size_(size)
+{
+}
+
+const uint8_t* RSParcelSlabBlock::GetData() const
+{
+    return slab_->GetData(offset_);
+}
+
+size_t RSParcelSlabBlock::GetSize() const
+{
+    return size_;
+}
+
+namespace {
+thread_local RSParcelSlabRing::Scope* g_currentSlabScope = nullptr;
+thread_local RSParcelSlabHolder* g_currentSlabHolder = nullptr;
+}
+
+RSParcelSlabRing::Scope::Scope(RSParcelSlabRing& ring, RSParcelSlabList& slabs)
+    : ring_(ring), slabs_(slabs), previous_(g_currentSlabScope)
+{
+    g_currentSlabScope = this;
+}
+
+RSParcelSlabRing::Scope::~Scope()
+{
+    g_currentSlabScope = previous_;
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlabRing::Scope::Allocate(size_t size, size_t& offset)
+{
+    return ring_.Allocate(size, offset, slabs_);
+}
+
+RSParcelSlabRing::Scope* RSParcelSlabRing::GetCurrentScope()
+{
+    return g_currentSlabScope;
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlabRing::Allocate(size_t size, size_t& offset, RSParcelSlabList& slabs)
+{
+    if (size > RSParcelSlab::SLAB_SIZE - RSParcelSlab::HEADER_SIZE) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < SLAB_COUNT; i++) {
+        size_t index = (current_ + i) % SLAB_COUNT;
+        if (index == slabs_.size()) {
+            // the slabs are created on demand, in order.
+            auto slab = RSParcelSlab::Create();
+            if (slab == nullptr) {
+                return nullptr;
+            }
+            slabs_.emplace_back(std::move(slab));
+        }
+        if (index < slabs_.size() && slabs_[index]->Reserve(size, offset)) {
+            current_ = index;
+            auto& slab = slabs_[index];
+            if (std::find(slabs.begin(), slabs.end(), slab) == slabs.end()) {
+                // the first block of the parcel in this slab, the hold keeps the slab from starting over until the
+                // reader releases the parcel.
+                slab->Hold();
+                slabs.push_back(slab);
+            }
+            return slab;
+        }
+    }
+    return nullptr;
+}
+
+void RSParcelSlabRing::ReleaseParcel(RSParcelSlabList& slabs)
+{
+    for (auto& slab : slabs) {
+        slab->Release();
+    }
+    slabs.clear();
+}
+
+RSParcelSlabHolder::Scope::Scope(RSParcelSlabHolder& holder) : previous_(g_currentSlabHolder)
+{
+    g_currentSlabHolder = &holder;
+}
+
+RSParcelSlabHolder::Scope::~Scope()
+{
+    g_currentSlabHolder = previous_;
+}
+
+RSParcelSlabHolder::RSParcelSlabHolder(MessageParcel& parcel)
+    : slabs_(RSParcelSlabCache::Instance().GetParcelSlabs(parcel))
+{
+}
+
+RSParcelSlabHolder::~RSParcelSlabHolder()
+{
+    // the writer may start a slab over as soon as it is released, copy the blocks still in use out of it before.
+    for (auto& weakBlock : blocks_) {
+        auto block = weakBlock.lock();
+        if (block == nullptr) {
+            continue;
+        }
+        if (!block->slab_->CopyOutBlock(block->offset_, block->size_)) {
+            // keep the slabs held rather than let the writer change a block in use, the writer falls back to
+            // dedicated ashmem for the blobs which don't fit in the other slabs.
+            ROSEN_LOGE("RSParcelSlabHolder: copy out block failed, offset:%zu, size:%zu", block->offset_,
+                block->size_);
+            return;
+        }
+        RSParcelSlabCache::Instance().Remove(block->slab_);
+    }
+    for (auto& slab : slabs_) {
+        slab->Release();
+    }
+}
+
+RSParcelSlabHolder* RSParcelSlabHolder::GetCurrent()
+{
+    return g_currentSlabHolder;
+}
+
+void RSParcelSlabHolder::AddBlock(const std::shared_ptr<RSParcelSlabBlock>& block)
+{
+    blocks_.emplace_back(block);
+}
+
+RSParcelSlabCache& RSParcelSlabCache::Instance()
+{
+    static RSParcelSlabCache instance;
+    return instance;
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlabCache::Get(int fd)
+{
+    struct stat st = {};
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        ROSEN_LOGE("RSParcelSlabCache::Get invalid fd:%d", fd);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return nullptr;
+    }
+    // the inode can't be forged by the writer, unlike an id written in the parcel.
+    auto key = std::make_pair(static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino));
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = slabs_.find(key);
+    if (iter != slabs_.end()) {
+        ::close(fd);
+        iter->second.lastUsed = ++useCount_;
+        return iter->second.slab;
+    }
+    auto slab = RSParcelSlab::Map(fd);
+    if (slab == nullptr) {
+        return nullptr;
+    }
+    // the limit shrinks as the clients disconnect. the blocks still in use keep their slab mapped.
+    size_t maxSlabs = std::max<size_t>(clientCount_, 1) * MAX_CACHED_SLABS_PER_CLIENT;
+    while (!slabs_.empty() && slabs_.size() >= maxSlabs) {
+        auto lru = std::min_element(slabs_.begin(), slabs_.end(),
+            [](const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+        slabs_.erase(lru);
+    }
+    slabs_.emplace(key, Entry { slab, ++useCount_ });
+    return slab;
+}
+
+RSParcelSlabList RSParcelSlabCache::GetParcelSlabs(MessageParcel& parcel)
+{
+    // the writer holds each slab once per parcel, whatever the number of its blocks in it.
+    RSParcelSlabList slabs;
+    binder_size_t* object = reinterpret_cast<binder_size_t*>(parcel.GetObjectOffsets());
+    size_t objectNum = parcel.GetOffsetsSize();
+    uintptr_t data = parcel.GetData();
+    for (size_t i = 0; i < objectNum; i++) {
+        const flat_binder_object* flat = reinterpret_cast<flat_binder_object*>(data + object[i]);
+        if (flat->hdr.type != BINDER_TYPE_FD || !IsSealedSlab(static_cast<int>(flat->handle))) {
+            continue;
+        }
+        auto slab = Get(dup(static_cast<int>(flat->handle)));
+        if (slab != nullptr && std::find(slabs.begin(), slabs.end(), slab) == slabs.end()) {
+            slabs.push_back(slab);
+        }
+    }
+    return slabs;
+}
+
+void RSParcelSlabCache::ReleaseParcel(MessageParcel& parcel)
+{
+    for (auto& slab : GetParcelSlabs(parcel)) {
+        slab->Release();
+    }
+}
+
+void RSParcelSlabCache::Remove(const std::shared_ptr<RSParcelSlab>& slab)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = std::find_if(slabs_.begin(), slabs_.end(), [&slab](const auto& entry) {
+        return entry.second.slab == slab;
+    });
+    if (iter != slabs_.end()) {
+        slabs_.erase(iter);
+    }
+}
+
+void RSParcelSlabCache::AddClient()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    clientCount_++;
+}
+
+void RSParcelSlabCache::RemoveClient()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (clientCount_ > 0) {
+        clientCount_--;
+    }
+}
+
 void RSAshmemHelper::CopyFileDescriptor(
     std::shared_ptr<MessageParcel>& ashmemParcel, std::shared_ptr<MessageParcel>& dataParcel)
 {
@@ -103,6 +103,24 @@ bool RSSystemProperties::GetOcclusionEnabled()
     return std::atoi((system::GetParameter("rosen.occlusion.enabled", "1")).c_str()) != 0;
 }
 
+bool RSSystemProperties::GetVSyncTimelineEnabled()
+{
+    // If not 0, the vsync distributors publish vsync through a shared memory timeline instead of the socket pairs.
+    return std::atoi((system::GetParameter("rosen.vsync.timeline.enabled", "0")).c_str()) != 0;
+}
+
+bool RSSystemProperties::GetVSyncAdaptivePhaseEnabled()
+{
+    // If not 0, the phase offsets of the rs and app vsync are tuned after the measured frame durations.
+    return std::atoi((system::GetParameter("rosen.vsync.adaptivephase.enabled", "0")).c_str()) != 0;
+}
+
+BlurQualityType RSSystemProperties::GetBlurQuality()
+{
+    return static_cast<BlurQualityType>(
+        std::atoi((system::GetParameter("rosen.blur.quality", "1")).c_str()));
+}
+
 std::string RSSystemProperties::GetRSEventProperty(const std::string &paraName)
 {
     return system::GetParameter(paraName, "0");
@@ -166,6 +184,12 @@ bool RSSystemProperties::GetColdStartThreadEnabled()
     return std::atoi((system::GetParameter("rosen.coldstartthread.enabled", "0")).c_str()) != 0;
 }
 
+bool RSSystemProperties::GetHardwareThreadEnabled()
+{
+    // commit the layers of the uni render to the screen on the hardware thread instead of the main thread
+    return std::atoi((system::GetParameter("rosen.hardwarethread.enabled", "1")).c_str()) != 0;
+}
+
 float RSSystemProperties::GetAnimationScale()
 {
     return std::atof((system::GetParameter("persist.sys.graphic.animationscale", "1.0")).c_str());
@@ -81,6 +81,167 @@ void* AshmemAllocator::Realloc(void* data, size_t newSize)
     return {};
 }
 
+std::shared_ptr<RSParcelSlab> RSParcelSlab::Create()
+{
+    return {};
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlab::Map(int fd)
+{
+    return {};
+}
+
+RSParcelSlab::RSParcelSlab(int fd, void* data) : fd_(fd), data_(data)
+{
+}
+
+RSParcelSlab::~RSParcelSlab()
+{
+}
+
+int RSParcelSlab::GetFd() const
+{
+    return fd_;
+}
+
+uint8_t* RSParcelSlab::GetData(size_t offset) const
+{
+    return {};
+}
+
+uint32_t RSParcelSlab::GetPendingCount() const
+{
+    return {};
+}
+
+size_t RSParcelSlab::GetFirstBlockOffset()
+{
+    return {};
+}
+
+bool RSParcelSlab::Reserve(size_t size, size_t& offset)
+{
+    return {};
+}
+
+void RSParcelSlab::Hold()
+{
+}
+
+void RSParcelSlab::Release()
+{
+}
+
+bool RSParcelSlab::IsValidBlock(size_t offset, size_t size) const
+{
+    return {};
+}
+
+bool RSParcelSlab::CopyOutBlock(size_t offset, size_t size)
+{
+    return {};
+}
+
+RSParcelSlabBlock::RSParcelSlabBlock(std::shared_ptr<RSParcelSlab> slab, size_t offset, size_t size)
+    : slab_(slab), offset_(offset), size_(size)
+{
+}
+
+const uint8_t* RSParcelSlabBlock::GetData() const
+{
+    return {};
+}
+
+size_t RSParcelSlabBlock::GetSize() const
+{
+    return {};
+}
+
+RSParcelSlabRing::Scope::Scope(RSParcelSlabRing& ring, RSParcelSlabList& slabs)
+    : ring_(ring), slabs_(slabs), previous_(nullptr)
+{
+}
+
+RSParcelSlabRing::Scope::~Scope()
+{
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlabRing::Scope::Allocate(size_t size, size_t& offset)
+{
+    return {};
+}
+
+RSParcelSlabRing::Scope* RSParcelSlabRing::GetCurrentScope()
+{
+    return {};
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlabRing::Allocate(size_t size, size_t& offset, RSParcelSlabList& slabs)
+{
+    return {};
+}
+
+void RSParcelSlabRing::ReleaseParcel(RSParcelSlabList& slabs)
+{
+}
+
+RSParcelSlabHolder::Scope::Scope(RSParcelSlabHolder& holder) : previous_(nullptr)
+{
+}
+
+RSParcelSlabHolder::Scope::~Scope()
+{
+}
+
+RSParcelSlabHolder::RSParcelSlabHolder(MessageParcel& parcel)
+{
+}
+
+RSParcelSlabHolder::~RSParcelSlabHolder()
+{
+}
+
+RSParcelSlabHolder* RSParcelSlabHolder::GetCurrent()
+{
+    return {};
+}
+
+void RSParcelSlabHolder::AddBlock(const std::shared_ptr<RSParcelSlabBlock>& block)
+{
+}
+
+RSParcelSlabCache& RSParcelSlabCache::Instance()
+{
+    static RSParcelSlabCache instance;
+    return instance;
+}
+
+std::shared_ptr<RSParcelSlab> RSParcelSlabCache::Get(int fd)
+{
+    return {};
+}
+
+RSParcelSlabList RSParcelSlabCache::GetParcelSlabs(MessageParcel& parcel)
+{
+    return {};
+}
+
+void RSParcelSlabCache::ReleaseParcel(MessageParcel& parcel)
+{
+}
+
+void RSParcelSlabCache::Remove(const std::shared_ptr<RSParcelSlab>& slab)
+{
+}
+
+void RSParcelSlabCache::AddClient()
+{
+}
+
+void RSParcelSlabCache::RemoveClient()
+{
+}
+
 void RSAshmemHelper::CopyFileDescriptor(
     std::shared_ptr<MessageParcel>& ashmemParcel, std::shared_ptr<MessageParcel>& dataParcel)
 {
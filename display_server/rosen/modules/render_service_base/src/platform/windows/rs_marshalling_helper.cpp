@@ -417,7 +417,7 @@ bool RSMarshallingHelper::WriteToParcel(Parcel& parcel, const void* data, size_t
     return {};
 }
 
-const void* RSMarshallingHelper::ReadFromParcel(Parcel& parcel, size_t size)
+sk_sp<SkData> RSMarshallingHelper::ReadDataFromParcel(Parcel& parcel, size_t size)
 {
     return {};
 }
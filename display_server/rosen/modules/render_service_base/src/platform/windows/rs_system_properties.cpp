@@ -58,6 +58,21 @@ bool RSSystemProperties::GetOcclusionEnabled()
     return {};
 }
 
+bool RSSystemProperties::GetVSyncTimelineEnabled()
+{
+    return {};
+}
+
+bool RSSystemProperties::GetVSyncAdaptivePhaseEnabled()
+{
+    return {};
+}
+
+BlurQualityType RSSystemProperties::GetBlurQuality()
+{
+    return {};
+}
+
 std::string RSSystemProperties::GetRSEventProperty(const std::string &paraName)
 {
     return {};
@@ -102,6 +117,11 @@ bool RSSystemProperties::GetColdStartThreadEnabled()
     return {};
 }
 
+bool RSSystemProperties::GetHardwareThreadEnabled()
+{
+    return {};
+}
+
 float RSSystemProperties::GetAnimationScale()
 {
     return 1.f;
@@ -257,45 +257,104 @@ void RSPropertiesPainter::DrawShadow(const RSProperties& properties, RSPaintFilt
 void RSPropertiesPainter::DrawFilter(const RSProperties& properties, RSPaintFilterCanvas& canvas,
     std::shared_ptr<RSSkiaFilter>& filter, const std::unique_ptr<SkRect>& rect, SkSurface* skSurface)
 {
-    g_blurCnt++;
     SkAutoCanvasRestore acr(&canvas, true);
+    SkRect bounds;
     if (rect != nullptr) {
         canvas.clipRect((*rect), true);
+        bounds = *rect;
     } else if (properties.GetClipBounds() != nullptr) {
         canvas.clipPath(properties.GetClipBounds()->GetSkiaPath(), true);
+        bounds = properties.GetClipBounds()->GetSkiaPath().getBounds();
     } else {
         canvas.clipRRect(RRect2SkRRect(properties.GetRRect()), true);
+        bounds = RRect2SkRRect(properties.GetRRect()).rect();
     }
-    auto paint = filter->GetPaint();
     if (skSurface == nullptr) {
+        g_blurCnt++;
         ROSEN_LOGD("RSPropertiesPainter::DrawFilter skSurface null");
+        auto paint = filter->GetPaint();
         SkCanvas::SaveLayerRec slr(nullptr, &paint, SkCanvas::kInitWithPrevious_SaveLayerFlag);
         canvas.saveLayer(slr);
         filter->PostProcess(canvas);
         return;
     }
 
+    // only the background filters are cached, a foreground filter is over the content of the node itself.
+    bool isCacheEnabled = canvas.isFilterCacheEnabled() && filter == properties.GetBackgroundFilter();
+    SkIRect cacheRect = SkIRect::MakeEmpty();
+    if (isCacheEnabled) {
+        // the whole filter in device coordinates, the clip may also be narrowed by the damage region of the frame.
+        cacheRect = canvas.getTotalMatrix().mapRect(bounds).roundOut();
+        if (!cacheRect.intersect(SkIRect::MakeWH(skSurface->width(), skSurface->height()))) {
+            cacheRect.setEmpty();
+        }
+        auto cachedImage = filter->GetCachedImage(cacheRect);
+        if (cachedImage != nullptr) {
+            DrawCachedFilter(canvas, cachedImage, cacheRect);
+            filter->PostProcess(canvas);
+            filter->ConsumeBackdropMark();
+            return;
+        }
+    }
+    g_blurCnt++;
+
     // canvas draw by snapshot instead of SaveLayer, since the blur layer moves while using saveLayer
     auto imageSnapshot = skSurface->makeImageSnapshot(canvas.getDeviceClipBounds());
     if (imageSnapshot == nullptr) {
         ROSEN_LOGE("RSPropertiesPainter::DrawFilter image null");
+        if (isCacheEnabled) {
+            filter->ConsumeBackdropMark();
+        }
         return;
     }
 
     filter->PreProcess(imageSnapshot);
+    if (isCacheEnabled && filter->IsBackdropStable() && canvas.getDeviceClipBounds() == cacheRect) {
+        // the backdrop is the same as the last frame, so it is likely static, filter it once for the next frames.
+        auto cacheSurface = skSurface->makeSurface(cacheRect.width(), cacheRect.height());
+        if (cacheSurface != nullptr) {
+            auto cacheBounds = SkRect::MakeIWH(cacheRect.width(), cacheRect.height());
+            filter->DrawImageRect(*cacheSurface->getCanvas(), imageSnapshot, cacheBounds, cacheBounds);
+            auto cachedImage = cacheSurface->makeImageSnapshot();
+            filter->SetCachedImage(cachedImage, cacheRect);
+            DrawCachedFilter(canvas, cachedImage, cacheRect);
+            filter->PostProcess(canvas);
+            filter->ConsumeBackdropMark();
+            return;
+        }
+    }
     auto clipBounds = SkRect::Make(canvas.getDeviceClipBounds());
     canvas.resetMatrix();
     auto visibleRect = canvas.GetVisibleRect();
     if (visibleRect.intersect(clipBounds)) {
         // the snapshot only contains the clip region, so we need to offset the src rect
-        canvas.drawImageRect(
-            imageSnapshot.get(), visibleRect.makeOffset(-clipBounds.left(), -clipBounds.top()), visibleRect, &paint);
+        filter->DrawImageRect(
+            canvas, imageSnapshot, visibleRect.makeOffset(-clipBounds.left(), -clipBounds.top()), visibleRect);
     } else {
         // the snapshot only contains the clip region, so we need to offset the src rect
-        canvas.drawImageRect(
-            imageSnapshot.get(), clipBounds.makeOffset(-clipBounds.left(), -clipBounds.top()), clipBounds, &paint);
+        filter->DrawImageRect(
+            canvas, imageSnapshot, clipBounds.makeOffset(-clipBounds.left(), -clipBounds.top()), clipBounds);
     }
     filter->PostProcess(canvas);
+    if (isCacheEnabled) {
+        filter->ConsumeBackdropMark();
+    }
+}
+
+void RSPropertiesPainter::DrawCachedFilter(
+    RSPaintFilterCanvas& canvas, const sk_sp<SkImage>& cachedImage, const SkIRect& cacheRect)
+{
+    canvas.resetMatrix();
+    auto dstRect = SkRect::Make(cacheRect);
+    auto visibleRect = canvas.GetVisibleRect();
+    if (visibleRect.intersect(dstRect)) {
+        dstRect = visibleRect;
+    }
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    // the cached image is the filtered cache rect, offset the src rect like the snapshot
+    canvas.drawImageRect(
+        cachedImage.get(), dstRect.makeOffset(-cacheRect.left(), -cacheRect.top()), dstRect, &paint);
 }
 
 SkColor RSPropertiesPainter::CalcAverageColor(sk_sp<SkImage> imageSnapshot)
@@ -16,6 +16,9 @@
 #include "render/rs_blur_filter.h"
 
 #include "include/effects/SkBlurImageFilter.h"
+
+#include "render/rs_dual_blur.h"
+
 namespace OHOS {
 namespace Rosen {
 RSBlurFilter::RSBlurFilter(float blurRadiusX, float blurRadiusY): RSSkiaFilter(SkBlurImageFilter::Make(blurRadiusX,
@@ -37,6 +40,16 @@ float RSBlurFilter::GetBlurRadiusY()
     return blurRadiusY_;
 }
 
+void RSBlurFilter::DrawImageRect(
+    SkCanvas& canvas, const sk_sp<SkImage>& image, const SkRect& src, const SkRect& dst) const
+{
+    int levels = RSDualBlur::GetDownsampleLevels(blurRadiusX_, blurRadiusY_, RSDualBlur::GetQuality());
+    if (levels > 0 && RSDualBlur::Draw(canvas, image, src, dst, blurRadiusX_, blurRadiusY_, levels, GetPaint())) {
+        return;
+    }
+    RSSkiaFilter::DrawImageRect(canvas, image, src, dst);
+}
+
 std::shared_ptr<RSFilter> RSBlurFilter::Add(const std::shared_ptr<RSFilter>& rhs)
 {
     if ((rhs == nullptr) || (rhs->GetFilterType() != FilterType::BLUR)) {
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/rs_dual_blur.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "include/core/SkSurface.h"
+#include "include/effects/SkBlurImageFilter.h"
+
+#include "platform/common/rs_log.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+// the sigma left at the lowest resolution, below it the result is blocky.
+constexpr float MIN_SIGMA_BALANCED = 4.0f;
+constexpr float MIN_SIGMA_FAST = 2.0f;
+constexpr int MAX_LEVELS = 4;
+// variance of a halving, a 2x2 box, and of the bilinear upscale, a tent, in pixels of the lower resolution.
+constexpr float HALVING_VARIANCE = 0.25f;
+constexpr float UPSCALE_VARIANCE = 1.0f / 6.0f;
+
+sk_sp<SkSurface> MakeSurface(SkCanvas& canvas, const sk_sp<SkImage>& image, int width, int height)
+{
+    auto info = SkImageInfo::MakeN32Premul(width, height, image->refColorSpace());
+    auto surface = canvas.makeSurface(info);
+    if (surface == nullptr) {
+        // no GPU context, or the canvas is not backed by a device.
+        surface = SkSurface::MakeRaster(info);
+    }
+    return surface;
+}
+
+// the sigma to blur with at the lowest resolution, given the blur of the halvings and the upscale.
+float GetResidualSigma(float sigma, int levels)
+{
+    float scale = static_cast<float>(1 << levels);
+    float area = scale * scale;
+    // the halving of level i blurs 2^(i-1) full resolution pixels, sum of the variances is (4^levels - 1) / 12
+    float variance = sigma * sigma - HALVING_VARIANCE * (area - 1.0f) / 3.0f - UPSCALE_VARIANCE * area;
+    return variance > 0.0f ? std::sqrt(variance) / scale : 0.0f;
+}
+} // namespace
+
+int RSDualBlur::GetDownsampleLevels(float sigmaX, float sigmaY, BlurQualityType quality)
+{
+    float minSigma;
+    switch (quality) {
+        case BlurQualityType::BALANCED:
+            minSigma = MIN_SIGMA_BALANCED;
+            break;
+        case BlurQualityType::FAST:
+            minSigma = MIN_SIGMA_FAST;
+            break;
+        default:
+            return 0;
+    }
+    float sigma = std::min(sigmaX, sigmaY);
+    if (!(sigma >= minSigma * 2.0f)) {
+        return 0;
+    }
+    return std::min(static_cast<int>(std::log2(sigma / minSigma)), MAX_LEVELS);
+}
+
+BlurQualityType RSDualBlur::GetQuality()
+{
+    static BlurQualityType quality = RSSystemProperties::GetBlurQuality();
+    return quality;
+}
+
+bool RSDualBlur::Draw(SkCanvas& canvas, const sk_sp<SkImage>& image, const SkRect& src, const SkRect& dst,
+    float sigmaX, float sigmaY, int levels, const SkPaint& paint)
+{
+    if (image == nullptr || levels <= 0 || src.isEmpty() || dst.isEmpty()) {
+        return false;
+    }
+    // downsample, each level is drawn from the previous one, a bilinear halving averages 2x2 pixels.
+    SkPaint scalePaint;
+    scalePaint.setBlendMode(SkBlendMode::kSrc);
+    scalePaint.setFilterQuality(kLow_SkFilterQuality);
+    sk_sp<SkImage> current = image;
+    SkRect currentSrc = src;
+    for (int i = 1; i <= levels; i++) {
+        int width = std::max(static_cast<int>(std::ceil(src.width() / (1 << i))), 1);
+        int height = std::max(static_cast<int>(std::ceil(src.height() / (1 << i))), 1);
+        auto surface = MakeSurface(canvas, image, width, height);
+        if (surface == nullptr) {
+            ROSEN_LOGE("RSDualBlur::Draw make surface failed");
+            return false;
+        }
+        surface->getCanvas()->drawImageRect(current, currentSrc, SkRect::MakeIWH(width, height), &scalePaint);
+        current = surface->makeImageSnapshot();
+        currentSrc = SkRect::MakeIWH(width, height);
+    }
+
+    // blur with what is left of the sigma.
+    float residualX = GetResidualSigma(sigmaX, levels);
+    float residualY = GetResidualSigma(sigmaY, levels);
+    if (residualX > 0.0f || residualY > 0.0f) {
+        auto surface = MakeSurface(canvas, image, current->width(), current->height());
+        if (surface == nullptr) {
+            ROSEN_LOGE("RSDualBlur::Draw make surface failed");
+            return false;
+        }
+        SkPaint blurPaint;
+        blurPaint.setBlendMode(SkBlendMode::kSrc);
+        blurPaint.setImageFilter(SkBlurImageFilter::Make(residualX, residualY, nullptr, nullptr,
+            SkBlurImageFilter::kClamp_TileMode));
+        surface->getCanvas()->drawImage(current, 0, 0, &blurPaint);
+        current = surface->makeImageSnapshot();
+    }
+
+    // upsample into dst with the paint of the caller.
+    SkPaint upscalePaint(paint);
+    upscalePaint.setImageFilter(nullptr);
+    upscalePaint.setFilterQuality(kLow_SkFilterQuality);
+    canvas.drawImageRect(current, currentSrc, dst, &upscalePaint);
+    return true;
+}
+} // namespace Rosen
+} // namespace OHOS
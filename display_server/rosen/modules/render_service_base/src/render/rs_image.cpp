@@ -15,12 +15,17 @@
 
 #include "render/rs_image.h"
 
+#include <cinttypes>
+
 #include "include/core/SkPaint.h"
 #include "include/core/SkRRect.h"
+#include "command/rs_image_cache_command.h"
+#include "command/rs_message_processor.h"
 #include "pixel_map_rosen_utils.h"
 #include "platform/common/rs_log.h"
 #include "property/rs_properties_painter.h"
 #include "render/rs_image_cache.h"
+#include "render/rs_image_transfer_cache.h"
 #include "rs_trace.h"
 #include "sandbox_utils.h"
 
@@ -51,6 +56,9 @@ bool RSImage::IsEqual(const RSImage& other) const
 
 void RSImage::CanvasDrawImage(SkCanvas& canvas, const SkRect& rect, const SkPaint& paint, bool isBackground)
 {
+    if (isImageMissing_) {
+        ResolveMissingImage();
+    }
     canvas.save();
     frameRect_.SetAll(rect.left(), rect.top(), rect.width(), rect.height());
     if (!isBackground) {
@@ -144,6 +152,18 @@ void RSImage::UploadGpu(SkCanvas& canvas)
 #endif
 }
 
+void RSImage::ResolveMissingImage()
+{
+    // the pixels come with RSImageCacheResend, see RSImageTransferCache::OnMissed
+    auto cache = RSImageCache::Instance().GetSkiaImageCache(uniqueId_);
+    if (cache == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    image_ = cache;
+    isImageMissing_ = false;
+}
+
 void RSImage::DrawImageRepeatRect(const SkPaint& paint, SkCanvas& canvas)
 {
     int minX = 0;
@@ -249,14 +269,31 @@ void RSImage::SetScale(double scale)
 }
 
 #ifdef ROSEN_OHOS
+void RSImage::AcknowledgeTransfer(uint64_t uniqueId, const sk_sp<SkImage>& img)
+{
+    if (img == nullptr) {
+        return;
+    }
+    uint32_t sequence = RSImageCache::Instance().PinTransferredImage(uniqueId, img);
+    if (sequence == 0) {
+        return;
+    }
+    std::unique_ptr<RSCommand> command = std::make_unique<RSImageCacheAcknowledge>(uniqueId, sequence,
+        img->imageInfo().computeMinByteSize(), RSImageCache::TRANSFER_BUDGET);
+    RSMessageProcessor::Instance().AddUIMessage(static_cast<uint32_t>(uniqueId >> 32), command); // 32 for the pid
+}
+
 bool RSImage::Marshalling(Parcel& parcel) const
 {
     int imageFit = static_cast<int>(imageFit_);
     int imageRepeat = static_cast<int>(imageRepeat_);
 
     std::lock_guard<std::mutex> lock(mutex_);
+    // the pixels are sent until the render service acknowledges it holds the image, then only the id.
+    bool heldByService = image_ && RSImageTransferCache::Instance().IsHeldByService(uniqueId_, image_);
     bool success = RSMarshallingHelper::Marshalling(parcel, uniqueId_) &&
-                   RSMarshallingHelper::Marshalling(parcel, image_) &&
+                   RSMarshallingHelper::Marshalling(parcel, heldByService) &&
+                   RSMarshallingHelper::Marshalling(parcel, heldByService ? sk_sp<SkImage>() : image_) &&
                    RSMarshallingHelper::Marshalling(parcel, compressData_) &&
                    RSMarshallingHelper::Marshalling(parcel, static_cast<int>(srcRect_.width_)) &&
                    RSMarshallingHelper::Marshalling(parcel, static_cast<int>(srcRect_.height_)) &&
@@ -279,20 +316,38 @@ RSImage* RSImage::Unmarshalling(Parcel& parcel)
     SkVector radius[CORNER_SIZE];
     double scale;
     uint64_t uniqueId;
-    if (!RSMarshallingHelper::Unmarshalling(parcel, uniqueId)) {
+    bool heldByService = false;
+    bool isImageMissing = false;
+    if (!RSMarshallingHelper::Unmarshalling(parcel, uniqueId) ||
+        !RSMarshallingHelper::Unmarshalling(parcel, heldByService)) {
         return nullptr;
     }
     img = RSImageCache::Instance().GetSkiaImageCache(uniqueId);
-    if (img != nullptr) {
-        // match a cached skimage
+    if (heldByService) {
+        // only the id is sent, the image is pinned until the client releases it
         if (!RSMarshallingHelper::SkipSkImage(parcel)) {
             return nullptr;
         }
-    } else if (RSMarshallingHelper::Unmarshalling(parcel, img)) {
-        // unmarshalling the skimage and cache it
-        RSImageCache::Instance().CacheSkiaImage(uniqueId, img);
+        if (img == nullptr) {
+            // e.g. pinned by another connection of the client which is gone, ask the client for the pixels
+            ROSEN_LOGW("RSImage::Unmarshalling transferred image %" PRIu64 " not found, request it", uniqueId);
+            std::unique_ptr<RSCommand> command = std::make_unique<RSImageCacheMiss>(uniqueId);
+            RSMessageProcessor::Instance().AddUIMessage(static_cast<uint32_t>(uniqueId >> 32), command); // 32 for pid
+            isImageMissing = true;
+        }
     } else {
-        return nullptr;
+        if (img != nullptr) {
+            // match a cached skimage
+            if (!RSMarshallingHelper::SkipSkImage(parcel)) {
+                return nullptr;
+            }
+        } else if (RSMarshallingHelper::Unmarshalling(parcel, img)) {
+            // unmarshalling the skimage and cache it
+            RSImageCache::Instance().CacheSkiaImage(uniqueId, img);
+        } else {
+            return nullptr;
+        }
+        AcknowledgeTransfer(uniqueId, img);
     }
     if (img != nullptr) {
         if (!RSMarshallingHelper::SkipSkData(parcel)) {
@@ -336,6 +391,10 @@ RSImage* RSImage::Unmarshalling(Parcel& parcel)
     rsImage->SetRadius(radius);
     rsImage->SetScale(scale);
     rsImage->uniqueId_ = uniqueId;
+    if (isImageMissing) {
+        rsImage->isImageMissing_ = true;
+        rsImage->srcRect_.SetAll(0.0, 0.0, width, height);
+    }
 
     return rsImage;
 }
@@ -15,6 +15,9 @@
 
 #include "render/rs_image_cache.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace OHOS {
 namespace Rosen {
 // modify the RSImageCache instance as global to extend life cycle, fix destructor crash
@@ -52,5 +55,96 @@ void RSImageCache::ReleaseSkiaImageCache(uint64_t uniqueId)
         skiaImageCache_.erase(it);
     }
 }
+
+namespace {
+// the connection unmarshalling transaction data on this thread, 0 if none.
+thread_local uint64_t g_transferOwner = 0;
+} // namespace
+
+RSImageCache::TransferOwnerScope::TransferOwnerScope(uint64_t owner) : prevOwner_(g_transferOwner)
+{
+    g_transferOwner = owner;
+}
+
+RSImageCache::TransferOwnerScope::~TransferOwnerScope()
+{
+    g_transferOwner = prevOwner_;
+}
+
+uint32_t RSImageCache::PinTransferredImage(uint64_t uniqueId, sk_sp<SkImage> img)
+{
+    uint64_t owner = g_transferOwner;
+    if (!img || owner == 0) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = transferredImages_.find(uniqueId);
+    if (it == transferredImages_.end()) {
+        // the client evicts past the budget, twice of it leaves room for the releases in flight.
+        size_t bytes = img->imageInfo().computeMinByteSize();
+        size_t& ownerBytes = transferredBytes_[owner];
+        if (ownerBytes + bytes > TRANSFER_BUDGET * 2) {
+            return 0;
+        }
+        ownerBytes += bytes;
+        it = transferredImages_.emplace(uniqueId, TransferredImage { img, 0, bytes, owner }).first;
+        skiaImageCache_.emplace(uniqueId, img);
+    } else if (it->second.owner != owner) {
+        // sent again through another connection of the client, which holds the pin from now on.
+        auto& prevBytes = transferredBytes_[it->second.owner];
+        prevBytes -= std::min(prevBytes, it->second.bytes);
+        transferredBytes_[owner] += it->second.bytes;
+        it->second.owner = owner;
+    }
+    if (++transferSequence_ == 0) {
+        ++transferSequence_;
+    }
+    it->second.sequence = transferSequence_;
+    return transferSequence_;
+}
+
+void RSImageCache::ReleaseTransferredImage(uint64_t uniqueId, uint32_t sequence)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = transferredImages_.find(uniqueId);
+    if (it != transferredImages_.end() && it->second.sequence == sequence) {
+        UnpinLocked(it);
+    }
+}
+
+void RSImageCache::ReleaseTransferredImages(uint64_t owner)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = transferredImages_.begin(); it != transferredImages_.end();) {
+        auto next = std::next(it);
+        if (it->second.owner == owner) {
+            UnpinLocked(it);
+        }
+        it = next;
+    }
+    transferredBytes_.erase(owner);
+}
+
+size_t RSImageCache::GetTransferredBytes(uint64_t owner) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = transferredBytes_.find(owner);
+    return (it != transferredBytes_.end()) ? it->second : 0;
+}
+
+void RSImageCache::UnpinLocked(std::unordered_map<uint64_t, TransferredImage>::iterator it)
+{
+    uint64_t uniqueId = it->first;
+    auto bytesIt = transferredBytes_.find(it->second.owner);
+    if (bytesIt != transferredBytes_.end()) {
+        bytesIt->second -= std::min(bytesIt->second, it->second.bytes);
+    }
+    transferredImages_.erase(it);
+    // drop it from the skia cache as well if no RSImage uses it anymore, like ReleaseSkiaImageCache.
+    auto cacheIt = skiaImageCache_.find(uniqueId);
+    if (cacheIt != skiaImageCache_.end() && (!cacheIt->second || cacheIt->second->unique())) {
+        skiaImageCache_.erase(cacheIt);
+    }
+}
 } // namespace Rosen
 } // namespace OHOS
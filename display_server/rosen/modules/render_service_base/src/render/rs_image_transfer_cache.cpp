@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/rs_image_transfer_cache.h"
+
+#include <cinttypes>
+#include <vector>
+
+#include "command/rs_image_cache_command.h"
+#include "platform/common/rs_log.h"
+#include "transaction/rs_transaction_proxy.h"
+
+namespace OHOS {
+namespace Rosen {
+RSImageTransferCache& RSImageTransferCache::Instance()
+{
+    static RSImageTransferCache instance;
+    return instance;
+}
+
+bool RSImageTransferCache::IsHeldByService(uint64_t uniqueId, const sk_sp<SkImage>& image)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(uniqueId);
+    if (it == entries_.end()) {
+        return false;
+    }
+    if (image != nullptr) {
+        it->second->image = image;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return true;
+}
+
+void RSImageTransferCache::OnAcknowledged(uint64_t uniqueId, uint32_t sequence, uint64_t bytes, uint64_t budget)
+{
+    std::vector<Entry> victims;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(uniqueId);
+        if (it != entries_.end()) {
+            // sent again before the former acknowledgement arrived, the render service keeps the latest pin.
+            heldBytes_ -= it->second->bytes;
+            lru_.erase(it->second);
+        }
+        lru_.push_front({ uniqueId, sequence, bytes, nullptr });
+        entries_[uniqueId] = lru_.begin();
+        heldBytes_ += bytes;
+
+        while (heldBytes_ > budget && lru_.size() > 1) {
+            victims.push_back(lru_.back());
+            heldBytes_ -= lru_.back().bytes;
+            entries_.erase(lru_.back().uniqueId);
+            lru_.pop_back();
+        }
+    }
+
+    // from now on the victims are sent with their pixels again, which pins them again if the release is still in
+    // flight, the render service ignores the release of an outdated sequence.
+    auto transactionProxy = RSTransactionProxy::GetInstance();
+    if (transactionProxy == nullptr) {
+        return;
+    }
+    for (const auto& victim : victims) {
+        ROSEN_LOGD("RSImageTransferCache::OnAcknowledged release %" PRIu64, victim.uniqueId);
+        std::unique_ptr<RSCommand> command = std::make_unique<RSImageCacheRelease>(victim.uniqueId, victim.sequence);
+        transactionProxy->AddCommand(command, true);
+    }
+}
+
+void RSImageTransferCache::OnMissed(uint64_t uniqueId)
+{
+    sk_sp<SkImage> image;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(uniqueId);
+        if (it == entries_.end()) {
+            // evicted meanwhile, the next marshalling sends the pixels anyway
+            return;
+        }
+        image = std::move(it->second->image);
+        heldBytes_ -= it->second->bytes;
+        lru_.erase(it->second);
+        entries_.erase(it);
+    }
+    ROSEN_LOGW("RSImageTransferCache::OnMissed %" PRIu64 ", send it again", uniqueId);
+    auto transactionProxy = RSTransactionProxy::GetInstance();
+    if (image == nullptr || transactionProxy == nullptr) {
+        return;
+    }
+    std::unique_ptr<RSCommand> command = std::make_unique<RSImageCacheResend>(uniqueId, image);
+    transactionProxy->AddCommand(command, true);
+}
+
+void RSImageTransferCache::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    entries_.clear();
+    heldBytes_ = 0;
+}
+
+uint64_t RSImageTransferCache::GetHeldBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return heldBytes_;
+}
+} // namespace Rosen
+} // namespace OHOS
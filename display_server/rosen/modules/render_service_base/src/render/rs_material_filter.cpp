@@ -20,6 +20,7 @@
 
 #include "pipeline/rs_paint_filter_canvas.h"
 #include "property/rs_properties_painter.h"
+#include "render/rs_dual_blur.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -57,6 +58,11 @@ RSMaterialFilter::RSMaterialFilter(int style, float dipScale, BLUR_COLOR_MODE mo
       dipScale_(dipScale), style_(static_cast<MATERIAL_BLUR_STYLE>(style)), colorMode_(mode)
 {
     type_ = FilterType::MATERIAL;
+    auto iter = materialParams_.find(style_);
+    if (iter != materialParams_.end()) {
+        blurSigma_ = RadiusVp2Sigma(iter->second.radius, dipScale);
+        saturation_ = iter->second.saturation;
+    }
 }
 
 RSMaterialFilter::~RSMaterialFilter() = default;
@@ -105,6 +111,23 @@ void RSMaterialFilter::PostProcess(RSPaintFilterCanvas& canvas)
     canvas.drawPaint(paint);
 }
 
+void RSMaterialFilter::DrawImageRect(
+    SkCanvas& canvas, const sk_sp<SkImage>& image, const SkRect& src, const SkRect& dst) const
+{
+    int levels = RSDualBlur::GetDownsampleLevels(blurSigma_, blurSigma_, RSDualBlur::GetQuality());
+    if (levels > 0) {
+        // the saturation is linear, it is applied while upsampling instead of before the blur.
+        SkColorMatrix cm;
+        cm.setSaturation(saturation_);
+        auto paint = GetPaint();
+        paint.setColorFilter(SkColorFilters::Matrix(cm));
+        if (RSDualBlur::Draw(canvas, image, src, dst, blurSigma_, blurSigma_, levels, paint)) {
+            return;
+        }
+    }
+    RSSkiaFilter::DrawImageRect(canvas, image, src, dst);
+}
+
 std::shared_ptr<RSFilter> RSMaterialFilter::Add(const std::shared_ptr<RSFilter>& rhs)
 {
     return shared_from_this();
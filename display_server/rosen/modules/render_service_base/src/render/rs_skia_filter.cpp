@@ -17,6 +17,11 @@
 
 namespace OHOS {
 namespace Rosen {
+namespace {
+// bumped to drop the cached images of all the filters at once, only used by the render thread.
+uint32_t g_cacheEpoch = 0;
+}
+
 RSSkiaFilter::RSSkiaFilter(sk_sp<SkImageFilter> imageFilter) : RSFilter(), imageFilter_(imageFilter) {}
 
 RSSkiaFilter::~RSSkiaFilter() {}
@@ -29,5 +34,48 @@ SkPaint RSSkiaFilter::GetPaint() const
     paint.setImageFilter(imageFilter_);
     return paint;
 }
+
+void RSSkiaFilter::DrawImageRect(
+    SkCanvas& canvas, const sk_sp<SkImage>& image, const SkRect& src, const SkRect& dst) const
+{
+    auto paint = GetPaint();
+    canvas.drawImageRect(image.get(), src, dst, &paint);
+}
+
+void RSSkiaFilter::MarkBackdrop(bool changed)
+{
+    isBackdropStable_ = !changed;
+    if (changed) {
+        cachedImage_ = nullptr;
+    }
+}
+
+sk_sp<SkImage> RSSkiaFilter::GetCachedImage(const SkIRect& rect) const
+{
+    if (!isBackdropStable_ || cachedEpoch_ != g_cacheEpoch || cachedRect_ != rect) {
+        return nullptr;
+    }
+    return cachedImage_;
+}
+
+void RSSkiaFilter::SetCachedImage(sk_sp<SkImage> image, const SkIRect& rect)
+{
+    cachedImage_ = image;
+    cachedRect_ = rect;
+    cachedEpoch_ = g_cacheEpoch;
+}
+
+void RSSkiaFilter::ConsumeBackdropMark()
+{
+    if (!isBackdropStable_) {
+        cachedImage_ = nullptr;
+    }
+    isBackdropStable_ = false;
+}
+
+void RSSkiaFilter::InvalidateCachedImages()
+{
+    g_cacheEpoch++;
+}
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmark of RSYuvConverter at 1080p and 4K, compares the pooled and the single thread conversion with the
+// per pixel loop it replaced.
+// usage: rs_yuv_converter_perf_test [frames]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include "pipeline/rs_yuv_converter.h"
+
+using namespace OHOS::Rosen;
+
+namespace {
+constexpr int DEFAULT_FRAMES = 30;
+constexpr int COLOR_CHANNEL = 4;
+constexpr int STRIDE_ALIGNMENT = 64;
+struct Resolution {
+    const char* name;
+    int32_t width;
+    int32_t height;
+};
+constexpr Resolution RESOLUTIONS[] = { { "1080p", 1920, 1080 }, { "4K", 3840, 2160 } };
+
+// the former ConvertYUV420SPToRGBA loop, kept here as the baseline.
+void LegacyConvert(const YUV420SPImage& image, uint8_t* rgbaDst)
+{
+    for (int i = 0; i < image.height; i++) {
+        for (int j = 0; j < image.width; j++) {
+            int y = static_cast<int>(image.yPlane[i * image.stride + j]);
+            int u = static_cast<int>(image.uvPlane[i / 2 * image.stride + (j / 2) * 2 + 1]);
+            int v = static_cast<int>(image.uvPlane[i / 2 * image.stride + (j / 2) * 2]);
+            if (!image.vFirst) {
+                std::swap(u, v);
+            }
+            RSYuvConverter::ConvertPixel(static_cast<uint8_t>(y), static_cast<uint8_t>(u), static_cast<uint8_t>(v),
+                &rgbaDst[(i * image.width + j) * COLOR_CHANNEL]);
+        }
+    }
+}
+
+double MeasureMsPerFrame(int frames, const std::function<void()>& convert)
+{
+    convert(); // warm up, the first conversion also starts the workers
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        convert();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) {
+        printf("usage: %s [frames]\n", argv[0]);
+        return -1;
+    }
+
+    int ret = 0;
+    for (const auto& resolution : RESOLUTIONS) {
+        int32_t stride = (resolution.width + STRIDE_ALIGNMENT - 1) / STRIDE_ALIGNMENT * STRIDE_ALIGNMENT;
+        std::vector<uint8_t> yuv(static_cast<size_t>(stride) * resolution.height * 3 / 2); // 3 / 2: y and uv planes
+        for (size_t i = 0; i < yuv.size(); i++) {
+            yuv[i] = static_cast<uint8_t>(i * 7 + i / stride); // 7: any odd step
+        }
+        YUV420SPImage image;
+        image.yPlane = yuv.data();
+        image.uvPlane = yuv.data() + stride * resolution.height;
+        image.stride = stride;
+        image.width = resolution.width;
+        image.height = resolution.height;
+        size_t rgbaSize = static_cast<size_t>(resolution.width) * resolution.height * COLOR_CHANNEL;
+        std::vector<uint8_t> legacyRgba(rgbaSize);
+        std::vector<uint8_t> rowsRgba(rgbaSize);
+        std::vector<uint8_t> pooledRgba(rgbaSize);
+
+        double legacyMs = MeasureMsPerFrame(frames, [&]() { LegacyConvert(image, legacyRgba.data()); });
+        double rowsMs = MeasureMsPerFrame(frames,
+            [&]() { RSYuvConverter::ConvertRows(image, rowsRgba.data(), 0, image.height); });
+        double pooledMs = MeasureMsPerFrame(frames,
+            [&]() { RSYuvConverter::Instance().ConvertYUV420SPToRGBA(image, pooledRgba.data()); });
+        bool same = legacyRgba == rowsRgba && legacyRgba == pooledRgba;
+        double megaPixels = resolution.width * resolution.height / 1e6;
+        printf("%-5s: legacy %7.2f ms/frame, one thread %7.2f ms/frame (%.2fx), pool %7.2f ms/frame (%.2fx), "
+            "%.0f MPix/s%s\n", resolution.name, legacyMs, rowsMs, legacyMs / rowsMs, pooledMs, legacyMs / pooledMs,
+            megaPixels * 1000 / pooledMs, same ? "" : " (MISMATCH)"); // 1000 ms per second
+        if (!same) {
+            ret = -1;
+        }
+    }
+    return ret;
+}
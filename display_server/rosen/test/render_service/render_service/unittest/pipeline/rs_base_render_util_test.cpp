@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
+
 #include "gtest/gtest.h"
 #include "limit_number.h"
 #include "pipeline/rs_base_render_util.h"
@@ -242,6 +244,60 @@ HWTEST_F(RSBaseRenderUtilTest, ConvertBufferToBitmap_003, TestSize.Level2)
     ASSERT_EQ(true, RSBaseRenderUtil::ConvertBufferToBitmap(cbuffer, newBuffer, dstGamut, bitmap));
 }
 
+/*
+ * @tc.name: ConvertBufferToBitmap_004
+ * @tc.desc: Test ConvertBufferToBitmap converts a DISPLAY_P3 buffer to SRGB, grey stays grey and alpha is kept
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSBaseRenderUtilTest, ConvertBufferToBitmap_004, TestSize.Level2)
+{
+    auto rsSurfaceRenderNode = RSTestUtil::CreateSurfaceNode();
+    const auto& surfaceConsumer = rsSurfaceRenderNode->GetConsumer();
+    auto producer = surfaceConsumer->GetProducer();
+    psurf = Surface::CreateSurfaceAsProducer(producer);
+    psurf->SetQueueSize(1);
+    sptr<SurfaceBuffer> buffer;
+    sptr<SyncFence> requestFence = SyncFence::INVALID_FENCE;
+    BufferRequestConfig config = requestConfig;
+    config.format = PIXEL_FMT_RGBA_8888;
+    config.colorGamut = GraphicColorGamut::GRAPHIC_COLOR_GAMUT_DISPLAY_P3;
+    GSError ret = psurf->RequestBuffer(buffer, requestFence, config);
+    ASSERT_EQ(ret, GSERROR_OK);
+    constexpr uint8_t grey = 0x80;
+    constexpr uint8_t alpha = 0x40;
+    auto addr = static_cast<uint8_t*>(buffer->GetVirAddr());
+    for (uint32_t i = 0; i < buffer->GetSize() / 4; i++) { // 4 is color channel
+        addr[i * 4] = grey;
+        addr[i * 4 + 1] = grey;
+        addr[i * 4 + 2] = grey; // 2 is blue
+        addr[i * 4 + 3] = alpha; // 3 is alpha
+    }
+    sptr<SyncFence> flushFence = SyncFence::INVALID_FENCE;
+    ret = psurf->FlushBuffer(buffer, flushFence, flushConfig);
+    OHOS::sptr<SurfaceBuffer> cbuffer;
+    Rect damage;
+    sptr<SyncFence> acquireFence = SyncFence::INVALID_FENCE;
+    int64_t timestamp = 0;
+    ret = surfaceConsumer->AcquireBuffer(cbuffer, acquireFence, timestamp, damage);
+    ASSERT_EQ(ret, GSERROR_OK);
+
+    // the second conversion reuses the buffer and the cached conversion
+    std::vector<uint8_t> newBuffer;
+    for (int i = 0; i < 2; i++) { // 2 is times of conversion
+        SkBitmap bitmap;
+        ASSERT_EQ(true, RSBaseRenderUtil::ConvertBufferToBitmap(cbuffer, newBuffer, ColorGamut::COLOR_GAMUT_SRGB,
+            bitmap));
+        ASSERT_EQ(newBuffer.size(), cbuffer->GetSize());
+        for (size_t j = 0; j < newBuffer.size(); j += 4) { // 4 is color channel
+            ASSERT_LE(std::abs(newBuffer[j] - grey), 1);
+            ASSERT_LE(std::abs(newBuffer[j + 1] - grey), 1);
+            ASSERT_LE(std::abs(newBuffer[j + 2] - grey), 1); // 2 is blue
+            ASSERT_EQ(newBuffer[j + 3], alpha); // 3 is alpha
+        }
+    }
+}
+
 /*
  * @tc.name: WritePixelMapToPng_001
  * @tc.desc: Test WritePixelMapToPng
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <parameters.h>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "limit_number.h"
+#include "pipeline/rs_composer_adapter.h"
+#include "pipeline/rs_hardware_thread.h"
+#include "platform/common/rs_system_properties.h"
+#include "rs_test_util.h"
+#include "screen_manager/rs_screen_manager.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSHardwareThreadTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+
+    std::unique_ptr<RSComposerAdapter> CreateComposerAdapter(bool asyncCommit);
+    // runs the task on the hardware thread after the tasks posted before
+    static void RunOnHardwareThread(const std::function<void()>& task);
+
+    sptr<RSScreenManager> screenManager_;
+    bool hardwareThreadStarted_ = false;
+    static inline uint32_t screenId_ = 0;
+};
+
+void RSHardwareThreadTest::SetUpTestCase() {}
+void RSHardwareThreadTest::TearDownTestCase()
+{
+    system::SetParameter("rosen.hardwarethread.enabled", "1");
+}
+void RSHardwareThreadTest::SetUp()
+{
+    screenManager_ = CreateOrGetScreenManager();
+    screenManager_->Init();
+    hardwareThreadStarted_ = RSHardwareThread::Instance().IsStarted();
+}
+void RSHardwareThreadTest::TearDown()
+{
+    // the thread is never stopped, a test that runs as if it were not started restores the state
+    RSHardwareThread::Instance().started_ = hardwareThreadStarted_;
+    screenManager_ = nullptr;
+}
+
+std::unique_ptr<RSComposerAdapter> RSHardwareThreadTest::CreateComposerAdapter(bool asyncCommit)
+{
+    auto rsScreen = std::make_unique<impl::RSScreen>(screenId_, false, HdiOutput::CreateHdiOutput(screenId_), nullptr);
+    screenManager_->MockHdiScreenConnected(rsScreen);
+    auto info = screenManager_->QueryScreenInfo(screenId_);
+    info.width = 2560;  // 2560: screen width
+    info.height = 1080; // 1080: screen height
+    screenId_++;
+    auto composerAdapter = std::make_unique<RSComposerAdapter>();
+    composerAdapter->Init(info, 0, 0, 1.0f, nullptr, asyncCommit);
+    return composerAdapter;
+}
+
+void RSHardwareThreadTest::RunOnHardwareThread(const std::function<void()>& task)
+{
+    RSHardwareThread::Instance().handler_->PostSyncTask(task, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+}
+
+/**
+ * @tc.name: HardwareThreadDisabled001
+ * @tc.desc: with rosen.hardwarethread.enabled=0 the thread is not started, the layers are committed and the buffers
+ *           are released on the calling thread
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSHardwareThreadTest, HardwareThreadDisabled001, Function | SmallTest | Level2)
+{
+    system::SetParameter("rosen.hardwarethread.enabled", "0");
+    ASSERT_FALSE(RSSystemProperties::GetHardwareThreadEnabled());
+    // the main thread does not start the thread when it is disabled, whatever the tests run before
+    auto& hardwareThread = RSHardwareThread::Instance();
+    hardwareThread.WaitForIdle();
+    hardwareThread.started_ = false;
+
+    auto composerAdapter = CreateComposerAdapter(true);
+    ASSERT_FALSE(composerAdapter->isAsyncCommit_);
+    auto surfaceNode = RSTestUtil::CreateSurfaceNodeWithBuffer();
+    ASSERT_NE(surfaceNode, nullptr);
+    std::vector<LayerInfoPtr> layers { composerAdapter->CreateLayer(*surfaceNode) };
+    composerAdapter->CommitLayers(layers);
+
+    auto& surfaceHandler = static_cast<RSSurfaceHandler&>(*surfaceNode);
+    surfaceHandler.SetBuffer(nullptr, SyncFence::INVALID_FENCE, {}, 0);
+    ASSERT_NE(surfaceHandler.GetPreBuffer().buffer, nullptr);
+    ASSERT_TRUE(RSBaseRenderUtil::ReleaseBuffer(surfaceHandler));
+    ASSERT_EQ(surfaceHandler.GetPreBuffer().buffer, nullptr);
+}
+
+/**
+ * @tc.name: HardwareThreadEnabled001
+ * @tc.desc: with rosen.hardwarethread.enabled=1 the asynchronous adapters commit on the hardware thread, and the
+ *           synchronous ones wait for it to be idle
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSHardwareThreadTest, HardwareThreadEnabled001, Function | SmallTest | Level2)
+{
+    system::SetParameter("rosen.hardwarethread.enabled", "1");
+    ASSERT_TRUE(RSSystemProperties::GetHardwareThreadEnabled());
+    auto& hardwareThread = RSHardwareThread::Instance();
+    hardwareThread.Start();
+    ASSERT_TRUE(hardwareThread.IsStarted());
+    auto handler = hardwareThread.handler_;
+    hardwareThread.Start();
+    ASSERT_EQ(hardwareThread.handler_, handler);
+
+    auto composerAdapter = CreateComposerAdapter(true);
+    ASSERT_TRUE(composerAdapter->isAsyncCommit_);
+    auto surfaceNode = RSTestUtil::CreateSurfaceNodeWithBuffer();
+    ASSERT_NE(surfaceNode, nullptr);
+    std::vector<LayerInfoPtr> layers { composerAdapter->CreateLayer(*surfaceNode) };
+    for (uint32_t i = 0; i <= RSHardwareThread::MAX_PENDING_COMMITS; i++) {
+        composerAdapter->CommitLayers(layers);
+    }
+
+    auto syncComposerAdapter = CreateComposerAdapter(false);
+    ASSERT_FALSE(syncComposerAdapter->isAsyncCommit_);
+    for (const auto& [screenId, count] : hardwareThread.pendingCommits_) {
+        ASSERT_EQ(count, 0u);
+    }
+}
+
+/**
+ * @tc.name: CommitAndRelease001
+ * @tc.desc: a buffer released after a commit is released after this commit, with its fence, and consumes it
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSHardwareThreadTest, CommitAndRelease001, Function | SmallTest | Level2)
+{
+    auto& hardwareThread = RSHardwareThread::Instance();
+    hardwareThread.Start();
+    ASSERT_TRUE(hardwareThread.IsStarted());
+    auto surfaceNode = RSTestUtil::CreateSurfaceNodeWithBuffer();
+    ASSERT_NE(surfaceNode, nullptr);
+    const auto& consumer = surfaceNode->GetConsumer();
+    uint64_t surfaceId = consumer->GetUniqueId();
+
+    RSHardwareCommit commit;
+    commit.output = HdiOutput::CreateHdiOutput(screenId_++);
+    commit.prepareOutput = [&hardwareThread, consumer, surfaceId](HdiOutput&) {
+        // a slow commit, the release posted after it must not overtake it
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50ms: longer than posting the release
+        hardwareThread.releaseFences_[surfaceId] = { consumer, SyncFence::INVALID_FENCE };
+    };
+    hardwareThread.CommitLayers(std::move(commit));
+    hardwareThread.ReleaseBuffer(consumer, surfaceNode->GetBuffer(), SyncFence::INVALID_FENCE);
+    RunOnHardwareThread([&hardwareThread, surfaceId]() {
+        EXPECT_EQ(hardwareThread.releaseFences_.count(surfaceId), 0u);
+    });
+    hardwareThread.WaitForIdle();
+}
+
+/**
+ * @tc.name: CommitAndRelease002
+ * @tc.desc: the release fences of the destroyed surfaces are dropped after the next commit
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSHardwareThreadTest, CommitAndRelease002, Function | SmallTest | Level2)
+{
+    auto& hardwareThread = RSHardwareThread::Instance();
+    hardwareThread.Start();
+    ASSERT_TRUE(hardwareThread.IsStarted());
+    auto surfaceNode = RSTestUtil::CreateSurfaceNode();
+    ASSERT_NE(surfaceNode, nullptr);
+    sptr<Surface> consumer = surfaceNode->GetConsumer();
+    uint64_t surfaceId = consumer->GetUniqueId();
+    RunOnHardwareThread([&hardwareThread, consumer, surfaceId]() {
+        hardwareThread.releaseFences_[surfaceId] = { consumer, SyncFence::INVALID_FENCE };
+    });
+    consumer = nullptr;
+    surfaceNode = nullptr;
+    RSTestUtil::CreateSurfaceNode(); // the test util keeps the last consumer
+
+    RSHardwareCommit commit;
+    commit.output = HdiOutput::CreateHdiOutput(screenId_++);
+    hardwareThread.CommitLayers(std::move(commit));
+    hardwareThread.WaitForIdle();
+    RunOnHardwareThread([&hardwareThread, surfaceId]() {
+        EXPECT_EQ(hardwareThread.releaseFences_.count(surfaceId), 0u);
+    });
+}
+} // namespace OHOS::Rosen
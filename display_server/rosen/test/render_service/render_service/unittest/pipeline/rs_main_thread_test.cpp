@@ -13,9 +13,17 @@
  * limitations under the License.
  */
 
+#include <chrono>
+
 #include "gtest/gtest.h"
 #include "limit_number.h"
+#include "message_parcel.h"
+#include "pipeline/rs_display_render_node.h"
 #include "pipeline/rs_main_thread.h"
+#include "pipeline/rs_unmarshal_thread.h"
+#include "rs_test_util.h"
+#include "vsync_controller.h"
+#include "vsync_generator.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -27,6 +35,18 @@ public:
     static void TearDownTestCase();
     void SetUp() override;
     void TearDown() override;
+
+    // the surfaces are top-down, like the occlusion cache
+    static std::vector<std::shared_ptr<RSSurfaceRenderNode>> CreateOcclusionSurfaces(size_t count);
+    // put the surfaces on a display under the global root of the main thread
+    static std::shared_ptr<RSDisplayRenderNode> SetOcclusionSurfaces(
+        const std::vector<std::shared_ptr<RSSurfaceRenderNode>>& surfaces);
+    static void ClearOcclusionSurfaces(const std::shared_ptr<RSDisplayRenderNode>& displayNode);
+    // mark the cache entries, the ones recalculated by CalcOcclusion lose the mark
+    static void MarkOcclusionCache();
+    static bool IsOcclusionCacheMarked(size_t index);
+
+    static constexpr uint64_t OCCLUSION_CACHE_MARK = UINT64_MAX;
 };
 
 void RSMainThreadTest::SetUpTestCase() {}
@@ -34,6 +54,56 @@ void RSMainThreadTest::TearDownTestCase() {}
 void RSMainThreadTest::SetUp() {}
 void RSMainThreadTest::TearDown() {}
 
+std::vector<std::shared_ptr<RSSurfaceRenderNode>> RSMainThreadTest::CreateOcclusionSurfaces(size_t count)
+{
+    constexpr int32_t offset = 0x40; // each surface covers a part of the ones below
+    constexpr int32_t size = 0x100;
+    std::vector<std::shared_ptr<RSSurfaceRenderNode>> surfaces;
+    for (size_t i = 0; i < count; i++) {
+        auto surface = RSTestUtil::CreateSurfaceNodeWithBuffer();
+        surface->SetDstRect({ static_cast<int32_t>(i) * offset, 0, size, size });
+        surfaces.push_back(surface);
+    }
+    return surfaces;
+}
+
+std::shared_ptr<RSDisplayRenderNode> RSMainThreadTest::SetOcclusionSurfaces(
+    const std::vector<std::shared_ptr<RSSurfaceRenderNode>>& surfaces)
+{
+    constexpr NodeId displayId = TestSrc::limitNumber::Uint64[0];
+    RSDisplayNodeConfig config;
+    auto displayNode = std::make_shared<RSDisplayRenderNode>(displayId, config);
+    displayNode->GetCurAllSurfaces().assign(surfaces.rbegin(), surfaces.rend());
+    auto mainThread = RSMainThread::Instance();
+    auto rootNode = mainThread->GetContext().GetGlobalRootRenderNode();
+    rootNode->ClearChildren();
+    rootNode->AddChild(displayNode);
+    mainThread->doWindowAnimate_ = false;
+    mainThread->useUniVisitor_ = false;
+    mainThread->isDirty_ = false;
+    return displayNode;
+}
+
+void RSMainThreadTest::ClearOcclusionSurfaces(const std::shared_ptr<RSDisplayRenderNode>& displayNode)
+{
+    auto mainThread = RSMainThread::Instance();
+    mainThread->GetContext().GetGlobalRootRenderNode()->RemoveChild(displayNode);
+    mainThread->occlusionCache_.clear();
+}
+
+void RSMainThreadTest::MarkOcclusionCache()
+{
+    for (auto& entry : RSMainThread::Instance()->occlusionCache_) {
+        entry.visibleIds.push_back(OCCLUSION_CACHE_MARK);
+    }
+}
+
+bool RSMainThreadTest::IsOcclusionCacheMarked(size_t index)
+{
+    const auto& visibleIds = RSMainThread::Instance()->occlusionCache_.at(index).visibleIds;
+    return !visibleIds.empty() && visibleIds.back() == OCCLUSION_CACHE_MARK;
+}
+
 /**
  * @tc.name: Start001
  * @tc.desc: Test RSMainThreadTest.Start
@@ -226,6 +296,100 @@ HWTEST_F(RSMainThreadTest, CalcOcclusion, TestSize.Level1)
     mainThread->CalcOcclusion();
 }
 
+/**
+ * @tc.name: CalcOcclusionCache001
+ * @tc.desc: Test RSMainThreadTest.CalcOcclusion, nothing is recalculated if no surface is dirty
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSMainThreadTest, CalcOcclusionCache001, TestSize.Level1)
+{
+    constexpr size_t surfaceCount = 3;
+    auto mainThread = RSMainThread::Instance();
+    auto surfaces = CreateOcclusionSurfaces(surfaceCount);
+    auto displayNode = SetOcclusionSurfaces(surfaces);
+    mainThread->CalcOcclusion();
+    ASSERT_EQ(mainThread->occlusionCache_.size(), surfaceCount);
+
+    MarkOcclusionCache();
+    mainThread->CalcOcclusion();
+    ASSERT_EQ(mainThread->occlusionCache_.size(), surfaceCount);
+    for (size_t i = 0; i < surfaceCount; i++) {
+        ASSERT_EQ(mainThread->occlusionCache_[i].id, surfaces[i]->GetId());
+        ASSERT_TRUE(IsOcclusionCacheMarked(i));
+    }
+    ClearOcclusionSurfaces(displayNode);
+}
+
+/**
+ * @tc.name: CalcOcclusionCache002
+ * @tc.desc: Test RSMainThreadTest.CalcOcclusion, a dirty surface in the middle of the z-order which does not change
+ *           the occluded region is recalculated alone, the surfaces above and below keep their result
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSMainThreadTest, CalcOcclusionCache002, TestSize.Level1)
+{
+    constexpr size_t surfaceCount = 4;
+    constexpr size_t dirtyIndex = 1;
+    auto mainThread = RSMainThread::Instance();
+    auto surfaces = CreateOcclusionSurfaces(surfaceCount);
+    auto displayNode = SetOcclusionSurfaces(surfaces);
+    mainThread->CalcOcclusion();
+    ASSERT_EQ(mainThread->occlusionCache_.size(), surfaceCount);
+    auto regionAfter = mainThread->occlusionCache_[dirtyIndex].regionAfter;
+
+    MarkOcclusionCache();
+    surfaces[dirtyIndex]->alphaChanged_ = true;
+    mainThread->CalcOcclusion();
+    ASSERT_FALSE(surfaces[dirtyIndex]->GetAlphaChanged());
+    for (size_t i = 0; i < surfaceCount; i++) {
+        ASSERT_EQ(IsOcclusionCacheMarked(i), i != dirtyIndex);
+    }
+    ASSERT_TRUE(mainThread->occlusionCache_[dirtyIndex].regionAfter.GetRegionRects() ==
+        regionAfter.GetRegionRects());
+    ClearOcclusionSurfaces(displayNode);
+}
+
+/**
+ * @tc.name: CalcOcclusionCache003
+ * @tc.desc: Test RSMainThreadTest.CalcOcclusion, adding or removing a surface invalidates the cache from its position
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSMainThreadTest, CalcOcclusionCache003, TestSize.Level1)
+{
+    constexpr size_t surfaceCount = 3;
+    auto mainThread = RSMainThread::Instance();
+    auto surfaces = CreateOcclusionSurfaces(surfaceCount);
+    auto displayNode = SetOcclusionSurfaces(surfaces);
+    mainThread->CalcOcclusion();
+    ASSERT_EQ(mainThread->occlusionCache_.size(), surfaceCount);
+
+    // a surface added at the bottom, the surfaces above keep their result
+    MarkOcclusionCache();
+    surfaces.push_back(CreateOcclusionSurfaces(1).front());
+    displayNode->GetCurAllSurfaces().assign(surfaces.rbegin(), surfaces.rend());
+    mainThread->CalcOcclusion();
+    ASSERT_EQ(mainThread->occlusionCache_.size(), surfaces.size());
+    for (size_t i = 0; i < surfaces.size(); i++) {
+        ASSERT_EQ(mainThread->occlusionCache_[i].id, surfaces[i]->GetId());
+        ASSERT_EQ(IsOcclusionCacheMarked(i), i < surfaceCount);
+    }
+
+    // the topmost surface removed, all the surfaces move up and are recalculated
+    MarkOcclusionCache();
+    surfaces.erase(surfaces.begin());
+    displayNode->GetCurAllSurfaces().assign(surfaces.rbegin(), surfaces.rend());
+    mainThread->CalcOcclusion();
+    ASSERT_EQ(mainThread->occlusionCache_.size(), surfaces.size());
+    for (size_t i = 0; i < surfaces.size(); i++) {
+        ASSERT_EQ(mainThread->occlusionCache_[i].id, surfaces[i]->GetId());
+        ASSERT_FALSE(IsOcclusionCacheMarked(i));
+    }
+    ClearOcclusionSurfaces(displayNode);
+}
+
 /**
  * @tc.name: CheckQosVisChanged001
  * @tc.desc: Test RSMainThreadTest.CheckQosVisChanged, pidVisMap is empty
@@ -439,4 +603,53 @@ HWTEST_F(RSMainThreadTest, RenderServiceTreeDump, TestSize.Level1)
     std::string str = "";
     mainThread->RenderServiceTreeDump(str);
 }
+
+/**
+ * @tc.name: ReportAppFrameDurationForUniRender
+ * @tc.desc: Test that the transaction data pushed to the ring by an unmarshal worker reports the app frame duration
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSMainThreadTest, ReportAppFrameDurationForUniRender, TestSize.Level1)
+{
+    constexpr pid_t pid = 1000;
+    constexpr int64_t frameDuration = 4000000; // 4ms
+    auto mainThread = RSMainThread::Instance();
+    auto generator = CreateVSyncGenerator();
+    sptr<VSyncController> controller = new VSyncController(generator, 0);
+    sptr<VSyncDistributor> distributor = new VSyncDistributor(controller, "app");
+    sptr<VSyncConnection> conn = new VSyncConnection(distributor, "RSMainThreadTest", pid);
+    distributor->AddConnection(conn);
+    mainThread->appVSyncDistributor_ = distributor;
+    mainThread->vsyncPhaseTuner_ = std::make_unique<VSyncPhaseTuner>(distributor, distributor, 0);
+
+    auto& unmarshalThread = RSUnmarshalThread::Instance();
+    if (unmarshalThread.GetWorkerCount() == 0) {
+        unmarshalThread.Start();
+    }
+    mainThread->isUniRender_ = true;
+    mainThread->unmarshalPassedGenerations_.assign(unmarshalThread.GetWorkerCount(),
+        mainThread->unmarshalBarrierGeneration_);
+    unmarshalThread.AddTransactionDataRing(pid);
+
+    RSTransactionData transactionData;
+    transactionData.SetSendingPid(pid);
+    transactionData.SetUniRender(true);
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    transactionData.timestamp_ =
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count() - frameDuration);
+    auto parcel = std::make_shared<MessageParcel>();
+    ASSERT_TRUE(parcel->WriteParcelable(&transactionData));
+    unmarshalThread.RecvParcel(parcel, pid, 0);
+    // the data is in the ring once the worker passed the barrier
+    mainThread->PostUnmarshalBarrier();
+    mainThread->WaitUntilUnmarshallingTaskFinished();
+    ASSERT_GE(distributor->GetFrameDuration(), frameDuration);
+
+    unmarshalThread.RemoveTransactionDataRing(pid);
+    distributor->RemoveConnection(conn);
+    mainThread->vsyncPhaseTuner_ = nullptr;
+    mainThread->appVSyncDistributor_ = nullptr;
+    DestroyVSyncGenerator();
+}
 } // namespace OHOS::Rosen
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "pipeline/rs_yuv_converter.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int32_t COLOR_CHANNEL = 4;
+constexpr uint8_t GUARD_VALUE = 0xa5;
+
+struct YuvBuffer {
+    std::vector<uint8_t> data;
+    YUV420SPImage image;
+};
+
+YuvBuffer CreateYuvBuffer(int32_t width, int32_t height, int32_t stride, bool vFirst)
+{
+    YuvBuffer buffer;
+    int32_t chromaHeight = (height + 1) / 2;
+    buffer.data.resize(static_cast<size_t>(stride) * (height + chromaHeight));
+    buffer.image.yPlane = buffer.data.data();
+    buffer.image.uvPlane = buffer.data.data() + stride * height;
+    buffer.image.stride = stride;
+    buffer.image.width = width;
+    buffer.image.height = height;
+    buffer.image.vFirst = vFirst;
+    return buffer;
+}
+
+// converts pixel by pixel with the tables.
+std::vector<uint8_t> ConvertByPixel(const YUV420SPImage& image)
+{
+    std::vector<uint8_t> rgba(static_cast<size_t>(image.width) * image.height * COLOR_CHANNEL);
+    int32_t uIndex = image.vFirst ? 1 : 0;
+    for (int32_t row = 0; row < image.height; row++) {
+        for (int32_t col = 0; col < image.width; col++) {
+            const uint8_t* uv = image.uvPlane + (row / 2) * image.stride + (col / 2) * 2;
+            RSYuvConverter::ConvertPixel(image.yPlane[row * image.stride + col], uv[uIndex], uv[1 - uIndex],
+                &rgba[(row * image.width + col) * COLOR_CHANNEL]);
+        }
+    }
+    return rgba;
+}
+} // namespace
+
+class RSYuvConverterTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSYuvConverterTest::SetUpTestCase() {}
+void RSYuvConverterTest::TearDownTestCase() {}
+void RSYuvConverterTest::SetUp() {}
+void RSYuvConverterTest::TearDown() {}
+
+/*
+ * @tc.name: ConvertPixel_001
+ * @tc.desc: Test ConvertPixel clamps to 0~255 and writes an opaque alpha
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSYuvConverterTest, ConvertPixel_001, TestSize.Level1)
+{
+    uint8_t rgba[COLOR_CHANNEL] = { 0 };
+    RSYuvConverter::ConvertPixel(0x80, 0x80, 0x80, rgba);
+    ASSERT_EQ(rgba[0], 0x80);
+    ASSERT_EQ(rgba[1], 0x80);
+    ASSERT_EQ(rgba[2], 0x80);
+    ASSERT_EQ(rgba[3], 0xff);
+    RSYuvConverter::ConvertPixel(0, 0, 0, rgba);
+    ASSERT_EQ(rgba[0], 0);
+    ASSERT_EQ(rgba[2], 0);
+    RSYuvConverter::ConvertPixel(0xff, 0xff, 0xff, rgba);
+    ASSERT_EQ(rgba[0], 0xff);
+    ASSERT_EQ(rgba[2], 0xff);
+}
+
+/*
+ * @tc.name: ConvertYUV420SPToRGBA_001
+ * @tc.desc: Test every Y of every pair of chroma samples is converted like the tables, for NV21 and NV12
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSYuvConverterTest, ConvertYUV420SPToRGBA_001, TestSize.Level1)
+{
+    // one pair of chroma samples per 2x2 pixels, u by column and v by row
+    constexpr int32_t size = 512;
+    constexpr int32_t pixelsPerPair = 4;
+    for (bool vFirst : { true, false }) {
+        YuvBuffer buffer = CreateYuvBuffer(size, size, size, vFirst);
+        uint8_t* uvPlane = buffer.data.data() + size * size;
+        for (int32_t row = 0; row < size / 2; row++) {
+            for (int32_t col = 0; col < size / 2; col++) {
+                uvPlane[row * size + col * 2 + (vFirst ? 1 : 0)] = static_cast<uint8_t>(col);
+                uvPlane[row * size + col * 2 + (vFirst ? 0 : 1)] = static_cast<uint8_t>(row);
+            }
+        }
+        std::vector<uint8_t> rgba(size * size * COLOR_CHANNEL);
+        for (int32_t base = 0; base < UINT8_MAX + 1; base += pixelsPerPair) {
+            for (int32_t row = 0; row < size; row++) {
+                for (int32_t col = 0; col < size; col++) {
+                    buffer.data[row * size + col] = static_cast<uint8_t>(base + (row % 2) * 2 + col % 2);
+                }
+            }
+            RSYuvConverter::Instance().ConvertYUV420SPToRGBA(buffer.image, rgba.data());
+            ASSERT_EQ(rgba, ConvertByPixel(buffer.image));
+        }
+    }
+}
+
+/*
+ * @tc.name: ConvertYUV420SPToRGBA_002
+ * @tc.desc: Test an odd width and height with a padded stride, the pixels after the image are not written
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSYuvConverterTest, ConvertYUV420SPToRGBA_002, TestSize.Level1)
+{
+    constexpr int32_t width = 37;
+    constexpr int32_t height = RSYuvConverter::STRIPE_ROWS * 3 + 1;
+    constexpr int32_t stride = 48;
+    YuvBuffer buffer = CreateYuvBuffer(width, height, stride, true);
+    uint32_t seed = 1;
+    for (auto& value : buffer.data) {
+        seed = seed * 1103515245 + 12345; // 1103515245, 12345: the factors of a linear congruential generator
+        value = static_cast<uint8_t>(seed >> 16); // 16 bits of the state are dropped
+    }
+    size_t rgbaSize = static_cast<size_t>(width) * height * COLOR_CHANNEL;
+    std::vector<uint8_t> rgba(rgbaSize + COLOR_CHANNEL, GUARD_VALUE);
+    RSYuvConverter::Instance().ConvertYUV420SPToRGBA(buffer.image, rgba.data());
+    std::vector<uint8_t> expected = ConvertByPixel(buffer.image);
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), rgba.begin()));
+    for (size_t i = rgbaSize; i < rgba.size(); i++) {
+        ASSERT_EQ(rgba[i], GUARD_VALUE);
+    }
+
+    // rows converted on the calling thread are the same
+    std::vector<uint8_t> rows(rgbaSize);
+    RSYuvConverter::ConvertRows(buffer.image, rows.data(), 0, height);
+    ASSERT_EQ(rows, expected);
+}
+
+/*
+ * @tc.name: ConvertYUV420SPToRGBA_003
+ * @tc.desc: Test invalid images are ignored
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSYuvConverterTest, ConvertYUV420SPToRGBA_003, TestSize.Level1)
+{
+    std::vector<uint8_t> rgba(COLOR_CHANNEL, GUARD_VALUE);
+    YUV420SPImage image;
+    RSYuvConverter::Instance().ConvertYUV420SPToRGBA(image, rgba.data());
+    YuvBuffer buffer = CreateYuvBuffer(1, 1, 1, true);
+    buffer.image.width = 0;
+    RSYuvConverter::Instance().ConvertYUV420SPToRGBA(buffer.image, rgba.data());
+    ASSERT_EQ(rgba, std::vector<uint8_t>(COLOR_CHANNEL, GUARD_VALUE));
+}
+} // namespace OHOS::Rosen
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmark of DrawCmdList, records the small lists of UI nodes through RSRecordingCanvas and plays them back
+// like the client render thread, then unmarshals and plays them back like the render service.
+// usage: rs_draw_cmd_list_perf_test [frames]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkSurface.h"
+#include "parcel.h"
+
+#include "pipeline/rs_draw_cmd_list.h"
+#include "pipeline/rs_recording_canvas.h"
+
+using namespace OHOS;
+using namespace OHOS::Rosen;
+
+namespace {
+constexpr int DEFAULT_FRAMES = 500;
+constexpr int NODE_COUNT = 64;
+constexpr int NODE_SIZE = 64;
+constexpr size_t PARCEL_CAPACITY = 16 * 1024 * 1024;
+
+// a button like node: background, border, icon clip and a few shapes
+std::shared_ptr<DrawCmdList> Record(int index)
+{
+    RSRecordingCanvas canvas(NODE_SIZE, NODE_SIZE);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorBLUE + index);
+    canvas.save();
+    canvas.translate(1.f, 1.f);
+    canvas.clipRect(SkRect::MakeWH(NODE_SIZE - 2, NODE_SIZE - 2));
+    canvas.drawRect(SkRect::MakeWH(NODE_SIZE - 2, NODE_SIZE - 2), paint);
+    canvas.drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(4, 4, 40, 20), 6, 6), paint); // 4, 40, 20, 6: a label
+    canvas.save();
+    SkPath path;
+    path.addCircle(48, 48, 8); // 48, 8: an icon in the corner
+    canvas.clipPath(path, true);
+    canvas.drawCircle(48, 48, 8, paint); // 48, 8: an icon in the corner
+    canvas.restore();
+    canvas.drawLine(4, 30, 60, 30, paint); // 4, 30, 60: a divider
+    canvas.restore();
+    return canvas.GetDrawCmdList();
+}
+
+template<typename Func>
+double MeasureUsPerFrame(int frames, Func&& func)
+{
+    func(); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        func();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) {
+        printf("usage: %s [frames]\n", argv[0]);
+        return -1;
+    }
+    auto surface = SkSurface::MakeRasterN32Premul(NODE_SIZE, NODE_SIZE);
+    if (surface == nullptr) {
+        printf("failed to create the surface\n");
+        return -1;
+    }
+    SkCanvas& canvas = *surface->getCanvas();
+
+    // client: every node is recorded again and drawn once per frame
+    double recordUs = MeasureUsPerFrame(frames, [&canvas]() {
+        for (int i = 0; i < NODE_COUNT; ++i) {
+            Record(i)->Playback(canvas);
+        }
+    });
+
+    // render service: the lists arrive in a parcel and are drawn a few times before the next update
+    std::vector<std::shared_ptr<DrawCmdList>> lists;
+    for (int i = 0; i < NODE_COUNT; ++i) {
+        lists.push_back(Record(i));
+    }
+    int opCount = 0;
+    for (const auto& list : lists) {
+        opCount += list->GetSize();
+    }
+    Parcel parcel;
+    parcel.SetMaxCapacity(PARCEL_CAPACITY);
+    for (const auto& list : lists) {
+        if (!list->Marshalling(parcel)) {
+            printf("failed to marshal the lists\n");
+            return -1;
+        }
+    }
+    bool unmarshalled = true;
+    double unmarshalUs = MeasureUsPerFrame(frames, [&]() {
+        parcel.RewindRead(0);
+        for (int i = 0; i < NODE_COUNT; ++i) {
+            std::unique_ptr<DrawCmdList> list(DrawCmdList::Unmarshalling(parcel));
+            if (list == nullptr) {
+                unmarshalled = false;
+                return;
+            }
+            for (int j = 0; j < 3; ++j) { // 3: frames drawn until the node changes
+                list->Playback(canvas);
+            }
+        }
+    });
+    if (!unmarshalled) {
+        printf("failed to unmarshal the lists\n");
+        return -1;
+    }
+
+    printf("%d nodes, %d ops per frame\n", NODE_COUNT, opCount);
+    // 1000 ns per us
+    printf("record + playback      : %8.1f us/frame, %6.0f ns/op\n", recordUs, recordUs * 1000 / opCount);
+    printf("unmarshal + 3 playbacks: %8.1f us/frame, %6.0f ns/op\n", unmarshalUs, unmarshalUs * 1000 / opCount);
+    return 0;
+}
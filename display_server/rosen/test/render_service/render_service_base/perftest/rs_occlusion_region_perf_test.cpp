@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2023 Huawei Technologies Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Microbenchmark of Occlusion::Region, compares the flat segment tree of RegionOpLocal with the pointer based
+// Node tree it replaced, using the occlusion pattern of RSMainThread::CalcOcclusion.
+// usage: rs_occlusion_region_perf_test [frames]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <set>
+
+#include "common/rs_occlusion_region.h"
+
+using namespace OHOS::Rosen::Occlusion;
+
+namespace {
+constexpr int SCREEN_WIDTH = 2560;
+constexpr int SCREEN_HEIGHT = 1440;
+constexpr int DEFAULT_FRAMES = 200;
+constexpr int WINDOW_COUNTS[] = { 10, 50, 200 };
+
+// the former RegionOpLocal, kept here as the baseline.
+void LegacyUpdateRects(std::vector<Rect>& preRects, std::vector<Rect>& curRects, int preY, int curY,
+    std::vector<Range>& ranges, std::vector<int>& indexAt, Region& res)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while (i < preRects.size() && j < ranges.size()) {
+        if (preRects[i].left_ == indexAt[ranges[j].start_] && preRects[i].right_ == indexAt[ranges[j].end_]) {
+            curRects.emplace_back(Rect { preRects[i].left_, preRects[i].top_, preRects[i].right_, curY });
+            i++;
+            j++;
+        } else if (preRects[i].right_ < indexAt[ranges[j].end_]) {
+            res.GetRegionRects().push_back(preRects[i]);
+            i++;
+        } else {
+            curRects.emplace_back(Rect { indexAt[ranges[j].start_], preY, indexAt[ranges[j].end_], curY });
+            j++;
+        }
+    }
+    for (; j < ranges.size(); j++) {
+        curRects.emplace_back(Rect { indexAt[ranges[j].start_], preY, indexAt[ranges[j].end_], curY });
+    }
+    for (; i < preRects.size(); i++) {
+        res.GetRegionRects().push_back(preRects[i]);
+    }
+    preRects.clear();
+    preRects.swap(curRects);
+}
+
+void LegacyRegionOp(Region& r1, Region& r2, Region& res, Region::OP op)
+{
+    res.GetRegionRects().clear();
+    std::vector<Event> events;
+    std::set<int> xs;
+    for (auto& r : r1.GetRegionRects()) {
+        events.emplace_back(Event { r.top_, Event::Type::OPEN, r.left_, r.right_ });
+        events.emplace_back(Event { r.bottom_, Event::Type::CLOSE, r.left_, r.right_ });
+        xs.insert(r.left_);
+        xs.insert(r.right_);
+    }
+    for (auto& r : r2.GetRegionRects()) {
+        events.emplace_back(Event { r.top_, Event::Type::VOID_OPEN, r.left_, r.right_ });
+        events.emplace_back(Event { r.bottom_, Event::Type::VOID_CLOSE, r.left_, r.right_ });
+        xs.insert(r.left_);
+        xs.insert(r.right_);
+    }
+    if (events.size() == 0) {
+        return;
+    }
+
+    std::map<int, int> indexOf;
+    std::vector<int> indexAt;
+    for (int x : xs) {
+        indexOf[x] = static_cast<int>(indexAt.size());
+        indexAt.push_back(x);
+    }
+    std::sort(events.begin(), events.end(), EventSortByY);
+
+    Node rootNode { 0, static_cast<int>(indexOf.size() - 1) };
+    std::vector<Range> ranges;
+    std::vector<Rect> preRects;
+    std::vector<Rect> curRects;
+    int preY = events[0].y_;
+    for (auto& e : events) {
+        int curY = e.y_;
+        ranges.clear();
+        if (op == Region::OP::OR) {
+            rootNode.GetOrRange(ranges, false, false);
+        } else {
+            rootNode.GetSubRange(ranges, false, false);
+        }
+        if (curY > preY) {
+            LegacyUpdateRects(preRects, curRects, preY, curY, ranges, indexAt, res);
+        }
+        rootNode.Update(indexOf[e.left_], indexOf[e.right_], e.type_);
+        preY = curY;
+    }
+    std::copy(preRects.begin(), preRects.end(), std::back_inserter(res.GetRegionRects()));
+    res.MakeBound();
+}
+
+std::vector<Rect> MakeWindows(int count, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> xDist(0, SCREEN_WIDTH - 1);
+    std::uniform_int_distribution<int> yDist(0, SCREEN_HEIGHT - 1);
+    std::vector<Rect> windows;
+    for (int i = 0; i < count; ++i) {
+        int l = xDist(rng);
+        int t = yDist(rng);
+        int r = std::min(SCREEN_WIDTH, l + 1 + xDist(rng) / 3);
+        int b = std::min(SCREEN_HEIGHT, t + 1 + yDist(rng) / 3);
+        windows.emplace_back(l, t, r, b);
+    }
+    return windows;
+}
+
+// top-down occlusion of the windows, like RSMainThread::CalcOcclusion, returns the total visible rect count.
+template<typename OpFunc>
+size_t CalcOcclusion(const std::vector<Rect>& windows, OpFunc&& regionOp)
+{
+    Region accumulated;
+    Region visible;
+    Region merged;
+    size_t visibleRects = 0;
+    for (auto rect : windows) {
+        Region window { rect };
+        regionOp(window, accumulated, visible, Region::OP::SUB);
+        visibleRects += visible.GetSize();
+        regionOp(accumulated, window, merged, Region::OP::OR);
+        std::swap(accumulated, merged);
+    }
+    return visibleRects;
+}
+
+template<typename OpFunc>
+double MeasureUsPerFrame(const std::vector<Rect>& windows, int frames, size_t& visibleRects, OpFunc&& regionOp)
+{
+    visibleRects = CalcOcclusion(windows, regionOp); // warm up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        visibleRects = CalcOcclusion(windows, regionOp);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / frames;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    int frames = (argc > 1) ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) {
+        printf("usage: %s [frames]\n", argv[0]);
+        return -1;
+    }
+
+    std::mt19937 rng(0);
+    Region region;
+    int ret = 0;
+    for (int count : WINDOW_COUNTS) {
+        std::vector<Rect> windows = MakeWindows(count, rng);
+        size_t legacyRects = 0;
+        size_t flatRects = 0;
+        double legacyUs = MeasureUsPerFrame(windows, frames, legacyRects, LegacyRegionOp);
+        double flatUs = MeasureUsPerFrame(windows, frames, flatRects,
+            [&region](Region& r1, Region& r2, Region& res, Region::OP op) { region.RegionOpLocal(r1, r2, res, op); });
+        printf("%4d windows: legacy %10.1f us/frame, flat %10.1f us/frame, speedup %.2fx%s\n", count, legacyUs,
+            flatUs, legacyUs / flatUs, legacyRects == flatRects ? "" : " (MISMATCH)");
+        if (legacyRects != flatRects) {
+            ret = -1;
+        }
+    }
+    return ret;
+}
@@ -27,6 +27,14 @@ public:
     void SetUp() override;
     void TearDown() override;
     static inline std::shared_ptr<Node> testnode;
+    static int GetArea(const Region& region)
+    {
+        int area = 0;
+        for (const auto& rect : region.GetRegionRects()) {
+            area += (rect.right_ - rect.left_) * (rect.bottom_ - rect.top_);
+        }
+        return area;
+    }
 };
 
 void RSOcclusionRegionTest::SetUpTestCase() {}
@@ -170,4 +178,67 @@ HWTEST_F(RSOcclusionRegionTest, GetSubRange001, Function | MediumTest | Level2)
     ASSERT_EQ(res.size(), 3);
     ASSERT_TRUE(res[2] == Range(0, 1));
 }
+
+/**
+ * @tc.name: RegionOp001
+ * @tc.desc: test results of region operations of two overlapped rects
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSOcclusionRegionTest, RegionOp001, Function | MediumTest | Level2)
+{
+    /**
+     * @tc.steps: step1. make two overlapped regions
+     */
+    Rect rect1 { 0, 0, 100, 100 };
+    Rect rect2 { 50, 50, 150, 150 };
+    Region region1 { rect1 };
+    Region region2 { rect2 };
+
+    /**
+     * @tc.steps: step2. check the results of And/Or/Xor/Sub
+     */
+    Region andRegion = region1.And(region2);
+    ASSERT_EQ(andRegion.GetSize(), 1);
+    ASSERT_TRUE(andRegion.GetRegionRects()[0] == Rect(50, 50, 100, 100));
+    ASSERT_EQ(GetArea(region1.Or(region2)), 17500);
+    ASSERT_EQ(GetArea(region1.Xor(region2)), 15000);
+    Region subRegion = region1.Sub(region2);
+    ASSERT_EQ(GetArea(subRegion), 7500);
+    ASSERT_TRUE(subRegion.GetBound() == rect1);
+    ASSERT_FALSE(subRegion.IsIntersectWith(Rect(50, 50, 100, 100)));
+}
+
+/**
+ * @tc.name: OperationSelf001
+ * @tc.desc: test results of region operations which write the result to itself
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSOcclusionRegionTest, OperationSelf001, Function | MediumTest | Level2)
+{
+    Rect rect1 { 0, 0, 100, 100 };
+    Rect rect2 { 50, 50, 150, 150 };
+    Region region1 { rect1 };
+    Region region2 { rect2 };
+
+    /**
+     * @tc.steps: step1. operate with another region, repeatedly
+     */
+    region1.OrSelf(region2);
+    ASSERT_EQ(GetArea(region1), 17500);
+    region1.SubSelf(region2);
+    ASSERT_EQ(GetArea(region1), 7500);
+    region1.OrSelf(region2);
+    ASSERT_EQ(GetArea(region1), 17500);
+    ASSERT_EQ(GetArea(region2), 10000);
+
+    /**
+     * @tc.steps: step2. operate with itself
+     */
+    region2.OrSelf(region2);
+    ASSERT_EQ(GetArea(region2), 10000);
+    region2.SubSelf(region2);
+    ASSERT_TRUE(region2.IsEmpty());
+}
 } // namespace OHOS::Rosen
\ No newline at end of file
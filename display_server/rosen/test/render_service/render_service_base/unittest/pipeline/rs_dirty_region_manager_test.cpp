@@ -92,4 +92,84 @@ HWTEST_F(RSDirtyRegionManagerTest, SetSurfaceSize001, TestSize.Level1)
     height = 1;
     ASSERT_TRUE(manager->SetSurfaceSize(width, height));
 }
-} // namespace OHOS::Rosen
\ No newline at end of file
+
+/**
+ * @tc.name: MergeDirtyRect001
+ * @tc.desc: test distant dirty rects are kept apart
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSDirtyRegionManagerTest, MergeDirtyRect001, TestSize.Level1)
+{
+    /**
+     * @tc.steps: step1. merge two small rects in opposite corners
+     */
+    manager->MergeDirtyRect(RectI(0, 0, 100, 50));
+    manager->MergeDirtyRect(RectI(1800, 1000, 20, 20));
+    ASSERT_EQ(manager->GetDirtyRects().size(), 2u);
+    ASSERT_EQ(manager->GetDirtyRegion(), RectI(0, 0, 1820, 1020));
+
+    /**
+     * @tc.steps: step2. merge a rect overlapping the first one
+     */
+    manager->MergeDirtyRect(RectI(50, 0, 100, 50));
+    ASSERT_EQ(manager->GetDirtyRects().size(), 2u);
+    ASSERT_EQ(manager->GetDirtyRects()[1], RectI(0, 0, 150, 50));
+}
+
+/**
+ * @tc.name: MergeDirtyRect002
+ * @tc.desc: test dirty rects are bounded and disjoint
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSDirtyRegionManagerTest, MergeDirtyRect002, TestSize.Level1)
+{
+    constexpr int32_t count = 20;
+    constexpr int32_t step = 500;
+    for (int32_t i = 0; i < count; ++i) {
+        manager->MergeDirtyRect(RectI((i % 5) * step, (i / 5) * step, 10 + i, 10 + i));
+    }
+    const auto& rects = manager->GetDirtyRects();
+    ASSERT_LE(rects.size(), RSDirtyRegionManager::MAX_DIRTY_RECT_COUNT);
+    for (size_t i = 0; i < rects.size(); ++i) {
+        for (size_t j = i + 1; j < rects.size(); ++j) {
+            ASSERT_TRUE(rects[i].IntersectRect(rects[j]).IsEmpty());
+        }
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        RectI rect((i % 5) * step, (i / 5) * step, 10 + i, 10 + i);
+        bool covered = false;
+        for (const auto& subRect : rects) {
+            covered = covered || rect.IsInsideOf(subRect);
+        }
+        ASSERT_TRUE(covered);
+    }
+}
+
+/**
+ * @tc.name: UpdateDirty001
+ * @tc.desc: test history merging keeps separate rects
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSDirtyRegionManagerTest, UpdateDirty001, TestSize.Level1)
+{
+    ASSERT_TRUE(manager->SetSurfaceSize(1920, 1080));
+    manager->MergeDirtyRect(RectI(0, 0, 100, 50));
+    manager->UpdateDirty();
+    manager->Clear();
+    manager->MergeDirtyRect(RectI(1800, 1000, 20, 20));
+    ASSERT_TRUE(manager->SetBufferAge(2));
+    manager->UpdateDirty();
+    ASSERT_EQ(manager->GetDirtyRects().size(), 2u);
+
+    /**
+     * @tc.steps: step1. invalid buffer age falls back to the whole surface
+     */
+    ASSERT_TRUE(manager->SetBufferAge(0));
+    manager->UpdateDirty();
+    ASSERT_EQ(manager->GetDirtyRects().size(), 1u);
+    ASSERT_EQ(manager->GetDirtyRegion(), RectI(0, 0, 1920, 1080));
+}
+} // namespace OHOS::Rosen
@@ -333,6 +333,41 @@ HWTEST_F(RSPropertiesPainterTest, DrawFilter002, TestSize.Level1)
     RSPropertiesPainter::DrawFilter(properties, canvas, filter, nullptr, canvas.GetSurface());
 }
 
+/**
+ * @tc.name: FilterCache001
+ * @tc.desc: the cached image is only returned while the backdrop is stable
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSPropertiesPainterTest, FilterCache001, TestSize.Level1)
+{
+    auto filter = std::static_pointer_cast<RSSkiaFilter>(RSFilter::CreateBlurFilter(1.f, 1.f));
+    auto skSurface = SkSurface::MakeRasterN32Premul(10, 10);
+    ASSERT_NE(skSurface, nullptr);
+    auto image = skSurface->makeImageSnapshot();
+    SkIRect rect = SkIRect::MakeWH(10, 10);
+
+    filter->MarkBackdrop(false);
+    EXPECT_TRUE(filter->IsBackdropStable());
+    filter->SetCachedImage(image, rect);
+    EXPECT_EQ(filter->GetCachedImage(rect), image);
+    EXPECT_EQ(filter->GetCachedImage(SkIRect::MakeWH(5, 5)), nullptr);
+
+    // the mark is consumed by the draw, the visitor marks the backdrop again in the next frame.
+    filter->ConsumeBackdropMark();
+    EXPECT_EQ(filter->GetCachedImage(rect), nullptr);
+    filter->MarkBackdrop(false);
+    EXPECT_EQ(filter->GetCachedImage(rect), image);
+
+    // a change of the composition invalidates all the caches.
+    RSSkiaFilter::InvalidateCachedImages();
+    EXPECT_EQ(filter->GetCachedImage(rect), nullptr);
+
+    filter->SetCachedImage(image, rect);
+    filter->MarkBackdrop(true);
+    EXPECT_EQ(filter->GetCachedImage(rect), nullptr);
+}
+
 /**
  * @tc.name: DrawBackground001
  * @tc.desc: test
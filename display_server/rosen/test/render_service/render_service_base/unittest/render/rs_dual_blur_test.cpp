@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "include/core/SkSurface.h"
+#include "include/render/rs_blur_filter.h"
+#include "include/render/rs_dual_blur.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+namespace {
+constexpr int IMAGE_SIZE = 256;
+constexpr int CHECKER_SIZE = 37;
+constexpr float SIGMA = 30.0f;
+// per channel, out of 255.
+constexpr int MAX_DIFF = 16;
+constexpr double MAX_MEAN_DIFF = 2.0;
+
+sk_sp<SkImage> MakeCheckerImage()
+{
+    auto surface = SkSurface::MakeRasterN32Premul(IMAGE_SIZE, IMAGE_SIZE);
+    auto canvas = surface->getCanvas();
+    canvas->clear(SK_ColorBLACK);
+    SkPaint paint;
+    for (int y = 0; y < IMAGE_SIZE; y += CHECKER_SIZE) {
+        for (int x = 0; x < IMAGE_SIZE; x += CHECKER_SIZE) {
+            paint.setColor(((x + y) / CHECKER_SIZE) % 2 ? SK_ColorWHITE : SK_ColorRED);
+            canvas->drawRect(SkRect::MakeXYWH(x, y, CHECKER_SIZE, CHECKER_SIZE), paint);
+        }
+    }
+    return surface->makeImageSnapshot();
+}
+
+std::vector<uint8_t> ReadPixels(const sk_sp<SkSurface>& surface)
+{
+    std::vector<uint8_t> pixels(IMAGE_SIZE * IMAGE_SIZE * 4);
+    auto info = SkImageInfo::MakeN32Premul(IMAGE_SIZE, IMAGE_SIZE);
+    surface->readPixels(info, pixels.data(), IMAGE_SIZE * 4, 0, 0);
+    return pixels;
+}
+} // namespace
+
+class RSDualBlurTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSDualBlurTest::SetUpTestCase() {}
+void RSDualBlurTest::TearDownTestCase() {}
+void RSDualBlurTest::SetUp() {}
+void RSDualBlurTest::TearDown() {}
+
+/**
+ * @tc.name: GetDownsampleLevels001
+ * @tc.desc: small sigmas and the high quality are blurred at full resolution
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSDualBlurTest, GetDownsampleLevels001, TestSize.Level1)
+{
+    EXPECT_EQ(RSDualBlur::GetDownsampleLevels(SIGMA, SIGMA, BlurQualityType::HIGH), 0);
+    EXPECT_EQ(RSDualBlur::GetDownsampleLevels(4.0f, 4.0f, BlurQualityType::BALANCED), 0);
+    EXPECT_EQ(RSDualBlur::GetDownsampleLevels(-SIGMA, -SIGMA, BlurQualityType::BALANCED), 0);
+    EXPECT_EQ(RSDualBlur::GetDownsampleLevels(8.0f, 8.0f, BlurQualityType::BALANCED), 1);
+    EXPECT_EQ(RSDualBlur::GetDownsampleLevels(SIGMA, SIGMA, BlurQualityType::BALANCED), 2);
+    EXPECT_EQ(RSDualBlur::GetDownsampleLevels(SIGMA, SIGMA, BlurQualityType::FAST), 3);
+    EXPECT_EQ(RSDualBlur::GetDownsampleLevels(SIGMA, 4.0f, BlurQualityType::BALANCED), 0);
+    EXPECT_EQ(RSDualBlur::GetDownsampleLevels(1000.0f, 1000.0f, BlurQualityType::BALANCED), 4);
+}
+
+/**
+ * @tc.name: Draw001
+ * @tc.desc: the downsampled blur is close to the full resolution blur of RSBlurFilter
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSDualBlurTest, Draw001, TestSize.Level1)
+{
+    auto image = MakeCheckerImage();
+    ASSERT_NE(image, nullptr);
+    auto bounds = SkRect::MakeIWH(IMAGE_SIZE, IMAGE_SIZE);
+
+    auto filter = std::make_shared<RSBlurFilter>(SIGMA, SIGMA);
+    auto expected = SkSurface::MakeRasterN32Premul(IMAGE_SIZE, IMAGE_SIZE);
+    filter->RSSkiaFilter::DrawImageRect(*expected->getCanvas(), image, bounds, bounds);
+
+    int levels = RSDualBlur::GetDownsampleLevels(SIGMA, SIGMA, BlurQualityType::BALANCED);
+    ASSERT_GT(levels, 0);
+    auto actual = SkSurface::MakeRasterN32Premul(IMAGE_SIZE, IMAGE_SIZE);
+    ASSERT_TRUE(RSDualBlur::Draw(*actual->getCanvas(), image, bounds, bounds, SIGMA, SIGMA, levels,
+        filter->GetPaint()));
+
+    auto expectedPixels = ReadPixels(expected);
+    auto actualPixels = ReadPixels(actual);
+    int maxDiff = 0;
+    double sumDiff = 0.0;
+    for (size_t i = 0; i < expectedPixels.size(); i++) {
+        int diff = std::abs(static_cast<int>(expectedPixels[i]) - static_cast<int>(actualPixels[i]));
+        maxDiff = std::max(maxDiff, diff);
+        sumDiff += diff;
+    }
+    EXPECT_LE(maxDiff, MAX_DIFF);
+    EXPECT_LE(sumDiff / expectedPixels.size(), MAX_MEAN_DIFF);
+}
+
+/**
+ * @tc.name: Draw002
+ * @tc.desc: nothing is drawn for an empty rect or without levels
+ * @tc.type: FUNC
+ */
+HWTEST_F(RSDualBlurTest, Draw002, TestSize.Level1)
+{
+    auto image = MakeCheckerImage();
+    auto surface = SkSurface::MakeRasterN32Premul(IMAGE_SIZE, IMAGE_SIZE);
+    auto bounds = SkRect::MakeIWH(IMAGE_SIZE, IMAGE_SIZE);
+    SkPaint paint;
+    EXPECT_FALSE(RSDualBlur::Draw(*surface->getCanvas(), nullptr, bounds, bounds, SIGMA, SIGMA, 1, paint));
+    EXPECT_FALSE(RSDualBlur::Draw(*surface->getCanvas(), image, bounds, bounds, SIGMA, SIGMA, 0, paint));
+    EXPECT_FALSE(RSDualBlur::Draw(*surface->getCanvas(), image, SkRect::MakeEmpty(), bounds, SIGMA, SIGMA, 1, paint));
+}
+} // namespace OHOS::Rosen
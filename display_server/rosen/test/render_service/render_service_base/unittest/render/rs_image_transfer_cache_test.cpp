@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
+#include "include/render/rs_image_cache.h"
+#include "include/render/rs_image_transfer_cache.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS::Rosen {
+class RSImageTransferCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp() override;
+    void TearDown() override;
+};
+
+void RSImageTransferCacheTest::SetUpTestCase() {}
+void RSImageTransferCacheTest::TearDownTestCase() {}
+void RSImageTransferCacheTest::SetUp()
+{
+    RSImageTransferCache::Instance().Reset();
+}
+void RSImageTransferCacheTest::TearDown()
+{
+    RSImageTransferCache::Instance().Reset();
+}
+
+static sk_sp<SkImage> CreateImage(int width, int height)
+{
+    auto surface = SkSurface::MakeRasterN32Premul(width, height);
+    surface->getCanvas()->clear(SK_ColorRED);
+    return surface->makeImageSnapshot();
+}
+
+static constexpr uint64_t TEST_PID = static_cast<uint64_t>(1000) << 32;
+static constexpr uint64_t TEST_OWNER = 1;
+
+/**
+ * @tc.name: IsHeldByService001
+ * @tc.desc: the image is held only after it is acknowledged
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageTransferCacheTest, IsHeldByService001, TestSize.Level1)
+{
+    auto& cache = RSImageTransferCache::Instance();
+    ASSERT_FALSE(cache.IsHeldByService(TEST_PID | 1));
+    cache.OnAcknowledged(TEST_PID | 1, 1, 100, 1000);
+    ASSERT_TRUE(cache.IsHeldByService(TEST_PID | 1));
+    ASSERT_EQ(cache.GetHeldBytes(), 100);
+    // acknowledged again with a new sequence, not counted twice
+    cache.OnAcknowledged(TEST_PID | 1, 2, 100, 1000);
+    ASSERT_EQ(cache.GetHeldBytes(), 100);
+    cache.Reset();
+    ASSERT_FALSE(cache.IsHeldByService(TEST_PID | 1));
+}
+
+/**
+ * @tc.name: OnAcknowledged001
+ * @tc.desc: the least recently used images are evicted past the budget
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageTransferCacheTest, OnAcknowledged001, TestSize.Level1)
+{
+    auto& cache = RSImageTransferCache::Instance();
+    cache.OnAcknowledged(TEST_PID | 1, 1, 400, 1000);
+    cache.OnAcknowledged(TEST_PID | 2, 2, 400, 1000);
+    // use image 1, so image 2 is the least recently used one
+    ASSERT_TRUE(cache.IsHeldByService(TEST_PID | 1));
+    cache.OnAcknowledged(TEST_PID | 3, 3, 400, 1000);
+    ASSERT_TRUE(cache.IsHeldByService(TEST_PID | 1));
+    ASSERT_FALSE(cache.IsHeldByService(TEST_PID | 2));
+    ASSERT_TRUE(cache.IsHeldByService(TEST_PID | 3));
+    ASSERT_EQ(cache.GetHeldBytes(), 800);
+}
+
+/**
+ * @tc.name: OnMissed001
+ * @tc.desc: a missed image is not held anymore, so its pixels are sent again
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageTransferCacheTest, OnMissed001, TestSize.Level1)
+{
+    auto& cache = RSImageTransferCache::Instance();
+    cache.OnAcknowledged(TEST_PID | 1, 1, 100, 1000);
+    ASSERT_TRUE(cache.IsHeldByService(TEST_PID | 1, CreateImage(4, 4)));
+    cache.OnMissed(TEST_PID | 1);
+    ASSERT_FALSE(cache.IsHeldByService(TEST_PID | 1));
+    ASSERT_EQ(cache.GetHeldBytes(), 0);
+    // not held, nothing to do
+    cache.OnMissed(TEST_PID | 2);
+    ASSERT_EQ(cache.GetHeldBytes(), 0);
+}
+
+/**
+ * @tc.name: PinTransferredImage001
+ * @tc.desc: a pinned image stays in the RSImageCache until the pin of the same sequence is released
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageTransferCacheTest, PinTransferredImage001, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    const uint64_t uniqueId = TEST_PID | 10;
+    ASSERT_EQ(cache.PinTransferredImage(uniqueId, CreateImage(4, 4)), 0); // not unmarshalled for a connection
+    RSImageCache::TransferOwnerScope ownerScope(TEST_OWNER);
+    ASSERT_EQ(cache.PinTransferredImage(uniqueId, nullptr), 0);
+
+    uint32_t sequence1 = cache.PinTransferredImage(uniqueId, CreateImage(4, 4));
+    ASSERT_NE(sequence1, 0);
+    ASSERT_NE(cache.GetSkiaImageCache(uniqueId), nullptr);
+    ASSERT_EQ(cache.GetTransferredBytes(TEST_OWNER), 4 * 4 * 4);
+    // sent again while the release of sequence1 is in flight
+    uint32_t sequence2 = cache.PinTransferredImage(uniqueId, cache.GetSkiaImageCache(uniqueId));
+    ASSERT_NE(sequence2, sequence1);
+    cache.ReleaseTransferredImage(uniqueId, sequence1);
+    ASSERT_NE(cache.GetSkiaImageCache(uniqueId), nullptr);
+    cache.ReleaseTransferredImage(uniqueId, sequence2);
+    ASSERT_EQ(cache.GetSkiaImageCache(uniqueId), nullptr);
+    ASSERT_EQ(cache.GetTransferredBytes(TEST_OWNER), 0);
+}
+
+/**
+ * @tc.name: ReleaseTransferredImages001
+ * @tc.desc: all the images pinned by a dead connection are released, those of the other connections stay
+ * @tc.type:FUNC
+ */
+HWTEST_F(RSImageTransferCacheTest, ReleaseTransferredImages001, TestSize.Level1)
+{
+    auto& cache = RSImageCache::Instance();
+    const uint64_t otherOwner = TEST_OWNER + 1;
+    {
+        RSImageCache::TransferOwnerScope ownerScope(TEST_OWNER);
+        ASSERT_NE(cache.PinTransferredImage(TEST_PID | 20, CreateImage(4, 4)), 0);
+        ASSERT_NE(cache.PinTransferredImage(TEST_PID | 21, CreateImage(4, 4)), 0);
+    }
+    {
+        // another connection of the same process
+        RSImageCache::TransferOwnerScope ownerScope(otherOwner);
+        ASSERT_NE(cache.PinTransferredImage(TEST_PID | 22, CreateImage(4, 4)), 0);
+    }
+    cache.ReleaseTransferredImages(TEST_OWNER);
+    ASSERT_EQ(cache.GetSkiaImageCache(TEST_PID | 20), nullptr);
+    ASSERT_EQ(cache.GetSkiaImageCache(TEST_PID | 21), nullptr);
+    ASSERT_EQ(cache.GetTransferredBytes(TEST_OWNER), 0);
+    ASSERT_NE(cache.GetSkiaImageCache(TEST_PID | 22), nullptr);
+    ASSERT_EQ(cache.GetTransferredBytes(otherOwner), 4 * 4 * 4);
+    cache.ReleaseTransferredImages(otherOwner);
+    ASSERT_EQ(cache.GetSkiaImageCache(TEST_PID | 22), nullptr);
+}
+} // namespace OHOS::Rosen
@@ -13,7 +13,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <sys/mman.h>
+#include <unistd.h>
 
 #include "gtest/gtest.h"
 #include "include/core/SkCanvas.h"
@@ -231,6 +233,155 @@ HWTEST_F(RSAshmemTest, PixelMapAshmem001, Function | MediumTest | Level2)
     ASSERT_TRUE((int)parcel.GetDataSize() < width * height * pixelBytes);
 }
 
+/**
+ * @tc.name: ParcelSlabRing001
+ * @tc.desc: test the slabs are held once per parcel and reused once the parcel is released
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSAshmemTest, ParcelSlabRing001, Function | MediumTest | Level2)
+{
+    RSParcelSlabRing ring;
+    RSParcelSlabList slabs;
+    ASSERT_TRUE(RSParcelSlabRing::GetCurrentScope() == nullptr);
+    {
+        RSParcelSlabRing::Scope scope(ring, slabs);
+        ASSERT_EQ(RSParcelSlabRing::GetCurrentScope(), &scope);
+    }
+    ASSERT_TRUE(RSParcelSlabRing::GetCurrentScope() == nullptr);
+
+    size_t offset = 0;
+    ASSERT_TRUE(ring.Allocate(RSParcelSlab::SLAB_SIZE, offset, slabs) == nullptr);
+    auto slab = ring.Allocate(1000, offset, slabs);
+    ASSERT_TRUE(slab != nullptr);
+    ASSERT_EQ(offset, RSParcelSlab::GetFirstBlockOffset());
+    size_t nextOffset = 0;
+    ASSERT_EQ(ring.Allocate(1000, nextOffset, slabs), slab);
+    ASSERT_TRUE(nextOffset > offset);
+    ASSERT_EQ(slab->GetPendingCount(), 1u);
+    ASSERT_EQ(slabs.size(), 1u);
+
+    RSParcelSlabRing::ReleaseParcel(slabs);
+    ASSERT_TRUE(slabs.empty());
+    ASSERT_EQ(slab->GetPendingCount(), 0u);
+    ASSERT_EQ(ring.Allocate(1000, nextOffset, slabs), slab);
+    ASSERT_EQ(nextOffset, RSParcelSlab::GetFirstBlockOffset());
+    RSParcelSlabRing::ReleaseParcel(slabs);
+}
+
+/**
+ * @tc.name: ParcelSlabCache001
+ * @tc.desc: test the reader maps a slab once and rejects other fds
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSAshmemTest, ParcelSlabCache001, Function | MediumTest | Level2)
+{
+    auto slab = RSParcelSlab::Create();
+    ASSERT_TRUE(slab != nullptr);
+    auto mapped = RSParcelSlabCache::Instance().Get(dup(slab->GetFd()));
+    ASSERT_TRUE(mapped != nullptr);
+    ASSERT_EQ(mapped->GetFd(), -1);
+    ASSERT_EQ(RSParcelSlabCache::Instance().Get(dup(slab->GetFd())), mapped);
+    ASSERT_TRUE(mapped->IsValidBlock(RSParcelSlab::GetFirstBlockOffset(), 1000));
+    ASSERT_FALSE(mapped->IsValidBlock(0, 1000));
+    ASSERT_FALSE(mapped->IsValidBlock(RSParcelSlab::HEADER_SIZE, 1000));
+    ASSERT_FALSE(mapped->IsValidBlock(RSParcelSlab::GetFirstBlockOffset(), RSParcelSlab::SLAB_SIZE));
+
+    size_t size = 1024;
+    auto ashmemAllocator = AshmemAllocator::CreateAshmemAllocator(size, PROT_READ | PROT_WRITE);
+    ASSERT_TRUE(ashmemAllocator != nullptr);
+    ASSERT_TRUE(RSParcelSlabCache::Instance().Get(dup(ashmemAllocator->GetFd())) == nullptr);
+}
+
+/**
+ * @tc.name: ParcelSlabCache002
+ * @tc.desc: test the cache holds the slabs of each connected client
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSAshmemTest, ParcelSlabCache002, Function | MediumTest | Level2)
+{
+    auto& cache = RSParcelSlabCache::Instance();
+    cache.AddClient();
+    cache.AddClient();
+    std::vector<std::shared_ptr<RSParcelSlab>> slabs;
+    std::vector<std::shared_ptr<RSParcelSlab>> mappedSlabs;
+    for (size_t i = 0; i < 2 * RSParcelSlabCache::MAX_CACHED_SLABS_PER_CLIENT; i++) {
+        auto slab = RSParcelSlab::Create();
+        ASSERT_TRUE(slab != nullptr);
+        auto mapped = cache.Get(dup(slab->GetFd()));
+        ASSERT_TRUE(mapped != nullptr);
+        slabs.push_back(slab);
+        mappedSlabs.push_back(mapped);
+    }
+    // the rings of both clients stay mapped
+    for (size_t i = 0; i < slabs.size(); i++) {
+        ASSERT_EQ(cache.Get(dup(slabs[i]->GetFd())), mappedSlabs[i]);
+    }
+    cache.RemoveClient();
+    cache.RemoveClient();
+}
+
+/**
+ * @tc.name: SkImageSlab001
+ * @tc.desc: test the pixels of SkImage are read in place from the slab, and copied out of it once the parcel is
+ *           released if the image is still in use
+ * @tc.type:FUNC
+ * @tc.require:
+ */
+HWTEST_F(RSAshmemTest, SkImageSlab001, Function | MediumTest | Level2)
+{
+    /**
+     * @tc.steps: step1. serialize SkImage in the scope of a slab ring
+     */
+    auto skImage = CreateSkImage(200, 300);
+    ASSERT_TRUE(skImage != nullptr);
+    RSParcelSlabRing ring;
+    RSParcelSlabList slabs;
+    MessageParcel parcel;
+    {
+        RSParcelSlabRing::Scope scope(ring, slabs);
+        ASSERT_TRUE(RSMarshallingHelper::Marshalling(parcel, skImage));
+    }
+    ASSERT_EQ(slabs.size(), 1u);
+    auto slab = slabs.front();
+    ASSERT_EQ(slab->GetPendingCount(), 1u);
+
+    /**
+     * @tc.steps: step2. deserialize SkImage in the scope of a slab holder, the pixels are read in place
+     */
+    auto holder = std::make_unique<RSParcelSlabHolder>(parcel);
+    sk_sp<SkImage> result;
+    {
+        RSParcelSlabHolder::Scope scope(*holder);
+        ASSERT_TRUE(RSMarshallingHelper::Unmarshalling(parcel, result));
+    }
+    ASSERT_TRUE(result != nullptr);
+    auto mapped = RSParcelSlabCache::Instance().Get(dup(slab->GetFd()));
+    ASSERT_TRUE(mapped != nullptr);
+    SkPixmap pixmap;
+    ASSERT_TRUE(result->peekPixels(&pixmap));
+    auto pixels = static_cast<const uint8_t*>(pixmap.addr());
+    ASSERT_TRUE(pixels >= mapped->GetData(0) && pixels < mapped->GetData(0) + RSParcelSlab::SLAB_SIZE);
+    ASSERT_EQ(slab->GetPendingCount(), 1u);
+
+    /**
+     * @tc.steps: step3. release the parcel and start the slab over, the image outlives the slab block
+     */
+    holder = nullptr;
+    ASSERT_EQ(slab->GetPendingCount(), 0u);
+    size_t offset = 0;
+    ASSERT_TRUE(slab->Reserve(RSParcelSlab::SLAB_SIZE - RSParcelSlab::GetFirstBlockOffset(), offset));
+    std::fill_n(slab->GetData(offset), RSParcelSlab::SLAB_SIZE - offset, 0);
+    ASSERT_TRUE(result->peekPixels(&pixmap));
+    ASSERT_EQ(pixmap.addr(), pixels);
+    SkPixmap expected;
+    ASSERT_TRUE(skImage->peekPixels(&expected));
+    ASSERT_EQ(memcmp(pixmap.addr(), expected.addr(), expected.computeByteSize()), 0);
+    ASSERT_TRUE(RSParcelSlabCache::Instance().Get(dup(slab->GetFd())) != mapped);
+}
+
 /**
  * @tc.name: CreateAshmemParcel001
  * @tc.desc: test
@@ -28,6 +28,12 @@
 #define RS_ASYNC_TRACE_END(name, value) FinishAsyncTrace(HITRACE_TAG_GRAPHIC_AGP, name, value)
 #define RS_TRACE_INT(name, value) CountTrace(HITRACE_TAG_GRAPHIC_AGP, name, value)
 #define RS_TRACE_FUNC() RS_TRACE_NAME(__func__)
+#ifdef _FANGTIAN
+// the hitrace_meter of fangtian has no IsTagEnabled, the optional trace arguments are always built.
+#define RS_TRACE_ENABLED() true
+#else
+#define RS_TRACE_ENABLED() IsTagEnabled(HITRACE_TAG_GRAPHIC_AGP)
+#endif
 #else
 #define ROSEN_TRACE_BEGIN(tag, name)
 #define RS_TRACE_BEGIN(name)
@@ -39,6 +45,7 @@
 #define RS_ASYNC_TRACE_END(name, value)
 #define RS_TRACE_INT(name, value)
 #define RS_TRACE_FUNC()
+#define RS_TRACE_ENABLED() false
 #endif
 
 #endif // GRAPHIC_RS_TRACE_H
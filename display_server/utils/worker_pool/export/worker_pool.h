@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_WORKER_POOL_H
+#define UTILS_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OHOS {
+// A small pool of persistent threads per process for the loops over the stripes of an image in the raster code
+// paths, so that a call does not pay for creating and joining threads. The workers start with the first call that
+// can use them, and the thread locals of the tasks live as long as the workers.
+class WorkerPool {
+public:
+    static WorkerPool& Instance();
+
+    // calls task(index) for each index in [0, count) on the calling thread and the workers, and returns once all of
+    // them returned. the calls run on the calling thread alone while another thread has a job in the pool, and when
+    // ParallelFor is called from a task.
+    void ParallelFor(int32_t count, const std::function<void(int32_t)>& task);
+    // the number of threads running the tasks of a job, including the caller.
+    size_t GetThreadCount();
+
+    static constexpr size_t MAX_THREAD_COUNT = 4;
+
+private:
+    WorkerPool() = default;
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool(const WorkerPool&&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&&) = delete;
+
+    void StartWorkers();
+    void WorkerLoop();
+    // runs the tasks of the current job until there is none left.
+    void RunTasks();
+
+    std::mutex jobOwnerMutex_; // one job at a time
+    bool workersStarted_ = false; // guarded by jobOwnerMutex_
+    std::vector<std::thread> workers_;
+
+    std::mutex jobMutex_;
+    std::condition_variable jobCond_;
+    std::condition_variable doneCond_;
+    bool stopped_ = false;       // guarded by jobMutex_
+    uint64_t jobGeneration_ = 0; // guarded by jobMutex_
+    // the workers between taking a job and running out of its tasks, guarded by jobMutex_
+    size_t busyWorkers_ = 0;
+
+    // the current job, only written when no worker is busy
+    const std::function<void(int32_t)>* task_ = nullptr;
+    int32_t taskCount_ = 0;
+    std::atomic<int32_t> nextTask_ = 0;
+};
+} // namespace OHOS
+#endif // UTILS_WORKER_POOL_H
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "worker_pool.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace {
+// true on the workers, and on a caller while it runs the tasks of its job
+thread_local bool g_inWorkerPoolTask = false;
+
+void RunOnCallingThread(int32_t count, const std::function<void(int32_t)>& task)
+{
+    for (int32_t index = 0; index < count; ++index) {
+        task(index);
+    }
+}
+} // namespace
+
+WorkerPool& WorkerPool::Instance()
+{
+    static WorkerPool instance;
+    return instance;
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        stopped_ = true;
+    }
+    jobCond_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void WorkerPool::ParallelFor(int32_t count, const std::function<void(int32_t)>& task)
+{
+    if (count <= 0) {
+        return;
+    }
+    if (count < 2 || g_inWorkerPoolTask) { // 2 tasks at least to share the work
+        RunOnCallingThread(count, task);
+        return;
+    }
+    // the pool is not waited for, the caller is as fast alone as behind another job
+    std::unique_lock<std::mutex> jobOwnerLock(jobOwnerMutex_, std::try_to_lock);
+    if (!jobOwnerLock.owns_lock()) {
+        RunOnCallingThread(count, task);
+        return;
+    }
+    if (!workersStarted_) {
+        StartWorkers();
+        workersStarted_ = true;
+    }
+    if (workers_.empty()) {
+        RunOnCallingThread(count, task);
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(jobMutex_);
+        // a worker may still be looking for the tasks of the previous job
+        doneCond_.wait(lock, [this] { return busyWorkers_ == 0; });
+        task_ = &task;
+        taskCount_ = count;
+        nextTask_ = 0;
+        ++jobGeneration_;
+    }
+    jobCond_.notify_all();
+    g_inWorkerPoolTask = true;
+    RunTasks();
+    g_inWorkerPoolTask = false;
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    doneCond_.wait(lock, [this] { return busyWorkers_ == 0; });
+}
+
+size_t WorkerPool::GetThreadCount()
+{
+    std::lock_guard<std::mutex> jobOwnerLock(jobOwnerMutex_);
+    if (!workersStarted_) {
+        StartWorkers();
+        workersStarted_ = true;
+    }
+    return workers_.size() + 1;
+}
+
+void WorkerPool::StartWorkers()
+{
+    // the caller runs tasks too, leave the other cores to the main thread and the render threads
+    size_t threadCount = std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, MAX_THREAD_COUNT);
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers_.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+void WorkerPool::WorkerLoop()
+{
+    g_inWorkerPoolTask = true;
+    uint64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobCond_.wait(lock, [this, generation] { return stopped_ || jobGeneration_ != generation; });
+            if (stopped_) {
+                return;
+            }
+            generation = jobGeneration_;
+            ++busyWorkers_;
+        }
+        RunTasks();
+        {
+            std::lock_guard<std::mutex> lock(jobMutex_);
+            --busyWorkers_;
+        }
+        doneCond_.notify_all();
+    }
+}
+
+void WorkerPool::RunTasks()
+{
+    for (int32_t index = nextTask_.fetch_add(1); index < taskCount_; index = nextTask_.fetch_add(1)) {
+        (*task_)(index);
+    }
+}
+} // namespace OHOS
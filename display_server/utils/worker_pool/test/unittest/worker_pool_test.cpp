@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "worker_pool.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+class WorkerPoolTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+};
+
+/*
+* Function: ParallelFor001
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: every index runs once, and the workers are reused across the calls
+*/
+HWTEST_F(WorkerPoolTest, ParallelFor001, Function | SmallTest | Level2)
+{
+    auto& pool = WorkerPool::Instance();
+    size_t threadCount = pool.GetThreadCount();
+    ASSERT_GE(threadCount, 1u);
+    ASSERT_LE(threadCount, WorkerPool::MAX_THREAD_COUNT);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    for (int round = 0; round < 100; ++round) { // 100: calls sharing the same workers
+        constexpr int32_t count = 64;
+        std::vector<std::atomic<int32_t>> calls(count);
+        pool.ParallelFor(count, [&](int32_t index) {
+            calls[index]++;
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        });
+        for (auto& call : calls) {
+            ASSERT_EQ(call.load(), 1);
+        }
+    }
+    ASSERT_LE(threads.size(), threadCount);
+    ASSERT_EQ(pool.GetThreadCount(), threadCount);
+}
+
+/*
+* Function: ParallelFor002
+* Type: Function
+* Rank: Important(2)
+* EnvConditions: N/A
+* CaseDescription: nested and concurrent calls run on their calling thread instead of waiting for the pool
+*/
+HWTEST_F(WorkerPoolTest, ParallelFor002, Function | SmallTest | Level2)
+{
+    auto& pool = WorkerPool::Instance();
+    pool.ParallelFor(0, [](int32_t) { FAIL(); });
+
+    std::atomic<int32_t> total = 0;
+    pool.ParallelFor(8, [&pool, &total](int32_t) { // 8: outer tasks
+        auto caller = std::this_thread::get_id();
+        pool.ParallelFor(8, [&total, caller](int32_t) { // 8: inner tasks
+            EXPECT_EQ(std::this_thread::get_id(), caller);
+            total++;
+        });
+    });
+    ASSERT_EQ(total.load(), 64); // 64: 8 * 8
+
+    total = 0;
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 4; ++i) { // 4: threads calling at once
+        callers.emplace_back([&pool, &total]() {
+            pool.ParallelFor(32, [&total](int32_t) { total++; }); // 32: tasks per caller
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    ASSERT_EQ(total.load(), 128); // 128: 4 * 32
+}
+} // namespace OHOS
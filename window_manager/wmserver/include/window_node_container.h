@@ -131,6 +131,10 @@ private:
     void TraverseWindowNode(sptr<WindowNode>& root, std::vector<sptr<WindowNode>>& windowNodes) const;
     sptr<WindowNode> FindRoot(WindowType type) const;
     sptr<WindowNode> FindWindowNodeById(uint32_t id) const;
+    bool IsRootNode(const sptr<WindowNode>& node) const;
+    void AddToWindowNodeMap(const sptr<WindowNode>& node);
+    void RemoveFromWindowNodeMap(const sptr<WindowNode>& node);
+    void CheckWindowNodeMap(uint32_t id, const sptr<WindowNode>& node) const;
     void UpdateFocusStatus(uint32_t id, bool focused);
     void UpdateActiveStatus(uint32_t id, bool isActive);
     void NotifyIfAvoidAreaChanged(const sptr<WindowNode>& node, const AvoidControlType avoidType) const;
@@ -185,6 +189,8 @@ private:
     WindowLayoutMode layoutMode_ = WindowLayoutMode::CASCADE;
     std::vector<Rect> currentCoveredArea_;
     std::vector<uint32_t> removedIds_;
+    // the windows on the tree by id, the main windows and their sub windows.
+    std::unordered_map<uint32_t, sptr<WindowNode>> windowNodeMap_;
     static AnimationConfig animationConfig_;
 
     sptr<WindowNode> belowAppWindowNode_ = new WindowNode();
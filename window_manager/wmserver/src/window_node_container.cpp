@@ -135,6 +135,7 @@ WMError WindowNodeContainer::AddWindowNodeOnWindowTree(sptr<WindowNode>& node, c
             displayGroupController_->sysBarNodeMaps_[node->GetDisplayId()][node->GetWindowType()] = node;
         }
     }
+    AddToWindowNodeMap(node);
     return WMError::WM_OK;
 }
 
@@ -309,6 +310,7 @@ void WindowNodeContainer::RemoveWindowNodeFromWindowTree(sptr<WindowNode>& node)
     } else {
         WLOGFE("can't find this node in parent");
     }
+    RemoveFromWindowNodeMap(node);
     node->parent_ = nullptr;
 }
 
@@ -714,20 +716,70 @@ sptr<WindowNode> WindowNodeContainer::FindRoot(WindowType type) const
 
 sptr<WindowNode> WindowNodeContainer::FindWindowNodeById(uint32_t id) const
 {
-    std::vector<sptr<WindowNode>> rootNodes = { aboveAppWindowNode_, appWindowNode_, belowAppWindowNode_ };
-    for (const auto& rootNode : rootNodes) {
-        for (auto& node : rootNode->children_) {
-            if (node->GetWindowId() == id) {
-                return node;
+    auto iter = windowNodeMap_.find(id);
+    sptr<WindowNode> node = iter != windowNodeMap_.end() ? iter->second : nullptr;
+#ifndef NDEBUG
+    CheckWindowNodeMap(id, node);
+#endif
+    return node;
+}
+
+bool WindowNodeContainer::IsRootNode(const sptr<WindowNode>& node) const
+{
+    return node != nullptr &&
+        (node == aboveAppWindowNode_ || node == appWindowNode_ || node == belowAppWindowNode_);
+}
+
+void WindowNodeContainer::AddToWindowNodeMap(const sptr<WindowNode>& node)
+{
+    const auto& parentNode = node->parent_;
+    if (IsRootNode(parentNode)) {
+        // a main window brings the sub windows it kept while it was removed.
+        windowNodeMap_[node->GetWindowId()] = node;
+        for (auto& child : node->children_) {
+            if (child->parent_ == node) {
+                windowNodeMap_[child->GetWindowId()] = child;
             }
-            for (auto& subNode : node->children_) {
-                if (subNode->GetWindowId() == id) {
-                    return subNode;
+        }
+    } else if (parentNode != nullptr && IsRootNode(parentNode->parent_) &&
+        windowNodeMap_.count(parentNode->GetWindowId()) != 0) {
+        windowNodeMap_[node->GetWindowId()] = node;
+    }
+}
+
+void WindowNodeContainer::RemoveFromWindowNodeMap(const sptr<WindowNode>& node)
+{
+    auto erase = [this](const sptr<WindowNode>& windowNode) {
+        auto iter = windowNodeMap_.find(windowNode->GetWindowId());
+        if (iter != windowNodeMap_.end() && iter->second == windowNode) {
+            windowNodeMap_.erase(iter);
+        }
+    };
+    erase(node);
+    for (auto& child : node->children_) {
+        erase(child);
+    }
+}
+
+void WindowNodeContainer::CheckWindowNodeMap(uint32_t id, const sptr<WindowNode>& node) const
+{
+    // the map must give what a walk of the tree finds.
+    sptr<WindowNode> treeNode = nullptr;
+    for (const auto& rootNode : { aboveAppWindowNode_, appWindowNode_, belowAppWindowNode_ }) {
+        for (auto& mainNode : rootNode->children_) {
+            if (mainNode->GetWindowId() == id) {
+                treeNode = mainNode;
+            }
+            for (auto& subNode : mainNode->children_) {
+                if (subNode->GetWindowId() == id && subNode->parent_ == mainNode) {
+                    treeNode = subNode;
                 }
             }
         }
     }
-    return nullptr;
+    if (treeNode != node) {
+        WLOGFE("window node map is inconsistent with the tree, windowId: %{public}u", id);
+    }
 }
 
 void WindowNodeContainer::UpdateFocusStatus(uint32_t id, bool focused)
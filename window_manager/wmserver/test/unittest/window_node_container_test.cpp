@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <gtest/gtest.h>
 
 #include "display_manager.h"
@@ -788,6 +789,54 @@ HWTEST_F(WindowNodeContainerTest, TakeWindowPairSnapshot, Function | SmallTest |
     ASSERT_TRUE(!container->TakeWindowPairSnapshot(defaultDisplay_->GetId()));
     container->ClearWindowPairSnapshot(defaultDisplay_->GetId());
 }
+/**
+ * @tc.name: FindWindowNodeById
+ * @tc.desc: find 500 main windows and their sub windows by id, before and after they are removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowNodeContainerTest, FindWindowNodeById, Function | SmallTest | Level2)
+{
+    constexpr uint32_t windowCount = 500;
+    constexpr uint32_t baseWindowId = 1000u;
+    sptr<WindowNodeContainer> container = new WindowNodeContainer(defaultDisplay_->GetDisplayInfo(),
+        defaultDisplay_->GetScreenId());
+    std::vector<sptr<WindowNode>> nodes;
+    for (uint32_t i = 0; i < windowCount; i++) {
+        sptr<WindowProperty> property = CreateWindowProperty(baseWindowId + i * 2, "main",
+            WindowType::WINDOW_TYPE_APP_MAIN_WINDOW, WindowMode::WINDOW_MODE_FLOATING, windowRect_);
+        sptr<WindowNode> node = new WindowNode(property, nullptr, nullptr);
+        ASSERT_EQ(WMError::WM_OK, container->AddWindowNodeOnWindowTree(node, nullptr));
+        container->UpdateWindowTree(node);
+        sptr<WindowProperty> subProperty = CreateWindowProperty(baseWindowId + i * 2 + 1, "sub",
+            WindowType::WINDOW_TYPE_APP_SUB_WINDOW, WindowMode::WINDOW_MODE_FLOATING, windowRect_);
+        sptr<WindowNode> subNode = new WindowNode(subProperty, nullptr, nullptr);
+        ASSERT_EQ(WMError::WM_OK, container->AddWindowNodeOnWindowTree(subNode, node));
+        container->UpdateWindowTree(subNode);
+        nodes.push_back(node);
+        nodes.push_back(subNode);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto& node : nodes) {
+        ASSERT_EQ(node, container->FindWindowNodeById(node->GetWindowId()));
+    }
+    auto cost = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    WLOGFI("find %{public}zu windows cost %{public}lld us", nodes.size(), static_cast<long long>(cost.count()));
+    ASSERT_EQ(nullptr, container->FindWindowNodeById(baseWindowId + windowCount * 2));
+
+    // a removed main window takes its sub windows off the tree.
+    container->RemoveWindowNodeFromWindowTree(nodes[0]);
+    ASSERT_EQ(nullptr, container->FindWindowNodeById(nodes[0]->GetWindowId()));
+    ASSERT_EQ(nullptr, container->FindWindowNodeById(nodes[1]->GetWindowId()));
+    ASSERT_EQ(WMError::WM_OK, container->AddWindowNodeOnWindowTree(nodes[0], nullptr));
+    container->UpdateWindowTree(nodes[0]);
+    ASSERT_EQ(nodes[1], container->FindWindowNodeById(nodes[1]->GetWindowId()));
+
+    for (auto& node : nodes) {
+        container->RemoveWindowNodeFromWindowTree(node);
+        ASSERT_EQ(nullptr, container->FindWindowNodeById(node->GetWindowId()));
+    }
+}
 /**
  * @tc.name: Destroy
  * @tc.desc: clear vector cache completely, swap with empty vector